@@ -0,0 +1,1299 @@
+/*
+	# Vector Template Library - Benchmarks
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	Micro-benchmarks for every operation of every vector type, built on Google
+	Benchmark. Each benchmark is named "<type>/<operation>", e.g.
+	"Vector3D<float>/dot", so runs can be filtered with --benchmark_filter.
+	To record results for comparing releases, write them out as JSON:
+
+		vectors_bench --benchmark_out=results.json --benchmark_out_format=json
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+/* Deps */
+#include "vectors.h"
+#include "vectors_curve.h"
+#include "vectors_dynamic.h"
+#include "vectors_hnsw.h"
+#include "vectors_index.h"
+#include "vectors_io.h"
+#include "vectors_matrix.h"
+#include "vectors_quant.h"
+#include "vectors_quaternion.h"
+#include "vectors_parallel.h"
+#include "vectors_mapped.h"
+#include "vectors_arena.h"
+#include "vectors_reduce.h"
+#include "vectors_spatial.h"
+#include "vectors_sparse.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/* Types */
+template <typename T>
+struct ElementName;
+template <>
+struct ElementName<float>
+{
+	static constexpr const char* value = "float";
+};
+template <>
+struct ElementName<double>
+{
+	static constexpr const char* value = "double";
+};
+template <>
+struct ElementName<int32_t>
+{
+	static constexpr const char* value = "int32_t";
+};
+
+template <typename V>
+struct HasCross
+{
+	static constexpr bool value = false;
+};
+template <typename T>
+struct HasCross<Vector3D<T>>
+{
+	static constexpr bool value = true;
+};
+
+/* Fixtures */
+template <typename V>
+V makeVector(const int& seed)
+{
+	/*
+		A vector with small, non-zero elements, so that every operation (including
+		integer division) is well defined.
+	*/
+
+	typedef typename VectorTraits<V>::ElementType T;
+
+	V v;
+	for (uint64_t i = 0; i < VectorTraits<V>::dimensions; i++)
+	{
+		v.value[i] = (T)(((seed + i) % 7) + 1);
+	};
+	return v;
+};
+
+/* Benchmarks */
+template <typename V, typename F>
+void benchmarkUnary(benchmark::State& state, const F& operation)
+{
+	V A = makeVector<V>(1);
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(A);
+		auto result = operation(A);
+		benchmark::DoNotOptimize(result);
+	};
+	state.SetItemsProcessed(state.iterations());
+};
+
+template <typename V, typename F>
+void benchmarkBinary(benchmark::State& state, const F& operation)
+{
+	V A = makeVector<V>(1);
+	V B = makeVector<V>(2);
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(A);
+		benchmark::DoNotOptimize(B);
+		auto result = operation(A, B);
+		benchmark::DoNotOptimize(result);
+	};
+	state.SetItemsProcessed(state.iterations());
+};
+
+template <typename V, typename F>
+void benchmarkAssignment(benchmark::State& state, const F& operation)
+{
+	V A = makeVector<V>(1);
+	V B = makeVector<V>(2);
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(B);
+		operation(A, B);
+		benchmark::DoNotOptimize(A);
+		benchmark::ClobberMemory();
+	};
+	state.SetItemsProcessed(state.iterations());
+};
+
+/* Registration */
+template <typename V>
+void registerVector(const std::string& type)
+{
+	/*
+		Registers a benchmark for each operation of vector type V.
+	*/
+
+	typedef typename VectorTraits<V>::ElementType T;
+
+	auto add = [&](const std::string& operation, void (*function)(benchmark::State&)) {
+		benchmark::RegisterBenchmark((type + "/" + operation).c_str(), function);
+	};
+
+	// Construction
+	add("construct", [](benchmark::State& state) {
+		for (auto _ : state)
+		{
+			V v;
+			benchmark::DoNotOptimize(v);
+		};
+	});
+	add("copy", [](benchmark::State& state) {
+		benchmarkUnary<V>(state, [](const V& A) { V copy(A); return copy; });
+	});
+
+	// Unary & Comparison Operators
+	add("negate", [](benchmark::State& state) { benchmarkUnary<V>(state, [](const V& A) { return -A; }); });
+	add("equal", [](benchmark::State& state) { benchmarkBinary<V>(state, [](const V& A, const V& B) { return A == B; }); });
+
+	// Binary Operators
+	add("add", [](benchmark::State& state) { benchmarkBinary<V>(state, [](const V& A, const V& B) { return A + B; }); });
+	add("sub", [](benchmark::State& state) { benchmarkBinary<V>(state, [](const V& A, const V& B) { return A - B; }); });
+	add("mul", [](benchmark::State& state) { benchmarkBinary<V>(state, [](const V& A, const V& B) { return A * B; }); });
+	add("div", [](benchmark::State& state) { benchmarkBinary<V>(state, [](const V& A, const V& B) { return A / B; }); });
+	add("add_scalar", [](benchmark::State& state) { benchmarkUnary<V>(state, [](const V& A) { return A + (T)3; }); });
+	add("sub_scalar", [](benchmark::State& state) { benchmarkUnary<V>(state, [](const V& A) { return A - (T)3; }); });
+	add("mul_scalar", [](benchmark::State& state) { benchmarkUnary<V>(state, [](const V& A) { return A * (T)3; }); });
+	add("div_scalar", [](benchmark::State& state) { benchmarkUnary<V>(state, [](const V& A) { return A / (T)3; }); });
+	add("scalar_sub", [](benchmark::State& state) { benchmarkUnary<V>(state, [](const V& A) { return (T)3 - A; }); });
+	add("scalar_div", [](benchmark::State& state) { benchmarkUnary<V>(state, [](const V& A) { return (T)3 / A; }); });
+
+	// Binary Assignment Operators
+	add("add_assign", [](benchmark::State& state) { benchmarkAssignment<V>(state, [](V& A, const V& B) { A += B; }); });
+	add("sub_assign", [](benchmark::State& state) { benchmarkAssignment<V>(state, [](V& A, const V& B) { A -= B; }); });
+	add("mul_assign", [](benchmark::State& state) { benchmarkAssignment<V>(state, [](V& A, const V& B) { A *= B; }); });
+	add("div_assign", [](benchmark::State& state) { benchmarkAssignment<V>(state, [](V& A, const V& B) { A /= B; }); });
+
+	// Product Operators
+	add("dot", [](benchmark::State& state) { benchmarkBinary<V>(state, [](const V& A, const V& B) { return A.dot(B); }); });
+	if constexpr (HasCross<V>::value)
+	{
+		add("cross", [](benchmark::State& state) { benchmarkBinary<V>(state, [](const V& A, const V& B) { return A.cross(B); }); });
+	};
+
+	// Magnitude & Normalization Methods
+	add("norm", [](benchmark::State& state) { benchmarkUnary<V>(state, [](const V& A) { return A.norm(); }); });
+	add("pNorm/1", [](benchmark::State& state) { benchmarkUnary<V>(state, [](const V& A) { return A.pNorm(1); }); });
+	add("pNorm/3", [](benchmark::State& state) { benchmarkUnary<V>(state, [](const V& A) { return A.pNorm(3); }); });
+	add("unitNormal", [](benchmark::State& state) { benchmarkUnary<V>(state, [](const V& A) { return A.unitNormal(); }); });
+	add("normal", [](benchmark::State& state) { benchmarkUnary<V>(state, [](const V& A) { return A.normal(); }); });
+
+	// Serialization
+	add("toString", [](benchmark::State& state) { benchmarkUnary<V>(state, [](const V& A) { return toString(A); }); });
+	add("formatTo", [](benchmark::State& state) {
+		V A = makeVector<V>(1);
+		std::vector<char> buffer(vectorsFormatLength<V>());
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(A);
+			benchmark::DoNotOptimize(formatTo(buffer.data(), buffer.size(), A));
+		};
+		state.SetItemsProcessed(state.iterations());
+	});
+	add("parse", [](benchmark::State& state) {
+		const std::string text = toString(makeVector<V>(1));
+		V A;
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(parse(text.data(), (text.data() + text.size()), A));
+			benchmark::DoNotOptimize(A);
+		};
+		state.SetItemsProcessed(state.iterations());
+	});
+	add("ostream", [](benchmark::State& state) {
+		V A = makeVector<V>(1);
+		std::ostringstream stream;
+		for (auto _ : state)
+		{
+			stream.str(std::string());
+			stream << A;
+			benchmark::DoNotOptimize(stream);
+		};
+		state.SetItemsProcessed(state.iterations());
+	});
+};
+
+template <typename T>
+void registerElement()
+{
+	const std::string element = ElementName<T>::value;
+	registerVector<Vector2D<T>>("Vector2D<" + element + ">");
+	registerVector<Vector3D<T>>("Vector3D<" + element + ">");
+	registerVector<Vector4D<T>>("Vector4D<" + element + ">");
+	registerVector<Vector<8, T>>("Vector<8," + element + ">");
+	registerVector<Vector<64, T>>("Vector<64," + element + ">");
+	registerVector<Vector<128, T>>("Vector<128," + element + ">");
+	registerVector<Vector<1024, T>>("Vector<1024," + element + ">");
+};
+
+template <typename V>
+void registerSerialization(const std::string& type)
+{
+	/*
+		Registers benchmarks for writing and reading arrays of vectors in the binary
+		format, against the text format, over state.range(0) vectors.
+	*/
+
+	auto add = [&](const std::string& operation, void (*function)(benchmark::State&)) {
+		benchmark::RegisterBenchmark((type + "/" + operation).c_str(), function)->Arg(1 << 16);
+	};
+
+	add("writeVectors", [](benchmark::State& state) {
+		std::vector<V> vectors((size_t)state.range(0), makeVector<V>(1));
+		std::ostringstream stream;
+		for (auto _ : state)
+		{
+			stream.str(std::string());
+			writeVectors(stream, vectors);
+			benchmark::DoNotOptimize(stream);
+		};
+		state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(V));
+	});
+	add("readVectors", [](benchmark::State& state) {
+		std::ostringstream written;
+		writeVectors(written, std::vector<V>((size_t)state.range(0), makeVector<V>(1)));
+		const std::string buffer = written.str();
+		std::vector<V> vectors;
+		for (auto _ : state)
+		{
+			std::istringstream stream(buffer);
+			readVectors(stream, vectors);
+			benchmark::DoNotOptimize(vectors.data());
+		};
+		state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(V));
+	});
+	add("writeText", [](benchmark::State& state) {
+		std::vector<V> vectors((size_t)state.range(0), makeVector<V>(1));
+		std::ostringstream stream;
+		for (auto _ : state)
+		{
+			stream.str(std::string());
+			for (const V& v : vectors)
+			{
+				stream << v << '\n';
+			};
+			benchmark::DoNotOptimize(stream);
+		};
+		state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(V));
+	});
+};
+
+template <typename V>
+std::vector<V> randomVectors(const size_t& n, const uint32_t& seed)
+{
+	/*
+		Returns n vectors with elements drawn uniformly from [-0.5, 0.5), from a
+		fixed-seed linear congruential generator so runs are reproducible.
+	*/
+
+	std::vector<V> vectors(n);
+	uint32_t state = seed;
+	for (V& v : vectors)
+	{
+		for (uint64_t i = 0; i < VectorTraits<V>::dimensions; i++)
+		{
+			state = (state * 1664525u) + 1013904223u;
+			v.value[i] = ((float)(state >> 8) / (float)(1u << 24)) - 0.5f;
+		};
+	};
+	return vectors;
+};
+
+template <uint64_t N>
+void registerIndex()
+{
+	/*
+		Registers FlatIndex searches over state.range(0) random vectors, answering a
+		batch of 64 queries for the 10 nearest neighbours by each metric, against a
+		loop over Vector<N,T>::dot.
+	*/
+
+	typedef Vector<N, float> V;
+
+	const std::string type = "FlatIndex<" + std::to_string(N) + ",float>";
+	const char* metrics[] = { "l2", "inner_product", "cosine" };
+
+	for (int metric = VECTOR_METRIC_L2; metric <= VECTOR_METRIC_COSINE; metric++)
+	{
+		benchmark::RegisterBenchmark((type + "/search/" + metrics[metric]).c_str(), [=](benchmark::State& state) {
+			FlatIndex<N, float> index((VectorMetric)metric);
+			const std::vector<V> base = randomVectors<V>((size_t)state.range(0), 1);
+			const std::vector<V> queries = randomVectors<V>(64, 2);
+			index.add(base.data(), base.size());
+			std::vector<VectorNeighbour<float>> results(queries.size() * 10);
+			for (auto _ : state)
+			{
+				index.search(queries.data(), queries.size(), 10, results.data());
+				benchmark::DoNotOptimize(results.data());
+			};
+			state.SetItemsProcessed(state.iterations() * queries.size());
+		})->Arg(1 << 16)->Unit(benchmark::kMillisecond);
+	};
+	benchmark::RegisterBenchmark((type + "/search/dot_loop").c_str(), [=](benchmark::State& state) {
+		const std::vector<V> base = randomVectors<V>((size_t)state.range(0), 1);
+		const std::vector<V> queries = randomVectors<V>(64, 2);
+		for (auto _ : state)
+		{
+			for (const V& query : queries)
+			{
+				VectorTopK<float> top;
+				top.reset(10);
+				for (size_t i = 0; i < base.size(); i++)
+				{
+					top.push(i, -query.dot(base[i]));
+				};
+				benchmark::DoNotOptimize(top.heap.data());
+			};
+		};
+		state.SetItemsProcessed(state.iterations() * queries.size());
+	})->Arg(1 << 16)->Unit(benchmark::kMillisecond);
+};
+
+template <uint64_t N>
+void registerHnsw()
+{
+	/*
+		Registers HnswIndex searches over state.range(0) random vectors at several
+		efSearch settings, timing single queries for the 10 nearest neighbours and
+		reporting recall@10 against the exact FlatIndex results as a counter.
+	*/
+
+	typedef Vector<N, float> V;
+
+	const std::string type = "HnswIndex<" + std::to_string(N) + ",float>";
+	const size_t efs[] = { 16, 64, 256 };
+
+	benchmark::RegisterBenchmark((type + "/build").c_str(), [=](benchmark::State& state) {
+		const std::vector<V> base = randomVectors<V>((size_t)state.range(0), 1);
+		for (auto _ : state)
+		{
+			HnswIndex<N, float> index(VECTOR_METRIC_L2, 16, 100);
+			index.add(base.data(), base.size());
+			benchmark::DoNotOptimize(index.size());
+		};
+		state.SetItemsProcessed(state.iterations() * base.size());
+	})->Arg(1 << 14)->Iterations(1)->Unit(benchmark::kMillisecond);
+
+	for (const size_t& ef : efs)
+	{
+		benchmark::RegisterBenchmark((type + "/search/ef:" + std::to_string(ef)).c_str(), [=](benchmark::State& state) {
+			const std::vector<V> base = randomVectors<V>((size_t)state.range(0), 1);
+			const std::vector<V> queries = randomVectors<V>(256, 2);
+			HnswIndex<N, float> index(VECTOR_METRIC_L2, 16, 100);
+			index.add(base.data(), base.size());
+
+			std::vector<VectorNeighbour<float>> results(queries.size() * 10);
+			size_t q = 0;
+			for (auto _ : state)
+			{
+				index.search(queries[q], 10, results.data() + (q * 10), ef);
+				q = (q + 1) % queries.size();
+			};
+
+			// Recall
+			FlatIndex<N, float> exact(VECTOR_METRIC_L2);
+			exact.add(base.data(), base.size());
+			std::vector<VectorNeighbour<float>> truth(queries.size() * 10);
+			exact.search(queries.data(), queries.size(), 10, truth.data());
+			for (size_t i = 0; i < queries.size(); i++)
+			{
+				index.search(queries[i], 10, results.data() + (i * 10), ef);
+			};
+			size_t found = 0;
+			for (size_t i = 0; i < queries.size(); i++)
+			{
+				for (size_t a = 0; a < 10; a++)
+				{
+					for (size_t b = 0; b < 10; b++)
+					{
+						if (results[(i * 10) + a].id == truth[(i * 10) + b].id)
+						{
+							found++;
+							break;
+						};
+					};
+				};
+			};
+			state.counters["recall@10"] = (double)found / (double)(queries.size() * 10);
+			state.SetItemsProcessed(state.iterations());
+		})->Arg(1 << 14)->Unit(benchmark::kMicrosecond);
+	};
+};
+
+template <uint64_t N>
+void registerQuantized()
+{
+	/*
+		Registers scans scoring one query against state.range(0) stored vectors in
+		each storage format, reporting the bytes of storage read per second.
+	*/
+
+	typedef Vector<N, float> V;
+
+	auto scan = [](const char* name, auto make, auto score) {
+		benchmark::RegisterBenchmark(name, [=](benchmark::State& state) {
+			const std::vector<V> base = randomVectors<V>((size_t)state.range(0), 1);
+			const V query = randomVectors<V>(1, 2)[0];
+			auto stored = make(base);
+			auto q = make(std::vector<V>(1, query));
+			std::vector<float> scores(stored.size());
+			for (auto _ : state)
+			{
+				for (size_t i = 0; i < stored.size(); i++)
+				{
+					scores[i] = score(stored[i], q[0], query);
+				};
+				benchmark::DoNotOptimize(scores.data());
+			};
+			state.SetBytesProcessed(state.iterations() * stored.size() * sizeof(stored[0]));
+		})->Arg(1 << 14);
+	};
+	auto convert = [](auto element) {
+		return [](const std::vector<V>& vectors) {
+			std::vector<Vector<N, decltype(element)>> out;
+			for (const V& v : vectors)
+			{
+				out.push_back(vectorCast<decltype(element)>(v));
+			};
+			return out;
+		};
+	};
+	auto quantize = [](const std::vector<V>& vectors) {
+		std::vector<QuantizedVector<N>> out;
+		for (const V& v : vectors)
+		{
+			out.emplace_back(v);
+		};
+		return out;
+	};
+
+	const std::string n = std::to_string(N);
+	scan(("Vector<" + n + ",float>/scan/dot").c_str(), convert(0.0f), [](const V& a, const V& b, const V&) { return a.dot(b); });
+	scan(("Vector<" + n + ",half>/scan/wideDot").c_str(), convert(half()), [](const auto& a, const auto& b, const V&) { return wideDot(a, b); });
+	scan(("Vector<" + n + ",bfloat16>/scan/wideDot").c_str(), convert(bfloat16()), [](const auto& a, const auto& b, const V&) { return wideDot(a, b); });
+	scan(("QuantizedVector<" + n + ">/scan/dot").c_str(), quantize, [](const auto& a, const auto& b, const V&) { return a.dot(b); });
+	scan(("QuantizedVector<" + n + ">/scan/dot_float").c_str(), quantize, [](const auto& a, const auto&, const V& query) { return a.dot(query); });
+};
+
+void registerSpatial()
+{
+	/*
+		Registers KdTree3 and Bvh3 builds over state.range(0) random points, and
+		batches of 4096 queries for the 8 nearest points and for the points within
+		a small radius, against a linear scan of the points for a radius query.
+		Then SpatialHashGrid3 builds, all pairs within about the mean spacing of
+		the points, and the same radius queries.
+	*/
+
+	typedef Vector3D<float> V;
+
+	benchmark::RegisterBenchmark("KdTree3<float>/build", [](benchmark::State& state) {
+		const std::vector<V> points = randomVectors<V>((size_t)state.range(0), 1);
+		KdTree3<float> tree;
+		for (auto _ : state)
+		{
+			tree.build(points.data(), points.size());
+			benchmark::DoNotOptimize(tree.nodes.data());
+		};
+		state.SetItemsProcessed(state.iterations() * points.size());
+	})->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+	benchmark::RegisterBenchmark("Bvh3<float>/build", [](benchmark::State& state) {
+		const std::vector<V> points = randomVectors<V>((size_t)state.range(0), 1);
+		Bvh3<float> bvh;
+		for (auto _ : state)
+		{
+			bvh.build(points.data(), points.size());
+			benchmark::DoNotOptimize(bvh.nodes.data());
+		};
+		state.SetItemsProcessed(state.iterations() * points.size());
+	})->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+	benchmark::RegisterBenchmark("KdTree3<float>/nearest_8", [](benchmark::State& state) {
+		const std::vector<V> points = randomVectors<V>((size_t)state.range(0), 1);
+		const std::vector<V> queries = randomVectors<V>(4096, 2);
+		const KdTree3<float> tree(points.data(), points.size());
+		std::vector<VectorNeighbour<float>> results(queries.size() * 8);
+		for (auto _ : state)
+		{
+			tree.nearest(queries.data(), queries.size(), 8, results.data());
+			benchmark::DoNotOptimize(results.data());
+		};
+		state.SetItemsProcessed(state.iterations() * queries.size());
+	})->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+	benchmark::RegisterBenchmark("Bvh3<float>/nearest_8", [](benchmark::State& state) {
+		const std::vector<V> points = randomVectors<V>((size_t)state.range(0), 1);
+		const std::vector<V> queries = randomVectors<V>(4096, 2);
+		const Bvh3<float> bvh(points.data(), points.size());
+		std::vector<VectorNeighbour<float>> results(queries.size() * 8);
+		for (auto _ : state)
+		{
+			bvh.nearest(queries.data(), queries.size(), 8, results.data());
+			benchmark::DoNotOptimize(results.data());
+		};
+		state.SetItemsProcessed(state.iterations() * queries.size());
+	})->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+	benchmark::RegisterBenchmark("KdTree3<float>/within_radius", [](benchmark::State& state) {
+		const std::vector<V> points = randomVectors<V>((size_t)state.range(0), 1);
+		const std::vector<V> queries = randomVectors<V>(4096, 2);
+		const KdTree3<float> tree(points.data(), points.size());
+		VectorSpatialResults<float> results;
+		for (auto _ : state)
+		{
+			tree.withinRadius(queries.data(), queries.size(), 0.02f, results);
+			benchmark::DoNotOptimize(results.results.data());
+		};
+		state.SetItemsProcessed(state.iterations() * queries.size());
+	})->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+	benchmark::RegisterBenchmark("KdTree3<float>/within_radius/scan", [](benchmark::State& state) {
+		const std::vector<V> points = randomVectors<V>((size_t)state.range(0), 1);
+		const std::vector<V> queries = randomVectors<V>(16, 2);
+		std::vector<VectorNeighbour<float>> results;
+		for (auto _ : state)
+		{
+			results.clear();
+			for (const V& query : queries)
+			{
+				for (size_t i = 0; i < points.size(); i++)
+				{
+					const float distance = vectorsSquaredDistance(query, points[i]);
+					if (distance <= 0.0004f)
+					{
+						results.push_back(VectorNeighbour<float>{ i, distance });
+					};
+				};
+			};
+			benchmark::DoNotOptimize(results.data());
+		};
+		state.SetItemsProcessed(state.iterations() * queries.size());
+	})->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+	benchmark::RegisterBenchmark("SpatialHashGrid3<float>/build", [](benchmark::State& state) {
+		const std::vector<V> points = randomVectors<V>((size_t)state.range(0), 1);
+		SpatialHashGrid3<float> grid(0.01f);
+		for (auto _ : state)
+		{
+			grid.build(points.data(), points.size());
+			benchmark::DoNotOptimize(grid.entries.data());
+		};
+		state.SetItemsProcessed(state.iterations() * points.size());
+	})->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+	benchmark::RegisterBenchmark("SpatialHashGrid3<float>/pairs", [](benchmark::State& state) {
+		const std::vector<V> points = randomVectors<V>((size_t)state.range(0), 1);
+		const SpatialHashGrid3<float> grid(0.01f, points.data(), points.size());
+		std::vector<std::pair<uint32_t, uint32_t>> pairs;
+		for (auto _ : state)
+		{
+			pairs.clear();
+			grid.pairs(0.01f, pairs);
+			benchmark::DoNotOptimize(pairs.data());
+		};
+		state.counters["pairs"] = (double)pairs.size();
+		state.SetItemsProcessed(state.iterations() * points.size());
+	})->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+	benchmark::RegisterBenchmark("SpatialHashGrid3<float>/within_radius", [](benchmark::State& state) {
+		const std::vector<V> points = randomVectors<V>((size_t)state.range(0), 1);
+		const std::vector<V> queries = randomVectors<V>(4096, 2);
+		const SpatialHashGrid3<float> grid(0.02f, points.data(), points.size());
+		std::vector<VectorNeighbour<float>> results;
+		for (auto _ : state)
+		{
+			results.clear();
+			for (const V& query : queries)
+			{
+				grid.withinRadius(query, 0.02f, results);
+			};
+			benchmark::DoNotOptimize(results.data());
+		};
+		state.SetItemsProcessed(state.iterations() * queries.size());
+	})->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+};
+
+void registerCurve()
+{
+	/*
+		Registers encoding and sorting state.range(0) random points by their Morton
+		and Hilbert codes, radixSort() of their codes against std::sort, and the
+		8 nearest point queries of KdTree3 one at a time for the same queries
+		in random and in Hilbert order.
+	*/
+
+	typedef Vector3D<float> V;
+
+	const char* curves[] = { "morton", "hilbert" };
+	for (int curve = VECTOR_CURVE_MORTON; curve <= VECTOR_CURVE_HILBERT; curve++)
+	{
+		benchmark::RegisterBenchmark((std::string("Vector3D<float>/curve_codes/") + curves[curve]).c_str(), [=](benchmark::State& state) {
+			const std::vector<V> points = randomVectors<V>((size_t)state.range(0), 1);
+			std::vector<uint64_t> codes(points.size());
+			for (auto _ : state)
+			{
+				curveCodes(points.data(), points.size(), codes.data(), (VectorCurve)curve);
+				benchmark::DoNotOptimize(codes.data());
+			};
+			state.SetItemsProcessed(state.iterations() * points.size());
+		})->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+		benchmark::RegisterBenchmark((std::string("Vector3D<float>/spatial_sort/") + curves[curve]).c_str(), [=](benchmark::State& state) {
+			const std::vector<V> points = randomVectors<V>((size_t)state.range(0), 1);
+			std::vector<V> sorted;
+			for (auto _ : state)
+			{
+				state.PauseTiming();
+				sorted = points;
+				state.ResumeTiming();
+				spatialSort(sorted.data(), sorted.size(), (VectorCurve)curve);
+				benchmark::DoNotOptimize(sorted.data());
+			};
+			state.SetItemsProcessed(state.iterations() * points.size());
+		})->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+	};
+
+	benchmark::RegisterBenchmark("uint64_t/radix_sort", [](benchmark::State& state) {
+		const std::vector<V> points = randomVectors<V>((size_t)state.range(0), 1);
+		std::vector<uint64_t> codes(points.size());
+		curveCodes(points.data(), points.size(), codes.data());
+		std::vector<uint64_t> keys;
+		std::vector<uint32_t> order(points.size());
+		for (auto _ : state)
+		{
+			state.PauseTiming();
+			keys = codes;
+			std::iota(order.begin(), order.end(), (uint32_t)0);
+			state.ResumeTiming();
+			radixSort(keys.data(), order.data(), keys.size());
+			benchmark::DoNotOptimize(keys.data());
+		};
+		state.SetItemsProcessed(state.iterations() * points.size());
+	})->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+	benchmark::RegisterBenchmark("uint64_t/radix_sort/std_sort", [](benchmark::State& state) {
+		const std::vector<V> points = randomVectors<V>((size_t)state.range(0), 1);
+		std::vector<uint64_t> codes(points.size());
+		curveCodes(points.data(), points.size(), codes.data());
+		std::vector<std::pair<uint64_t, uint32_t>> keys(points.size());
+		for (auto _ : state)
+		{
+			state.PauseTiming();
+			for (size_t i = 0; i < codes.size(); i++)
+			{
+				keys[i] = std::make_pair(codes[i], (uint32_t)i);
+			};
+			state.ResumeTiming();
+			std::sort(keys.begin(), keys.end());
+			benchmark::DoNotOptimize(keys.data());
+		};
+		state.SetItemsProcessed(state.iterations() * points.size());
+	})->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+	for (int sorted = 0; sorted <= 1; sorted++)
+	{
+		benchmark::RegisterBenchmark(sorted ? "KdTree3<float>/nearest_8/hilbert_order" : "KdTree3<float>/nearest_8/random_order", [=](benchmark::State& state) {
+			const std::vector<V> points = randomVectors<V>((size_t)state.range(0), 1);
+			std::vector<V> queries = randomVectors<V>(1 << 16, 2);
+			if (sorted)
+			{
+				spatialSort(queries.data(), queries.size(), VECTOR_CURVE_HILBERT);
+			};
+			const KdTree3<float> tree(points.data(), points.size());
+			VectorNeighbour<float> results[8];
+			for (auto _ : state)
+			{
+				for (const V& query : queries)
+				{
+					tree.nearest(query, 8, results);
+					benchmark::DoNotOptimize(results);
+				};
+			};
+			state.SetItemsProcessed(state.iterations() * queries.size());
+		})->Arg(1 << 22)->Unit(benchmark::kMillisecond);
+	};
+};
+
+void registerMatrix()
+{
+	/*
+		Registers transformPoints() and transformVectors() over state.range(0)
+		random points, in and out of cache, against a loop of
+		Matrix4::transformPoint(), and the Matrix4 products and inverses.
+	*/
+
+	typedef Vector3D<float> V;
+	typedef Matrix4<float> M;
+	static const M model = M::translation(V(1.0f, 2.0f, 3.0f)) * M::rotation(V(0.0f, 0.6f, 0.8f), 0.7f) * M::scaling(V(2.0f, 2.0f, 2.0f));
+
+	benchmark::RegisterBenchmark("Matrix4<float>/transformPoints", [](benchmark::State& state) {
+		const std::vector<V> points = randomVectors<V>((size_t)state.range(0), 1);
+		std::vector<V> out(points.size());
+		for (auto _ : state)
+		{
+			transformPoints(model, points.data(), out.data(), points.size());
+			benchmark::DoNotOptimize(out.data());
+		};
+		state.SetItemsProcessed(state.iterations() * points.size());
+	})->Arg(1 << 12)->Arg(1 << 20);
+	benchmark::RegisterBenchmark("Matrix4<float>/transformPoints/scalar", [](benchmark::State& state) {
+		const std::vector<V> points = randomVectors<V>((size_t)state.range(0), 1);
+		std::vector<V> out(points.size());
+		for (auto _ : state)
+		{
+			for (size_t i = 0; i < points.size(); i++)
+			{
+				out[i] = model.transformPoint(points[i]);
+			};
+			benchmark::DoNotOptimize(out.data());
+		};
+		state.SetItemsProcessed(state.iterations() * points.size());
+	})->Arg(1 << 12)->Arg(1 << 20);
+	benchmark::RegisterBenchmark("Matrix4<float>/transformVectors", [](benchmark::State& state) {
+		const std::vector<Vector4D<float>> vectors = randomVectors<Vector4D<float>>((size_t)state.range(0), 1);
+		std::vector<Vector4D<float>> out(vectors.size());
+		for (auto _ : state)
+		{
+			transformVectors(model, vectors.data(), out.data(), vectors.size());
+			benchmark::DoNotOptimize(out.data());
+		};
+		state.SetItemsProcessed(state.iterations() * vectors.size());
+	})->Arg(1 << 12)->Arg(1 << 20);
+
+	benchmark::RegisterBenchmark("Matrix4<float>/multiply", [](benchmark::State& state) {
+		M product = model;
+		for (auto _ : state)
+		{
+			product = (product * model);
+			benchmark::DoNotOptimize(product);
+		};
+	});
+	benchmark::RegisterBenchmark("Matrix4<float>/inverse", [](benchmark::State& state) {
+		M inverse;
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(model.inverse(inverse));
+			benchmark::DoNotOptimize(inverse);
+		};
+	});
+	benchmark::RegisterBenchmark("Matrix4<float>/affineInverse", [](benchmark::State& state) {
+		M inverse;
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(model.affineInverse(inverse));
+			benchmark::DoNotOptimize(inverse);
+		};
+	});
+};
+
+void registerQuaternion()
+{
+	/*
+		Registers batchRotate(), batchNlerp() and batchSlerp() over state.range(0)
+		random unit quaternions (e.g. the joints of a set of skeletons), against
+		loops of the scalar forms.
+	*/
+
+	typedef Quaternion<float> Q;
+	typedef Vector3D<float> V;
+	auto quaternions = [](const size_t& n, const uint32_t& seed) {
+		const std::vector<Vector4D<float>> values = randomVectors<Vector4D<float>>(n, seed);
+		std::vector<Q> out;
+		for (const Vector4D<float>& value : values)
+		{
+			out.push_back(Q(value).unitNormal());
+		};
+		return out;
+	};
+
+	benchmark::RegisterBenchmark("Quaternion<float>/batchRotate", [=](benchmark::State& state) {
+		const std::vector<Q> rotations = quaternions((size_t)state.range(0), 1);
+		const std::vector<V> points = randomVectors<V>(rotations.size(), 2);
+		std::vector<V> out(points.size());
+		for (auto _ : state)
+		{
+			batchRotate(rotations.data(), points.data(), out.data(), points.size());
+			benchmark::DoNotOptimize(out.data());
+		};
+		state.SetItemsProcessed(state.iterations() * points.size());
+	})->Arg(1 << 12);
+	benchmark::RegisterBenchmark("Quaternion<float>/rotate", [=](benchmark::State& state) {
+		const std::vector<Q> rotations = quaternions((size_t)state.range(0), 1);
+		const std::vector<V> points = randomVectors<V>(rotations.size(), 2);
+		std::vector<V> out(points.size());
+		for (auto _ : state)
+		{
+			for (size_t i = 0; i < points.size(); i++)
+			{
+				out[i] = rotations[i].rotate(points[i]);
+			};
+			benchmark::DoNotOptimize(out.data());
+		};
+		state.SetItemsProcessed(state.iterations() * points.size());
+	})->Arg(1 << 12);
+
+	benchmark::RegisterBenchmark("Quaternion<float>/batchNlerp", [=](benchmark::State& state) {
+		const std::vector<Q> A = quaternions((size_t)state.range(0), 1);
+		const std::vector<Q> B = quaternions(A.size(), 2);
+		std::vector<Q> out(A.size());
+		for (auto _ : state)
+		{
+			batchNlerp(A.data(), B.data(), 0.3f, out.data(), A.size());
+			benchmark::DoNotOptimize(out.data());
+		};
+		state.SetItemsProcessed(state.iterations() * A.size());
+	})->Arg(1 << 12);
+	benchmark::RegisterBenchmark("Quaternion<float>/batchSlerp", [=](benchmark::State& state) {
+		const std::vector<Q> A = quaternions((size_t)state.range(0), 1);
+		const std::vector<Q> B = quaternions(A.size(), 2);
+		std::vector<Q> out(A.size());
+		for (auto _ : state)
+		{
+			batchSlerp(A.data(), B.data(), 0.3f, out.data(), A.size());
+			benchmark::DoNotOptimize(out.data());
+		};
+		state.SetItemsProcessed(state.iterations() * A.size());
+	})->Arg(1 << 12);
+	benchmark::RegisterBenchmark("Quaternion<float>/slerp", [=](benchmark::State& state) {
+		const std::vector<Q> A = quaternions((size_t)state.range(0), 1);
+		const std::vector<Q> B = quaternions(A.size(), 2);
+		std::vector<Q> out(A.size());
+		for (auto _ : state)
+		{
+			for (size_t i = 0; i < A.size(); i++)
+			{
+				out[i] = slerp(A[i], B[i], 0.3f);
+			};
+			benchmark::DoNotOptimize(out.data());
+		};
+		state.SetItemsProcessed(state.iterations() * A.size());
+	})->Arg(1 << 12);
+};
+
+void registerParallel()
+{
+	/*
+		Registers the execution policy overloads over state.range(0) vectors, with
+		vectorsSeq and with vectorsPar on the shared pool. They're timed in wall
+		clock time, as the work is spread over several threads.
+	*/
+
+	typedef Vector3D<float> V;
+	auto policies = [](const std::string& name, const auto& run) {
+		benchmark::RegisterBenchmark((name + "/seq").c_str(), [=](benchmark::State& state) { run(state, vectorsSeq); })->Arg(1 << 22)->UseRealTime();
+		benchmark::RegisterBenchmark((name + "/par").c_str(), [=](benchmark::State& state) { run(state, vectorsPar); })->Arg(1 << 22)->UseRealTime();
+	};
+
+	policies("Parallel/batchNormalize<Vector3D<float>>", [](benchmark::State& state, const auto& policy) {
+		const std::vector<V> A = randomVectors<V>((size_t)state.range(0), 1);
+		std::vector<V> out(A.size());
+		for (auto _ : state)
+		{
+			batchNormalize(policy, A.data(), out.data(), A.size());
+			benchmark::DoNotOptimize(out.data());
+		};
+		state.SetItemsProcessed(state.iterations() * A.size());
+	});
+	policies("Parallel/batchSum<Vector3D<float>>", [](benchmark::State& state, const auto& policy) {
+		const std::vector<V> A = randomVectors<V>((size_t)state.range(0), 1);
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(batchSum(policy, A.data(), A.size()));
+		};
+		state.SetItemsProcessed(state.iterations() * A.size());
+	});
+	policies("Parallel/batchBounds<Vector3D<float>>", [](benchmark::State& state, const auto& policy) {
+		const std::vector<V> A = randomVectors<V>((size_t)state.range(0), 1);
+		V lower, upper;
+		for (auto _ : state)
+		{
+			batchBounds(policy, A.data(), A.size(), lower, upper);
+			benchmark::DoNotOptimize(lower);
+			benchmark::DoNotOptimize(upper);
+		};
+		state.SetItemsProcessed(state.iterations() * A.size());
+	});
+	policies("Parallel/transformPoints<float>", [](benchmark::State& state, const auto& policy) {
+		const Matrix4<float> M = Matrix4<float>::rotation(V(0.0f, 0.0f, 1.0f), 0.5f);
+		const std::vector<V> A = randomVectors<V>((size_t)state.range(0), 1);
+		std::vector<V> out(A.size());
+		for (auto _ : state)
+		{
+			transformPoints(policy, M, A.data(), out.data(), A.size());
+			benchmark::DoNotOptimize(out.data());
+		};
+		state.SetItemsProcessed(state.iterations() * A.size());
+	});
+};
+
+void registerMapped()
+{
+	/*
+		Registers opening and scanning a MappedVectorStore of state.range(0) vectors
+		against reading the same file into a std::vector, and appending to a store.
+		The file is in the system's temporary directory and in the page cache, so
+		this measures the cost of parsing and copying rather than of the disk.
+	*/
+
+	typedef Vector<128, float> V;
+	const std::string path = (std::filesystem::temp_directory_path() / "vectors_bench_store.vtlb").string();
+	auto prepare = [path](const size_t& n) {
+		MappedVectorStore<V> store;
+		store.create(path);
+		const std::vector<V> vectors = randomVectors<V>(n, 1);
+		store.append(vectors.data(), vectors.size());
+	};
+
+	benchmark::RegisterBenchmark("MappedVectorStore<Vector<128,float>>/open", [=](benchmark::State& state) {
+		prepare((size_t)state.range(0));
+		for (auto _ : state)
+		{
+			MappedVectorStore<V> store;
+			store.open(path);
+			benchmark::DoNotOptimize(store[store.size() / 2]);
+		};
+	})->Arg(1 << 16);
+	benchmark::RegisterBenchmark("MappedVectorStore<Vector<128,float>>/scan", [=](benchmark::State& state) {
+		prepare((size_t)state.range(0));
+		for (auto _ : state)
+		{
+			MappedVectorStore<V> store;
+			store.open(path);
+			store.advise(VECTORS_ACCESS_SEQUENTIAL);
+			benchmark::DoNotOptimize(batchSum(store.data(), store.size()));
+		};
+		state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(V));
+	})->Arg(1 << 16);
+	benchmark::RegisterBenchmark("MappedVectorStore<Vector<128,float>>/scan/readVectors", [=](benchmark::State& state) {
+		prepare((size_t)state.range(0));
+		std::vector<V> vectors;
+		for (auto _ : state)
+		{
+			std::ifstream stream(path, std::ios::binary);
+			readVectors(stream, vectors);
+			benchmark::DoNotOptimize(batchSum(vectors.data(), vectors.size()));
+		};
+		state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(V));
+	})->Arg(1 << 16);
+	benchmark::RegisterBenchmark("MappedVectorStore<Vector<128,float>>/append", [=](benchmark::State& state) {
+		const std::vector<V> vectors = randomVectors<V>((size_t)state.range(0), 1);
+		for (auto _ : state)
+		{
+			MappedVectorStore<V> store;
+			store.create(path);
+			store.setSyncInterval(vectors.size() / 4);
+			for (const V& v : vectors)
+			{
+				store.append(v);
+			};
+		};
+		state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(V));
+	})->Arg(1 << 16);
+};
+
+void registerArena()
+{
+	/*
+		Registers building a per-frame scratch array of state.range(0) vectors with
+		a fresh std::vector each frame, against an arena backed AlignedVectorArray
+		which is reset each frame.
+	*/
+
+	typedef Vector3D<float> V;
+
+	benchmark::RegisterBenchmark("AlignedVectorArray<Vector3D<float>>/frame/std::vector", [](benchmark::State& state) {
+		const std::vector<V> source = randomVectors<V>((size_t)state.range(0), 1);
+		for (auto _ : state)
+		{
+			std::vector<V> scratch;
+			for (const V& v : source)
+			{
+				scratch.push_back(v * 2.0f);
+			};
+			benchmark::DoNotOptimize(scratch.data());
+		};
+		state.SetItemsProcessed(state.iterations() * source.size());
+	})->Arg(1 << 8);
+	benchmark::RegisterBenchmark("AlignedVectorArray<Vector3D<float>>/frame/arena", [](benchmark::State& state) {
+		const std::vector<V> source = randomVectors<V>((size_t)state.range(0), 1);
+		VectorArena arena;
+		for (auto _ : state)
+		{
+			arena.reset();
+			AlignedVectorArray<V> scratch(arena);
+			for (const V& v : source)
+			{
+				scratch.push_back(v * 2.0f);
+			};
+			benchmark::DoNotOptimize(scratch.data());
+		};
+		state.SetItemsProcessed(state.iterations() * source.size());
+	})->Arg(1 << 8);
+	benchmark::RegisterBenchmark("AlignedVectorArray<Vector3D<float>>/frame/reused", [](benchmark::State& state) {
+		const std::vector<V> source = randomVectors<V>((size_t)state.range(0), 1);
+		AlignedVectorArray<V> scratch;
+		for (auto _ : state)
+		{
+			scratch.clear();
+			for (const V& v : source)
+			{
+				scratch.push_back(v * 2.0f);
+			};
+			benchmark::DoNotOptimize(scratch.data());
+		};
+		state.SetItemsProcessed(state.iterations() * source.size());
+	})->Arg(1 << 8);
+};
+
+template <typename Reduction>
+void registerReduction(const std::string& name)
+{
+	/*
+		Registers vectorsDot with the given reduction policy over state.range(0)
+		floats, and the dot member of Vector<1024, float> with it.
+	*/
+
+	typedef Vector<1024, float> V;
+
+	benchmark::RegisterBenchmark(("Reduce/vectorsDot<float>/" + name).c_str(), [](benchmark::State& state) {
+		const std::vector<V> A = randomVectors<V>((size_t)state.range(0) / 1024, 1);
+		const std::vector<V> B = randomVectors<V>((size_t)state.range(0) / 1024, 2);
+		const size_t n = (A.size() * 1024);
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(vectorsDot<Reduction>(A[0].value, B[0].value, n));
+		};
+		state.SetItemsProcessed(state.iterations() * n);
+	})->Arg(1 << 20);
+	benchmark::RegisterBenchmark(("Reduce/Vector<1024, float>::dot/" + name).c_str(), [](benchmark::State& state) {
+		const std::vector<V> A = randomVectors<V>(2, 1);
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(A[0].template dot<Reduction>(A[1]));
+		};
+		state.SetItemsProcessed(state.iterations() * 1024);
+	});
+};
+
+void registerReduce()
+{
+	/*
+		Registers the reduction policies against a naive single accumulator loop,
+		and batchSum over Vector3D with the Kahan policy.
+	*/
+
+	typedef Vector<1024, float> V;
+
+	benchmark::RegisterBenchmark("Reduce/vectorsDot<float>/naive", [](benchmark::State& state) {
+		const std::vector<V> A = randomVectors<V>((size_t)state.range(0) / 1024, 1);
+		const std::vector<V> B = randomVectors<V>((size_t)state.range(0) / 1024, 2);
+		const size_t n = (A.size() * 1024);
+		for (auto _ : state)
+		{
+			const float* a = A[0].value;
+			const float* b = B[0].value;
+			benchmark::DoNotOptimize(a);
+			float sum = 0.0f;
+			for (size_t i = 0; i < n; i++)
+			{
+				sum += (a[i] * b[i]);
+			};
+			benchmark::DoNotOptimize(sum);
+		};
+		state.SetItemsProcessed(state.iterations() * n);
+	})->Arg(1 << 20);
+	registerReduction<VectorsFastReduction>("fast");
+	registerReduction<VectorsPairwiseReduction>("pairwise");
+	registerReduction<VectorsKahanReduction>("kahan");
+	registerReduction<VectorsDoubleReduction>("double");
+
+	benchmark::RegisterBenchmark("Reduce/batchSum<Vector3D<float>>/kahan", [](benchmark::State& state) {
+		const std::vector<Vector3D<float>> A = randomVectors<Vector3D<float>>((size_t)state.range(0), 1);
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(batchSum<VectorsKahanReduction>(A.data(), A.size()));
+		};
+		state.SetItemsProcessed(state.iterations() * A.size());
+	})->Arg(1 << 20);
+};
+
+void registerDynamic()
+{
+	/*
+		Registers DynVector<float> against Vector<768, float>, at a dispatched
+		dimension (768) and at one which runs on the blocked kernels (769).
+	*/
+
+	typedef Vector<768, float> V;
+
+	benchmark::RegisterBenchmark("Vector<768, float>/dot", [](benchmark::State& state) {
+		const std::vector<V> A = randomVectors<V>(2, 1);
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(A[0].dot(A[1]));
+		};
+		state.SetItemsProcessed(state.iterations());
+	});
+	for (const int64_t n : { 768, 769 })
+	{
+		benchmark::RegisterBenchmark("DynVector<float>/dot", [](benchmark::State& state) {
+			const std::vector<V> A = randomVectors<V>(4, 1);
+			DynVector<float> a(A[0].value, (size_t)state.range(0));
+			DynVector<float> b(A[2].value, (size_t)state.range(0));
+			for (auto _ : state)
+			{
+				benchmark::DoNotOptimize(a.dot(b));
+			};
+			state.SetItemsProcessed(state.iterations());
+		})->Arg(n);
+		benchmark::RegisterBenchmark("DynVector<float>/addAssign", [](benchmark::State& state) {
+			const std::vector<V> A = randomVectors<V>(4, 1);
+			DynVector<float> a(A[0].value, (size_t)state.range(0));
+			DynVector<float> b(A[2].value, (size_t)state.range(0));
+			for (auto _ : state)
+			{
+				a += b;
+				benchmark::DoNotOptimize(a.data());
+				benchmark::ClobberMemory();
+			};
+			state.SetItemsProcessed(state.iterations());
+		})->Arg(n);
+	};
+	benchmark::RegisterBenchmark("DynVector<float>/norm", [](benchmark::State& state) {
+		const std::vector<Vector3D<float>> A = randomVectors<Vector3D<float>>(1, 1);
+		const DynVector<float> a(A[0].value, 3);
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(a.norm());
+		};
+		state.SetItemsProcessed(state.iterations());
+	});
+};
+
+SparseVector<float> randomSparse(const size_t& dimensions, const size_t& n, const uint32_t& seed)
+{
+	/*
+		A sparse vector of the given size with n elements at random indices, from
+		the same generator as randomVectors().
+	*/
+
+	std::vector<uint32_t> indices(n);
+	std::vector<float> values(n);
+	uint32_t state = seed;
+	for (size_t k = 0; k < n; k++)
+	{
+		state = (state * 1664525u) + 1013904223u;
+		indices[k] = (uint32_t)(state % dimensions);
+		values[k] = ((float)(state >> 8) / (float)(1u << 24)) - 0.5f;
+	};
+	return SparseVector<float>(dimensions, indices.data(), values.data(), n);
+};
+
+void registerSparse()
+{
+	/*
+		Registers the products of SparseVector<float> with 100k dimensions and
+		state.range(0) non zero elements: against a dense vector (gathered, and with
+		scalar loads), against another sparse vector of the same length (merged) and
+		of a much longer one (galloped), and scored against a dense matrix of 64
+		columns.
+	*/
+
+	const size_t D = 100000;
+
+	benchmark::RegisterBenchmark("SparseVector<float>/dot/dense", [=](benchmark::State& state) {
+		const SparseVector<float> A = randomSparse(D, (size_t)state.range(0), 1);
+		const std::vector<Vector<1000, float>> B = randomVectors<Vector<1000, float>>(D / 1000, 2);
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(A.dot(B[0].value, D));
+		};
+		state.SetItemsProcessed(state.iterations() * A.nonZeros());
+	})->Arg(50)->Arg(1000);
+	benchmark::RegisterBenchmark("SparseVector<float>/dot/dense/scalar", [=](benchmark::State& state) {
+		const SparseVector<float> A = randomSparse(D, (size_t)state.range(0), 1);
+		const std::vector<Vector<1000, float>> B = randomVectors<Vector<1000, float>>(D / 1000, 2);
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(VectorSparseMath<VECTORS_ISA_GENERIC>::dot(A.indices(), A.values(), A.nonZeros(), B[0].value));
+		};
+		state.SetItemsProcessed(state.iterations() * A.nonZeros());
+	})->Arg(50)->Arg(1000);
+	benchmark::RegisterBenchmark("SparseVector<float>/dot/sparse", [=](benchmark::State& state) {
+		const SparseVector<float> A = randomSparse(D, (size_t)state.range(0), 1);
+		const SparseVector<float> B = randomSparse(D, (size_t)state.range(0), 2);
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(A.dot(B));
+		};
+		state.SetItemsProcessed(state.iterations() * A.nonZeros());
+	})->Arg(50)->Arg(1000);
+	benchmark::RegisterBenchmark("SparseVector<float>/dot/sparse/gallop", [=](benchmark::State& state) {
+		const SparseVector<float> A = randomSparse(D, (size_t)state.range(0), 1);
+		const SparseVector<float> B = randomSparse(D, 20000, 2);
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(A.dot(B));
+		};
+		state.SetItemsProcessed(state.iterations() * A.nonZeros());
+	})->Arg(50);
+	benchmark::RegisterBenchmark("SparseVector<float>/batchScore", [=](benchmark::State& state) {
+		const size_t columns = 64;
+		std::vector<SparseVector<float>> A;
+		for (uint32_t i = 0; i < 64; i++)
+		{
+			A.push_back(randomSparse(D, (size_t)state.range(0), (i + 1)));
+		};
+		const std::vector<Vector<64, float>> M = randomVectors<Vector<64, float>>(D, 3);
+		std::vector<float> out(A.size() * columns);
+		for (auto _ : state)
+		{
+			batchScore(A.data(), A.size(), M[0].value, columns, out.data());
+			benchmark::DoNotOptimize(out.data());
+		};
+		state.SetItemsProcessed(state.iterations() * A.size());
+	})->Arg(50);
+};
+
+/* Entry Point */
+int main(int argc, char** argv)
+{
+	registerElement<float>();
+	registerElement<double>();
+	registerElement<int32_t>();
+	registerSerialization<Vector3D<float>>("Vector3D<float>");
+	registerSerialization<Vector<64, float>>("Vector<64,float>");
+	registerIndex<128>();
+	registerHnsw<64>();
+	registerQuantized<128>();
+	registerSpatial();
+	registerCurve();
+	registerMatrix();
+	registerQuaternion();
+	registerParallel();
+	registerMapped();
+	registerArena();
+	registerReduce();
+	registerDynamic();
+	registerSparse();
+
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv))
+	{
+		return 1;
+	};
+	benchmark::AddCustomContext("vectors_version", "1.1");
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return 0;
+};
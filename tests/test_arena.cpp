@@ -0,0 +1,69 @@
+/*
+	# Vector Template Library - Arena Tests
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	Checks AlignedVectorArray growth, appending its own elements, and that an
+	arena backed array forgets its storage when the arena is reset.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+/* Deps */
+#include "vectors_test.h"
+#include "vectors_arena.h"
+
+/* Tests */
+TEST(AlignedVectorArray, PushesOwnElementWhenFull)
+{
+	AlignedVectorArray<Vector3D<float>> heap;
+	VectorArena arena;
+	AlignedVectorArray<Vector3D<float>> arenaBacked(arena);
+	for (AlignedVectorArray<Vector3D<float>>* array : { &heap, &arenaBacked })
+	{
+		for (size_t i = 0; i < 16; i++)
+		{
+			array->push_back(Vector3D<float>((float)i, 1.0f, 2.0f));
+		};
+		ASSERT_EQ(array->size(), array->capacity());
+		array->push_back((*array)[3]);
+		ASSERT_EQ(array->size(), 17u);
+		EXPECT_EQ((*array)[16], Vector3D<float>(3.0f, 1.0f, 2.0f));
+		EXPECT_EQ(((uintptr_t)array->data() % 64), 0u);
+	};
+};
+TEST(AlignedVectorArray, EmptyAfterArenaReset)
+{
+	VectorArena arena;
+	AlignedVectorArray<Vector4D<float>> array(arena);
+	for (size_t i = 0; i < 10; i++)
+	{
+		array.push_back(Vector4D<float>((float)i, 0.0f, 0.0f, 0.0f));
+	};
+	const AlignedVectorArray<Vector4D<float>>& view = array;
+
+	arena.reset();
+	EXPECT_EQ(view.size(), 0u);
+	EXPECT_TRUE(view.empty());
+	EXPECT_EQ(view.capacity(), 0u);
+	EXPECT_EQ(view.begin(), view.end());
+
+	// Whatever the arena hands out next mustn't be written through the array.
+	Vector4D<float>* other = arena.allocate<Vector4D<float>>(16);
+	for (size_t i = 0; i < 16; i++)
+	{
+		other[i] = Vector4D<float>(-1.0f, -1.0f, -1.0f, -1.0f);
+	};
+	array.push_back(Vector4D<float>(7.0f, 7.0f, 7.0f, 7.0f));
+	const Vector4D<float> more[] = { Vector4D<float>(8.0f, 8.0f, 8.0f, 8.0f), Vector4D<float>(9.0f, 9.0f, 9.0f, 9.0f) };
+	array.append(more, 2);
+	ASSERT_EQ(array.size(), 3u);
+	EXPECT_EQ(array[0], Vector4D<float>(7.0f, 7.0f, 7.0f, 7.0f));
+	EXPECT_EQ(array[2], Vector4D<float>(9.0f, 9.0f, 9.0f, 9.0f));
+	EXPECT_EQ((size_t)(array.end() - array.begin()), 3u);
+	for (size_t i = 0; i < 16; i++)
+	{
+		EXPECT_EQ(other[i], Vector4D<float>(-1.0f, -1.0f, -1.0f, -1.0f)) << "element " << i;
+	};
+};
@@ -0,0 +1,99 @@
+/*
+	# Vector Template Library - Batch Operation Tests
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	Checks batchSum, batchBounds and batchAxpy against scalar loops on every
+	instruction set the CPU supports, for vectors of a few components and for
+	ones too long for Sum and Bounds to handle in one pass, and batchAxpy with X
+	and Y the same array.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+/* Deps */
+#include "vectors_test.h"
+#include "vectors_batch.h"
+#include <algorithm>
+
+/* Helpers */
+template <typename V>
+static std::vector<V> integerVectors(const size_t& n)
+{
+	// Small integers, so sums are exact in any order.
+	std::vector<V> vectors(n);
+	for (size_t i = 0; i < n; i++)
+	{
+		for (uint64_t c = 0; c < VectorTraits<V>::dimensions; c++)
+		{
+			vectors[i].value[c] = (typename VectorTraits<V>::ElementType)((int)(((i * 7) + (c * 3)) % 11) - 5);
+		};
+	};
+	return vectors;
+};
+
+static const size_t batchSizes[] = { 1, 2, 15, 16, 17, 33, 100 };
+
+template <typename V>
+static void checkBatch()
+{
+	typedef typename VectorTraits<V>::ElementType T;
+	const uint64_t D = VectorTraits<V>::dimensions;
+	forEachISA([&](const VectorsISA&) {
+		for (const size_t n : batchSizes)
+		{
+			SCOPED_TRACE(::testing::Message() << n << " vectors");
+			const std::vector<V> A = integerVectors<V>(n);
+			V sum, lower, upper;
+			for (uint64_t c = 0; c < D; c++)
+			{
+				sum.value[c] = T();
+				lower.value[c] = A[0].value[c];
+				upper.value[c] = A[0].value[c];
+				for (size_t i = 0; i < n; i++)
+				{
+					sum.value[c] += A[i].value[c];
+					lower.value[c] = std::min(lower.value[c], A[i].value[c]);
+					upper.value[c] = std::max(upper.value[c], A[i].value[c]);
+				};
+			};
+
+			const V found = batchSum(A.data(), n);
+			V foundLower, foundUpper;
+			ASSERT_TRUE(batchBounds(A.data(), n, foundLower, foundUpper));
+			std::vector<V> Y = A;
+			batchAxpy((T)2, Y.data(), Y.data(), n);
+			for (uint64_t c = 0; c < D; c++)
+			{
+				EXPECT_EQ(found.value[c], sum.value[c]) << "component " << c;
+				EXPECT_EQ(foundLower.value[c], lower.value[c]) << "component " << c;
+				EXPECT_EQ(foundUpper.value[c], upper.value[c]) << "component " << c;
+				for (size_t i = 0; i < n; i++)
+				{
+					EXPECT_EQ(Y[i].value[c], ((T)3 * A[i].value[c])) << "vector " << i << ", component " << c;
+				};
+			};
+		};
+	});
+};
+
+/* Tests */
+TEST(Batch, Vector3Float)
+{
+	checkBatch<Vector3D<float>>();
+};
+TEST(Batch, Vector4Double)
+{
+	checkBatch<Vector4D<double>>();
+};
+TEST(Batch, LongVectorFloat)
+{
+	// 100 floats, two passes of 64 and 36 components.
+	checkBatch<Vector<100, float>>();
+};
+TEST(Batch, LongVectorDouble)
+{
+	// 200 doubles, six passes of 32 components and one of 8.
+	checkBatch<Vector<200, double>>();
+};
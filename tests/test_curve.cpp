@@ -0,0 +1,204 @@
+/*
+	# Vector Template Library - Space Filling Curve Tests
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	Checks that Morton codes decode back to their points, that the Hilbert curve
+	only steps between adjacent cells, that the batched encoders match the single
+	point ones on every instruction set, that radixSort is ordered and stable
+	either side of the size it sorts in cache and split across several threads,
+	and that spatialSort moves the payloads with the points.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+/* Deps */
+#include "vectors_test.h"
+#include "vectors_curve.h"
+#include <algorithm>
+#include <numeric>
+
+/* Helpers */
+static uint32_t randomBits(uint32_t& state)
+{
+	state = (state * 1664525u) + 1013904223u;
+	return state;
+};
+
+template <typename V>
+static uint32_t gridDistance(const V& A, const V& B)
+{
+	uint32_t distance = 0;
+	for (uint64_t c = 0; c < VectorTraits<V>::dimensions; c++)
+	{
+		distance += (A.value[c] > B.value[c]) ? (A.value[c] - B.value[c]) : (B.value[c] - A.value[c]);
+	};
+	return distance;
+};
+
+template <typename V>
+static void checkHilbertAdjacency(const uint32_t& side)
+{
+	// The cells of the cube at the origin are the first side^D along the curve.
+	uint32_t count = 1;
+	for (uint64_t c = 0; c < VectorTraits<V>::dimensions; c++)
+	{
+		count *= side;
+	};
+	std::vector<std::pair<uint64_t, V>> cells;
+	V point;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		uint32_t rest = i;
+		for (uint64_t c = 0; c < VectorTraits<V>::dimensions; c++)
+		{
+			point.value[c] = (rest % side);
+			rest /= side;
+		};
+		cells.push_back(std::make_pair(hilbertEncode(point), point));
+	};
+	std::sort(cells.begin(), cells.end(), [](const std::pair<uint64_t, V>& A, const std::pair<uint64_t, V>& B) { return (A.first < B.first); });
+	for (size_t i = 0; i < cells.size(); i++)
+	{
+		ASSERT_EQ(cells[i].first, (uint64_t)i);
+		if (i > 0)
+		{
+			EXPECT_EQ(gridDistance(cells[i - 1].second, cells[i].second), 1u) << "step " << i;
+		};
+	};
+};
+
+static void checkRadixSort(const size_t& n, const size_t& threads, const uint64_t& mask, const int& shift)
+{
+	SCOPED_TRACE(::testing::Message() << n << " keys, " << threads << " threads, mask " << std::hex << mask);
+	std::vector<uint64_t> keys(n);
+	uint32_t state = (uint32_t)(n + threads);
+	for (uint64_t& key : keys)
+	{
+		key = (((((uint64_t)randomBits(state) << 32) | randomBits(state)) & mask) << shift);
+	};
+
+	// The payloads are the original indexes, so a stable sort keeps them ascending among equal keys.
+	std::vector<uint32_t> payloads(n);
+	std::iota(payloads.begin(), payloads.end(), (uint32_t)0);
+	std::vector<uint32_t> expected = payloads;
+	std::stable_sort(expected.begin(), expected.end(), [&](const uint32_t& A, const uint32_t& B) { return (keys[A] < keys[B]); });
+
+	const std::vector<uint64_t> original = keys;
+	radixSort(keys.data(), payloads.data(), n, threads);
+	ASSERT_EQ(payloads, expected);
+	for (size_t i = 0; i < n; i++)
+	{
+		ASSERT_EQ(keys[i], original[payloads[i]]) << "key " << i;
+	};
+};
+
+/* Tests */
+TEST(Curve, MortonRoundTrips)
+{
+	EXPECT_EQ(mortonEncode(Vector2D<uint32_t>(1, 0)), 2u);
+	EXPECT_EQ(mortonEncode(Vector2D<uint32_t>(0, 1)), 1u);
+	EXPECT_EQ(mortonEncode(Vector3D<uint32_t>(1, 0, 0)), 4u);
+	EXPECT_EQ(mortonEncode(Vector2D<uint32_t>(UINT32_MAX, UINT32_MAX)), UINT64_MAX);
+	EXPECT_EQ(mortonEncode(Vector3D<uint32_t>(0x1FFFFF, 0x1FFFFF, 0x1FFFFF)), (UINT64_MAX >> 1));
+
+	uint32_t state = 1;
+	for (size_t i = 0; i < 10000; i++)
+	{
+		const Vector2D<uint32_t> A(randomBits(state), randomBits(state));
+		const Vector3D<uint32_t> B((randomBits(state) & 0x1FFFFF), (randomBits(state) & 0x1FFFFF), (randomBits(state) & 0x1FFFFF));
+		EXPECT_EQ(mortonDecode2D(mortonEncode(A)), A);
+		EXPECT_EQ(mortonDecode3D(mortonEncode(B)), B);
+	};
+};
+TEST(Curve, HilbertStepsToAdjacentCells)
+{
+	EXPECT_EQ(hilbertEncode(Vector2D<uint32_t>(0, 0)), 0u);
+	EXPECT_EQ(hilbertEncode(Vector3D<uint32_t>(0, 0, 0)), 0u);
+	checkHilbertAdjacency<Vector2D<uint32_t>>(32);
+	checkHilbertAdjacency<Vector3D<uint32_t>>(8);
+};
+TEST(Curve, BatchMatchesSinglePoints)
+{
+	const size_t n = 1000;
+	std::vector<Vector2D<uint32_t>> A(n);
+	std::vector<Vector3D<uint32_t>> B(n);
+	uint32_t state = 2;
+	for (size_t i = 0; i < n; i++)
+	{
+		A[i] = Vector2D<uint32_t>(randomBits(state), randomBits(state));
+		B[i] = Vector3D<uint32_t>((randomBits(state) & 0x1FFFFF), (randomBits(state) & 0x1FFFFF), (randomBits(state) & 0x1FFFFF));
+	};
+	forEachISA([&](const VectorsISA&) {
+		std::vector<uint64_t> codes(n);
+		curveCodes(A.data(), n, codes.data(), VECTOR_CURVE_MORTON);
+		for (size_t i = 0; i < n; i++)
+		{
+			ASSERT_EQ(codes[i], mortonEncode(A[i])) << "point " << i;
+		};
+		curveCodes(A.data(), n, codes.data(), VECTOR_CURVE_HILBERT);
+		for (size_t i = 0; i < n; i++)
+		{
+			ASSERT_EQ(codes[i], hilbertEncode(A[i])) << "point " << i;
+		};
+		curveCodes(B.data(), n, codes.data(), VECTOR_CURVE_MORTON);
+		for (size_t i = 0; i < n; i++)
+		{
+			ASSERT_EQ(codes[i], mortonEncode(B[i])) << "point " << i;
+		};
+		curveCodes(B.data(), n, codes.data(), VECTOR_CURVE_HILBERT);
+		for (size_t i = 0; i < n; i++)
+		{
+			ASSERT_EQ(codes[i], hilbertEncode(B[i])) << "point " << i;
+		};
+	});
+};
+TEST(Curve, RadixSortIsStable)
+{
+	// Either side of the size sorted in cache, and big enough for four workers.
+	const size_t sizes[] = { 0, 1, 2, 33, 1000, VECTORS_RADIX_SORT_CACHED, (VECTORS_RADIX_SORT_CACHED + 1), ((size_t)4 << 16) + 17 };
+	for (const size_t n : sizes)
+	{
+		for (const size_t threads : { (size_t)1, (size_t)4 })
+		{
+			// Full keys, few distinct keys, and keys differing in only some bytes.
+			checkRadixSort(n, threads, UINT64_MAX, 0);
+			checkRadixSort(n, threads, 0xFF, 0);
+			checkRadixSort(n, threads, 0x0F0F, 20);
+			checkRadixSort(n, threads, 0x3, 62);
+		};
+	};
+};
+TEST(Curve, SpatialSortMovesPayloads)
+{
+	const size_t n = 5000;
+	std::vector<Vector3D<float>> points = randomVectors<Vector3D<float>>(n, 3, 100.0f);
+	const std::vector<Vector3D<float>> original = points;
+	std::vector<uint32_t> ids(n);
+	std::iota(ids.begin(), ids.end(), (uint32_t)0);
+	std::vector<Vector3D<float>> copies = points;
+
+	const std::vector<uint32_t> order = spatialSort(points.data(), n, VECTOR_CURVE_HILBERT, ids.data(), copies.data());
+	ASSERT_EQ(order.size(), n);
+	EXPECT_EQ(ids, order);
+	std::vector<uint64_t> codes(n);
+	curveCodes(points.data(), n, codes.data());
+	for (size_t i = 0; i < n; i++)
+	{
+		EXPECT_EQ(points[i], original[order[i]]) << "point " << i;
+		EXPECT_EQ(copies[i], points[i]) << "point " << i;
+		if (i > 0)
+		{
+			EXPECT_LE(codes[i - 1], codes[i]) << "point " << i;
+		};
+	};
+
+	// The order is a permutation.
+	std::vector<uint32_t> sorted = order;
+	std::sort(sorted.begin(), sorted.end());
+	for (size_t i = 0; i < n; i++)
+	{
+		ASSERT_EQ(sorted[i], (uint32_t)i);
+	};
+};
@@ -0,0 +1,208 @@
+/*
+	# Vector Template Library - Dynamic Vector Tests
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	Checks DynVector against Vector<N,T> for the sizes dispatched to its kernels,
+	the sizes run as 64 element blocks and sizes with a remainder, its copies and
+	moves between inline and heap storage, and operators on vectors of different
+	sizes working over the elements they share.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+/* Deps */
+#include "vectors_test.h"
+#include "vectors_dynamic.h"
+#include <utility>
+
+/* Helpers */
+template <uint64_t N>
+static Vector<N, double> integerVector(const uint32_t& seed)
+{
+	// Small non zero integers, so sums are exact in any order and division is safe.
+	Vector<N, double> v;
+	uint32_t state = seed;
+	for (uint64_t i = 0; i < N; i++)
+	{
+		const double value = std::round(randomUnit(state) * 16.0);
+		v.value[i] = (value == 0.0) ? 1.0 : value;
+	};
+	return v;
+};
+
+template <uint64_t N>
+static void expectSame(const DynVector<double>& found, const Vector<N, double>& expected)
+{
+	ASSERT_EQ(found.size(), (size_t)N);
+	for (uint64_t i = 0; i < N; i++)
+	{
+		EXPECT_EQ(found[i], expected.value[i]) << "element " << i;
+	};
+};
+
+template <uint64_t N>
+static void checkMatchesVector()
+{
+	SCOPED_TRACE(::testing::Message() << N << " dimensions");
+	const Vector<N, double> a = integerVector<N>(N), b = integerVector<N>(N + 1000);
+	const DynVector<double> A(a), B(b);
+	expectSame(A, a);
+	EXPECT_EQ(((uintptr_t)A.data() % DynVector<double>::alignment), 0u);
+
+	expectSame((A + B), (a + b));
+	expectSame((A - B), (a - b));
+	expectSame((A * B), (a * b));
+	expectSame((A / B), (a / b));
+	expectSame((A + 2.0), (a + 2.0));
+	expectSame((A - 2.0), (a - 2.0));
+	expectSame((A * 3.0), (a * 3.0));
+	expectSame((A / 4.0), (a / 4.0));
+	expectSame((2.0 - A), (-a + 2.0));
+	expectSame(-A, -a);
+	expectSame(A.unitNormal(), a.unitNormal());
+
+	EXPECT_EQ(A.dot(B), a.dot(b));
+	EXPECT_EQ(A.squaredNorm(), a.squaredNorm());
+	EXPECT_EQ(A.norm(), a.norm());
+	EXPECT_EQ(A.sum(), a.sum());
+	EXPECT_EQ(A.infNorm(), a.infNorm());
+	EXPECT_EQ(A.pNorm(1), a.pNorm(1));
+	EXPECT_EQ(A.pNorm(2), a.pNorm(2));
+	EXPECT_NEAR(A.pNorm(3), a.pNorm(3), (1e-12 * a.pNorm(3)));
+
+	EXPECT_TRUE(A == DynVector<double>(a));
+	EXPECT_TRUE(A != B);
+	Vector<N, double> back;
+	ASSERT_TRUE(A.toVector(back));
+	EXPECT_EQ(back, a);
+};
+
+/* Tests */
+TEST(DynVector, MatchesDispatchedSizes)
+{
+	checkMatchesVector<2>();
+	checkMatchesVector<3>();
+	checkMatchesVector<4>();
+	checkMatchesVector<8>();
+	checkMatchesVector<16>();
+	checkMatchesVector<64>();
+};
+TEST(DynVector, MatchesBlockedSizes)
+{
+	// Dispatched, but run as 64 element blocks
+	checkMatchesVector<128>();
+	checkMatchesVector<256>();
+	checkMatchesVector<768>();
+};
+TEST(DynVector, MatchesOtherSizes)
+{
+	checkMatchesVector<1>();
+	checkMatchesVector<5>();
+	checkMatchesVector<63>();
+	checkMatchesVector<65>();
+	checkMatchesVector<100>();
+	checkMatchesVector<192>();
+	checkMatchesVector<1000>();
+};
+TEST(DynVector, CopiesAndMovesBetweenStorage)
+{
+	const size_t inlineSize = 4;
+	const size_t heapSize = 100;
+	ASSERT_LT(inlineSize, DynVector<double>::inlineCapacity);
+	ASSERT_GT(heapSize, DynVector<double>::inlineCapacity);
+	const Vector<4, double> small = integerVector<4>(1);
+	const Vector<100, double> large = integerVector<100>(2);
+
+	// Copies in both directions
+	DynVector<double> A(small), B(large);
+	DynVector<double> C(B);
+	expectSame(C, large);
+	C = A;
+	expectSame(C, small);
+	C = B;
+	expectSame(C, large);
+	const DynVector<double>& self = C;
+	C = self;
+	expectSame(C, large);
+
+	// A move takes over heap storage, and copies inline storage
+	const double* heap = C.data();
+	DynVector<double> D(std::move(C));
+	expectSame(D, large);
+	EXPECT_EQ(D.data(), heap);
+	EXPECT_TRUE(C.empty());
+	DynVector<double> E(std::move(A));
+	expectSame(E, small);
+	EXPECT_TRUE(A.empty());
+
+	// Moving inline storage over heap storage, and heap over inline
+	D = std::move(E);
+	expectSame(D, small);
+	EXPECT_EQ(D.capacity(), DynVector<double>::inlineCapacity);
+	E = DynVector<double>(large);
+	expectSame(E, large);
+	DynVector<double>& moved = E;
+	E = std::move(moved);
+	expectSame(E, large);
+
+	// Emptied vectors are still usable
+	A = B;
+	expectSame(A, large);
+	C.resize(3);
+	EXPECT_EQ(C, DynVector<double>({ 0.0, 0.0, 0.0 }));
+
+	D.swap(E);
+	expectSame(D, large);
+	expectSame(E, small);
+	EXPECT_EQ(((uintptr_t)D.data() % DynVector<double>::alignment), 0u);
+	EXPECT_EQ(((uintptr_t)E.data() % DynVector<double>::alignment), 0u);
+
+	// Growing onto the heap keeps the elements and zeroes the new ones
+	E.resize(heapSize);
+	ASSERT_EQ(E.size(), heapSize);
+	for (size_t i = 0; i < heapSize; i++)
+	{
+		EXPECT_EQ(E[i], ((i < inlineSize) ? small.value[i] : 0.0)) << "element " << i;
+	};
+	E.resize(2);
+	E.resize(3);
+	EXPECT_EQ(E[2], 0.0);
+};
+TEST(DynVector, MismatchedSizesUseSharedElements)
+{
+	// Sizes either side of a 64 element block, so no operator can read or write
+	// past the shorter vector without ASan or the results noticing.
+	const Vector<130, double> a = integerVector<130>(3);
+	const Vector<70, double> b = integerVector<70>(4);
+	const DynVector<double> A(a), B(b);
+
+	const DynVector<double> sum = (A + B);
+	ASSERT_EQ(sum.size(), A.size());
+	for (size_t i = 0; i < sum.size(); i++)
+	{
+		EXPECT_EQ(sum[i], ((i < B.size()) ? (a.value[i] + b.value[i]) : a.value[i])) << "element " << i;
+	};
+	const DynVector<double> product = (B * A);
+	ASSERT_EQ(product.size(), B.size());
+	for (size_t i = 0; i < product.size(); i++)
+	{
+		EXPECT_EQ(product[i], (b.value[i] * a.value[i])) << "element " << i;
+	};
+
+	double dot = 0.0;
+	for (size_t i = 0; i < B.size(); i++)
+	{
+		dot += (a.value[i] * b.value[i]);
+	};
+	EXPECT_EQ(A.dot(B), dot);
+	EXPECT_EQ(B.dot(A), dot);
+	EXPECT_FALSE(A == B);
+	EXPECT_FALSE(DynVector<double>(b.value, 64) == B);
+	EXPECT_EQ((DynVector<double>() + A).size(), 0u);
+	EXPECT_EQ(A.dot(DynVector<double>()), 0.0);
+
+	Vector<70, double> wrongSize;
+	EXPECT_FALSE(A.toVector(wrongSize));
+};
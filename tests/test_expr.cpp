@@ -0,0 +1,92 @@
+/*
+	# Vector Template Library - Expression Template Tests
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	Checks that lazily evaluated expressions give exactly the results of the
+	eager operators, for the fixed size vector types and a long Vector<N,T>,
+	including scalars on either side, temporaries held by value, a vector
+	assigned an expression of itself, and the reductions.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+/* Deps */
+#include "vectors_test.h"
+#include "vectors_expr.h"
+#include <cmath>
+
+/* Helpers */
+template <typename V>
+static V integerVector(const uint32_t& seed)
+{
+	// Small integers, so sums are exact in any order and the reductions compare exactly.
+	V v = randomVectors<V>(1, seed, 32.0f)[0];
+	for (uint64_t i = 0; i < VectorTraits<V>::dimensions; i++)
+	{
+		v.value[i] = std::round(v.value[i]);
+	};
+	return v;
+};
+
+template <typename V>
+static void checkExpressions()
+{
+	typedef typename VectorTraits<V>::ElementType T;
+	const V a = integerVector<V>(1), b = integerVector<V>(2), c = integerVector<V>(3);
+	const T s = (T)3;
+
+	const V fused = lazy(a) + lazy(b) * s - lazy(c);
+	EXPECT_EQ(fused, ((a + (b * s)) - c));
+	EXPECT_EQ(V(lazy(a) * lazy(b) / (T)4), ((a * b) / (T)4));
+	EXPECT_EQ(V(s - lazy(a)), ((-a) + s));
+	EXPECT_EQ(V(s * lazy(a) + (T)1), ((a * s) + (T)1));
+	EXPECT_EQ(V(-(lazy(a) - c)), -(a - c));
+	EXPECT_EQ(evaluate(lazy(a) + (b * s)), (a + (b * s)));
+
+	V assigned;
+	assigned = (lazy(a) - lazy(b)) * (lazy(c) + s);
+	EXPECT_EQ(assigned, ((a - b) * (c + s)));
+
+	// Each element only reads the same element, so a vector may appear on both sides.
+	V aliased = a;
+	aliased = lazy(aliased) * lazy(aliased) + lazy(b);
+	EXPECT_EQ(aliased, ((a * a) + b));
+
+	EXPECT_EQ(dot(lazy(a) + lazy(b), c), (a + b).dot(c));
+	EXPECT_EQ(dot(c, lazy(a) - lazy(b)), c.dot(a - b));
+	EXPECT_EQ(sum(lazy(a) - lazy(b)), (a - b).sum());
+	EXPECT_EQ(norm(lazy(a) + lazy(c)), (a + c).norm());
+};
+
+/* Tests */
+TEST(Expressions, MatchEagerVector2D)
+{
+	checkExpressions<Vector2D<float>>();
+	checkExpressions<Vector2D<double>>();
+};
+TEST(Expressions, MatchEagerVector3D)
+{
+	checkExpressions<Vector3D<float>>();
+	checkExpressions<Vector3D<double>>();
+};
+TEST(Expressions, MatchEagerVector4D)
+{
+	checkExpressions<Vector4D<float>>();
+	checkExpressions<Vector4D<double>>();
+};
+TEST(Expressions, MatchEagerLongVector)
+{
+	checkExpressions<Vector<7, double>>();
+	checkExpressions<Vector<256, float>>();
+};
+TEST(Expressions, EvaluateAtCompileTime)
+{
+	constexpr Vector3D<int> a(1, 2, 3);
+	constexpr Vector3D<int> b(4, 5, 6);
+	constexpr Vector3D<int> c = (lazy(a) + lazy(b) * 2);
+	static_assert(c == Vector3D<int>(9, 12, 15), "Expressions evaluate at compile time.");
+	static_assert(dot(lazy(a) - lazy(b), a) == -18, "Expression reductions evaluate at compile time.");
+	EXPECT_EQ(c, Vector3D<int>(9, 12, 15));
+};
@@ -0,0 +1,156 @@
+/*
+	# Vector Template Library - Formatting Tests
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	Checks that formatted vectors parse back to exactly the same values, at the
+	extremes of each element type too, that formatTo() never writes past its
+	buffer, and that malformed text is rejected without touching the result.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+/* Deps */
+#include "vectors_test.h"
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <string>
+
+/* Helpers */
+template <typename V>
+static void expectRoundTrip(const V& value)
+{
+	char buffer[vectorsFormatLength<V>()];
+	const size_t length = formatTo(buffer, sizeof(buffer), value);
+	ASSERT_GT(length, 0u);
+	const std::string text(buffer, length);
+	SCOPED_TRACE(text);
+	EXPECT_EQ(toString(value), text);
+
+	V parsed;
+	ASSERT_TRUE(parse(text, parsed));
+	for (uint64_t i = 0; i < VectorTraits<V>::dimensions; i++)
+	{
+		// Compared by bits, so -0 and NaN round trip as well.
+		EXPECT_EQ(memcmp(&parsed.value[i], &value.value[i], sizeof(value.value[i])), 0) << "element " << i;
+	};
+
+	// The text fits without the terminator, but any shorter buffer is refused.
+	EXPECT_EQ(formatTo(buffer, length, value), length);
+	EXPECT_EQ(formatTo(buffer, (length - 1), value), 0u);
+};
+
+template <typename V>
+static void checkRoundTrips()
+{
+	typedef typename VectorTraits<V>::ElementType T;
+	for (const V& value : randomVectors<V>(200, 1, 2000.0f))
+	{
+		expectRoundTrip(value);
+	};
+
+	// The longest elements, which vectorsFormatLength() must allow for
+	V extreme;
+	const T extremes[] = {
+		std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max(), std::numeric_limits<T>::min(),
+		(T)-std::numeric_limits<T>::denorm_min(), std::numeric_limits<T>::epsilon(), (T)0
+	};
+	for (size_t first = 0; first < (sizeof(extremes) / sizeof(extremes[0])); first++)
+	{
+		for (uint64_t i = 0; i < VectorTraits<V>::dimensions; i++)
+		{
+			extreme.value[i] = extremes[(first + i) % (sizeof(extremes) / sizeof(extremes[0]))];
+		};
+		expectRoundTrip(extreme);
+	};
+};
+
+/* Tests */
+TEST(Formatting, RoundTripsFloat)
+{
+	checkRoundTrips<Vector2D<float>>();
+	checkRoundTrips<Vector3D<float>>();
+	checkRoundTrips<Vector4D<float>>();
+	checkRoundTrips<Vector<10, float>>();
+};
+TEST(Formatting, RoundTripsDouble)
+{
+	checkRoundTrips<Vector3D<double>>();
+	checkRoundTrips<Vector<7, double>>();
+};
+TEST(Formatting, RoundTripsIntegers)
+{
+	expectRoundTrip(Vector3D<int>(std::numeric_limits<int>::lowest(), std::numeric_limits<int>::max(), 0));
+	expectRoundTrip(Vector<4, int64_t>(std::numeric_limits<int64_t>::lowest(), std::numeric_limits<int64_t>::max(), -1, 1));
+	expectRoundTrip(Vector2D<uint64_t>(std::numeric_limits<uint64_t>::max(), 0));
+};
+TEST(Formatting, RoundTripsSpecialValues)
+{
+	expectRoundTrip(Vector3D<float>(-0.0f, std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity()));
+	expectRoundTrip(Vector2D<double>(std::numeric_limits<double>::quiet_NaN(), -0.0));
+};
+TEST(Formatting, ShortestText)
+{
+	EXPECT_EQ(toString(Vector3D<float>(1.0f, 2.5f, -3.0f)), "(1,2.5,-3)");
+	EXPECT_EQ(toString(Vector2D<double>(0.1, 1e300)), "(0.1,1e+300)");
+	EXPECT_EQ(toString(Vector<3, int>(1, -2, 3)), "(1,-2,3)");
+
+	std::ostringstream stream;
+	stream << Vector4D<float>(0.1f, 2.0f, -0.0f, 1e-30f);
+	EXPECT_EQ(stream.str(), toString(Vector4D<float>(0.1f, 2.0f, -0.0f, 1e-30f)));
+
+	// Too small for even the parentheses
+	char buffer[2] = { 'x', 'x' };
+	EXPECT_EQ(formatTo(buffer, 1, Vector2D<float>()), 0u);
+	EXPECT_EQ(formatTo(buffer, 0, Vector2D<float>()), 0u);
+};
+TEST(Formatting, ParsesWhitespaceAndRecords)
+{
+	Vector3D<float> value;
+	ASSERT_TRUE(parse(" ( 1 ,\t2 ,3\n) ", value));
+	EXPECT_EQ(value, Vector3D<float>(1.0f, 2.0f, 3.0f));
+
+	// One record after another
+	const std::string records = "(1,2)(3,4) (5,6)";
+	const char* cursor = records.data();
+	const char* const last = (records.data() + records.size());
+	Vector2D<int> record;
+	for (int i = 0; i < 3; i++)
+	{
+		cursor = parse(cursor, last, record);
+		ASSERT_NE(cursor, nullptr);
+		EXPECT_EQ(record, Vector2D<int>((2 * i) + 1, (2 * i) + 2));
+	};
+	EXPECT_EQ(cursor, last);
+};
+TEST(Formatting, RejectsMalformedText)
+{
+	const char* const rejected[] = {
+		"", " ", "(", "()", "1,2,3", "(1,2,3", "(1,2)", "(1,2,3,4)", "(1,,3)", "(1;2;3)",
+		"(a,b,c)", "(1,2,3)x", "(1,2,3))", "((1,2,3)", "(1 2,3)", "(0x10,2,3)", "[1,2,3]"
+	};
+	for (const char* text : rejected)
+	{
+		SCOPED_TRACE(text);
+		Vector3D<float> value(7.0f, 8.0f, 9.0f);
+		EXPECT_FALSE(parse(std::string_view(text), value));
+		EXPECT_EQ(value, Vector3D<float>(7.0f, 8.0f, 9.0f));
+	};
+
+	// Out of range for the element type, though subnormals are in range
+	Vector2D<double> doubles(1.0, 2.0);
+	EXPECT_FALSE(parse("(1e999,1)", doubles));
+	EXPECT_FALSE(parse("(1,-1e-999)", doubles));
+	EXPECT_EQ(doubles, Vector2D<double>(1.0, 2.0));
+	ASSERT_TRUE(parse("(1e-320,-5e-324)", doubles));
+	EXPECT_EQ(doubles, Vector2D<double>(1e-320, -5e-324));
+	Vector2D<int> integers(1, 2);
+	EXPECT_FALSE(parse("(99999999999,1)", integers));
+	EXPECT_FALSE(parse("(1.5,1)", integers));
+	EXPECT_EQ(integers, Vector2D<int>(1, 2));
+	Vector2D<uint32_t> unsignedIntegers(1, 2);
+	EXPECT_FALSE(parse("(-1,1)", unsignedIntegers));
+	EXPECT_EQ(unsignedIntegers, Vector2D<uint32_t>(1, 2));
+};
@@ -0,0 +1,184 @@
+/*
+	# Vector Template Library - HNSW Tests
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	Recall of HnswIndex against FlatIndex, save/load round trips, and corrupt
+	files which load() must reject.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+/* Deps */
+#include "vectors_test.h"
+#include "vectors_hnsw.h"
+#include <sstream>
+#include <string>
+
+/* Helpers */
+typedef Vector<16, float> HnswVector;
+typedef HnswIndex<16, float> HnswTestIndex;
+
+static constexpr size_t hnswCount = 500;
+
+static std::string savedIndex(const HnswTestIndex& index)
+{
+	std::stringstream stream;
+	EXPECT_TRUE(index.save(stream));
+	return stream.str();
+};
+template <typename U>
+static std::string patched(std::string bytes, const size_t& offset, const U& value)
+{
+	memcpy(&bytes[offset], &value, sizeof(U));
+	return bytes;
+};
+static size_t linksOffset(const size_t& count)
+{
+	/*
+		Where the layer 0 link lists start in a saved index: after the 13 header
+		fields, the vectors, their norms and their levels.
+	*/
+
+	return ((13 * sizeof(uint64_t)) + (count * (sizeof(HnswVector) + sizeof(float) + sizeof(uint32_t))));
+};
+
+class HnswTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		this->base = randomVectors<HnswVector>(hnswCount, 1);
+		this->queries = randomVectors<HnswVector>(20, 2);
+		this->index.add(this->base.data(), this->base.size());
+		this->saved = savedIndex(this->index);
+	};
+
+	bool loads(const std::string& bytes)
+	{
+		std::stringstream stream(bytes);
+		HnswTestIndex loaded;
+		const bool good = loaded.load(stream);
+		if (good)
+		{
+			// A loaded index must be safe to search.
+			VectorNeighbour<float> out[5];
+			loaded.search(this->queries[0], 5, out);
+		}
+		else
+		{
+			EXPECT_TRUE(loaded.empty());
+		};
+		return good;
+	};
+
+	std::vector<HnswVector> base;
+	std::vector<HnswVector> queries;
+	HnswTestIndex index;
+	std::string saved;
+};
+
+/* Tests */
+TEST_F(HnswTest, Recall)
+{
+	FlatIndex<16, float> flat;
+	flat.add(this->base.data(), this->base.size());
+
+	size_t hits = 0;
+	for (const HnswVector& query : this->queries)
+	{
+		VectorNeighbour<float> exact[10], approximate[10];
+		flat.search(query, 10, exact);
+		this->index.search(query, 10, approximate, 100);
+		for (const VectorNeighbour<float>& e : exact)
+		{
+			for (const VectorNeighbour<float>& a : approximate)
+			{
+				hits += (e.id == a.id);
+			};
+		};
+	};
+	EXPECT_GE(hits, (size_t)(0.9 * 10 * this->queries.size()));
+};
+TEST_F(HnswTest, SaveLoadRoundTrip)
+{
+	std::stringstream stream(this->saved);
+	HnswTestIndex loaded;
+	ASSERT_TRUE(loaded.load(stream));
+	ASSERT_EQ(loaded.size(), this->index.size());
+	EXPECT_EQ(savedIndex(loaded), this->saved);
+
+	for (const HnswVector& query : this->queries)
+	{
+		VectorNeighbour<float> expected[10], found[10];
+		this->index.search(query, 10, expected);
+		loaded.search(query, 10, found);
+		for (size_t i = 0; i < 10; i++)
+		{
+			EXPECT_EQ(found[i].id, expected[i].id);
+			EXPECT_EQ(found[i].distance, expected[i].distance);
+		};
+	};
+};
+TEST_F(HnswTest, SaveLoadEmpty)
+{
+	HnswTestIndex empty;
+	std::stringstream stream(savedIndex(empty));
+	HnswTestIndex loaded;
+	EXPECT_TRUE(loaded.load(stream));
+	EXPECT_TRUE(loaded.empty());
+};
+TEST_F(HnswTest, RejectsCorruptHeader)
+{
+	ASSERT_TRUE(this->loads(this->saved));
+	EXPECT_FALSE(this->loads(patched(this->saved, (9 * 8), (uint64_t)1000000))); // entry
+	EXPECT_FALSE(this->loads(patched(this->saved, (9 * 8), (uint64_t)hnswCount)));
+	EXPECT_FALSE(this->loads(patched(this->saved, (10 * 8), (uint64_t)40))); // maxLevel
+	EXPECT_FALSE(this->loads(patched(this->saved, (10 * 8), (uint64_t)-2)));
+	EXPECT_FALSE(this->loads(patched(this->saved, (6 * 8), (uint64_t)0))); // M
+	EXPECT_FALSE(this->loads(patched(this->saved, (6 * 8), (uint64_t)1 << 40)));
+	EXPECT_FALSE(this->loads(patched(this->saved, (5 * 8), (uint64_t)7))); // metric
+	EXPECT_FALSE(this->loads(patched(this->saved, (12 * 8), (uint64_t)1 << 40))); // count
+	EXPECT_FALSE(this->loads(patched(this->saved, (12 * 8), UINT64_MAX)));
+	EXPECT_FALSE(this->loads(patched(this->saved, (12 * 8), (uint64_t)(hnswCount + 1))));
+	EXPECT_FALSE(this->loads(patched(this->saved, (7 * 8), (uint64_t)0))); // efConstruction
+};
+TEST(Hnsw, ZeroEfConstruction)
+{
+	// A search width of zero is raised, rather than emptying the search results.
+	HnswIndex<4, float> index(VECTOR_METRIC_L2, 16, 0);
+	EXPECT_EQ(index.efConstruction, 16u);
+	const std::vector<Vector<4, float>> base = randomVectors<Vector<4, float>>(50, 9);
+	index.add(base.data(), base.size());
+	index.efConstruction = 0;
+	index.add(base.data(), 10);
+	ASSERT_EQ(index.size(), 60u);
+	VectorNeighbour<float> nearest;
+	ASSERT_EQ(index.search(base[30], 1, &nearest), 1u);
+	EXPECT_EQ(nearest.id, 30u);
+};
+TEST_F(HnswTest, RejectsCorruptLinks)
+{
+	const size_t links = linksOffset(hnswCount);
+	const size_t stride = ((2 * this->index.M) + 1);
+	ASSERT_GT(this->index.neighbours(0, 0)[0], 0u);
+
+	EXPECT_FALSE(this->loads(patched(this->saved, (links + 4), (uint32_t)1000000)));
+	EXPECT_FALSE(this->loads(patched(this->saved, (links + 4), (uint32_t)hnswCount)));
+	EXPECT_FALSE(this->loads(patched(this->saved, links, (uint32_t)(stride + 5))));
+	EXPECT_FALSE(this->loads(patched(this->saved, (links + 4), (uint32_t)UINT32_MAX)));
+};
+TEST_F(HnswTest, RejectsCorruptLevels)
+{
+	const size_t levels = ((13 * sizeof(uint64_t)) + (hnswCount * (sizeof(HnswVector) + sizeof(float))));
+	EXPECT_FALSE(this->loads(patched(this->saved, (levels + 4), (uint32_t)1000)));
+	EXPECT_FALSE(this->loads(patched(this->saved, (levels + 4), (uint32_t)UINT32_MAX)));
+};
+TEST_F(HnswTest, RejectsTruncated)
+{
+	for (const size_t size : { (size_t)0, (size_t)50, (size_t)104, linksOffset(hnswCount), (this->saved.size() - 1) })
+	{
+		EXPECT_FALSE(this->loads(this->saved.substr(0, size))) << size;
+	};
+};
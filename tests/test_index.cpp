@@ -0,0 +1,178 @@
+/*
+	# Vector Template Library - Flat Index Tests
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	Checks FlatIndex's top k against a brute force search in double precision for
+	each metric, with sizes that end part way through a block of stored vectors,
+	batches of queries that end part way through a tile, more neighbours asked
+	for than are stored, and batched searches matching single ones.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+/* Deps */
+#include "vectors_test.h"
+#include "vectors_index.h"
+#include <algorithm>
+#include <cmath>
+
+/* Helpers */
+template <uint64_t N>
+static double exactDistance(const Vector<N, float>& a, const Vector<N, float>& b, const VectorMetric& metric)
+{
+	/*
+		The distance or similarity FlatIndex reports between a and b, in double.
+	*/
+
+	double dot = 0.0, aa = 0.0, bb = 0.0, squared = 0.0;
+	for (uint64_t i = 0; i < N; i++)
+	{
+		dot += ((double)a.value[i] * b.value[i]);
+		aa += ((double)a.value[i] * a.value[i]);
+		bb += ((double)b.value[i] * b.value[i]);
+		squared += (((double)a.value[i] - b.value[i]) * ((double)a.value[i] - b.value[i]));
+	};
+	if (metric == VECTOR_METRIC_L2)
+	{
+		return squared;
+	}
+	else if (metric == VECTOR_METRIC_COSINE)
+	{
+		return (dot / std::sqrt(aa * bb));
+	};
+	return dot;
+};
+
+template <uint64_t N>
+static void checkAgainstBruteForce(const VectorMetric& metric, const size_t& size, const size_t& k)
+{
+	SCOPED_TRACE(::testing::Message() << "metric " << (int)metric << ", " << size << " vectors, k " << k);
+	typedef Vector<N, float> V;
+	const std::vector<V> base = randomVectors<V>(size, 1, 4.0f);
+	const std::vector<V> queries = randomVectors<V>(9, 2, 4.0f);
+	FlatIndex<N, float> index(metric);
+	index.add(base.data(), (base.size() - 1));
+	EXPECT_EQ(index.add(base.back()), (uint64_t)(size - 1));
+	ASSERT_EQ(index.size(), size);
+
+	const bool ascending = (metric == VECTOR_METRIC_L2);
+	std::vector<VectorNeighbour<float>> found(k);
+	for (const V& query : queries)
+	{
+		// Every distance, best first
+		std::vector<double> expected(size);
+		for (size_t i = 0; i < size; i++)
+		{
+			expected[i] = exactDistance(query, base[i], metric);
+		};
+		std::vector<double> sorted = expected;
+		if (ascending)
+		{
+			std::sort(sorted.begin(), sorted.end());
+		}
+		else
+		{
+			std::sort(sorted.begin(), sorted.end(), [](const double& a, const double& b) { return (a > b); });
+		};
+
+		const size_t kept = std::min(k, size);
+		ASSERT_EQ(index.search(query, k, found.data()), kept);
+		for (size_t i = 0; i < kept; i++)
+		{
+			// Near ties may come back in either order, so the ids are checked by their distances.
+			ASSERT_LT(found[i].id, (uint64_t)size) << "rank " << i;
+			const double tolerance = (1e-5 * (1.0 + std::fabs(sorted[i])));
+			EXPECT_NEAR(found[i].distance, sorted[i], tolerance) << "rank " << i;
+			EXPECT_NEAR(expected[found[i].id], sorted[i], tolerance) << "rank " << i;
+			for (size_t j = 0; j < i; j++)
+			{
+				EXPECT_NE(found[i].id, found[j].id) << "ranks " << j << " and " << i;
+			};
+		};
+		for (size_t i = kept; i < k; i++)
+		{
+			EXPECT_EQ(found[i].id, VECTOR_NO_NEIGHBOUR) << "rank " << i;
+		};
+	};
+};
+
+template <uint64_t N>
+static void checkBatchMatchesSingle(const VectorMetric& metric)
+{
+	SCOPED_TRACE(::testing::Message() << "metric " << (int)metric);
+	typedef Vector<N, float> V;
+	const size_t k = 7;
+	const std::vector<V> queries = randomVectors<V>(11, 4);
+	FlatIndex<N, float> index(metric);
+	index.add(randomVectors<V>(600, 3).data(), 600);
+
+	for (const size_t threads : { (size_t)1, (size_t)3 })
+	{
+		std::vector<VectorNeighbour<float>> batch(queries.size() * k);
+		index.search(queries.data(), queries.size(), k, batch.data(), threads);
+		for (size_t q = 0; q < queries.size(); q++)
+		{
+			VectorNeighbour<float> single[k];
+			index.search(queries[q], k, single);
+			for (size_t i = 0; i < k; i++)
+			{
+				EXPECT_EQ(batch[(q * k) + i].id, single[i].id) << threads << " threads, query " << q << ", rank " << i;
+				EXPECT_EQ(batch[(q * k) + i].distance, single[i].distance) << threads << " threads, query " << q << ", rank " << i;
+			};
+		};
+	};
+};
+
+/* Tests */
+TEST(FlatIndex, MatchesBruteForceL2)
+{
+	forEachISA([](VectorsISA) {
+		checkAgainstBruteForce<16>(VECTOR_METRIC_L2, 300, 10);
+		checkAgainstBruteForce<19>(VECTOR_METRIC_L2, 1000, 1);
+		checkAgainstBruteForce<3>(VECTOR_METRIC_L2, 257, 25);
+	});
+};
+TEST(FlatIndex, MatchesBruteForceInnerProduct)
+{
+	forEachISA([](VectorsISA) {
+		checkAgainstBruteForce<16>(VECTOR_METRIC_INNER_PRODUCT, 300, 10);
+		checkAgainstBruteForce<19>(VECTOR_METRIC_INNER_PRODUCT, 1000, 1);
+		checkAgainstBruteForce<3>(VECTOR_METRIC_INNER_PRODUCT, 257, 25);
+	});
+};
+TEST(FlatIndex, MatchesBruteForceCosine)
+{
+	forEachISA([](VectorsISA) {
+		checkAgainstBruteForce<16>(VECTOR_METRIC_COSINE, 300, 10);
+		checkAgainstBruteForce<19>(VECTOR_METRIC_COSINE, 1000, 1);
+		checkAgainstBruteForce<3>(VECTOR_METRIC_COSINE, 257, 25);
+	});
+};
+TEST(FlatIndex, PadsMissingNeighbours)
+{
+	for (const VectorMetric metric : { VECTOR_METRIC_L2, VECTOR_METRIC_INNER_PRODUCT, VECTOR_METRIC_COSINE })
+	{
+		checkAgainstBruteForce<16>(metric, 5, 8);
+		checkAgainstBruteForce<16>(metric, 1, 3);
+	};
+
+	// Nothing stored
+	FlatIndex<16, float> empty;
+	VectorNeighbour<float> out[3];
+	EXPECT_EQ(empty.search(Vector<16, float>(), 3, out), 0u);
+	for (const VectorNeighbour<float>& neighbour : out)
+	{
+		EXPECT_EQ(neighbour.id, VECTOR_NO_NEIGHBOUR);
+	};
+};
+TEST(FlatIndex, BatchMatchesSingle)
+{
+	forEachISA([](VectorsISA) {
+		checkBatchMatchesSingle<16>(VECTOR_METRIC_L2);
+		checkBatchMatchesSingle<16>(VECTOR_METRIC_INNER_PRODUCT);
+		checkBatchMatchesSingle<16>(VECTOR_METRIC_COSINE);
+		checkBatchMatchesSingle<19>(VECTOR_METRIC_L2);
+	});
+};
@@ -0,0 +1,70 @@
+/*
+	# Vector Template Library - Serialization Tests
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	Round trips through vectors_io.h, and headers which must be rejected.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+/* Deps */
+#include "vectors_test.h"
+#include "vectors_io.h"
+#include <sstream>
+#include <string>
+
+/* Helpers */
+static std::string withCount(std::string bytes, const uint64_t& count)
+{
+	const uint64_t encoded = vectorsToLittleEndian(count);
+	memcpy(&bytes[16], &encoded, 8);
+	return bytes;
+};
+
+/* Tests */
+TEST(VectorsIO, RoundTrip)
+{
+	const std::vector<Vector3D<float>> written = randomVectors<Vector3D<float>>(1000, 1);
+	std::stringstream stream;
+	ASSERT_TRUE(writeVectors(stream, written));
+
+	std::vector<Vector3D<float>> read;
+	ASSERT_TRUE(readVectors(stream, read));
+	ASSERT_EQ(read.size(), written.size());
+	for (size_t i = 0; i < read.size(); i++)
+	{
+		EXPECT_EQ(read[i], written[i]);
+	};
+};
+TEST(VectorsIO, RejectsWrongType)
+{
+	std::stringstream stream;
+	writeVectors(stream, randomVectors<Vector3D<float>>(10, 1));
+	std::vector<Vector3D<double>> read;
+	EXPECT_FALSE(readVectors(stream, read));
+};
+TEST(VectorsIO, RejectsCountPastEnd)
+{
+	std::stringstream written;
+	writeVectors(written, randomVectors<Vector3D<float>>(100, 1));
+	const std::string bytes = written.str();
+
+	for (const uint64_t count : { (uint64_t)101, ((uint64_t)1 << 40), (UINT64_MAX / 2), UINT64_MAX })
+	{
+		std::stringstream stream(withCount(bytes, count));
+		std::vector<Vector3D<float>> read(3);
+		EXPECT_FALSE(readVectors(stream, read)) << count;
+		EXPECT_TRUE(read.empty());
+	};
+};
+TEST(VectorsIO, RejectsTruncatedValues)
+{
+	std::stringstream stream("12345678");
+	std::vector<uint32_t> values;
+	EXPECT_TRUE(readValues(stream, values, 2));
+	EXPECT_EQ(values.size(), 2u);
+	EXPECT_FALSE(readValues(stream, values, ((uint64_t)1 << 40)));
+	EXPECT_TRUE(values.empty());
+};
@@ -0,0 +1,38 @@
+/*
+	# Vector Template Library - Layout Tests
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	The size and alignment of the vector types must match across translation
+	units built with different instruction set flags, see test_layout.h.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+/* Deps */
+#include "vectors_test.h"
+#include "test_layout.h"
+
+/* Tests */
+TEST(VectorLayout, SameWithAVX)
+{
+	const std::vector<VectorTypeLayout> expected = VECTORS_LAYOUTS;
+	const std::vector<VectorTypeLayout> avx = vectorsLayoutsAVX();
+	ASSERT_EQ(avx.size(), expected.size());
+	for (size_t i = 0; i < expected.size(); i++)
+	{
+		EXPECT_EQ(avx[i].size, expected[i].size) << expected[i].name;
+		EXPECT_EQ(avx[i].alignment, expected[i].alignment) << expected[i].name;
+	};
+};
+TEST(VectorLayout, Alignment)
+{
+	EXPECT_EQ(alignof(Vector4D<float>), 16u);
+	EXPECT_EQ(alignof(Vector4D<double>), 32u);
+	EXPECT_EQ(alignof(Vector3D<float>), alignof(float));
+	EXPECT_EQ(sizeof(Vector3D<float>), (3 * sizeof(float)));
+	EXPECT_EQ(alignof(Vector<4, float>), 16u);
+	EXPECT_EQ(alignof(Vector<128, float>), 32u);
+	EXPECT_EQ(alignof(Vector<6, float>), alignof(float));
+};
@@ -0,0 +1,58 @@
+#pragma once
+/*
+	# Vector Template Library - Layout Tests
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	The types whose size and alignment must not depend on the instruction sets
+	a translation unit is built with. test_layout.cpp is built with the
+	project's flags and test_layout_avx.cpp with AVX2 and FMA enabled, and each
+	records the layouts it sees for the test to compare. Only sizeof and alignof
+	are taken in the AVX translation unit, so no inline function is compiled
+	for AVX there and picked by the linker for the rest of the tests.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+#ifndef VECTOR_TEMPLATE_LIBRARY_TEST_LAYOUT__H
+#define VECTOR_TEMPLATE_LIBRARY_TEST_LAYOUT__H
+/* Deps */
+#include "vectors.h"
+#include "vectors_quaternion.h"
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+/* Layouts */
+struct VectorTypeLayout
+{
+	std::string name;
+	size_t size;
+	size_t alignment;
+};
+
+#define VECTORS_LAYOUT(...) VectorTypeLayout{ #__VA_ARGS__, sizeof(__VA_ARGS__), alignof(__VA_ARGS__) }
+
+#define VECTORS_LAYOUTS { \
+	VECTORS_LAYOUT(Vector2D<float>), \
+	VECTORS_LAYOUT(Vector2D<double>), \
+	VECTORS_LAYOUT(Vector3D<float>), \
+	VECTORS_LAYOUT(Vector3D<double>), \
+	VECTORS_LAYOUT(Vector4D<float>), \
+	VECTORS_LAYOUT(Vector4D<double>), \
+	VECTORS_LAYOUT(Vector4D<int32_t>), \
+	VECTORS_LAYOUT(Vector<4, float>), \
+	VECTORS_LAYOUT(Vector<6, float>), \
+	VECTORS_LAYOUT(Vector<8, float>), \
+	VECTORS_LAYOUT(Vector<12, double>), \
+	VECTORS_LAYOUT(Vector<16, double>), \
+	VECTORS_LAYOUT(Vector<128, float>), \
+	VECTORS_LAYOUT(Vector<5, int32_t>), \
+	VECTORS_LAYOUT(Quaternion<float>), \
+	VECTORS_LAYOUT(Quaternion<double>) \
+}
+
+std::vector<VectorTypeLayout> vectorsLayoutsAVX();
+
+#endif
@@ -0,0 +1,20 @@
+/*
+	# Vector Template Library - Layout Tests (AVX)
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	The layouts of the vector types as seen with AVX2 and FMA enabled, see
+	test_layout.h.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+/* Deps */
+#include "test_layout.h"
+
+/* Layouts */
+std::vector<VectorTypeLayout> vectorsLayoutsAVX()
+{
+	return VECTORS_LAYOUTS;
+};
@@ -0,0 +1,178 @@
+/*
+	# Vector Template Library - Memory Mapped Storage Tests
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	Checks MappedVectorStore against a temporary file: creating, appending past
+	the mapping, reopening, trimming the file to its vectors on close(), the
+	header's count following flush() and the sync interval, and rejecting files
+	of other vector types.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+/* Deps */
+#include "vectors_test.h"
+#include "vectors_mapped.h"
+#include <stdio.h>
+#include <fstream>
+#include <string>
+
+/* Helpers */
+typedef Vector<64, float> MappedVector;
+
+static std::string temporaryPath(const std::string& name)
+{
+	const std::string path = (::testing::TempDir() + "vectors_mapped_" + name + ".vtlb");
+	::remove(path.c_str());
+	return path;
+};
+
+static uint64_t fileSize(const std::string& path)
+{
+	std::ifstream stream(path, std::ios::binary | std::ios::ate);
+	return (uint64_t)stream.tellg();
+};
+
+static VectorFileHeader fileHeader(const std::string& path)
+{
+	// Read through a separate stream, which sees the shared mapping's pages.
+	unsigned char encoded[VECTOR_FILE_HEADER_SIZE] = {};
+	std::ifstream stream(path, std::ios::binary);
+	stream.read((char*)encoded, VECTOR_FILE_HEADER_SIZE);
+	return VectorFileHeader::decode(encoded);
+};
+
+/* Tests */
+TEST(MappedVectorStore, AppendsAndReopens)
+{
+#if VECTORS_MAPPED
+	const std::string path = temporaryPath("reopen");
+	const std::vector<MappedVector> written = randomVectors<MappedVector>(5000, 1);
+	const size_t first = 100;
+	{
+		MappedVectorStore<MappedVector> store;
+		ASSERT_TRUE(store.create(path));
+		EXPECT_TRUE(store.isWritable());
+		EXPECT_TRUE(store.empty());
+		for (size_t i = 0; i < first; i++)
+		{
+			ASSERT_TRUE(store.append(written[i]));
+		};
+		ASSERT_EQ(store.size(), first);
+		EXPECT_GT(store.capacity(), first);
+		ASSERT_TRUE(store.flush());
+		EXPECT_EQ(fileHeader(path).count, first);
+	};
+
+	// close() trims the slack the file grew by.
+	EXPECT_EQ(fileSize(path), (VECTOR_FILE_HEADER_SIZE + (first * sizeof(MappedVector))));
+
+	{
+		MappedVectorStore<MappedVector> store;
+		ASSERT_TRUE(store.open(path));
+		EXPECT_FALSE(store.isWritable());
+		ASSERT_EQ(store.size(), first);
+		EXPECT_FALSE(store.append(written[0]));
+		EXPECT_FALSE(store.flush());
+		for (size_t i = 0; i < first; i++)
+		{
+			EXPECT_EQ(store[i], written[i]) << "vector " << i;
+		};
+	};
+
+	{
+		// Enough more that the mapping has to grow and move.
+		MappedVectorStore<MappedVector> store;
+		ASSERT_TRUE(store.open(path, true));
+		const size_t capacity = store.capacity();
+		ASSERT_TRUE(store.append((written.data() + first), (written.size() - first)));
+		EXPECT_GT(store.capacity(), capacity);
+
+		MappedVectorStore<MappedVector> moved(std::move(store));
+		EXPECT_FALSE(store.valid());
+		EXPECT_EQ(moved.size(), written.size());
+	};
+	EXPECT_EQ(fileSize(path), (VECTOR_FILE_HEADER_SIZE + (written.size() * sizeof(MappedVector))));
+
+	// The file reads back with vectors_io.h too.
+	std::ifstream stream(path, std::ios::binary);
+	std::vector<MappedVector> read;
+	ASSERT_TRUE(readVectors(stream, read));
+	EXPECT_EQ(read, written);
+
+	MappedVectorStore<MappedVector> store;
+	ASSERT_TRUE(store.open(path));
+	ASSERT_EQ(store.size(), written.size());
+	EXPECT_TRUE(std::equal(store.begin(), store.end(), written.begin()));
+	EXPECT_TRUE(store.advise(VECTORS_ACCESS_SEQUENTIAL));
+	store.close();
+	::remove(path.c_str());
+#else
+	GTEST_SKIP() << "Memory mapping isn't available.";
+#endif
+};
+TEST(MappedVectorStore, HeaderCountsFlushedVectors)
+{
+#if VECTORS_MAPPED
+	const std::string path = temporaryPath("sync");
+	const std::vector<MappedVector> written = randomVectors<MappedVector>(25, 2);
+	MappedVectorStore<MappedVector> store;
+	ASSERT_TRUE(store.create(path));
+
+	// Without an interval only flush() updates the count.
+	ASSERT_TRUE(store.append(written.data(), 5));
+	EXPECT_EQ(fileHeader(path).count, 0u);
+	ASSERT_TRUE(store.flush());
+	EXPECT_EQ(fileHeader(path).count, 5u);
+
+	store.setSyncInterval(10);
+	for (size_t i = 5; i < written.size(); i++)
+	{
+		// Flushed every 10 appends after the first 5
+		ASSERT_TRUE(store.append(written[i]));
+		EXPECT_EQ(fileHeader(path).count, (5 + (((i - 4) / 10) * 10))) << "after vector " << i;
+	};
+
+	// The rest of the header is left as it was.
+	const VectorFileHeader header = fileHeader(path);
+	EXPECT_TRUE(header.matches<MappedVector>());
+	EXPECT_EQ(header.reserved, 0u);
+
+	store.close();
+	EXPECT_FALSE(store.valid());
+	EXPECT_EQ(fileHeader(path).count, written.size());
+	::remove(path.c_str());
+#else
+	GTEST_SKIP() << "Memory mapping isn't available.";
+#endif
+};
+TEST(MappedVectorStore, RejectsOtherFiles)
+{
+#if VECTORS_MAPPED
+	const std::string path = temporaryPath("reject");
+	{
+		MappedVectorStore<MappedVector> store;
+		ASSERT_TRUE(store.create(path));
+		ASSERT_TRUE(store.append(randomVectors<MappedVector>(3, 3).data(), 3));
+	};
+	MappedVectorStore<Vector3D<double>> other;
+	EXPECT_FALSE(other.open(path));
+	EXPECT_FALSE(other.valid());
+
+	// A count past the end of the file
+	{
+		std::fstream stream(path, std::ios::binary | std::ios::in | std::ios::out);
+		unsigned char encoded[VECTOR_FILE_HEADER_SIZE];
+		VectorFileHeader::describe<MappedVector>(4).encode(encoded);
+		stream.write((const char*)encoded, VECTOR_FILE_HEADER_SIZE);
+	};
+	MappedVectorStore<MappedVector> store;
+	EXPECT_FALSE(store.open(path));
+	EXPECT_FALSE(store.open(temporaryPath("missing")));
+	::remove(path.c_str());
+#else
+	GTEST_SKIP() << "Memory mapping isn't available.";
+#endif
+};
@@ -0,0 +1,105 @@
+/*
+	# Vector Template Library - Matrix Tests
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	The batched matrix transforms on every instruction set against the scalar
+	methods of Matrix3 and Matrix4, and the inverses against their products.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+/* Deps */
+#include "vectors_test.h"
+#include "vectors_matrix.h"
+
+/* Helpers */
+template <typename T>
+static Matrix4<T> testTransform()
+{
+	return Matrix4<T>::translation(Vector3D<T>((T)1.5, (T)-2, (T)0.25)) * Matrix4<T>::rotation(Vector3D<T>((T)1, (T)2, (T)3), (T)0.7) * Matrix4<T>::scaling(Vector3D<T>((T)2, (T)0.5, (T)3));
+};
+
+// Every length up to past two AVX-512 iterations, so each ISA runs its tail
+static const size_t matrixSizes[] = { 0, 1, 2, 3, 5, 7, 8, 9, 15, 16, 17, 31, 33, 47, 48, 49, 100 };
+
+template <typename T>
+static void checkTransforms()
+{
+	const Matrix4<T> M = testTransform<T>();
+	Matrix4<T> projective = M;
+	projective.value[3][0] = (T)0.1;
+	projective.value[3][2] = (T)-0.3;
+	const Matrix3<T> linear = M.linear();
+	const double tolerance = std::is_same<T, float>::value ? 1e-4 : 1e-12;
+
+	forEachISA([&](const VectorsISA&) {
+		for (const size_t n : matrixSizes)
+		{
+			SCOPED_TRACE(::testing::Message() << n << " vectors");
+			const std::vector<Vector3D<T>> A = randomVectors<Vector3D<T>>(n, (uint32_t)(n + 1), 10.0f);
+			const std::vector<Vector4D<T>> B = randomVectors<Vector4D<T>>(n, (uint32_t)(n + 2), 10.0f);
+			std::vector<Vector3D<T>> points(n), directions(n), vectors(n), inPlace = A;
+			std::vector<Vector4D<T>> homogeneous(n);
+
+			transformPoints(M, A.data(), points.data(), n);
+			transformDirections(M, A.data(), directions.data(), n);
+			transformVectors(linear, A.data(), vectors.data(), n);
+			transformVectors(projective, B.data(), homogeneous.data(), n);
+			transformPoints(M, inPlace.data(), n);
+			for (size_t i = 0; i < n; i++)
+			{
+				expectNear(points[i].value, M.transformPoint(A[i]).value, tolerance);
+				expectNear(directions[i].value, M.transformDirection(A[i]).value, tolerance);
+				expectNear(vectors[i].value, (linear * A[i]).value, tolerance);
+				expectNear(homogeneous[i].value, (projective * B[i]).value, tolerance);
+				EXPECT_EQ(inPlace[i], points[i]);
+			};
+		};
+
+		// An empty batch may be passed the null data() of an empty std::vector
+		transformPoints(M, (const Vector3D<T>*)nullptr, (Vector3D<T>*)nullptr, 0);
+		transformVectors(projective, (const Vector4D<T>*)nullptr, (Vector4D<T>*)nullptr, 0);
+	});
+};
+
+/* Tests */
+TEST(Matrix, TransformsFloat)
+{
+	checkTransforms<float>();
+};
+TEST(Matrix, TransformsDouble)
+{
+	checkTransforms<double>();
+};
+TEST(Matrix, Inverses)
+{
+	const Matrix4<double> M = testTransform<double>();
+	Matrix4<double> inverse;
+	ASSERT_TRUE(M.inverse(inverse));
+	Matrix4<double> affineInverse;
+	ASSERT_TRUE(M.affineInverse(affineInverse));
+	const Matrix4<double> identity = (M * inverse);
+	const Matrix4<double> affine = (M * affineInverse);
+	for (int r = 0; r < 4; r++)
+	{
+		for (int c = 0; c < 4; c++)
+		{
+			EXPECT_NEAR(identity.value[r][c], ((r == c) ? 1.0 : 0.0), 1e-12);
+			EXPECT_NEAR(affine.value[r][c], ((r == c) ? 1.0 : 0.0), 1e-12);
+		};
+	};
+
+	Matrix3<double> linear;
+	ASSERT_TRUE(M.linear().inverse(linear));
+	const Matrix3<double> product = (M.linear() * linear);
+	for (int r = 0; r < 3; r++)
+	{
+		for (int c = 0; c < 3; c++)
+		{
+			EXPECT_NEAR(product.value[r][c], ((r == c) ? 1.0 : 0.0), 1e-12);
+		};
+	};
+	EXPECT_FALSE(Matrix4<double>::scaling(Vector3D<double>(1.0, 0.0, 1.0)).inverse(inverse));
+};
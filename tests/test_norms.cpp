@@ -0,0 +1,95 @@
+/*
+	# Vector Template Library - Norm Tests
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	Checks the norms of each vector type against values worked out by hand,
+	p-norms of odd p over negative elements, integer vectors, and the accuracy
+	of fastInvNorm() over many vectors.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+/* Deps */
+#include "vectors_test.h"
+#include <cmath>
+
+/* Tests */
+TEST(Norms, HandValues)
+{
+	const Vector2D<float> a(3.0f, -4.0f);
+	EXPECT_EQ(a.squaredNorm(), 25.0f);
+	EXPECT_EQ(a.norm(), 5.0f);
+	EXPECT_EQ(a.length(), 5.0f);
+	EXPECT_EQ(a.pNorm(1), 7.0f);
+	EXPECT_EQ(a.pNorm(2), 5.0f);
+	EXPECT_FLOAT_EQ(a.pNorm(3), std::cbrt(91.0f));
+	EXPECT_EQ(a.infNorm(), 4.0f);
+
+	const Vector3D<double> b(1.0, -2.0, 2.0);
+	EXPECT_EQ(b.norm(), 3.0);
+	EXPECT_EQ(b.pNorm(1), 5.0);
+	EXPECT_DOUBLE_EQ(b.pNorm(4), std::pow(33.0, 0.25));
+	EXPECT_EQ(b.infNorm(), 2.0);
+
+	const Vector4D<float> c(-1.0f, 1.0f, -1.0f, 1.0f);
+	EXPECT_EQ(c.norm(), 2.0f);
+	EXPECT_EQ(c.pNorm(1), 4.0f);
+	EXPECT_FLOAT_EQ(c.pNorm(3), std::cbrt(4.0f));
+	EXPECT_EQ(c.infNorm(), 1.0f);
+
+	const Vector<5, double> d(2.0, 4.0, 5.0, 6.0, -12.0);
+	EXPECT_EQ(d.squaredNorm(), 225.0);
+	EXPECT_EQ(d.norm(), 15.0);
+	EXPECT_EQ(d.pNorm(1), 29.0);
+	EXPECT_EQ(d.infNorm(), 12.0);
+	EXPECT_DOUBLE_EQ(d.pNorm(8), std::pow(std::pow(12.0, 8.0) + std::pow(6.0, 8.0) + std::pow(5.0, 8.0) + std::pow(4.0, 8.0) + 256.0, 0.125));
+};
+TEST(Norms, OddPowersOfNegativeElements)
+{
+	// The absolute values are raised to p, so negative elements can't cancel.
+	const Vector3D<float> a(-1.0f, -1.0f, -1.0f);
+	EXPECT_FLOAT_EQ(a.pNorm(3), std::cbrt(3.0f));
+	const Vector2D<double> b(-2.0, 2.0);
+	EXPECT_DOUBLE_EQ(b.pNorm(5), std::pow(64.0, 0.2));
+	EXPECT_EQ((Vector<3, double>(-1.0, 2.0, -3.0).pNorm(1)), 6.0);
+};
+TEST(Norms, ZeroVector)
+{
+	const Vector4D<float> zero;
+	EXPECT_EQ(zero.norm(), 0.0f);
+	EXPECT_EQ(zero.pNorm(1), 0.0f);
+	EXPECT_EQ(zero.pNorm(3), 0.0f);
+	EXPECT_EQ(zero.infNorm(), 0.0f);
+};
+TEST(Norms, IntegerVectors)
+{
+	EXPECT_EQ(vectorsIntegerPower(3, 5), 243);
+	EXPECT_EQ(vectorsIntegerPower(2.0, 0), 1.0);
+	EXPECT_EQ(vectorsIntegerPower(-2, 3), -8);
+
+	const Vector3D<int> a(3, -4, 0);
+	EXPECT_EQ(a.squaredNorm(), 25);
+	EXPECT_EQ(a.norm(), 5);
+	EXPECT_EQ(a.pNorm(1), 7);
+	EXPECT_EQ(a.infNorm(), 4);
+	EXPECT_EQ(Vector2D<int>(2, 2).pNorm(3), 2);
+};
+TEST(Norms, FastInverseNorm)
+{
+	EXPECT_NEAR(Vector2D<float>(3.0f, 4.0f).fastInvNorm(), 0.2f, 1e-7f);
+	EXPECT_EQ(Vector2D<double>(3.0, 4.0).fastInvNorm(), 0.2);
+
+	for (const Vector3D<float>& v : randomVectors<Vector3D<float>>(1000, 1, 1000.0f))
+	{
+		const double exact = (1.0 / std::sqrt((double)v.x() * v.x() + (double)v.y() * v.y() + (double)v.z() * v.z()));
+		EXPECT_NEAR(v.fastInvNorm(), exact, (exact * 1e-6));
+		const Vector3D<float> unit = v.fastUnitNormal();
+		EXPECT_NEAR(unit.norm(), 1.0f, 1e-6f);
+	};
+	for (const Vector<7, float>& v : randomVectors<Vector<7, float>>(100, 2))
+	{
+		EXPECT_NEAR(v.fastInvNorm(), (1.0f / v.norm()), (1e-6f / v.norm()));
+	};
+};
@@ -0,0 +1,238 @@
+/*
+	# Vector Template Library - Quantization Tests
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	Checks the half and bfloat16 conversions against hand rounded values and
+	every 16 bit pattern, and the wide and quantized products against float
+	references on every instruction set the CPU supports, including the AVX-512
+	VNNI byte dot product and its masked remainder.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+/* Deps */
+#include "vectors_test.h"
+#include "vectors_quant.h"
+#include <cmath>
+
+/* Helpers */
+static float scaledPower(const float& mantissa, const int& exponent)
+{
+	return std::ldexp(mantissa, exponent);
+};
+
+template <uint64_t N, typename T>
+static void checkWideProducts()
+{
+	forEachISA([&](const VectorsISA&) {
+		for (uint32_t seed = 1; seed <= 4; seed++)
+		{
+			const Vector<N, float> a = randomVectors<Vector<N, float>>(1, seed, 8.0f)[0];
+			const Vector<N, float> b = randomVectors<Vector<N, float>>(1, (seed + 100), 8.0f)[0];
+			const Vector<N, T> A = vectorCast<T>(a), B = vectorCast<T>(b);
+
+			// The 16 bit values widen to float exactly, so only the sums differ.
+			double dot = 0.0, squared = 0.0, magnitude = 0.0;
+			for (uint64_t i = 0; i < N; i++)
+			{
+				const double x = (float)A.value[i], y = (float)B.value[i];
+				dot += (x * y);
+				squared += ((x - y) * (x - y));
+				magnitude += std::fabs(x * y);
+			};
+			const double tolerance = (1e-6 * (magnitude + squared + 1.0));
+			EXPECT_NEAR((double)wideDot(A, B), dot, tolerance);
+			EXPECT_NEAR((double)wideSquaredDistance(A, B), squared, tolerance);
+		};
+	});
+};
+
+template <uint64_t N>
+static void checkQuantized()
+{
+	forEachISA([&](const VectorsISA&) {
+		for (uint32_t seed = 1; seed <= 4; seed++)
+		{
+			const Vector<N, float> a = randomVectors<Vector<N, float>>(1, seed, 4.0f)[0];
+			const Vector<N, float> b = randomVectors<Vector<N, float>>(1, (seed + 100), 4.0f)[0];
+			const QuantizedVector<N> A(a), B(b);
+			const Vector<N, float> x = A.dequantize(), y = B.dequantize();
+
+			// The byte dot product alone is exact, whichever kernel runs it.
+			int32_t bytes = 0;
+			for (uint64_t i = 0; i < N; i++)
+			{
+				bytes += ((int32_t)A.value[i] * (int32_t)B.value[i]);
+				EXPECT_LE(std::fabs(x.value[i] - a.value[i]), ((0.5f * A.scale) + 1e-6f)) << "element " << i;
+			};
+			EXPECT_EQ(vectorsDispatch<VectorQuantDot>((const int8_t*)A.value, (const int8_t*)B.value, (size_t)N), bytes);
+
+			double quantized = 0.0, mixed = 0.0, quantizedSquared = 0.0, mixedSquared = 0.0, magnitude = 0.0;
+			for (uint64_t i = 0; i < N; i++)
+			{
+				quantized += ((double)x.value[i] * y.value[i]);
+				mixed += ((double)x.value[i] * b.value[i]);
+				quantizedSquared += (((double)x.value[i] - y.value[i]) * ((double)x.value[i] - y.value[i]));
+				mixedSquared += (((double)x.value[i] - b.value[i]) * ((double)x.value[i] - b.value[i]));
+				magnitude += (((double)x.value[i] * x.value[i]) + ((double)y.value[i] * y.value[i]) + ((double)b.value[i] * b.value[i]));
+			};
+			const double tolerance = (1e-5 * (magnitude + 1.0));
+			EXPECT_NEAR((double)A.dot(B), quantized, tolerance);
+			EXPECT_NEAR((double)A.dot(b), mixed, tolerance);
+			EXPECT_NEAR((double)A.squaredDistance(B), quantizedSquared, tolerance);
+			EXPECT_NEAR((double)A.squaredDistance(b), mixedSquared, tolerance);
+		};
+	});
+};
+
+/* Tests */
+TEST(Quantization, HalfRoundsToNearestEven)
+{
+	EXPECT_EQ(vectorsFloatToHalf(1.0f), 0x3C00);
+	EXPECT_EQ(vectorsFloatToHalf(-2.0f), 0xC000);
+	EXPECT_EQ(vectorsFloatToHalf(-0.0f), 0x8000);
+	EXPECT_EQ(vectorsFloatToHalf(65504.0f), 0x7BFF);
+
+	// Ties go to the even mantissa, either way.
+	EXPECT_EQ(vectorsFloatToHalf(1.0f + scaledPower(1.0f, -11)), 0x3C00);
+	EXPECT_EQ(vectorsFloatToHalf(1.0f + scaledPower(3.0f, -11)), 0x3C02);
+	EXPECT_EQ(vectorsFloatToHalf(1.0f + scaledPower(1.0f, -11) + scaledPower(1.0f, -20)), 0x3C01);
+
+	// Subnormals, and the tie below the smallest one.
+	EXPECT_EQ(vectorsFloatToHalf(scaledPower(1.0f, -24)), 0x0001);
+	EXPECT_EQ(vectorsFloatToHalf(scaledPower(1.0f, -25)), 0x0000);
+	EXPECT_EQ(vectorsFloatToHalf(scaledPower(3.0f, -25)), 0x0002);
+	EXPECT_EQ(vectorsFloatToHalf(scaledPower(1023.0f, -24)), 0x03FF);
+
+	// Past the largest half, halfway to the next step, is infinity.
+	EXPECT_EQ(vectorsFloatToHalf(65519.0f), 0x7BFF);
+	EXPECT_EQ(vectorsFloatToHalf(65520.0f), 0x7C00);
+	EXPECT_EQ(vectorsFloatToHalf(-1e10f), 0xFC00);
+	EXPECT_EQ(vectorsFloatToHalf(std::numeric_limits<float>::infinity()), 0x7C00);
+
+	const uint16_t nan = vectorsFloatToHalf(std::numeric_limits<float>::quiet_NaN());
+	EXPECT_EQ((nan & 0x7C00), 0x7C00);
+	EXPECT_NE((nan & 0x03FF), 0);
+	EXPECT_TRUE(std::isnan(vectorsHalfToFloat(nan)));
+};
+TEST(Quantization, HalfRoundTripsEveryValue)
+{
+	for (uint32_t bits = 0; bits <= 0xFFFF; bits++)
+	{
+		const float value = vectorsHalfToFloat((uint16_t)bits);
+		if (((bits & 0x7C00) == 0x7C00) && ((bits & 0x03FF) != 0))
+		{
+			EXPECT_TRUE(std::isnan(value)) << "bits " << bits;
+			continue;
+		};
+		EXPECT_EQ(vectorsFloatToHalf(value), bits) << "bits " << bits;
+	};
+	EXPECT_EQ(vectorsHalfToFloat(0x0001), scaledPower(1.0f, -24));
+	EXPECT_EQ(vectorsHalfToFloat(0x3555), 0.333251953125f);
+	EXPECT_EQ((float)half(0.1f), 0.0999755859375f);
+};
+TEST(Quantization, BFloat16RoundsToNearestEven)
+{
+	EXPECT_EQ(vectorsFloatToBFloat16(1.0f), 0x3F80);
+	EXPECT_EQ(vectorsFloatToBFloat16(-1.0f), 0xBF80);
+	EXPECT_EQ(vectorsFloatToBFloat16(1.0f + scaledPower(1.0f, -8)), 0x3F80);
+	EXPECT_EQ(vectorsFloatToBFloat16(1.0f + scaledPower(3.0f, -8)), 0x3F82);
+	EXPECT_EQ(vectorsFloatToBFloat16(1.0f + scaledPower(1.0f, -8) + scaledPower(1.0f, -20)), 0x3F81);
+	EXPECT_EQ(vectorsFloatToBFloat16(std::numeric_limits<float>::max()), 0x7F80);
+	EXPECT_EQ(vectorsFloatToBFloat16(std::numeric_limits<float>::infinity()), 0x7F80);
+
+	// A NaN whose payload is all in the low bits must not round to infinity.
+	const float lowNaN = vectorsBitsFloat(0x7F800001);
+	EXPECT_TRUE(std::isnan(vectorsBFloat16ToFloat(vectorsFloatToBFloat16(lowNaN))));
+
+	for (uint32_t bits = 0; bits <= 0xFFFF; bits++)
+	{
+		const float value = vectorsBFloat16ToFloat((uint16_t)bits);
+		if (std::isnan(value))
+		{
+			continue;
+		};
+		EXPECT_EQ(vectorsFloatToBFloat16(value), bits) << "bits " << bits;
+	};
+};
+TEST(Quantization, WideProductsHalf)
+{
+	checkWideProducts<1, half>();
+	checkWideProducts<7, half>();
+	checkWideProducts<16, half>();
+	checkWideProducts<33, half>();
+	checkWideProducts<100, half>();
+};
+TEST(Quantization, WideProductsBFloat16)
+{
+	checkWideProducts<1, bfloat16>();
+	checkWideProducts<7, bfloat16>();
+	checkWideProducts<16, bfloat16>();
+	checkWideProducts<33, bfloat16>();
+	checkWideProducts<100, bfloat16>();
+};
+TEST(Quantization, WideDotIsNotRounded)
+{
+	// 256 * 100 * 100 is far past the largest half, but exact in float.
+	Vector<256, half> A;
+	for (uint64_t i = 0; i < 256; i++)
+	{
+		A.value[i] = half(100.0f);
+	};
+	forEachISA([&](const VectorsISA&) {
+		EXPECT_EQ(wideDot(A, A), 2560000.0f);
+		EXPECT_EQ(wideSquaredDistance(A, A), 0.0f);
+	});
+};
+TEST(Quantization, QuantizedProducts)
+{
+	// Lengths either side of each kernel's register and of a 64 byte VNNI step.
+	checkQuantized<1>();
+	checkQuantized<7>();
+	checkQuantized<16>();
+	checkQuantized<31>();
+	checkQuantized<64>();
+	checkQuantized<65>();
+	checkQuantized<130>();
+};
+TEST(Quantization, ByteDotAtExtremes)
+{
+	// -127 and 127 everywhere, whose products the VNNI bias must not overflow.
+	const size_t n = 200;
+	std::vector<int8_t> A(n), B(n);
+	int32_t expected = 0;
+	for (size_t i = 0; i < n; i++)
+	{
+		A[i] = (int8_t)(((i % 3) == 0) ? -127 : 127);
+		B[i] = (int8_t)(((i % 5) == 0) ? 127 : -127);
+		expected += ((int32_t)A[i] * (int32_t)B[i]);
+	};
+	forEachISA([&](const VectorsISA&) {
+		for (size_t length = 0; length <= n; length += 13)
+		{
+			int32_t partial = 0;
+			for (size_t i = 0; i < length; i++)
+			{
+				partial += ((int32_t)A[i] * (int32_t)B[i]);
+			};
+			EXPECT_EQ(vectorsDispatch<VectorQuantDot>((const int8_t*)A.data(), (const int8_t*)B.data(), length), partial) << length << " bytes";
+		};
+		EXPECT_EQ(vectorsDispatch<VectorQuantDot>((const int8_t*)A.data(), (const int8_t*)B.data(), n), expected);
+	});
+};
+TEST(Quantization, ConstantVector)
+{
+	// A zero range gives a zero scale, and the vector comes back exactly.
+	Vector<20, float> a;
+	for (uint64_t i = 0; i < 20; i++)
+	{
+		a.value[i] = 1.5f;
+	};
+	const QuantizedVector<20> A(a);
+	EXPECT_EQ(A.scale, 0.0f);
+	EXPECT_EQ(A.dequantize(), a);
+	EXPECT_EQ(A.squaredDistance(A), 0.0f);
+	EXPECT_NEAR(A.dot(a), 45.0f, 1e-5f);
+};
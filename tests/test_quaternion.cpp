@@ -0,0 +1,91 @@
+/*
+	# Vector Template Library - Quaternion Tests
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	The batched quaternion operations on every instruction set against the
+	scalar methods, and the scalar methods against matrices.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+/* Deps */
+#include "vectors_test.h"
+#include "vectors_quaternion.h"
+
+/* Helpers */
+template <typename T>
+static std::vector<Quaternion<T>> randomRotations(const size_t& n, const uint32_t& seed)
+{
+	std::vector<Quaternion<T>> rotations;
+	for (const Vector4D<T>& v : randomVectors<Vector4D<T>>(n, seed))
+	{
+		rotations.push_back(Quaternion<T>(v + Vector4D<T>((T)0.01, (T)0.01, (T)0.01, (T)0.01)).unitNormal());
+	};
+	return rotations;
+};
+
+static const size_t quaternionSizes[] = { 0, 1, 3, 15, 16, 17, 33, 100 };
+
+template <typename T>
+static void checkBatches()
+{
+	const double tolerance = std::is_same<T, float>::value ? 1e-5 : 1e-12;
+	forEachISA([&](const VectorsISA&) {
+		for (const size_t n : quaternionSizes)
+		{
+			SCOPED_TRACE(::testing::Message() << n << " quaternions");
+			const std::vector<Quaternion<T>> A = randomRotations<T>(n, 1), B = randomRotations<T>(n, 2);
+			const std::vector<Vector3D<T>> V = randomVectors<Vector3D<T>>(n, 3, 10.0f);
+			std::vector<T> t(n);
+			for (size_t i = 0; i < n; i++)
+			{
+				t[i] = (T)i / (T)(n + 1);
+			};
+
+			std::vector<Vector3D<T>> rotated(n), single(n);
+			std::vector<Quaternion<T>> nlerped(n), slerped(n), fixed(n);
+			batchRotate(A.data(), V.data(), rotated.data(), n);
+			if (n > 0)
+			{
+				batchRotate(A[0], V.data(), single.data(), n);
+			};
+			batchNlerp(A.data(), B.data(), t.data(), nlerped.data(), n);
+			batchSlerp(A.data(), B.data(), t.data(), slerped.data(), n);
+			batchSlerp(A.data(), B.data(), (T)0.3, fixed.data(), n);
+			for (size_t i = 0; i < n; i++)
+			{
+				expectNear(rotated[i].value, A[i].rotate(V[i]).value, (tolerance * 10));
+				expectNear(single[i].value, A[0].rotate(V[i]).value, (tolerance * 10));
+				expectNear(nlerped[i].value, nlerp(A[i], B[i], t[i]).value, tolerance);
+				expectNear(slerped[i].value, slerp(A[i], B[i], t[i]).value, 2e-6);
+				expectNear(fixed[i].value, slerp(A[i], B[i], (T)0.3).value, 2e-6);
+			};
+		};
+	});
+};
+
+/* Tests */
+TEST(Quaternion, BatchesFloat)
+{
+	checkBatches<float>();
+};
+TEST(Quaternion, BatchesDouble)
+{
+	checkBatches<double>();
+};
+TEST(Quaternion, MatchesMatrices)
+{
+	for (const Quaternion<double>& q : randomRotations<double>(20, 4))
+	{
+		const Matrix3<double> M = q.toMatrix3();
+		const Quaternion<double> back = Quaternion<double>::fromMatrix(M);
+		EXPECT_NEAR(std::fabs(back.dot(q)), 1.0, 1e-12);
+		for (const Vector3D<double>& v : randomVectors<Vector3D<double>>(5, 5))
+		{
+			expectNear(q.rotate(v).value, (M * v).value, 1e-12);
+			expectNear((q * q.inverse()).rotate(v).value, v.value, 1e-12);
+		};
+	};
+};
@@ -0,0 +1,68 @@
+/*
+	# Vector Template Library - Reduction Tests
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	Checks the sums of each reduction policy against sums in long double, over
+	lengths either side of the block size, and with enough blocks that the
+	pairwise policy needs many levels.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+/* Deps */
+#include "vectors_test.h"
+#include "vectors_reduce.h"
+#include <cmath>
+#include <limits>
+
+/* Helpers */
+static const size_t reductionSizes[] = { 0, 1, 15, 16, 17, 255, 256, 257, 511, 512, 513, 4095, 65536, 65537, 1000003 };
+
+template <typename Reduction>
+static void checkSums()
+{
+	for (const size_t n : reductionSizes)
+	{
+		SCOPED_TRACE(::testing::Message() << n << " terms");
+		std::vector<float> A(n);
+		uint32_t state = (uint32_t)(n + 1);
+		long double sum = 0.0L;
+		long double magnitude = 0.0L;
+		for (size_t i = 0; i < n; i++)
+		{
+			A[i] = randomUnit(state);
+			sum += A[i];
+			magnitude += std::fabs(A[i]);
+		};
+		const double tolerance = ((double)magnitude * std::numeric_limits<float>::epsilon() * 2.0 * (std::log2((double)n + 1.0) + 1.0));
+		EXPECT_NEAR((double)vectorsSum<Reduction>(A.data(), n), (double)sum, tolerance);
+	};
+};
+
+/* Tests */
+TEST(Reduction, SumsFast)
+{
+	checkSums<VectorsFastReduction>();
+};
+TEST(Reduction, SumsPairwise)
+{
+	checkSums<VectorsPairwiseReduction>();
+};
+TEST(Reduction, SumsKahan)
+{
+	checkSums<VectorsKahanReduction>();
+};
+TEST(Reduction, SumsDouble)
+{
+	checkSums<VectorsDoubleReduction>();
+};
+TEST(Reduction, PairwiseExactOverManyLevels)
+{
+	// 2^24 + 256 ones, 65537 blocks needing 17 levels, whose partial sums are all
+	// exact in float.
+	const size_t n = (((size_t)1 << 24) + 256);
+	const std::vector<float> ones(n, 1.0f);
+	EXPECT_EQ(vectorsSum<VectorsPairwiseReduction>(ones.data(), n), (float)n);
+};
@@ -0,0 +1,109 @@
+/*
+	# Vector Template Library - Structure of Arrays Tests
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	Checks the bulk operators of VectorSoA against the vector types, with
+	operands which alias each other, and that the padding past size() stays zero.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+/* Deps */
+#include "vectors_test.h"
+#include "vectors_soa.h"
+#include <limits>
+#include <utility>
+
+/* Helpers */
+template <uint64_t N, typename T>
+static void expectZeroPadding(const VectorSoA<N, T>& A)
+{
+	for (uint64_t c = 0; c < N; c++)
+	{
+		for (size_t i = A.size(); i < A.paddedSize(); i++)
+		{
+			EXPECT_EQ(A.component(c)[i], T()) << "component " << c << ", element " << i;
+		};
+	};
+};
+
+/* Tests */
+TEST(VectorSoA, AddsAliased)
+{
+	const std::vector<Vector3D<float>> source = randomVectors<Vector3D<float>>(37, 1);
+	VectorSoA<3, float> A(source.data(), source.size());
+	ASSERT_TRUE(A.add(A));
+	for (size_t i = 0; i < source.size(); i++)
+	{
+		EXPECT_EQ(std::as_const(A)[i], (source[i] + source[i]));
+	};
+};
+TEST(VectorSoA, AddRejectsSizeMismatch)
+{
+	const std::vector<Vector3D<float>> source = randomVectors<Vector3D<float>>(37, 1);
+	VectorSoA<3, float> A(source.data(), source.size());
+	const VectorSoA<3, float> B(source.data(), 20);
+	EXPECT_FALSE(A.add(B));
+	for (size_t i = 0; i < source.size(); i++)
+	{
+		EXPECT_EQ(std::as_const(A)[i], source[i]);
+	};
+};
+TEST(VectorSoA, DotAndCrossRejectSizeMismatch)
+{
+	const std::vector<Vector3D<float>> source = randomVectors<Vector3D<float>>(37, 1);
+	const VectorSoA<3, float> A(source.data(), source.size());
+	const VectorSoA<3, float> B(source.data(), 20);
+	std::vector<float> out(source.size(), -1.0f);
+	EXPECT_FALSE(A.dot(B, out.data()));
+	EXPECT_FALSE(B.dot(A, out.data()));
+	EXPECT_EQ(out, std::vector<float>(source.size(), -1.0f));
+
+	VectorSoA<3, float> crossed(B);
+	EXPECT_FALSE(A.cross(B, crossed));
+	EXPECT_FALSE(B.cross(A, crossed));
+	ASSERT_EQ(crossed.size(), 20u);
+	for (size_t i = 0; i < crossed.size(); i++)
+	{
+		EXPECT_EQ(std::as_const(crossed)[i], source[i]);
+	};
+	EXPECT_TRUE(A.dot(A, out.data()));
+	EXPECT_TRUE(A.cross(A, crossed));
+};
+TEST(VectorSoA, CrossesAliased)
+{
+	const std::vector<Vector3D<double>> a = randomVectors<Vector3D<double>>(45, 2), b = randomVectors<Vector3D<double>>(45, 3);
+	const VectorSoA<3, double> B(b.data(), b.size());
+	VectorSoA<3, double> A(a.data(), a.size());
+	ASSERT_TRUE(A.cross(B, A));
+	for (size_t i = 0; i < a.size(); i++)
+	{
+		EXPECT_EQ(std::as_const(A)[i], a[i].cross(b[i]));
+	};
+
+	VectorSoA<3, double> C(a.data(), a.size());
+	VectorSoA<3, double> D(b.data(), b.size());
+	ASSERT_TRUE(C.cross(D, D));
+	for (size_t i = 0; i < a.size(); i++)
+	{
+		EXPECT_EQ(std::as_const(D)[i], a[i].cross(b[i]));
+	};
+};
+TEST(VectorSoA, ScaleKeepsPaddingZero)
+{
+	const std::vector<Vector4D<float>> source = randomVectors<Vector4D<float>>(21, 4);
+	VectorSoA<4, float> A(source.data(), source.size());
+	A.scale(std::numeric_limits<float>::infinity());
+	expectZeroPadding(A);
+	A.scale(std::numeric_limits<float>::quiet_NaN());
+	expectZeroPadding(A);
+
+	// Growing into the padding must give zero elements.
+	A.resize(30);
+	for (size_t i = source.size(); i < A.size(); i++)
+	{
+		EXPECT_EQ(std::as_const(A)[i], Vector4D<float>());
+	};
+};
@@ -0,0 +1,275 @@
+/*
+	# Vector Template Library - Span Overload Tests
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	Calls each std::span overload the way it's written in practice, with the
+	std::span<V> of std::span(vector), as well as with spans over const vectors,
+	and checks it does the same as the pointer form. Built as C++20, where the
+	span overloads exist.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+/* Deps */
+#include "vectors_test.h"
+#include "vectors_batch.h"
+#include "vectors_matrix.h"
+#include "vectors_quaternion.h"
+#include "vectors_parallel.h"
+#include "vectors_sparse.h"
+#include <array>
+#include <span>
+
+/* Tests */
+#if defined(__cpp_lib_span)
+TEST(SpanOverloads, Batch)
+{
+	std::vector<Vector3D<float>> A = randomVectors<Vector3D<float>>(37, 1), B = randomVectors<Vector3D<float>>(37, 2);
+	const std::vector<Vector3D<float>> constant = A;
+	std::vector<float> out(A.size()), expected(A.size());
+	std::vector<Vector3D<float>> crossed(A.size()), expectedCross(A.size());
+
+	batchDot(std::span(A), std::span(B), std::span(out));
+	batchDot(A.data(), B.data(), expected.data(), A.size());
+	EXPECT_EQ(out, expected);
+	batchDot(std::span(constant), std::span<const Vector3D<float>>(B), std::span(out));
+	EXPECT_EQ(out, expected);
+
+	batchNorm(std::span(A), std::span(out));
+	batchNorm(A.data(), expected.data(), A.size());
+	EXPECT_EQ(out, expected);
+	batchNorm(std::span(constant), std::span(out));
+	EXPECT_EQ(out, expected);
+
+	batchCross(std::span(A), std::span(constant), std::span(crossed));
+	batchCross(A.data(), constant.data(), expectedCross.data(), A.size());
+	EXPECT_EQ(crossed, expectedCross);
+
+	const Vector3D<float> sum = batchSum(std::span(A));
+	EXPECT_EQ(sum, batchSum(std::span(constant)));
+	EXPECT_EQ(sum, batchSum(A.data(), A.size()));
+
+	Vector3D<float> lower, upper;
+	EXPECT_TRUE(batchBounds(std::span(constant), lower, upper));
+	EXPECT_TRUE(batchBounds(std::span(A), lower, upper));
+
+	std::vector<Vector3D<float>> Y = B, expectedY = B;
+	batchAxpy(2.0f, std::span(A), std::span(Y));
+	batchAxpy(2.0f, A.data(), expectedY.data(), A.size());
+	EXPECT_EQ(Y, expectedY);
+	batchAxpy(2.0f, std::span(constant), std::span(Y));
+
+	// Spans of different sizes are rejected without writing anything.
+	const std::vector<float> before = out;
+	const std::vector<Vector3D<float>> beforeY = Y;
+	EXPECT_FALSE(batchDot(std::span(A), std::span(B).first(10), std::span(out)));
+	EXPECT_FALSE(batchDot(std::span(A), std::span(B), std::span(out).first(10)));
+	EXPECT_FALSE(batchNorm(std::span(A), std::span(out).first(10)));
+	EXPECT_FALSE(batchCross(std::span(A).first(10), std::span(B), std::span(crossed)));
+	EXPECT_FALSE(batchAxpy(2.0f, std::span(A), std::span(Y).first(10)));
+	EXPECT_EQ(out, before);
+	EXPECT_EQ(Y, beforeY);
+	EXPECT_TRUE(batchNorm(std::span(A).first(10), std::span(out).first(10)));
+
+	std::array<Vector4D<double>, 5> fixed = {};
+	fixed[0] = Vector4D<double>(3.0, 4.0, 0.0, 0.0);
+	batchNormalize(std::span(fixed));
+	EXPECT_NEAR(fixed[0][0], 0.6, 1e-15);
+	EXPECT_NEAR(fixed[0][1], 0.8, 1e-15);
+	std::array<double, 5> norms;
+	batchNorm(std::span(fixed), std::span(norms));
+	EXPECT_NEAR(norms[0], 1.0, 1e-15);
+};
+TEST(SpanOverloads, Matrix)
+{
+	const Matrix4<float> M = Matrix4<float>::translation(Vector3D<float>(1.0f, 2.0f, 3.0f)) * Matrix4<float>::rotation(Vector3D<float>(0.0f, 0.0f, 1.0f), 0.5f);
+	const Matrix3<float> linear = M.linear();
+	std::vector<Vector3D<float>> A = randomVectors<Vector3D<float>>(19, 3);
+	const std::vector<Vector3D<float>> constant = A;
+	std::vector<Vector3D<float>> out(A.size()), expected(A.size());
+	std::vector<Vector4D<float>> A4(A.size()), out4(A.size()), expected4(A.size());
+	for (size_t i = 0; i < A.size(); i++) { A4[i] = Vector4D<float>(A[i].x(), A[i].y(), A[i].z(), 1.0f); };
+
+	transformPoints(M, std::span(constant), std::span(out));
+	transformPoints(M, constant.data(), expected.data(), A.size());
+	EXPECT_EQ(out, expected);
+	transformPoints(M, std::span(A), std::span(out));
+	EXPECT_EQ(out, expected);
+	out = A;
+	transformPoints(M, std::span(out));
+	EXPECT_EQ(out, expected);
+
+	transformDirections(M, std::span(A), std::span(out));
+	transformDirections(M, A.data(), expected.data(), A.size());
+	EXPECT_EQ(out, expected);
+	out = A;
+	transformDirections(M, std::span(out));
+	EXPECT_EQ(out, expected);
+
+	transformVectors(linear, std::span(constant), std::span(out));
+	transformVectors(linear, A.data(), expected.data(), A.size());
+	EXPECT_EQ(out, expected);
+	out = A;
+	transformVectors(linear, std::span(out));
+	EXPECT_EQ(out, expected);
+
+	transformVectors(M, std::span(A4), std::span(out4));
+	transformVectors(M, A4.data(), expected4.data(), A4.size());
+	EXPECT_EQ(out4, expected4);
+	transformVectors(M, std::span(A4));
+	EXPECT_EQ(A4, expected4);
+
+	// A result span of a different size is rejected without writing anything.
+	out = A;
+	EXPECT_FALSE(transformPoints(M, std::span(constant), std::span(out).first(5)));
+	EXPECT_FALSE(transformDirections(M, std::span(constant).first(5), std::span(out)));
+	EXPECT_FALSE(transformVectors(linear, std::span(constant), std::span(out).first(5)));
+	EXPECT_FALSE(transformVectors(M, std::span(A4).first(5), std::span(out4)));
+	EXPECT_EQ(out, A);
+	EXPECT_TRUE(transformPoints(M, std::span(constant).first(5), std::span(out).first(5)));
+};
+TEST(SpanOverloads, Quaternion)
+{
+	std::vector<Quaternion<float>> A, B;
+	for (const Vector4D<float>& v : randomVectors<Vector4D<float>>(23, 4)) { A.push_back(Quaternion<float>(v).unitNormal()); };
+	for (const Vector4D<float>& v : randomVectors<Vector4D<float>>(23, 5)) { B.push_back(Quaternion<float>(v).unitNormal()); };
+	const std::vector<Quaternion<float>> constant = A;
+	std::vector<float> t(A.size());
+	for (size_t i = 0; i < t.size(); i++) { t[i] = (float)i / (float)t.size(); };
+	std::vector<Vector3D<float>> V = randomVectors<Vector3D<float>>(A.size(), 6), rotated(A.size()), expected(A.size());
+	std::vector<Quaternion<float>> out(A.size()), expectedOut(A.size());
+
+	batchRotate(std::span(A), std::span(V), std::span(rotated));
+	batchRotate(A.data(), V.data(), expected.data(), A.size());
+	EXPECT_EQ(rotated, expected);
+	batchRotate(std::span(constant), std::span(V), std::span(rotated));
+	EXPECT_EQ(rotated, expected);
+	rotated = V;
+	batchRotate(A[0], std::span(rotated));
+	batchRotate(A[0], V.data(), expected.data(), V.size());
+	EXPECT_EQ(rotated, expected);
+
+	batchNlerp(std::span(A), std::span(constant), std::span(t), std::span(out));
+	batchNlerp(A.data(), constant.data(), t.data(), expectedOut.data(), A.size());
+	EXPECT_EQ(out, expectedOut);
+	batchNlerp(std::span(A), std::span(B), 0.25f, std::span(out));
+	batchNlerp(A.data(), B.data(), 0.25f, expectedOut.data(), A.size());
+	EXPECT_EQ(out, expectedOut);
+
+	batchSlerp(std::span(constant), std::span(B), std::span(t), std::span(out));
+	batchSlerp(constant.data(), B.data(), t.data(), expectedOut.data(), A.size());
+	EXPECT_EQ(out, expectedOut);
+	batchSlerp(std::span(A), std::span(B), 0.25f, std::span(out));
+	batchSlerp(A.data(), B.data(), 0.25f, expectedOut.data(), A.size());
+	EXPECT_EQ(out, expectedOut);
+
+	// Spans of different sizes are rejected without writing anything.
+	EXPECT_FALSE(batchRotate(std::span(A).first(5), std::span(V), std::span(rotated)));
+	EXPECT_FALSE(batchNlerp(std::span(A), std::span(B), std::span(t).first(5), std::span(out)));
+	EXPECT_FALSE(batchNlerp(std::span(A), std::span(B).first(5), 0.25f, std::span(out)));
+	EXPECT_FALSE(batchSlerp(std::span(A), std::span(B), std::span(t), std::span(out).first(5)));
+	EXPECT_FALSE(batchSlerp(std::span(A).first(5), std::span(B), 0.25f, std::span(out)));
+	EXPECT_EQ(out, expectedOut);
+};
+TEST(SpanOverloads, Parallel)
+{
+	// The policy overloads are the same templates for every policy, so small
+	// sequenced chunks cover them without starting the thread pool.
+	const VectorsSequencedPolicy policy = vectorsSeq.withChunk(64);
+	std::vector<Vector3D<float>> A = randomVectors<Vector3D<float>>(5000, 7), B = randomVectors<Vector3D<float>>(5000, 8);
+	const std::vector<Vector3D<float>> constant = A;
+	std::vector<float> out(A.size()), expected(A.size());
+	std::vector<Vector3D<float>> crossed(A.size()), expectedCross(A.size());
+
+	batchDot(policy, std::span(A), std::span(B), std::span(out));
+	batchDot(policy, A.data(), B.data(), expected.data(), A.size());
+	EXPECT_EQ(out, expected);
+	batchNorm(policy, std::span(constant), std::span(out));
+	batchNorm(policy, constant.data(), expected.data(), A.size());
+	EXPECT_EQ(out, expected);
+	batchCross(policy, std::span(constant), std::span(B), std::span(crossed));
+	batchCross(policy, constant.data(), B.data(), expectedCross.data(), A.size());
+	EXPECT_EQ(crossed, expectedCross);
+
+	EXPECT_EQ(batchSum(policy, std::span(A)), batchSum(policy, A.data(), A.size()));
+	Vector3D<float> lower, upper, expectedLower, expectedUpper;
+	EXPECT_TRUE(batchBounds(policy, std::span(constant), lower, upper));
+	EXPECT_TRUE(batchBounds(policy, A.data(), A.size(), expectedLower, expectedUpper));
+	EXPECT_EQ(lower, expectedLower);
+	EXPECT_EQ(upper, expectedUpper);
+
+	std::vector<Vector3D<float>> Y = B, expectedY = B;
+	batchAxpy(policy, 2.0f, std::span(A), std::span(Y));
+	batchAxpy(policy, 2.0f, A.data(), expectedY.data(), A.size());
+	EXPECT_EQ(Y, expectedY);
+
+	const Matrix4<float> M = Matrix4<float>::translation(Vector3D<float>(1.0f, 2.0f, 3.0f));
+	transformPoints(policy, M, std::span(constant), std::span(crossed));
+	transformPoints(policy, M, constant.data(), expectedCross.data(), A.size());
+	EXPECT_EQ(crossed, expectedCross);
+	transformPoints(policy, M, std::span(A));
+	EXPECT_EQ(A, expectedCross);
+	transformDirections(policy, M, std::span(B), std::span(crossed));
+	transformDirections(policy, M, B.data(), expectedCross.data(), B.size());
+	EXPECT_EQ(crossed, expectedCross);
+	transformDirections(policy, M, std::span(B));
+	transformVectors(policy, M.linear(), std::span(B), std::span(crossed));
+	transformVectors(policy, M.linear(), std::span(B));
+	EXPECT_EQ(B, crossed);
+
+	std::vector<Vector4D<float>> A4 = randomVectors<Vector4D<float>>(3000, 9), out4(A4.size());
+	transformVectors(policy, M, std::span(A4), std::span(out4));
+	transformVectors(policy, M, std::span(A4));
+	EXPECT_EQ(A4, out4);
+	batchNormalize(policy, std::span(A4));
+
+	// Spans of different sizes are rejected without writing anything.
+	const std::vector<float> before = out;
+	EXPECT_FALSE(batchDot(policy, std::span(A), std::span(B).first(10), std::span(out)));
+	EXPECT_FALSE(batchNorm(policy, std::span(A), std::span(out).first(10)));
+	EXPECT_FALSE(batchCross(policy, std::span(A), std::span(B), std::span(crossed).first(10)));
+	EXPECT_FALSE(batchAxpy(policy, 2.0f, std::span(A).first(10), std::span(Y)));
+	EXPECT_FALSE(transformPoints(policy, M, std::span(A), std::span(crossed).first(10)));
+	EXPECT_FALSE(transformDirections(policy, M, std::span(A), std::span(crossed).first(10)));
+	EXPECT_FALSE(transformVectors(policy, M.linear(), std::span(A).first(10), std::span(crossed)));
+	EXPECT_FALSE(transformVectors(policy, M, std::span(A4), std::span(out4).first(10)));
+	EXPECT_EQ(out, before);
+	EXPECT_EQ(Y, expectedY);
+};
+TEST(SpanOverloads, Sparse)
+{
+	const size_t dimensions = 40, columns = 3;
+	std::vector<float> dense(dimensions), M(dimensions * columns);
+	for (size_t i = 0; i < M.size(); i++) { M[i] = (float)(i % 7) - 3.0f; };
+	std::vector<SparseVector<float>> A;
+	for (size_t k = 0; k < 9; k++)
+	{
+		for (size_t i = 0; i < dimensions; i++) { dense[i] = (((i + k) % 4) == 0) ? (float)(i + 1) : 0.0f; };
+		A.push_back(SparseVector<float>(dense.data(), dimensions));
+	};
+	const std::vector<SparseVector<float>> constant = A;
+	std::vector<float> out(A.size()), expected(A.size()), scores(A.size() * columns), expectedScores(A.size() * columns);
+
+	batchDot(std::span(A), M.data(), std::span(out));
+	batchDot(A.data(), M.data(), expected.data(), A.size());
+	EXPECT_EQ(out, expected);
+	batchDot(std::span(constant), dense.data(), std::span(out));
+	batchDot(constant.data(), dense.data(), expected.data(), A.size());
+	EXPECT_EQ(out, expected);
+
+	batchScore(std::span(A), M.data(), columns, std::span(scores));
+	batchScore(A.data(), A.size(), M.data(), columns, expectedScores.data());
+	EXPECT_EQ(scores, expectedScores);
+	batchScore(std::span(constant), (const float*)M.data(), columns, std::span(scores));
+	EXPECT_EQ(scores, expectedScores);
+
+	// Results spans of the wrong size are rejected without writing anything.
+	EXPECT_FALSE(batchDot(std::span(A), M.data(), std::span(out).first(3)));
+	EXPECT_FALSE(batchScore(std::span(A), M.data(), columns, std::span(scores).first(A.size())));
+	EXPECT_FALSE(batchScore(std::span(A).first(3), M.data(), columns, std::span(scores)));
+	EXPECT_EQ(out, expected);
+	EXPECT_EQ(scores, expectedScores);
+};
+#endif
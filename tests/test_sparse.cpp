@@ -0,0 +1,65 @@
+/*
+	# Vector Template Library - Sparse Vector Tests
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	Checks the merging operators of SparseVector against dense arithmetic, and
+	at the largest index a sparse vector can store.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+/* Deps */
+#include "vectors_test.h"
+#include "vectors_sparse.h"
+
+/* Tests */
+TEST(SparseVector, MergesMatchDense)
+{
+	const size_t dimensions = 64;
+	uint32_t state = 1;
+	for (size_t trial = 0; trial < 100; trial++)
+	{
+		std::vector<float> a(dimensions), b(dimensions), sum(dimensions), difference(dimensions);
+		for (size_t i = 0; i < dimensions; i++)
+		{
+			a[i] = (randomUnit(state) < -0.2f) ? (float)(i + 1) : 0.0f;
+			b[i] = (randomUnit(state) < -0.2f) ? (float)(2 * i + 1) : 0.0f;
+			sum[i] = (a[i] + b[i]);
+			difference[i] = (a[i] - b[i]);
+		};
+		const SparseVector<float> A(a.data(), dimensions), B(b.data(), dimensions);
+		EXPECT_EQ((A + B), SparseVector<float>(sum.data(), dimensions));
+		EXPECT_EQ((A - B), SparseVector<float>(difference.data(), dimensions));
+		EXPECT_EQ((A == B), (a == b));
+	};
+};
+TEST(SparseVector, MergesAtLastIndex)
+{
+	const size_t dimensions = ((size_t)UINT32_MAX + 1);
+	const uint32_t first[] = { 5 };
+	const uint32_t last[] = { 5, UINT32_MAX };
+	const float twos[] = { 2.0f, 2.0f };
+	const SparseVector<float> B(dimensions, last, twos, 2), C(dimensions, (last + 1), twos, 1);
+
+	// A keeps a stale element past its end, which a merge running off the end of
+	// A would pick up.
+	SparseVector<float> A(dimensions);
+	A.append(first[0], 1.0f);
+	A.append(6, 7.0f);
+	A.clear();
+	A.append(first[0], 1.0f);
+
+	const SparseVector<float> sum = (A + B);
+	ASSERT_EQ(sum.nonZeros(), 2u);
+	EXPECT_EQ(sum[5], 3.0f);
+	EXPECT_EQ(sum[UINT32_MAX], 2.0f);
+	const SparseVector<float> difference = (C - A);
+	ASSERT_EQ(difference.nonZeros(), 2u);
+	EXPECT_EQ(difference[5], -1.0f);
+	EXPECT_EQ(difference[UINT32_MAX], 2.0f);
+	EXPECT_NE(A, B);
+	EXPECT_EQ(B, B);
+	EXPECT_EQ((B + C)[UINT32_MAX], 4.0f);
+};
@@ -0,0 +1,274 @@
+/*
+	# Vector Template Library - Spatial Index Tests
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	The queries of KdTree3 and Bvh3 against brute force over the same points.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+/* Deps */
+#include "vectors_test.h"
+#include "vectors_spatial.h"
+#include <algorithm>
+#include <utility>
+
+/* Helpers */
+typedef Vector3D<float> Point;
+
+static std::vector<VectorNeighbour<float>> bruteNearest(const std::vector<Point>& points, const Point& query, const size_t& k)
+{
+	std::vector<VectorNeighbour<float>> all;
+	for (size_t i = 0; i < points.size(); i++)
+	{
+		all.push_back(VectorNeighbour<float>{ i, vectorsSquaredDistance(query, points[i]) });
+	};
+	std::sort(all.begin(), all.end(), [](const VectorNeighbour<float>& A, const VectorNeighbour<float>& B) {
+		return (A.distance < B.distance) || ((A.distance == B.distance) && (A.id < B.id));
+	});
+	all.resize(std::min(k, all.size()));
+	return all;
+};
+static std::vector<uint64_t> bruteRadius(const std::vector<Point>& points, const Point& center, const float& radius)
+{
+	std::vector<uint64_t> ids;
+	for (size_t i = 0; i < points.size(); i++)
+	{
+		if (vectorsSquaredDistance(center, points[i]) <= (radius * radius))
+		{
+			ids.push_back(i);
+		};
+	};
+	return ids;
+};
+static std::vector<uint64_t> bruteBox(const std::vector<Point>& points, const Box3<float>& box)
+{
+	std::vector<uint64_t> ids;
+	for (size_t i = 0; i < points.size(); i++)
+	{
+		if (box.contains(points[i]))
+		{
+			ids.push_back(i);
+		};
+	};
+	return ids;
+};
+static std::vector<uint64_t> sortedIds(const VectorNeighbour<float>* first, const VectorNeighbour<float>* last)
+{
+	std::vector<uint64_t> ids;
+	for (; first != last; first++)
+	{
+		ids.push_back(first->id);
+	};
+	std::sort(ids.begin(), ids.end());
+	return ids;
+};
+static std::vector<uint64_t> sortedIds(std::vector<uint64_t> ids)
+{
+	std::sort(ids.begin(), ids.end());
+	return ids;
+};
+static Box3<float> boxAround(const Point& center, const float& size)
+{
+	return Box3<float>(center - Point(size, size, size), center + Point(size, size, size));
+};
+
+template <typename Index>
+static void checkNearest(const Index& index, const std::vector<Point>& points, const std::vector<Point>& queries, const size_t& k)
+{
+	std::vector<VectorNeighbour<float>> batched(queries.size() * k);
+	index.nearest(queries.data(), queries.size(), k, batched.data(), 3);
+	for (size_t q = 0; q < queries.size(); q++)
+	{
+		const std::vector<VectorNeighbour<float>> expected = bruteNearest(points, queries[q], k);
+		std::vector<VectorNeighbour<float>> found(k);
+		ASSERT_EQ(index.nearest(queries[q], k, found.data()), expected.size());
+		for (size_t i = 0; i < expected.size(); i++)
+		{
+			EXPECT_EQ(found[i].distance, expected[i].distance) << "query " << q << ", rank " << i;
+			EXPECT_EQ(batched[(q * k) + i].distance, expected[i].distance) << "query " << q << ", rank " << i;
+		};
+	};
+};
+template <typename Index>
+static void checkRadius(const Index& index, const std::vector<Point>& points, const std::vector<Point>& queries, const float& radius)
+{
+	VectorSpatialResults<float> batched;
+	index.withinRadius(queries.data(), queries.size(), radius, batched, 3);
+	for (size_t q = 0; q < queries.size(); q++)
+	{
+		const std::vector<uint64_t> expected = bruteRadius(points, queries[q], radius);
+		std::vector<VectorNeighbour<float>> found;
+		index.withinRadius(queries[q], radius, found);
+		EXPECT_EQ(sortedIds(found.data(), found.data() + found.size()), expected) << "query " << q;
+		EXPECT_EQ(sortedIds(batched.begin(q), batched.end(q)), expected) << "query " << q;
+	};
+};
+
+/* Tests */
+TEST(KdTree3, MatchesBruteForce)
+{
+	for (const size_t n : { (size_t)1, (size_t)7, (size_t)100, (size_t)5000 })
+	{
+		SCOPED_TRACE(::testing::Message() << n << " points");
+		const std::vector<Point> points = randomVectors<Point>(n, 1, 10.0f);
+		const std::vector<Point> queries = randomVectors<Point>(50, 2, 12.0f);
+		const KdTree3<float> tree(points.data(), points.size());
+		checkNearest(tree, points, queries, 1);
+		checkNearest(tree, points, queries, 10);
+		checkRadius(tree, points, queries, 0.5f);
+		checkRadius(tree, points, queries, 3.0f);
+		for (const Point& query : queries)
+		{
+			std::vector<uint64_t> found;
+			tree.withinBox(boxAround(query, 1.5f), found);
+			EXPECT_EQ(sortedIds(found), bruteBox(points, boxAround(query, 1.5f)));
+		};
+	};
+};
+TEST(KdTree3, Duplicates)
+{
+	const std::vector<Point> points(300, Point(1.0f, 2.0f, 3.0f));
+	const KdTree3<float> tree(points.data(), points.size());
+	std::vector<VectorNeighbour<float>> found;
+	EXPECT_EQ(tree.withinRadius(Point(1.0f, 2.0f, 3.0f), 0.0f, found), points.size());
+};
+TEST(Bvh3, PointsMatchBruteForce)
+{
+	for (const size_t n : { (size_t)1, (size_t)7, (size_t)100, (size_t)5000 })
+	{
+		SCOPED_TRACE(::testing::Message() << n << " points");
+		const std::vector<Point> points = randomVectors<Point>(n, 3, 10.0f);
+		const std::vector<Point> queries = randomVectors<Point>(50, 4, 12.0f);
+		const Bvh3<float> bvh(points.data(), points.size());
+		checkNearest(bvh, points, queries, 1);
+		checkNearest(bvh, points, queries, 10);
+		checkRadius(bvh, points, queries, 0.5f);
+		checkRadius(bvh, points, queries, 3.0f);
+	};
+};
+TEST(Bvh3, BoxesMatchBruteForce)
+{
+	const std::vector<Point> centers = randomVectors<Point>(2000, 5, 10.0f);
+	const std::vector<Point> sizes = randomVectors<Point>(2000, 6, 1.0f);
+	std::vector<Box3<float>> boxes;
+	for (size_t i = 0; i < centers.size(); i++)
+	{
+		const Point half(std::fabs(sizes[i][0]), std::fabs(sizes[i][1]), std::fabs(sizes[i][2]));
+		boxes.push_back(Box3<float>(centers[i] - half, centers[i] + half));
+	};
+	const Bvh3<float> bvh(boxes.data(), boxes.size());
+
+	for (const Point& query : randomVectors<Point>(50, 7, 12.0f))
+	{
+		const Box3<float> box = boxAround(query, 1.0f);
+		std::vector<uint64_t> expected, overlapping;
+		std::vector<VectorNeighbour<float>> near;
+		for (size_t i = 0; i < boxes.size(); i++)
+		{
+			if (boxes[i].overlaps(box))
+			{
+				expected.push_back(i);
+			};
+		};
+		bvh.overlapping(box, overlapping);
+		EXPECT_EQ(sortedIds(overlapping), expected);
+
+		expected.clear();
+		for (size_t i = 0; i < boxes.size(); i++)
+		{
+			if (boxes[i].squaredDistance(query) <= 4.0f)
+			{
+				expected.push_back(i);
+			};
+		};
+		bvh.withinRadius(query, 2.0f, near);
+		EXPECT_EQ(sortedIds(near.data(), near.data() + near.size()), expected);
+	};
+};
+
+/* Hash Grid Tests */
+typedef std::vector<std::pair<uint32_t, uint32_t>> PairList;
+
+static PairList brutePairs(const std::vector<Point>& points, const float& radius)
+{
+	PairList pairs;
+	for (uint32_t i = 0; i < (uint32_t)points.size(); i++)
+	{
+		for (uint32_t j = (i + 1); j < (uint32_t)points.size(); j++)
+		{
+			if (vectorsSquaredDistance(points[i], points[j]) <= (radius * radius))
+			{
+				pairs.push_back(std::make_pair(i, j));
+			};
+		};
+	};
+	return pairs;
+};
+static PairList gridPairs(const SpatialHashGrid3<float>& grid, const float& radius, const size_t& threads)
+{
+	PairList pairs;
+	grid.pairs(radius, pairs, threads);
+	std::sort(pairs.begin(), pairs.end());
+	return pairs;
+};
+
+TEST(SpatialHashGrid3, PairsAcrossWrappedRow)
+{
+	// With few points the row wraps around the table, so both cells share a bucket.
+	const std::vector<Point> points = { Point(0.5f, 0.5f, 2.5f), Point(0.5f, 0.5f, 0.5f) };
+	const SpatialHashGrid3<float> grid(1.0f, points.data(), points.size());
+	EXPECT_EQ(gridPairs(grid, 2.5f, 1), brutePairs(points, 2.5f));
+};
+TEST(SpatialHashGrid3, PairsMatchBruteForce)
+{
+	uint32_t state = 11;
+	for (size_t trial = 0; trial < 1000; trial++)
+	{
+		// Mostly thin columns along z, where rows wrap, with some clouds
+		const size_t n = (2 + (size_t)((randomUnit(state) + 0.5f) * 60.0f));
+		const float width = ((trial % 4) == 0) ? 8.0f : 1.0f;
+		const float radius = (0.25f + ((randomUnit(state) + 0.5f) * 4.0f));
+		std::vector<Point> points(n);
+		for (Point& point : points)
+		{
+			point = Point(randomUnit(state) * width, randomUnit(state) * width, randomUnit(state) * 20.0f);
+		};
+		const SpatialHashGrid3<float> grid(1.0f, points.data(), points.size());
+		ASSERT_EQ(gridPairs(grid, radius, 1), brutePairs(points, radius)) << "trial " << trial;
+	};
+};
+TEST(SpatialHashGrid3, PairsAnyThreadCount)
+{
+	const std::vector<Point> points = randomVectors<Point>(20000, 8, 40.0f);
+	const SpatialHashGrid3<float> grid(0.5f, points.data(), points.size());
+	PairList single, many;
+	grid.pairs(0.5f, single, 1);
+	grid.pairs(0.5f, many, 4);
+	EXPECT_EQ(single, many);
+	std::sort(single.begin(), single.end());
+	EXPECT_EQ(single, brutePairs(points, 0.5f));
+};
+TEST(SpatialHashGrid3, WithinRadiusMatchesBruteForce)
+{
+	for (const size_t n : { (size_t)1, (size_t)10, (size_t)3000 })
+	{
+		SCOPED_TRACE(::testing::Message() << n << " points");
+		const std::vector<Point> points = randomVectors<Point>(n, 9, 10.0f);
+		for (const float cellSize : { 0.3f, 1.0f, 4.0f })
+		{
+			const SpatialHashGrid3<float> grid(cellSize, points.data(), points.size());
+			for (const Point& query : randomVectors<Point>(30, 10, 12.0f))
+			{
+				for (const float radius : { 0.0f, 0.7f, 2.5f, 9.0f })
+				{
+					std::vector<VectorNeighbour<float>> found;
+					grid.withinRadius(query, radius, found);
+					EXPECT_EQ(sortedIds(found.data(), found.data() + found.size()), bruteRadius(points, query, radius));
+				};
+			};
+		};
+	};
+};
@@ -0,0 +1,90 @@
+#pragma once
+/*
+	# Vector Template Library - Test Fixtures
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	Helpers shared by the vectors_tests sources: reproducible random inputs, a
+	way to run a check once for every instruction set the batch operations can
+	be dispatched to on the running CPU, and an element-wise comparison within a
+	tolerance.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+#ifndef VECTOR_TEMPLATE_LIBRARY_TEST__H
+#define VECTOR_TEMPLATE_LIBRARY_TEST__H
+/* Deps */
+#include "vectors.h"
+#include "vectors_batch.h"
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <vector>
+
+/* Fixtures */
+inline float randomUnit(uint32_t& state)
+{
+	/*
+		The next value from a linear congruential generator, uniform in [-0.5, 0.5).
+	*/
+
+	state = (state * 1664525u) + 1013904223u;
+	return ((float)(state >> 8) / (float)(1u << 24)) - 0.5f;
+};
+
+template <typename V>
+std::vector<V> randomVectors(const size_t& n, const uint32_t& seed, const float& scale = 1.0f)
+{
+	/*
+		Returns n vectors with elements drawn uniformly from [-scale / 2, scale / 2),
+		from a fixed seed so runs are reproducible.
+	*/
+
+	typedef typename VectorTraits<V>::ElementType T;
+
+	std::vector<V> vectors(n);
+	uint32_t state = seed;
+	for (V& v : vectors)
+	{
+		for (uint64_t i = 0; i < VectorTraits<V>::dimensions; i++)
+		{
+			v.value[i] = (T)(randomUnit(state) * scale);
+		};
+	};
+	return vectors;
+};
+
+template <typename F>
+void forEachISA(const F& f)
+{
+	/*
+		Calls f once for each instruction set the running CPU supports, with batch
+		operations forced to it, and restores automatic selection afterwards.
+	*/
+
+	const VectorsISA detected = vectorsDetectISA();
+	for (int isa = VECTORS_ISA_GENERIC; isa <= (int)detected; isa++)
+	{
+		SCOPED_TRACE(::testing::Message() << "ISA " << isa);
+		vectorsForceISA((VectorsISA)isa);
+		f((VectorsISA)isa);
+	};
+	vectorsResetISA();
+};
+
+template <typename T, size_t N>
+void expectNear(const T (&found)[N], const T (&expected)[N], const double& tolerance)
+{
+	/*
+		Expects each element of found to be within tolerance of the same element of
+		expected, as for the value arrays of two vectors or quaternions.
+	*/
+
+	for (size_t i = 0; i < N; i++)
+	{
+		EXPECT_NEAR((double)found[i], (double)expected[i], tolerance) << "element " << i;
+	};
+};
+
+#endif
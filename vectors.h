@@ -1,7 +1,7 @@
 #pragma once
 /*
 	# Vector Template Library
-	## Version 1.0
+	## Version 1.1
 	## By Joseph Juma
 
 	## About
@@ -19,8 +19,797 @@
 /* Deps */
 #include <stdint.h>
 #include <stdarg.h>
+#include <stdlib.h>
+#include <math.h>
+#include <cmath>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <charconv>
+#include <limits>
 #include <string>
+#include <string_view>
 #include <iostream>
+#include <type_traits>
+#include <utility>
+#if defined(__has_include)
+	#if __has_include(<format>)
+		#include <format>
+	#endif
+#endif
+
+/* SIMD Support */
+#if !defined(VECTORS_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+	#include <immintrin.h>
+	#define VECTORS_SSE 1
+	#if defined(__AVX__)
+		#define VECTORS_AVX 1
+	#endif
+#endif
+#ifndef VECTORS_SSE
+	#define VECTORS_SSE 0
+#endif
+#ifndef VECTORS_AVX
+	#define VECTORS_AVX 0
+#endif
+
+/* Macros */
+#if defined(_MSC_VER)
+	#define VECTORS_RESTRICT __restrict
+#else
+	#define VECTORS_RESTRICT __restrict__
+#endif
+
+template <size_t A, typename T>
+inline T* vectorsAssumeAligned(T* pointer)
+{
+	/*
+		Tells the compiler that pointer is aligned to A bytes, so loops over it can use
+		aligned vector loads and skip the peeling prologue.
+	*/
+
+#if defined(__GNUC__) || defined(__clang__)
+	return (T*)__builtin_assume_aligned(pointer, A);
+#else
+	return pointer;
+#endif
+};
+
+/* Forward Declarations */
+template <typename T> struct Vector2D;
+template <typename T> struct Vector3D;
+template <typename T> struct Vector4D;
+template <uint64_t N, typename T> struct Vector;
+template <typename V> struct VectorTraits;
+
+template <typename T> std::string toString(const Vector2D<T>& value);
+template <typename T> std::string toString(const Vector3D<T>& value);
+template <typename T> std::string toString(const Vector4D<T>& value);
+template <uint64_t N, typename T> std::string toString(const Vector<N, T>& value);
+template <typename V> typename std::enable_if<VectorTraits<V>::isVector, size_t>::type formatTo(char* buffer, const size_t& size, const V& value);
+
+/* Traits */
+template <typename V>
+struct VectorTraits
+{
+	/*
+		# Vector Traits (struct)
+		Describes the dimensions and element type of a vector type, so that code which
+		works over arrays of vectors can be written once for all of them.
+	*/
+
+	static constexpr bool isVector = false;
+};
+template <typename T>
+struct VectorTraits<Vector2D<T>>
+{
+	typedef T ElementType;
+	static constexpr bool isVector = true;
+	static constexpr uint64_t dimensions = 2;
+};
+template <typename T>
+struct VectorTraits<Vector3D<T>>
+{
+	typedef T ElementType;
+	static constexpr bool isVector = true;
+	static constexpr uint64_t dimensions = 3;
+};
+template <typename T>
+struct VectorTraits<Vector4D<T>>
+{
+	typedef T ElementType;
+	static constexpr bool isVector = true;
+	static constexpr uint64_t dimensions = 4;
+};
+template <uint64_t N, typename T>
+struct VectorTraits<Vector<N, T>>
+{
+	typedef T ElementType;
+	static constexpr bool isVector = true;
+	static constexpr uint64_t dimensions = N;
+};
+
+template <typename E>
+struct VectorExpressionTraits
+{
+	/*
+		# Vector Expression Traits (struct)
+		Marks the lazily evaluated expression types from vectors_expr.h, which every
+		vector type can be constructed from and assigned.
+	*/
+
+	static constexpr bool isExpression = false;
+};
+
+/* Unrolling */
+#ifndef VECTORS_UNROLL_LIMIT
+	#define VECTORS_UNROLL_LIMIT 16
+#endif
+
+template <uint64_t N, bool Unrolled = (N <= VECTORS_UNROLL_LIMIT)>
+struct VectorUnroll
+{
+	/*
+		# Vector Unroll (struct)
+		Calls f(i) for every index below N. Up to VECTORS_UNROLL_LIMIT this expands to
+		a fold over an index sequence, so there is no loop for the compiler to keep;
+		past it, it is an ordinary loop which the compiler is free to vectorize.
+	*/
+
+	template <typename F>
+	static constexpr void each(const F& f)
+	{
+		for (uint64_t i = 0; i < N; i++)
+		{
+			f(i);
+		};
+	};
+};
+template <uint64_t N>
+struct VectorUnroll<N, true>
+{
+	template <typename F, size_t... I>
+	static constexpr void each(const F& f, std::index_sequence<I...>)
+	{
+		(f((uint64_t)I), ...);
+	};
+	template <typename F>
+	static constexpr void each(const F& f)
+	{
+		each(f, std::make_index_sequence<(size_t)N>());
+	};
+};
+
+template <typename T, typename... Args>
+struct VectorsAllConvertible
+{
+	static constexpr bool value = (std::is_convertible<Args, T>::value && ...);
+};
+
+template <typename T>
+constexpr T vectorsAbs(const T& x)
+{
+	return (x < T()) ? -x : x;
+};
+
+/* Norm Helpers */
+template <typename T>
+inline T vectorsMultiplyAdd(const T& A, const T& B, const T& C)
+{
+	/*
+		Returns (A * B) + C, as a single fused multiply-add when the target has one in
+		hardware (std::fma is a slow library call otherwise).
+	*/
+
+#if defined(FP_FAST_FMAF)
+	if constexpr (std::is_same<T, float>::value)
+	{
+		return std::fma(A, B, C);
+	};
+#endif
+#if defined(FP_FAST_FMA)
+	if constexpr (std::is_same<T, double>::value)
+	{
+		return std::fma(A, B, C);
+	};
+#endif
+	return ((A * B) + C);
+};
+
+template <typename T>
+constexpr T vectorsIntegerPower(const T& x, uint64_t p)
+{
+	/*
+		x raised to a whole number power by repeated squaring, which is exact for
+		integers and much cheaper than pow() for small p.
+	*/
+
+	T result = (T)1;
+	T base = x;
+	while (p > 0)
+	{
+		if (p & 1)
+		{
+			result *= base;
+		};
+		base *= base;
+		p >>= 1;
+	};
+	return result;
+};
+
+template <typename T>
+inline T vectorsRoot(const T& x, const uint64_t& p)
+{
+	/*
+		The p-th root of x, in the precision of T for floating point types.
+	*/
+
+	if constexpr (std::is_floating_point<T>::value)
+	{
+		return std::pow(x, ((T)1 / (T)p));
+	}
+	else
+	{
+		return (T)std::pow((double)x, (1.0 / (double)p));
+	};
+};
+
+template <typename T>
+inline T vectorsFastInverseSqrt(const T& x)
+{
+	/*
+		An approximation of 1 / sqrt(x). For floats this is the hardware reciprocal
+		square root estimate refined with one Newton-Raphson step, which is accurate
+		to about 23 bits; other types fall back to an exact division.
+	*/
+
+#if VECTORS_SSE
+	if constexpr (std::is_same<T, float>::value)
+	{
+		const __m128 v = _mm_set_ss(x);
+		const __m128 y = _mm_rsqrt_ss(v);
+		const __m128 half = _mm_mul_ss(_mm_set_ss(0.5f), v);
+		const __m128 correction = _mm_sub_ss(_mm_set_ss(1.5f), _mm_mul_ss(half, _mm_mul_ss(y, y)));
+		return _mm_cvtss_f32(_mm_mul_ss(y, correction));
+	};
+#endif
+	return ((T)1 / (T)std::sqrt(x));
+};
+
+template <uint64_t N, typename T>
+struct VectorNorms
+{
+	/*
+		# Vector Norms (struct)
+		The norms shared by every vector type, computed in the precision of T.
+	*/
+
+	static inline T squared(const T* A)
+	{
+		T sum = T();
+		VectorUnroll<N>::each([&](const uint64_t& i) { sum = vectorsMultiplyAdd(A[i], A[i], sum); });
+		return sum;
+	};
+	static constexpr T sumAbs(const T* A)
+	{
+		T sum = T();
+		VectorUnroll<N>::each([&](const uint64_t& i) { sum += vectorsAbs(A[i]); });
+		return sum;
+	};
+	static constexpr T infNorm(const T* A)
+	{
+		T largest = T();
+		VectorUnroll<N>::each([&](const uint64_t& i) {
+			const T a = vectorsAbs(A[i]);
+			largest = (a > largest) ? a : largest;
+		});
+		return largest;
+	};
+	static inline T pNorm(const T* A, const uint64_t& p)
+	{
+		/*
+			The p-norm for a whole number p. 1 and 2 are special cased, and otherwise
+			each element is raised to the power p by repeated multiplication with a
+			single root taken at the end.
+		*/
+
+		if (p == 1)
+		{
+			return sumAbs(A);
+		};
+		if (p == 2)
+		{
+			return (T)std::sqrt(squared(A));
+		};
+
+		T sum = T();
+		VectorUnroll<N>::each([&](const uint64_t& i) { sum += vectorsIntegerPower(vectorsAbs(A[i]), p); });
+		return vectorsRoot(sum, p);
+	};
+};
+
+/* Layout */
+template <typename T, uint64_t N>
+struct VectorLayout
+{
+	/*
+		# Vector Layout (struct)
+		The alignment of the vector types. float and double vectors of 4 or more
+		elements are aligned to 32 bytes when they fill a whole number of AVX
+		registers and to 16 bytes when they fill SSE registers, so the kernels can
+		use aligned loads. It doesn't depend on which instruction sets are enabled,
+		so a vector (and anything containing one) has the same size and alignment
+		in translation units built with different flags.
+	*/
+
+	static constexpr size_t bytes = (N * sizeof(T));
+	static constexpr bool packed = ((std::is_same<T, float>::value || std::is_same<T, double>::value) && (N >= 4));
+	static constexpr size_t alignment = (packed && ((bytes % 32) == 0)) ? 32 : ((packed && ((bytes % 16) == 0)) ? 16 : alignof(T));
+};
+
+/* Kernels */
+template <typename T, uint64_t N>
+struct VectorKernels
+{
+	/*
+		# Vector Kernels (struct)
+		The element-wise arithmetic behind the fixed size vector types. The generic
+		form is plain scalar code; specializations below replace it with SSE/AVX 
+		intrinsics for the common float/double shapes when those are available, and
+		can be switched off by defining VECTORS_NO_SIMD.
+	*/
+
+	static inline void add(const T* A, const T* B, T* C)
+	{
+		for (uint64_t i = 0; i < N; i++) { C[i] = A[i] + B[i]; };
+	};
+	static inline void sub(const T* A, const T* B, T* C)
+	{
+		for (uint64_t i = 0; i < N; i++) { C[i] = A[i] - B[i]; };
+	};
+	static inline void mul(const T* A, const T* B, T* C)
+	{
+		for (uint64_t i = 0; i < N; i++) { C[i] = A[i] * B[i]; };
+	};
+	static inline void div(const T* A, const T* B, T* C)
+	{
+		for (uint64_t i = 0; i < N; i++) { C[i] = A[i] / B[i]; };
+	};
+
+	static inline void addScalar(const T* A, const T& B, T* C)
+	{
+		for (uint64_t i = 0; i < N; i++) { C[i] = A[i] + B; };
+	};
+	static inline void subScalar(const T* A, const T& B, T* C)
+	{
+		for (uint64_t i = 0; i < N; i++) { C[i] = A[i] - B; };
+	};
+	static inline void mulScalar(const T* A, const T& B, T* C)
+	{
+		for (uint64_t i = 0; i < N; i++) { C[i] = A[i] * B; };
+	};
+	static inline void divScalar(const T* A, const T& B, T* C)
+	{
+		for (uint64_t i = 0; i < N; i++) { C[i] = A[i] / B; };
+	};
+
+	static inline T dot(const T* A, const T* B)
+	{
+		T value = T();
+		for (uint64_t i = 0; i < N; i++) { value = vectorsMultiplyAdd(A[i], B[i], value); };
+		return value;
+	};
+	static inline void cross(const T* A, const T* B, T* C)
+	{
+		static_assert(N == 3, "The cross product is only defined for 3 dimensions.");
+		const T c0 = (A[1] * B[2]) - (A[2] * B[1]);
+		const T c1 = (A[2] * B[0]) - (A[0] * B[2]);
+		const T c2 = (A[0] * B[1]) - (A[1] * B[0]);
+		C[0] = c0;
+		C[1] = c1;
+		C[2] = c2;
+	};
+};
+
+#if VECTORS_SSE
+inline float vectorsHorizontalSum(const __m128 v)
+{
+	__m128 shuffled = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+	__m128 sums = _mm_add_ps(v, shuffled);
+	shuffled = _mm_movehl_ps(shuffled, sums);
+	sums = _mm_add_ss(sums, shuffled);
+	return _mm_cvtss_f32(sums);
+};
+
+template <>
+struct VectorKernels<float, 4>
+{
+	/*
+		Four floats fill an SSE register exactly, so each operator is a single
+		load/op/store. The vector is 16 byte aligned so the loads are aligned.
+	*/
+
+	static inline void add(const float* A, const float* B, float* C) { _mm_store_ps(C, _mm_add_ps(_mm_load_ps(A), _mm_load_ps(B))); };
+	static inline void sub(const float* A, const float* B, float* C) { _mm_store_ps(C, _mm_sub_ps(_mm_load_ps(A), _mm_load_ps(B))); };
+	static inline void mul(const float* A, const float* B, float* C) { _mm_store_ps(C, _mm_mul_ps(_mm_load_ps(A), _mm_load_ps(B))); };
+	static inline void div(const float* A, const float* B, float* C) { _mm_store_ps(C, _mm_div_ps(_mm_load_ps(A), _mm_load_ps(B))); };
+
+	static inline void addScalar(const float* A, const float& B, float* C) { _mm_store_ps(C, _mm_add_ps(_mm_load_ps(A), _mm_set1_ps(B))); };
+	static inline void subScalar(const float* A, const float& B, float* C) { _mm_store_ps(C, _mm_sub_ps(_mm_load_ps(A), _mm_set1_ps(B))); };
+	static inline void mulScalar(const float* A, const float& B, float* C) { _mm_store_ps(C, _mm_mul_ps(_mm_load_ps(A), _mm_set1_ps(B))); };
+	static inline void divScalar(const float* A, const float& B, float* C) { _mm_store_ps(C, _mm_div_ps(_mm_load_ps(A), _mm_set1_ps(B))); };
+
+	static inline float dot(const float* A, const float* B)
+	{
+		return vectorsHorizontalSum(_mm_mul_ps(_mm_load_ps(A), _mm_load_ps(B)));
+	};
+};
+
+template <>
+struct VectorKernels<float, 3>
+{
+	/*
+		Three floats are widened into a padded SSE register with a zero fourth lane.
+		The padding lives only in the register, so Vector3D<float> stays 12 bytes.
+	*/
+
+	static inline __m128 load(const float* A)
+	{
+		// __m64 may alias anything, a double load of x and y could be reordered past float stores to them
+		return _mm_movelh_ps(
+			_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)A),
+			_mm_load_ss(A + 2)
+		);
+	};
+	static inline void store(float* C, const __m128 v)
+	{
+		_mm_storel_pi((__m64*)C, v);
+		_mm_store_ss(C + 2, _mm_movehl_ps(v, v));
+	};
+
+	static inline void add(const float* A, const float* B, float* C) { store(C, _mm_add_ps(load(A), load(B))); };
+	static inline void sub(const float* A, const float* B, float* C) { store(C, _mm_sub_ps(load(A), load(B))); };
+	static inline void mul(const float* A, const float* B, float* C) { store(C, _mm_mul_ps(load(A), load(B))); };
+	static inline void div(const float* A, const float* B, float* C) { store(C, _mm_div_ps(load(A), load(B))); };
+
+	static inline void addScalar(const float* A, const float& B, float* C) { store(C, _mm_add_ps(load(A), _mm_set1_ps(B))); };
+	static inline void subScalar(const float* A, const float& B, float* C) { store(C, _mm_sub_ps(load(A), _mm_set1_ps(B))); };
+	static inline void mulScalar(const float* A, const float& B, float* C) { store(C, _mm_mul_ps(load(A), _mm_set1_ps(B))); };
+	static inline void divScalar(const float* A, const float& B, float* C) { store(C, _mm_div_ps(load(A), _mm_set1_ps(B))); };
+
+	static inline float dot(const float* A, const float* B)
+	{
+		return vectorsHorizontalSum(_mm_mul_ps(load(A), load(B)));
+	};
+	static inline void cross(const float* A, const float* B, float* C)
+	{
+		const __m128 a = load(A);
+		const __m128 b = load(B);
+		const __m128 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+		const __m128 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+		const __m128 c = _mm_sub_ps(_mm_mul_ps(a, bYZX), _mm_mul_ps(aYZX, b));
+		store(C, _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1)));
+	};
+};
+#endif
+
+#if VECTORS_AVX
+template <>
+struct VectorKernels<double, 4>
+{
+	/*
+		Four doubles fill an AVX register exactly. The vector is 32 byte aligned
+		so the loads are aligned.
+	*/
+
+	static inline void add(const double* A, const double* B, double* C) { _mm256_store_pd(C, _mm256_add_pd(_mm256_load_pd(A), _mm256_load_pd(B))); };
+	static inline void sub(const double* A, const double* B, double* C) { _mm256_store_pd(C, _mm256_sub_pd(_mm256_load_pd(A), _mm256_load_pd(B))); };
+	static inline void mul(const double* A, const double* B, double* C) { _mm256_store_pd(C, _mm256_mul_pd(_mm256_load_pd(A), _mm256_load_pd(B))); };
+	static inline void div(const double* A, const double* B, double* C) { _mm256_store_pd(C, _mm256_div_pd(_mm256_load_pd(A), _mm256_load_pd(B))); };
+
+	static inline void addScalar(const double* A, const double& B, double* C) { _mm256_store_pd(C, _mm256_add_pd(_mm256_load_pd(A), _mm256_set1_pd(B))); };
+	static inline void subScalar(const double* A, const double& B, double* C) { _mm256_store_pd(C, _mm256_sub_pd(_mm256_load_pd(A), _mm256_set1_pd(B))); };
+	static inline void mulScalar(const double* A, const double& B, double* C) { _mm256_store_pd(C, _mm256_mul_pd(_mm256_load_pd(A), _mm256_set1_pd(B))); };
+	static inline void divScalar(const double* A, const double& B, double* C) { _mm256_store_pd(C, _mm256_div_pd(_mm256_load_pd(A), _mm256_set1_pd(B))); };
+
+	static inline double dot(const double* A, const double* B)
+	{
+		const __m256d products = _mm256_mul_pd(_mm256_load_pd(A), _mm256_load_pd(B));
+		const __m128d halves = _mm_add_pd(_mm256_castpd256_pd128(products), _mm256_extractf128_pd(products, 1));
+		return _mm_cvtsd_f64(_mm_add_sd(halves, _mm_unpackhi_pd(halves, halves)));
+	};
+};
+#endif
+
+/* Operations */
+/*
+	The element-wise arithmetic operations, on single elements (apply) and on whole
+	SIMD registers (packet, see VectorPacket). Shared by VectorBlockKernels and the
+	expression templates in vectors_expr.h.
+*/
+struct VectorAddOperation
+{
+	template <typename T>
+	static constexpr T apply(const T& A, const T& B) { return A + B; };
+	template <typename P>
+	static inline typename P::Type packet(const typename P::Type A, const typename P::Type B) { return P::add(A, B); };
+};
+struct VectorSubOperation
+{
+	template <typename T>
+	static constexpr T apply(const T& A, const T& B) { return A - B; };
+	template <typename P>
+	static inline typename P::Type packet(const typename P::Type A, const typename P::Type B) { return P::sub(A, B); };
+};
+struct VectorMulOperation
+{
+	template <typename T>
+	static constexpr T apply(const T& A, const T& B) { return A * B; };
+	template <typename P>
+	static inline typename P::Type packet(const typename P::Type A, const typename P::Type B) { return P::mul(A, B); };
+};
+struct VectorDivOperation
+{
+	template <typename T>
+	static constexpr T apply(const T& A, const T& B) { return A / B; };
+	template <typename P>
+	static inline typename P::Type packet(const typename P::Type A, const typename P::Type B) { return P::div(A, B); };
+};
+
+template <typename T>
+struct VectorPacket
+{
+	/*
+		# Vector Packet (struct)
+		The widest SIMD register this translation unit is compiled for, holding
+		elements of type T, with the few operations VectorBlockKernels needs. A width
+		of 1 means there is none, and the kernels use plain scalar code.
+	*/
+
+	static constexpr size_t width = 1;
+};
+
+#if VECTORS_SSE
+inline bool vectorsPacketEqual(const __m128 A, const __m128 B) { return (_mm_movemask_ps(_mm_cmpeq_ps(A, B)) == 0xF); };
+inline bool vectorsPacketEqual(const __m128d A, const __m128d B) { return (_mm_movemask_pd(_mm_cmpeq_pd(A, B)) == 0x3); };
+inline float vectorsPacketSum(const __m128 v) { return vectorsHorizontalSum(v); };
+inline double vectorsPacketSum(const __m128d v) { return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v))); };
+#endif
+#if VECTORS_AVX
+inline bool vectorsPacketEqual(const __m256 A, const __m256 B) { return (_mm256_movemask_ps(_mm256_cmp_ps(A, B, _CMP_EQ_OQ)) == 0xFF); };
+inline bool vectorsPacketEqual(const __m256d A, const __m256d B) { return (_mm256_movemask_pd(_mm256_cmp_pd(A, B, _CMP_EQ_OQ)) == 0xF); };
+inline float vectorsPacketSum(const __m256 v) { return vectorsHorizontalSum(_mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1))); };
+inline double vectorsPacketSum(const __m256d v) { return vectorsPacketSum(_mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1))); };
+#endif
+
+#if defined(__FMA__)
+	#define VECTORS_PACKET_MULTIPLY_ADD(prefix, suffix) return prefix##fmadd_##suffix(A, B, C);
+#else
+	#define VECTORS_PACKET_MULTIPLY_ADD(prefix, suffix) return prefix##add_##suffix(prefix##mul_##suffix(A, B), C);
+#endif
+#define VECTORS_PACKET(T, Register, prefix, suffix) \
+	template <> \
+	struct VectorPacket<T> \
+	{ \
+		typedef Register Type; \
+		static constexpr size_t width = (sizeof(Register) / sizeof(T)); \
+		static inline Type load(const T* A) { return prefix##load_##suffix(A); }; \
+		static inline Type loadUnaligned(const T* A) { return prefix##loadu_##suffix(A); }; \
+		static inline void store(T* C, const Type v) { prefix##store_##suffix(C, v); }; \
+		static inline void storeUnaligned(T* C, const Type v) { prefix##storeu_##suffix(C, v); }; \
+		static inline Type set(const T& A) { return prefix##set1_##suffix(A); }; \
+		static inline Type zero() { return prefix##setzero_##suffix(); }; \
+		static inline Type add(const Type A, const Type B) { return prefix##add_##suffix(A, B); }; \
+		static inline Type sub(const Type A, const Type B) { return prefix##sub_##suffix(A, B); }; \
+		static inline Type mul(const Type A, const Type B) { return prefix##mul_##suffix(A, B); }; \
+		static inline Type div(const Type A, const Type B) { return prefix##div_##suffix(A, B); }; \
+		static inline Type negate(const Type A) { return prefix##xor_##suffix(A, set((T)-0.0)); }; \
+		static inline Type multiplyAdd(const Type A, const Type B, const Type C) { VECTORS_PACKET_MULTIPLY_ADD(prefix, suffix) }; \
+		static inline bool equal(const Type A, const Type B) { return vectorsPacketEqual(A, B); }; \
+		static inline T sum(const Type v) { return vectorsPacketSum(v); }; \
+	};
+
+#if VECTORS_AVX
+VECTORS_PACKET(float, __m256, _mm256_, ps)
+VECTORS_PACKET(double, __m256d, _mm256_, pd)
+#elif VECTORS_SSE
+VECTORS_PACKET(float, __m128, _mm_, ps)
+VECTORS_PACKET(double, __m128d, _mm_, pd)
+#endif
+
+#undef VECTORS_PACKET
+#undef VECTORS_PACKET_MULTIPLY_ADD
+
+template <typename T, uint64_t N>
+struct VectorBlockKernels
+{
+	/*
+		# Vector Block Kernels (struct)
+		The element-wise arithmetic behind Vector<N,T>, which walks the vector a
+		SIMD register (see VectorPacket) at a time with a scalar loop for any
+		remainder. When N fills a whole number of registers the vector is aligned to
+		the register size (see VectorLayout), so every load and store is aligned.
+	*/
+
+	typedef VectorPacket<T> Packet;
+
+	static constexpr uint64_t width = Packet::width;
+	static constexpr uint64_t blocks = ((width > 1) ? ((N / width) * width) : 0);
+	static constexpr size_t alignment = VectorLayout<T, N>::alignment;
+	static constexpr bool aligned = ((width > 1) && ((N % width) == 0) && (alignment >= (width * sizeof(T))));
+
+	template <typename P>
+	static inline P load(const T* A)
+	{
+		if constexpr (aligned)
+		{
+			return Packet::load(A);
+		}
+		else
+		{
+			return Packet::loadUnaligned(A);
+		};
+	};
+	template <typename P>
+	static inline void store(T* C, const P v)
+	{
+		if constexpr (aligned)
+		{
+			Packet::store(C, v);
+		}
+		else
+		{
+			Packet::storeUnaligned(C, v);
+		};
+	};
+
+	template <typename Operation>
+	static inline void apply(const T* A, const T* B, T* C)
+	{
+		/*
+			C = A op B, a register at a time and then element by element.
+		*/
+
+		uint64_t i = 0;
+		if constexpr (blocks > 0)
+		{
+			for (; i < blocks; i += width)
+			{
+				store(C + i, Operation::template packet<Packet>(load<typename Packet::Type>(A + i), load<typename Packet::Type>(B + i)));
+			};
+		};
+		for (; i < N; i++)
+		{
+			C[i] = Operation::apply(A[i], B[i]);
+		};
+	};
+	template <typename Operation, bool Reversed = false>
+	static inline void applyScalar(const T* A, const T& B, T* C)
+	{
+		/*
+			C = A op B for a scalar B, or B op A when Reversed is set.
+		*/
+
+		uint64_t i = 0;
+		if constexpr (blocks > 0)
+		{
+			const typename Packet::Type b = Packet::set(B);
+			for (; i < blocks; i += width)
+			{
+				const typename Packet::Type a = load<typename Packet::Type>(A + i);
+				store(C + i, Reversed ? Operation::template packet<Packet>(b, a) : Operation::template packet<Packet>(a, b));
+			};
+		};
+		for (; i < N; i++)
+		{
+			C[i] = Reversed ? Operation::apply(B, A[i]) : Operation::apply(A[i], B);
+		};
+	};
+
+	// Element-wise Operations
+	static inline void add(const T* A, const T* B, T* C) { apply<VectorAddOperation>(A, B, C); };
+	static inline void sub(const T* A, const T* B, T* C) { apply<VectorSubOperation>(A, B, C); };
+	static inline void mul(const T* A, const T* B, T* C) { apply<VectorMulOperation>(A, B, C); };
+	static inline void div(const T* A, const T* B, T* C) { apply<VectorDivOperation>(A, B, C); };
+
+	static inline void addScalar(const T* A, const T& B, T* C) { applyScalar<VectorAddOperation>(A, B, C); };
+	static inline void subScalar(const T* A, const T& B, T* C) { applyScalar<VectorSubOperation>(A, B, C); };
+	static inline void mulScalar(const T* A, const T& B, T* C) { applyScalar<VectorMulOperation>(A, B, C); };
+	static inline void divScalar(const T* A, const T& B, T* C) { applyScalar<VectorDivOperation>(A, B, C); };
+	static inline void scalarSub(const T& A, const T* B, T* C) { applyScalar<VectorSubOperation, true>(B, A, C); };
+	static inline void scalarDiv(const T& A, const T* B, T* C) { applyScalar<VectorDivOperation, true>(B, A, C); };
+
+	static inline void negate(const T* A, T* C)
+	{
+		uint64_t i = 0;
+		if constexpr (blocks > 0)
+		{
+			for (; i < blocks; i += width)
+			{
+				store(C + i, Packet::negate(load<typename Packet::Type>(A + i)));
+			};
+		};
+		for (; i < N; i++)
+		{
+			C[i] = -A[i];
+		};
+	};
+
+	// Reductions
+	static inline bool equal(const T* A, const T* B)
+	{
+		uint64_t i = 0;
+		if constexpr (blocks > 0)
+		{
+			for (; i < blocks; i += width)
+			{
+				if (!Packet::equal(load<typename Packet::Type>(A + i), load<typename Packet::Type>(B + i)))
+				{
+					return false;
+				};
+			};
+		};
+		for (; i < N; i++)
+		{
+			if (!(A[i] == B[i]))
+			{
+				return false;
+			};
+		};
+		return true;
+	};
+	static inline T dot(const T* A, const T* B)
+	{
+		/*
+			Large vectors are summed in chunks of four registers with a separate
+			accumulator for each, so consecutive multiply-adds do not wait on each
+			other.
+		*/
+
+		T value = T();
+		uint64_t i = 0;
+		if constexpr (blocks > 0)
+		{
+			typedef typename Packet::Type P;
+			P sums[4] = { Packet::zero(), Packet::zero(), Packet::zero(), Packet::zero() };
+			for (; (i + (4 * width)) <= blocks; i += (4 * width))
+			{
+				sums[0] = Packet::multiplyAdd(load<P>(A + i), load<P>(B + i), sums[0]);
+				sums[1] = Packet::multiplyAdd(load<P>(A + i + width), load<P>(B + i + width), sums[1]);
+				sums[2] = Packet::multiplyAdd(load<P>(A + i + (2 * width)), load<P>(B + i + (2 * width)), sums[2]);
+				sums[3] = Packet::multiplyAdd(load<P>(A + i + (3 * width)), load<P>(B + i + (3 * width)), sums[3]);
+			};
+			for (; i < blocks; i += width)
+			{
+				sums[0] = Packet::multiplyAdd(load<P>(A + i), load<P>(B + i), sums[0]);
+			};
+			value = Packet::sum(Packet::add(Packet::add(sums[0], sums[1]), Packet::add(sums[2], sums[3])));
+		};
+		for (; i < N; i++)
+		{
+			value = vectorsMultiplyAdd(A[i], B[i], value);
+		};
+		return value;
+	};
+};
+
+constexpr bool vectorsIsConstantEvaluated()
+{
+	/*
+		Whether the caller is being evaluated at compile time, so constexpr functions
+		can use intrinsics at runtime only. Without compiler support this assumes it
+		always is, and the portable constexpr code is used everywhere.
+	*/
+
+#if defined(__cpp_lib_is_constant_evaluated)
+	return std::is_constant_evaluated();
+#elif defined(__GNUC__) || defined(__clang__)
+	return __builtin_is_constant_evaluated();
+#else
+	return true;
+#endif
+};
 
 /* Structures */
 template <typename T>
@@ -31,55 +820,78 @@ struct Vector2D
 	*/
 
 	/* Elements */
-	T value[2];
+	alignas(VectorLayout<T, 2>::alignment) T value[2];
 
 	/* Methods */
 
 	// Constructors & Destructor
-	Vector2D()
-	{
-		this->value[0] = T();
-		this->value[1] = T();
-	};
-	Vector2D(const T& i, const T& j)
+	constexpr Vector2D() : value{} {};
+	constexpr Vector2D(const T& i, const T& j) : value{ i, j } {};
+	Vector2D(const Vector2D<T>& source) = default;
+	template <typename E, typename = typename std::enable_if<VectorExpressionTraits<E>::isExpression>::type>
+	constexpr Vector2D(const E& expression) : value{}
 	{
-		this->value[0] = i;
-		this->value[1] = j;
+		(*this) = expression;
 	};
-	Vector2D(const Vector2D<T>& source)
+
+	// Assignment Operators
+	Vector2D<T>& operator=(const Vector2D<T>& source) = default;
+	template <typename E, typename = typename std::enable_if<VectorExpressionTraits<E>::isExpression>::type>
+	constexpr Vector2D<T>& operator=(const E& expression)
 	{
-		this->value[0] = source.value[0];
-		this->value[1] = source.value[1];
+		static_assert(E::dimensions == 2, "Expression dimensions must match the vector.");
+		VectorUnroll<2>::each([&](const uint64_t& i) { this->value[i] = expression[i]; });
+		return (*this);
 	};
 
 	// Access Operators
-	inline T& x()
+	constexpr T& x()
+	{
+		return this->value[0];
+	};
+	constexpr const T& x() const
 	{
 		return this->value[0];
 	};
-	inline T& y()
+	constexpr T& y()
+	{
+		return this->value[1];
+	};
+	constexpr const T& y() const
 	{
 		return this->value[1];
 	};
-	inline T& operator[](const uint64_t& i)
+	constexpr T& operator[](const uint64_t& i)
+	{
+		return this->value[i];
+	};
+	constexpr const T& operator[](const uint64_t& i) const
 	{
 		return this->value[i];
 	};
-	inline T& get(const uint64_t& i)
+	constexpr T& get(const uint64_t& i)
+	{
+		return (*this)[i];
+	};
+	constexpr const T& get(const uint64_t& i) const
 	{
 		return (*this)[i];
 	};
 
 	// Serialization
-	virtual inline std::string toString() const
+	inline std::string toString() const
+	{
+		return ::toString(*this);
+	};
+	inline size_t formatTo(char* buffer, const size_t& size) const
 	{
-		return "(" + std::to_string(this->value[0]) + "," + std::to_string(this->value[1]) + ")";
+		return ::formatTo(buffer, size, *this);
 	};
 
 	// Magnitude Operators
-	inline T length()
+	inline T length() const
 	{
-		return sqrt(pow((double)this->x(),2.0) + pow((double)this->y(), 2.0));
+		return this->norm();
 	};
 	inline T sum() const
 	{
@@ -88,35 +900,51 @@ struct Vector2D
 			abs(this->value[1])
 		);
 	};
-	
+
 	// Normalization Methods
+	inline T squaredNorm() const
+	{
+		return VectorKernels<T, 2>::dot(this->value, this->value);
+	};
 	inline T norm() const
 	{
-		return sqrt(
-			pow((double)this->value[0], 2.0) +
-			pow((double)this->value[1], 2.0)
-		);
+		return (T)std::sqrt(this->squaredNorm());
+	};
+	inline T fastInvNorm() const
+	{
+		/*
+			An approximation of 1 / norm(), see vectorsFastInverseSqrt().
+		*/
+
+		return vectorsFastInverseSqrt(this->squaredNorm());
 	};
-	inline T pNorm(const uint64_t& p)
+	inline T pNorm(const uint64_t& p) const
 	{
 		/*
 			A lebesgue p-Norm, where the exponent (2) in the norm formula is generalized
 			into a variable p. Thanks again Henri!
 		*/
 
-		return pow(
-			(
-				pow((double)this->x(), (double)p) +
-				pow((double)this->y(), (double)p)
-			),
-			(1.0 / p)
-		);
+		return VectorNorms<2, T>::pNorm(this->value, p);
+	};
+	inline T infNorm() const
+	{
+		/*
+			The infinity norm, the limit of pNorm() as p grows: the largest absolute
+			element.
+		*/
+
+		return VectorNorms<2, T>::infNorm(this->value);
 	};
 	
-	inline Vector2D<T> unitNormal()
+	inline Vector2D<T> unitNormal() const
 	{
 		return ((*this) / this->norm());
 	};
+	inline Vector2D<T> fastUnitNormal() const
+	{
+		return ((*this) * this->fastInvNorm());
+	};
 	inline Vector2D<T> normal() const
 	{
 		/*
@@ -133,229 +961,537 @@ struct Vector2D
 
 	// Product Operators
 	inline T dot(const Vector2D<T>& B) const
+	{
+		return VectorKernels<T, 2>::dot(this->value, B.value);
+	};
+
+	// Projection Operators
+	inline T scalarProjection(Vector2D<T>& B) const
+	{
+		/*
+			Performs a scalar vector projection of this vector onto the given
+			vector (B).
+		*/
+		return (*this).dot(B.unitNormal());
+	};
+
+	// Unary Operators
+	constexpr Vector2D<T> operator+() const
+	{
+		return (*this);
+	};
+	constexpr Vector2D<T> operator-() const
+	{
+		Vector2D<T> C;
+		VectorUnroll<2>::each([&](const uint64_t& i) { C.value[i] = -this->value[i]; });
+		return C;
+	};
+
+	// Comparison Operators
+	constexpr bool operator==(const Vector2D<T>& B) const
+	{
+		bool equal = true;
+		VectorUnroll<2>::each([&](const uint64_t& i) { equal = (equal && (this->value[i] == B.value[i])); });
+		return equal;
+	};
+	constexpr bool operator!=(const Vector2D<T>& B) const
+	{
+		return !((*this) == B);
+	};
+
+	// Binary Operators
+	inline Vector2D<T> operator+(const Vector2D<T>& B) const
+	{
+		Vector2D<T> C;
+		VectorKernels<T, 2>::add(this->value, B.value, C.value);
+		return C;
+	};
+	inline Vector2D<T> operator+(const T& B) const
+	{
+		Vector2D<T> C;
+		VectorKernels<T, 2>::addScalar(this->value, B, C.value);
+		return C;
+	};
+
+	inline Vector2D<T> operator-(const Vector2D<T>& B) const
+	{
+		Vector2D<T> C;
+		VectorKernels<T, 2>::sub(this->value, B.value, C.value);
+		return C;
+	};
+	inline Vector2D<T> operator-(const T& B) const
+	{
+		Vector2D<T> C;
+		VectorKernels<T, 2>::subScalar(this->value, B, C.value);
+		return C;
+	};
+
+	inline Vector2D<T> operator*(const Vector2D<T>& B) const
+	{
+		Vector2D<T> C;
+		VectorKernels<T, 2>::mul(this->value, B.value, C.value);
+		return C;
+	};
+	inline Vector2D<T> operator*(const T& B) const
+	{
+		Vector2D<T> C;
+		VectorKernels<T, 2>::mulScalar(this->value, B, C.value);
+		return C;
+	};
+
+	inline Vector2D<T> operator/(const Vector2D<T>& B) const
+	{
+		Vector2D<T> C;
+		VectorKernels<T, 2>::div(this->value, B.value, C.value);
+		return C;
+	};
+	inline Vector2D<T> operator/(const T& B) const
+	{
+		Vector2D<T> C;
+		VectorKernels<T, 2>::divScalar(this->value, B, C.value);
+		return C;
+	};
+
+	// Binary Assignment Operators
+	inline Vector2D<T>& operator+=(const Vector2D<T>& B)
+	{
+		VectorKernels<T, 2>::add(this->value, B.value, this->value);
+		return (*this);
+	};
+	inline Vector2D<T>& operator+=(const T& B)
+	{
+		VectorKernels<T, 2>::addScalar(this->value, B, this->value);
+		return (*this);
+	};
+
+	inline Vector2D<T>& operator-=(const Vector2D<T>& B)
+	{
+		VectorKernels<T, 2>::sub(this->value, B.value, this->value);
+		return (*this);
+	};
+	inline Vector2D<T>& operator-=(const T& B)
+	{
+		VectorKernels<T, 2>::subScalar(this->value, B, this->value);
+		return (*this);
+	};
+
+	inline Vector2D<T>& operator*=(const Vector2D<T>& B)
+	{
+		VectorKernels<T, 2>::mul(this->value, B.value, this->value);
+		return (*this);
+	};
+	inline Vector2D<T>& operator*=(const T& B)
+	{
+		VectorKernels<T, 2>::mulScalar(this->value, B, this->value);
+		return (*this);
+	};
+
+	inline Vector2D<T>& operator/=(const Vector2D<T>& B)
+	{
+		VectorKernels<T, 2>::div(this->value, B.value, this->value);
+		return (*this);
+	};
+	inline Vector2D<T>& operator/=(const T& B)
+	{
+		VectorKernels<T, 2>::divScalar(this->value, B, this->value);
+		return (*this);
+	};
+};
+
+template <typename T>
+struct Vector3D
+{
+	/*
+		# Vector 3D (struct)
+	*/
+
+	/* Elements */
+	alignas(VectorLayout<T, 3>::alignment) T value[3];
+
+	/* Methods */
+
+	// Constructors & Destructor
+	constexpr Vector3D() : value{} {};
+	constexpr Vector3D(const T& i, const T& j, const T& k) : value{ i, j, k } {};
+	Vector3D(const Vector3D<T>& source) = default;
+	template <typename E, typename = typename std::enable_if<VectorExpressionTraits<E>::isExpression>::type>
+	constexpr Vector3D(const E& expression) : value{}
+	{
+		(*this) = expression;
+	};
+
+	// Assignment Operators
+	Vector3D<T>& operator=(const Vector3D<T>& source) = default;
+	template <typename E, typename = typename std::enable_if<VectorExpressionTraits<E>::isExpression>::type>
+	constexpr Vector3D<T>& operator=(const E& expression)
+	{
+		static_assert(E::dimensions == 3, "Expression dimensions must match the vector.");
+		VectorUnroll<3>::each([&](const uint64_t& i) { this->value[i] = expression[i]; });
+		return (*this);
+	};
+
+	// Serialization
+	inline std::string toString() const
+	{
+		return ::toString(*this);
+	};
+	inline size_t formatTo(char* buffer, const size_t& size) const
+	{
+		return ::formatTo(buffer, size, *this);
+	};
+
+	// Magnitude Operators
+	inline T length() const
+	{
+		return this->norm();
+	};
+	inline T sum() const
 	{
 		return (
-			(this->value[0] * B.value[0]) + 
-			(this->value[1] * B.value[1])
+			abs(this->value[0]) + 
+			abs(this->value[1]) + 
+			abs(this->value[2])
+		);
+	};
+
+	// Normalization Methods
+	inline T squaredNorm() const
+	{
+		return VectorKernels<T, 3>::dot(this->value, this->value);
+	};
+	inline T norm() const
+	{
+		return (T)std::sqrt(this->squaredNorm());
+	};
+	inline T fastInvNorm() const
+	{
+		/*
+			An approximation of 1 / norm(), see vectorsFastInverseSqrt().
+		*/
+
+		return vectorsFastInverseSqrt(this->squaredNorm());
+	};
+	inline T pNorm(const uint64_t& p) const
+	{
+		/*
+			A lebesgue p-Norm, where the exponent (2) in the norm formula is generalized
+			into a variable p. Thanks again Henri!
+		*/
+
+		return VectorNorms<3, T>::pNorm(this->value, p);
+	};
+	inline T infNorm() const
+	{
+		/*
+			The infinity norm, the limit of pNorm() as p grows: the largest absolute
+			element.
+		*/
+
+		return VectorNorms<3, T>::infNorm(this->value);
+	};
+	
+	inline Vector3D<T> unitNormal() const
+	{
+		return ((*this) / this->norm());
+	};
+	inline Vector3D<T> fastUnitNormal() const
+	{
+		return ((*this) * this->fastInvNorm());
+	};
+	inline Vector3D<T> normal() const
+	{
+		/*
+			Returns the normal vector, calculated from dividing each element by the sum
+			of all the elements.
+		*/
+
+		T _sum = this->sum();
+		return Vector3D<T>(
+			((double)this->value[0] / _sum),
+			((double)this->value[1] / _sum),
+			((double)this->value[2] / _sum)
 		);
 	};
 
+	// Access Operators
+	constexpr T& x()
+	{
+		return this->value[0];
+	};
+	constexpr const T& x() const
+	{
+		return this->value[0];
+	};
+	constexpr T& y()
+	{
+		return this->value[1];
+	};
+	constexpr const T& y() const
+	{
+		return this->value[1];
+	};
+	constexpr T& z()
+	{
+		return this->value[2];
+	};
+	constexpr const T& z() const
+	{
+		return this->value[2];
+	};
+	constexpr T& operator[](const uint64_t& i)
+	{
+		return this->value[i];
+	};
+	constexpr const T& operator[](const uint64_t& i) const
+	{
+		return this->value[i];
+	};
+	constexpr T& get(const uint64_t& i)
+	{
+		return (*this)[i];
+	};
+	constexpr const T& get(const uint64_t& i) const
+	{
+		return (*this)[i];
+	};
+
+	// Product Operators
+	inline T dot(const Vector3D<T>& B) const
+	{
+		return VectorKernels<T, 3>::dot(this->value, B.value);
+	};
+	inline Vector3D<T> cross(const Vector3D<T>& B) const
+	{
+		Vector3D<T> C;
+		VectorKernels<T, 3>::cross(this->value, B.value, C.value);
+		return C;
+	};
+
 	// Projection Operators
-	inline T scalarProjection(Vector2D<T>& B) const
+	inline T scalarProjection(Vector3D<T>& B) const
+	{
+		/*
+			Performs a scalar vector projection of this vector onto the given
+			vector (B).
+		*/
+		return (*this).dot(B.unitNormal());
+	};
+
+	// Unary Operators
+	constexpr Vector3D<T> operator+() const
+	{
+		return (*this);
+	};
+	constexpr Vector3D<T> operator-() const
+	{
+		Vector3D<T> C;
+		VectorUnroll<3>::each([&](const uint64_t& i) { C.value[i] = -this->value[i]; });
+		return C;
+	};
+
+	// Comparison Operators
+	constexpr bool operator==(const Vector3D<T>& B) const
 	{
-		/*
-			Performs a scalar vector projection of this vector onto the given
-			vector (B).
-		*/
-		return (*this).dot(B.unitNormal());
+		bool equal = true;
+		VectorUnroll<3>::each([&](const uint64_t& i) { equal = (equal && (this->value[i] == B.value[i])); });
+		return equal;
+	};
+	constexpr bool operator!=(const Vector3D<T>& B) const
+	{
+		return !((*this) == B);
 	};
 
 	// Binary Operators
-	inline Vector2D<T> operator+(const Vector2D<T>& B)
+	inline Vector3D<T> operator+(const Vector3D<T>& B) const
 	{
-		return Vector2D<T>(
-			(this->x() + B.x()),
-			(this->y() + B.y())
-		);
+		Vector3D<T> C;
+		VectorKernels<T, 3>::add(this->value, B.value, C.value);
+		return C;
 	};
-	inline Vector2D<T> operator+(const T& B)
+	inline Vector3D<T> operator+(const T& B) const
 	{
-		return Vector2D<T>(
-			(this->x() + B),
-			(this->y() + B)
-		);
+		Vector3D<T> C;
+		VectorKernels<T, 3>::addScalar(this->value, B, C.value);
+		return C;
 	};
 
-	inline Vector2D<T> operator-(const Vector2D<T>& B)
+	inline Vector3D<T> operator-(const Vector3D<T>& B) const
 	{
-		return Vector2D<T>(
-			(this->x() - B.x()),
-			(this->y() - B.y())
-		);
+		Vector3D<T> C;
+		VectorKernels<T, 3>::sub(this->value, B.value, C.value);
+		return C;
 	};
-	inline Vector2D<T> operator-(const T& B)
+	inline Vector3D<T> operator-(const T& B) const
 	{
-		return Vector2D<T>(
-			(this->x() - B),
-			(this->y() - B)
-		);
+		Vector3D<T> C;
+		VectorKernels<T, 3>::subScalar(this->value, B, C.value);
+		return C;
 	};
 
-	inline Vector2D<T> operator*(const Vector2D<T>& B)
+	inline Vector3D<T> operator*(const Vector3D<T>& B) const
 	{
-		return Vector2D<T>(
-			(this->x() * B.x()),
-			(this->y() * B.y())
-		);
+		Vector3D<T> C;
+		VectorKernels<T, 3>::mul(this->value, B.value, C.value);
+		return C;
 	};
-	inline Vector2D<T> operator*(const T& B)
+	inline Vector3D<T> operator*(const T& B) const
 	{
-		return Vector2D<T>(
-			(this->x() * B),
-			(this->y() * B)
-		);
+		Vector3D<T> C;
+		VectorKernels<T, 3>::mulScalar(this->value, B, C.value);
+		return C;
 	};
 
-	inline Vector2D<T> operator/(const Vector2D<T>& B)
+	inline Vector3D<T> operator/(const Vector3D<T>& B) const
 	{
-		return Vector2D<T>(
-			(this->x() / B.x()),
-			(this->y() / B.y())
-		);
+		Vector3D<T> C;
+		VectorKernels<T, 3>::div(this->value, B.value, C.value);
+		return C;
 	};
-	inline Vector2D<T> operator/(const T& B)
+	inline Vector3D<T> operator/(const T& B) const
 	{
-		return Vector2D<T>(
-			(this->x() / B),
-			(this->y() / B)
-		);
+		Vector3D<T> C;
+		VectorKernels<T, 3>::divScalar(this->value, B, C.value);
+		return C;
 	};
 
 	// Binary Assignment Operators
-	inline Vector2D<T>& operator+=(const Vector2D<T>& B)
+	inline Vector3D<T>& operator+=(const Vector3D<T>& B)
 	{
-		this->x() = this->x() + B.x();
-		this->y() = this->y() + B.y();
+		VectorKernels<T, 3>::add(this->value, B.value, this->value);
 		return (*this);
 	};
-	inline Vector2D<T>& operator+=(const T& B)
+	inline Vector3D<T>& operator+=(const T& B)
 	{
-		this->x() = this->x() + B;
-		this->y() = this->y() + B;
+		VectorKernels<T, 3>::addScalar(this->value, B, this->value);
 		return (*this);
 	};
 
-	inline Vector2D<T>& operator-=(const Vector2D<T>& B)
+	inline Vector3D<T>& operator-=(const Vector3D<T>& B)
 	{
-		this->x() = this->x() - B.x();
-		this->y() = this->y() - B.y();
+		VectorKernels<T, 3>::sub(this->value, B.value, this->value);
 		return (*this);
 	};
-	inline Vector2D<T>& operator-=(const T& B)
+	inline Vector3D<T>& operator-=(const T& B)
 	{
-		this->x() = this->x() - B;
-		this->y() = this->y() - B;
+		VectorKernels<T, 3>::subScalar(this->value, B, this->value);
 		return (*this);
 	};
 
-	inline Vector2D<T>& operator*=(const Vector2D<T>& B)
+	inline Vector3D<T>& operator*=(const Vector3D<T>& B)
 	{
-		this->x() = this->x() * B.x();
-		this->y() = this->y() * B.y();
+		VectorKernels<T, 3>::mul(this->value, B.value, this->value);
 		return (*this);
 	};
-	inline Vector2D<T>& operator*=(const T& B)
+	inline Vector3D<T>& operator*=(const T& B)
 	{
-		this->x() = this->x() * B;
-		this->y() = this->y() * B;
+		VectorKernels<T, 3>::mulScalar(this->value, B, this->value);
 		return (*this);
 	};
 
-	inline Vector2D<T>& operator/=(const Vector2D<T>& B)
+	inline Vector3D<T>& operator/=(const Vector3D<T>& B)
 	{
-		this->x() = this->x() / B.x();
-		this->y() = this->y() / B.y();
+		VectorKernels<T, 3>::div(this->value, B.value, this->value);
 		return (*this);
 	};
-	inline Vector2D<T>& operator/=(const T& B)
+	inline Vector3D<T>& operator/=(const T& B)
 	{
-		this->x() = this->x() / B;
-		this->y() = this->y() / B;
+		VectorKernels<T, 3>::divScalar(this->value, B, this->value);
 		return (*this);
 	};
 };
 
 template <typename T>
-struct Vector3D
+struct Vector4D
 {
 	/*
-		# Vector 3D (struct)
+		# Vector 4D (struct)
 	*/
 
 	/* Elements */
-	T value[3];
+	alignas(VectorLayout<T, 4>::alignment) T value[4];
 
 	/* Methods */
 
 	// Constructors & Destructor
-	Vector3D()
-	{
-		this->value[0] = T();
-		this->value[1] = T();
-		this->value[2] = T();
-	};
-	Vector3D(const T& i, const T& j, const T& k)
-	{
-		this->value[0] = i;
-		this->value[1] = j;
-		this->value[2] = k;
-	};
-	Vector3D(const Vector3D& source)
+	constexpr Vector4D() : value{} {};
+	constexpr Vector4D(const T& i, const T& j, const T& k, const T& l) : value{ i, j, k, l } {};
+	Vector4D(const Vector4D<T>& source) = default;
+	template <typename E, typename = typename std::enable_if<VectorExpressionTraits<E>::isExpression>::type>
+	constexpr Vector4D(const E& expression) : value{}
 	{
-		this->value[0] = source.value[0];
-		this->value[1] = source.value[1];
-		this->value[2] = source.value[2];
+		(*this) = expression;
 	};
 
-	// Serialization
-	virtual inline std::string toString() const
+	// Assignment Operators
+	Vector4D<T>& operator=(const Vector4D<T>& source) = default;
+	template <typename E, typename = typename std::enable_if<VectorExpressionTraits<E>::isExpression>::type>
+	constexpr Vector4D<T>& operator=(const E& expression)
 	{
-		return "(" +
-			std::to_string(this->value[0]) +
-			"," + std::to_string(this->value[1]) +
-			"," + std::to_string(this->value[2]) +
-		")";
+		static_assert(E::dimensions == 4, "Expression dimensions must match the vector.");
+		VectorUnroll<4>::each([&](const uint64_t& i) { this->value[i] = expression[i]; });
+		return (*this);
 	};
 
 	// Magnitude Operators
-	inline T length()
+	inline T length() const
 	{
-		return sqrt(
-			pow((double)this->value[0], 2.0) +
-			pow((double)this->value[1], 2.0) +
-			pow((double)this->value[2], 2.0)
-		);
+		return this->norm();
 	};
 	inline T sum() const
 	{
 		return (
 			abs(this->value[0]) + 
 			abs(this->value[1]) + 
-			abs(this->value[2])
+			abs(this->value[2]) + 
+			abs(this->value[3])
 		);
 	};
 
 	// Normalization Methods
+	inline T squaredNorm() const
+	{
+		return VectorKernels<T, 4>::dot(this->value, this->value);
+	};
 	inline T norm() const
 	{
-		return sqrt(
-			pow((double)this->value[0], 2.0) +
-			pow((double)this->value[1], 2.0) +
-			pow((double)this->value[2], 2.0)
-		);
+		return (T)std::sqrt(this->squaredNorm());
 	};
-	inline T pNorm(const uint64_t& p)
+	inline T fastInvNorm() const
+	{
+		/*
+			An approximation of 1 / norm(), see vectorsFastInverseSqrt().
+		*/
+
+		return vectorsFastInverseSqrt(this->squaredNorm());
+	};
+	inline T pNorm(const uint64_t& p) const
 	{
 		/*
 			A lebesgue p-Norm, where the exponent (2) in the norm formula is generalized
 			into a variable p. Thanks again Henri!
 		*/
 
-		return pow(
-			(
-				pow((double)this->value[0], (double)p) +
-				pow((double)this->value[1], (double)p) +
-				pow((double)this->value[2], (double)p)
-			),
-			(1.0 / p)
-		);
+		return VectorNorms<4, T>::pNorm(this->value, p);
 	};
+	inline T infNorm() const
+	{
+		/*
+			The infinity norm, the limit of pNorm() as p grows: the largest absolute
+			element.
+		*/
 
-	inline Vector3D<T> unitNormal()
+		return VectorNorms<4, T>::infNorm(this->value);
+	};
+	
+	inline Vector4D<T> unitNormal() const
 	{
 		return ((*this) / this->norm());
 	};
-	inline Vector3D<T> normal() const
+	inline Vector4D<T> fastUnitNormal() const
+	{
+		return ((*this) * this->fastInvNorm());
+	};
+	inline Vector4D<T> normal() const
 	{
 		/*
 			Returns the normal vector, calculated from dividing each element by the sum
@@ -363,55 +1499,82 @@ struct Vector3D
 		*/
 
 		T _sum = this->sum();
-		return Vector3D<T>(
+		return Vector4D<T>(
 			((double)this->value[0] / _sum),
 			((double)this->value[1] / _sum),
-			((double)this->value[2] / _sum)
+			((double)this->value[2] / _sum),
+			((double)this->value[3] / _sum)
 		);
 	};
 
 	// Access Operators
-	inline T& x()
+	constexpr T& x()
+	{
+		return this->value[0];
+	};
+	constexpr const T& x() const
 	{
 		return this->value[0];
 	};
-	inline T& y()
+	constexpr T& y()
 	{
 		return this->value[1];
 	};
-	inline T& z()
+	constexpr const T& y() const
+	{
+		return this->value[1];
+	};
+	constexpr T& z()
+	{
+		return this->value[2];
+	};
+	constexpr const T& z() const
 	{
 		return this->value[2];
 	};
-	inline T& operator[](const uint64_t& i)
+	constexpr T& t()
+	{
+		return this->value[3];
+	};
+	constexpr const T& t() const
+	{
+		return this->value[3];
+	};
+	constexpr T& operator[](const uint64_t& i)
 	{
 		return this->value[i];
 	};
-	inline T& get(const uint64_t& i)
+	constexpr const T& operator[](const uint64_t& i) const
+	{
+		return this->value[i];
+	};
+	constexpr T& get(const uint64_t& i)
+	{
+		return (*this)[i];
+	};
+	constexpr const T& get(const uint64_t& i) const
 	{
 		return (*this)[i];
 	};
 
-	// Product Operators
-	inline T dot(const Vector3D<T>& B) const
+	// Serialization
+	inline std::string toString() const
 	{
-		return (
-			(this->value[0] * B.value[0]) + 
-			(this->value[1] * B.value[1]) + 
-			(this->value[2] * B.value[2])
-		);
+		return ::toString(*this);
 	};
-	inline Vector3D<T> cross(const Vector3D<T>& B) const
+	inline size_t formatTo(char* buffer, const size_t& size) const
 	{
-		return Vector3D<T>(
-			(this->value[1] * B.value[2]) - (this->value[2] * B.value[1]),
-			(this->value[2] * B.value[0]) - (this->value[0] * B.value[2]),
-			(this->value[0] * B.value[1]) - (this->value[1] * B.value[0])
-		);
+		return ::formatTo(buffer, size, *this);
+	};
+
+	// Product Operators
+	inline T dot(const Vector4D<T>& B) const
+	{
+		return VectorKernels<T, 4>::dot(this->value, B.value);
 	};
 
 	// Projection Operators
-	inline T scalarProjection(Vector3D<T>& B) const
+	inline T scalarProjection(Vector4D<T>& B) const
 	{
 		/*
 			Performs a scalar vector projection of this vector onto the given
@@ -420,611 +1583,969 @@ struct Vector3D
 		return (*this).dot(B.unitNormal());
 	};
 
+	// Unary Operators
+	constexpr Vector4D<T> operator+() const
+	{
+		return (*this);
+	};
+	constexpr Vector4D<T> operator-() const
+	{
+		Vector4D<T> C;
+		VectorUnroll<4>::each([&](const uint64_t& i) { C.value[i] = -this->value[i]; });
+		return C;
+	};
+
+	// Comparison Operators
+	constexpr bool operator==(const Vector4D<T>& B) const
+	{
+		bool equal = true;
+		VectorUnroll<4>::each([&](const uint64_t& i) { equal = (equal && (this->value[i] == B.value[i])); });
+		return equal;
+	};
+	constexpr bool operator!=(const Vector4D<T>& B) const
+	{
+		return !((*this) == B);
+	};
+
 	// Binary Operators
-	inline Vector3D<T> operator+(const Vector3D<T>& B)
+	inline Vector4D<T> operator+(const Vector4D<T>& B) const
 	{
-		return Vector3D<T>(
-			(this->x() + B.x()),
-			(this->y() + B.y()),
-			(this->z() + B.z())
-		);
+		Vector4D<T> C;
+		VectorKernels<T, 4>::add(this->value, B.value, C.value);
+		return C;
 	};
-	inline Vector3D<T> operator+(const T& B)
+	inline Vector4D<T> operator+(const T& B) const
 	{
-		return Vector3D<T>(
-			(this->x() + B),
-			(this->y() + B),
-			(this->z() + B)
-		);
+		Vector4D<T> C;
+		VectorKernels<T, 4>::addScalar(this->value, B, C.value);
+		return C;
 	};
 
-	inline Vector3D<T> operator-(const Vector3D<T>& B)
+	inline Vector4D<T> operator-(const Vector4D<T>& B) const
 	{
-		return Vector3D<T>(
-			(this->x() - B.x()),
-			(this->y() - B.y()),
-			(this->z() - B.z())
-		);
+		Vector4D<T> C;
+		VectorKernels<T, 4>::sub(this->value, B.value, C.value);
+		return C;
 	};
-	inline Vector3D<T> operator-(const T& B)
+	inline Vector4D<T> operator-(const T& B) const
 	{
-		return Vector3D<T>(
-			(this->x() - B),
-			(this->y() - B),
-			(this->z() - B)
-		);
+		Vector4D<T> C;
+		VectorKernels<T, 4>::subScalar(this->value, B, C.value);
+		return C;
 	};
 
-	inline Vector3D<T> operator*(const Vector3D<T>& B)
+	inline Vector4D<T> operator*(const Vector4D<T>& B) const
 	{
-		return Vector3D<T>(
-			(this->x() * B.x()),
-			(this->y() * B.y()),
-			(this->z() * B.z())
-		);
+		Vector4D<T> C;
+		VectorKernels<T, 4>::mul(this->value, B.value, C.value);
+		return C;
 	};
-	inline Vector3D<T> operator*(const T& B)
+	inline Vector4D<T> operator*(const T& B) const
 	{
-		return Vector3D<T>(
-			(this->x() * B),
-			(this->y() * B),
-			(this->z() * B)
-		);
+		Vector4D<T> C;
+		VectorKernels<T, 4>::mulScalar(this->value, B, C.value);
+		return C;
 	};
 
-	inline Vector3D<T> operator/(const Vector3D<T>& B)
+	inline Vector4D<T> operator/(const Vector4D<T>& B) const
 	{
-		return Vector3D<T>(
-			(this->x() / B.x()),
-			(this->y() / B.y()),
-			(this->z() / B.z())
-		);
+		Vector4D<T> C;
+		VectorKernels<T, 4>::div(this->value, B.value, C.value);
+		return C;
 	};
-	inline Vector3D<T> operator/(const T& B)
+	inline Vector4D<T> operator/(const T& B) const
 	{
-		return Vector3D<T>(
-			(this->x() / B),
-			(this->y() / B),
-			(this->z() / B)
-		);
+		Vector4D<T> C;
+		VectorKernels<T, 4>::divScalar(this->value, B, C.value);
+		return C;
 	};
 
 	// Binary Assignment Operators
-	inline Vector3D<T>& operator+=(const Vector3D<T>& B)
+	inline Vector4D<T>& operator+=(const Vector4D<T>& B)
 	{
-		this->x() = this->x() + B.x();
-		this->y() = this->y() + B.y();
-		this->z() = this->z() + B.z();
+		VectorKernels<T, 4>::add(this->value, B.value, this->value);
 		return (*this);
 	};
-	inline Vector3D<T>& operator+=(const T& B)
+	inline Vector4D<T>& operator+=(const T& B)
 	{
-		this->x() = this->x() + B;
-		this->y() = this->y() + B;
-		this->z() = this->z() + B;
+		VectorKernels<T, 4>::addScalar(this->value, B, this->value);
 		return (*this);
 	};
 
-	inline Vector3D<T>& operator-=(const Vector3D<T>& B)
+	inline Vector4D<T>& operator-=(const Vector4D<T>& B)
 	{
-		this->x() = this->x() - B.x();
-		this->y() = this->y() - B.y();
-		this->z() = this->z() - B.z();
+		VectorKernels<T, 4>::sub(this->value, B.value, this->value);
 		return (*this);
 	};
-	inline Vector3D<T>& operator-=(const T& B)
+	inline Vector4D<T>& operator-=(const T& B)
 	{
-		this->x() = this->x() - B;
-		this->y() = this->y() - B;
-		this->z() = this->z() - B;
+		VectorKernels<T, 4>::subScalar(this->value, B, this->value);
 		return (*this);
 	};
 
-	inline Vector3D<T>& operator*=(const Vector3D<T>& B)
+	inline Vector4D<T>& operator*=(const Vector4D<T>& B)
 	{
-		this->x() = this->x() * B.x();
-		this->y() = this->y() * B.y();
-		this->z() = this->z() * B.z();
+		VectorKernels<T, 4>::mul(this->value, B.value, this->value);
 		return (*this);
 	};
-	inline Vector3D<T>& operator*=(const T& B)
+	inline Vector4D<T>& operator*=(const T& B)
 	{
-		this->x() = this->x() * B;
-		this->y() = this->y() * B;
-		this->z() = this->z() * B;
+		VectorKernels<T, 4>::mulScalar(this->value, B, this->value);
 		return (*this);
 	};
 
-	inline Vector3D<T>& operator/=(const Vector3D<T>& B)
+	inline Vector4D<T>& operator/=(const Vector4D<T>& B)
 	{
-		this->x() = this->x() / B.x();
-		this->y() = this->y() / B.y();
-		this->z() = this->z() / B.z();
+		VectorKernels<T, 4>::div(this->value, B.value, this->value);
 		return (*this);
 	};
-	inline Vector3D<T>& operator/=(const T& B)
+	inline Vector4D<T>& operator/=(const T& B)
 	{
-		this->x() = this->x() / B;
-		this->y() = this->y() / B;
-		this->z() = this->z() / B;
+		VectorKernels<T, 4>::divScalar(this->value, B, this->value);
 		return (*this);
 	};
 };
 
-template <typename T>
-struct Vector4D
+template <uint64_t N, typename T>
+struct Vector
 {
 	/*
-		# Vector 4D (struct)
+		# Vector (struct)
+		An N dimensional vector. Construction and the element-wise operators are
+		constexpr; at compile time they are fully unrolled for N up to
+		VECTORS_UNROLL_LIMIT, and at runtime they run on VectorBlockKernels.
 	*/
 
+	static_assert(N > 0, "A vector needs at least one dimension.");
+
 	/* Elements */
-	T value[4];
+	alignas(VectorBlockKernels<T, N>::alignment) T value[N];
 
 	/* Methods */
-
+	
 	// Constructors & Destructor
-	Vector4D()
+	constexpr Vector() : value{} {};
+	template <
+		typename... Args,
+		typename = typename std::enable_if<
+			(sizeof...(Args) == N) && 
+			VectorsAllConvertible<T, Args...>::value
+		>::type
+	>
+	constexpr Vector(const Args&... v) : value{ static_cast<T>(v)... } {};
+	Vector(const Vector<N, T>& source) = default;
+	template <typename E, typename = typename std::enable_if<VectorExpressionTraits<E>::isExpression>::type>
+	constexpr Vector(const E& expression) : value{}
+	{
+		(*this) = expression;
+	};
+
+	// Assignment Operators
+	Vector<N, T>& operator=(const Vector<N, T>& source) = default;
+	template <typename E, typename = typename std::enable_if<VectorExpressionTraits<E>::isExpression>::type>
+	constexpr Vector<N, T>& operator=(const E& expression)
+	{
+		/*
+			Evaluates a lazy expression (see vectors_expr.h) into this vector in a single
+			pass.
+		*/
+
+		static_assert(E::dimensions == N, "Expression dimensions must match the vector.");
+		VectorUnroll<N>::each([&](const uint64_t& i) { this->value[i] = expression[i]; });
+		return (*this);
+	};
+
+	// Access Operators
+	constexpr T& operator[](const uint64_t& i)
+	{
+		return this->value[i];
+	};
+	constexpr const T& operator[](const uint64_t& i) const
 	{
-		this->value[0] = T();
-		this->value[1] = T();
-		this->value[2] = T();
-		this->value[3] = T();
+		return this->value[i];
+	};
+	constexpr T& get(const uint64_t& i)
+	{
+		return (*this)[i];
 	};
-	Vector4D(const T& i, const T& j, const T& k, const T& l)
+	constexpr const T& get(const uint64_t& i) const
+	{
+		return (*this)[i];
+	};
+
+	// Serialization
+	inline std::string toString() const
 	{
-		this->value[0] = i;
-		this->value[1] = j;
-		this->value[2] = k;
-		this->value[3] = l;
+		return ::toString(*this);
 	};
-	Vector4D(const Vector4D& source)
+	inline size_t formatTo(char* buffer, const size_t& size) const
 	{
-		this->value[0] = source.value[0];
-		this->value[1] = source.value[1];
-		this->value[2] = source.value[2];
-		this->value[3] = source.value[3];
+		return ::formatTo(buffer, size, *this);
 	};
 
 	// Magnitude Operators
-	inline T length()
+	inline T length() const
 	{
-		return sqrt(
-			pow((double)this->value[0], 2.0) +
-			pow((double)this->value[1], 2.0) +
-			pow((double)this->value[2], 2.0) +
-			pow((double)this->value[3], 2.0)
-		);
+		return this->norm();
+	};
+	constexpr T sum() const
+	{
+		return VectorNorms<N, T>::sumAbs(this->value);
 	};
+	template <typename Reduction>
 	inline T sum() const
 	{
-		return (
-			abs(this->value[0]) + 
-			abs(this->value[1]) + 
-			abs(this->value[2]) + 
-			abs(this->value[3])
-		);
+		/*
+			sum() accumulated as the Reduction policy says, see vectors_reduce.h.
+		*/
+
+		return Reduction::template sum<T>(N, [this](const size_t& i) { return vectorsAbs(this->value[i]); });
 	};
 
 	// Normalization Methods
+	inline T squaredNorm() const
+	{
+		return VectorBlockKernels<T, N>::dot(this->value, this->value);
+	};
 	inline T norm() const
 	{
-		return sqrt(
-			pow((double)this->value[0], 2.0) +
-			pow((double)this->value[1], 2.0) +
-			pow((double)this->value[2], 2.0) +
-			pow((double)this->value[3], 2.0)
-		);
+		return (T)std::sqrt(this->squaredNorm());
 	};
-	inline T pNorm(const uint64_t& p) const
+	template <typename Reduction>
+	inline T squaredNorm() const
+	{
+		return Reduction::template dot<T>(this->value, this->value, N);
+	};
+	template <typename Reduction>
+	inline T norm() const
+	{
+		return (T)std::sqrt(this->template squaredNorm<Reduction>());
+	};
+	inline T fastInvNorm() const
 	{
 		/*
-			A lebesgue p-Norm, where the exponent (2) in the norm formula is generalized
-			into a variable p. Thanks again Henri!
+			An approximation of 1 / norm(), see vectorsFastInverseSqrt().
 		*/
 
-		return pow(
-			(
-				pow((double)this->value[0], (double)p) +
-				pow((double)this->value[1], (double)p) +
-				pow((double)this->value[2], (double)p) +
-				pow((double)this->value[3], (double)p)
-			),
-			(1.0 / p)
-		);
+		return vectorsFastInverseSqrt(this->squaredNorm());
 	};
-
-	inline Vector4D<T> unitNormal()
+	inline T pNorm(const uint64_t& p) const
 	{
-		return ((*this) / this->norm());
+		return VectorNorms<N, T>::pNorm(this->value, p);
 	};
-	inline Vector4D<T> normal() const
+	inline T infNorm() const
 	{
 		/*
-			Returns the normal vector, calculated from dividing each element by the sum
-			of all the elements.
+			The infinity norm, the limit of pNorm() as p grows: the largest absolute
+			element.
 		*/
 
-		T _sum = this->sum();
-		return Vector4D<T>(
-			((double)this->value[0] / _sum),
-			((double)this->value[1] / _sum),
-			((double)this->value[2] / _sum),
-			((double)this->value[3] / _sum)
-		);
+		return VectorNorms<N, T>::infNorm(this->value);
 	};
-
-	// Access Operators
-	inline T& x()
+	
+	inline Vector<N, T> unitNormal() const
 	{
-		return this->value[0];
+		return ((*this) / this->norm());
 	};
-	inline T& y()
+	inline Vector<N, T> fastUnitNormal() const
 	{
-		return this->value[1];
+		return ((*this) * this->fastInvNorm());
 	};
-	inline T& z()
+	constexpr Vector<N, T> normal() const
 	{
-		return this->value[2];
+		/*
+			Returns the normal vector, calculated from dividing each element by the sum 
+			of all the elements.
+		*/
+
+		return ((*this) / this->sum());
 	};
-	inline T& t()
+
+	// Product Operators
+	constexpr T dot(const Vector<N, T>& B) const
 	{
-		return this->value[3];
+		if (vectorsIsConstantEvaluated())
+		{
+			T value = T();
+			VectorUnroll<N>::each([&](const uint64_t& i) { value += (this->value[i] * B.value[i]); });
+			return value;
+		};
+		return VectorBlockKernels<T, N>::dot(this->value, B.value);
 	};
-	inline T& operator[](const uint64_t& i)
+	template <typename Reduction>
+	inline T dot(const Vector<N, T>& B) const
 	{
-		return this->value[i];
+		/*
+			The dot product accumulated as the Reduction policy says, see
+			vectors_reduce.h.
+		*/
+
+		return Reduction::template dot<T>(this->value, B.value, N);
 	};
-	inline T& get(const uint64_t& i)
+
+	// Vector Projection Methods
+	inline T scalarProjection(const Vector<N, T>& B) const
 	{
-		return (*this)[i];
+		return (*this).dot(B.unitNormal());
 	};
 
-	// Serialization
-	virtual inline std::string toString() const
+	// Unary Operators
+	constexpr Vector<N, T> operator+() const
 	{
-		return "(" + 
-			std::to_string(this->value[0]) + 
-			"," + std::to_string(this->value[1]) + 
-			"," + std::to_string(this->value[2]) + 
-			"," + std::to_string(this->value[3]) + 
-		")";
+		return (*this);
 	};
-
-	// Product Operators
-	inline T dot(const Vector4D<T>& B) const
+	constexpr Vector<N, T> operator-() const
 	{
-		return (
-			(this->value[0] * B.value[0]) +
-			(this->value[1] * B.value[1]) +
-			(this->value[2] * B.value[2]) +
-			(this->value[3] * B.value[3])
-		);
+		Vector<N, T> C = (*this);
+		if (vectorsIsConstantEvaluated())
+		{
+			VectorUnroll<N>::each([&](const uint64_t& i) { C.value[i] = -this->value[i]; });
+		}
+		else
+		{
+			VectorBlockKernels<T, N>::negate(this->value, C.value);
+		};
+		return C;
 	};
 
-	// Projection Operators
-	inline T scalarProjection(Vector4D<T>& B) const
+	// Comparison Operators
+	constexpr bool operator==(const Vector<N, T>& B) const
 	{
 		/*
-			Performs a scalar vector projection of this vector onto the given
-			vector (B).
+			Exact element-wise equality, so as with the elements, a vector containing
+			NaN is not equal to anything.
 		*/
-		return (*this).dot(B.unitNormal());
+
+		if (vectorsIsConstantEvaluated())
+		{
+			bool equal = true;
+			VectorUnroll<N>::each([&](const uint64_t& i) { equal = (equal && (this->value[i] == B.value[i])); });
+			return equal;
+		};
+		return VectorBlockKernels<T, N>::equal(this->value, B.value);
+	};
+	constexpr bool operator!=(const Vector<N, T>& B) const
+	{
+		return !((*this) == B);
 	};
 
 	// Binary Operators
-	inline Vector4D<T> operator+(const Vector4D<T>& B)
+	constexpr Vector<N, T> operator+(const Vector<N, T>& B) const
 	{
-		return Vector4D<T>(
-			(this->x() + B.x()),
-			(this->y() + B.y()),
-			(this->z() + B.z()),
-			(this->t() + B.t())
-		);
+		Vector<N, T> C = (*this);
+		return (C += B);
 	};
-	inline Vector4D<T> operator+(const T& B)
+	constexpr Vector<N, T> operator+(const T& B) const
 	{
-		return Vector4D<T>(
-			(this->x() + B),
-			(this->y() + B),
-			(this->z() + B),
-			(this->t() + B)
-		);
+		Vector<N, T> C = (*this);
+		return (C += B);
 	};
 
-	inline Vector4D<T> operator-(const Vector4D<T>& B)
+	constexpr Vector<N, T> operator-(const Vector<N, T>& B) const
 	{
-		return Vector4D<T>(
-			(this->x() - B.x()),
-			(this->y() - B.y()),
-			(this->z() - B.z()),
-			(this->t() - B.t())
-		);
+		Vector<N, T> C = (*this);
+		return (C -= B);
 	};
-	inline Vector4D<T> operator-(const T& B)
+	constexpr Vector<N, T> operator-(const T& B) const
 	{
-		return Vector4D<T>(
-			(this->x() - B),
-			(this->y() - B),
-			(this->z() - B),
-			(this->t() - B)
-		);
+		Vector<N, T> C = (*this);
+		return (C -= B);
 	};
 
-	inline Vector4D<T> operator*(const Vector4D<T>& B)
+	constexpr Vector<N, T> operator*(const Vector<N, T>& B) const
 	{
-		return Vector4D<T>(
-			(this->x() * B.x()),
-			(this->y() * B.y()),
-			(this->z() * B.z()),
-			(this->t() * B.t())
-		);
+		Vector<N, T> C = (*this);
+		return (C *= B);
 	};
-	inline Vector4D<T> operator*(const T& B)
+	constexpr Vector<N, T> operator*(const T& B) const
 	{
-		return Vector4D<T>(
-			(this->x() * B),
-			(this->y() * B),
-			(this->z() * B),
-			(this->t() * B)
-		);
+		Vector<N, T> C = (*this);
+		return (C *= B);
 	};
 
-	inline Vector4D<T> operator/(const Vector4D<T>& B)
+	constexpr Vector<N, T> operator/(const Vector<N, T>& B) const
 	{
-		return Vector4D<T>(
-			(this->x() / B.x()),
-			(this->y() / B.y()),
-			(this->z() / B.z()),
-			(this->t() / B.t())
-		);
+		Vector<N, T> C = (*this);
+		return (C /= B);
 	};
-	inline Vector4D<T> operator/(const T& B)
+	constexpr Vector<N, T> operator/(const T& B) const
 	{
-		return Vector4D<T>(
-			(this->x() / B),
-			(this->y() / B),
-			(this->z() / B),
-			(this->t() / B)
-		);
+		Vector<N, T> C = (*this);
+		return (C /= B);
 	};
 
 	// Binary Assignment Operators
-	inline Vector4D<T>& operator+=(const Vector4D<T>& B)
+	constexpr Vector<N, T>& operator+=(const Vector<N, T>& B)
 	{
-		this->x() = this->x() + B.x();
-		this->y() = this->y() + B.y();
-		this->z() = this->z() + B.z();
-		this->t() = this->t() + B.t();
+		if (vectorsIsConstantEvaluated())
+		{
+			VectorUnroll<N>::each([&](const uint64_t& i) { this->value[i] += B.value[i]; });
+		}
+		else
+		{
+			VectorBlockKernels<T, N>::add(this->value, B.value, this->value);
+		};
 		return (*this);
 	};
-	inline Vector4D<T>& operator+=(const T& B)
+	constexpr Vector<N, T>& operator+=(const T& B)
 	{
-		this->x() = this->x() + B;
-		this->y() = this->y() + B;
-		this->z() = this->z() + B;
-		this->t() = this->t() + B;
+		if (vectorsIsConstantEvaluated())
+		{
+			VectorUnroll<N>::each([&](const uint64_t& i) { this->value[i] += B; });
+		}
+		else
+		{
+			VectorBlockKernels<T, N>::addScalar(this->value, B, this->value);
+		};
 		return (*this);
 	};
 
-	inline Vector4D<T>& operator-=(const Vector4D<T>& B)
+	constexpr Vector<N, T>& operator-=(const Vector<N, T>& B)
 	{
-		this->x() = this->x() - B.x();
-		this->y() = this->y() - B.y();
-		this->z() = this->z() - B.z();
-		this->t() = this->t() - B.t();
+		if (vectorsIsConstantEvaluated())
+		{
+			VectorUnroll<N>::each([&](const uint64_t& i) { this->value[i] -= B.value[i]; });
+		}
+		else
+		{
+			VectorBlockKernels<T, N>::sub(this->value, B.value, this->value);
+		};
 		return (*this);
 	};
-	inline Vector4D<T>& operator-=(const T& B)
+	constexpr Vector<N, T>& operator-=(const T& B)
 	{
-		this->x() = this->x() - B;
-		this->y() = this->y() - B;
-		this->z() = this->z() - B;
-		this->t() = this->t() - B;
+		if (vectorsIsConstantEvaluated())
+		{
+			VectorUnroll<N>::each([&](const uint64_t& i) { this->value[i] -= B; });
+		}
+		else
+		{
+			VectorBlockKernels<T, N>::subScalar(this->value, B, this->value);
+		};
 		return (*this);
 	};
 
-	inline Vector4D<T>& operator*=(const Vector4D<T>& B)
+	constexpr Vector<N, T>& operator*=(const Vector<N, T>& B)
 	{
-		this->x() = this->x() * B.x();
-		this->y() = this->y() * B.y();
-		this->z() = this->z() * B.z();
-		this->t() = this->t() * B.t();
+		if (vectorsIsConstantEvaluated())
+		{
+			VectorUnroll<N>::each([&](const uint64_t& i) { this->value[i] *= B.value[i]; });
+		}
+		else
+		{
+			VectorBlockKernels<T, N>::mul(this->value, B.value, this->value);
+		};
 		return (*this);
 	};
-	inline Vector4D<T>& operator*=(const T& B)
+	constexpr Vector<N, T>& operator*=(const T& B)
 	{
-		this->x() = this->x() * B;
-		this->y() = this->y() * B;
-		this->z() = this->z() * B;
-		this->t() = this->t() *B;
+		if (vectorsIsConstantEvaluated())
+		{
+			VectorUnroll<N>::each([&](const uint64_t& i) { this->value[i] *= B; });
+		}
+		else
+		{
+			VectorBlockKernels<T, N>::mulScalar(this->value, B, this->value);
+		};
 		return (*this);
 	};
 
-	inline Vector4D<T>& operator/=(const Vector4D<T>& B)
+	constexpr Vector<N, T>& operator/=(const Vector<N, T>& B)
 	{
-		this->x() = this->x() / B.x();
-		this->y() = this->y() / B.y();
-		this->z() = this->z() / B.z();
-		this->t() = this->t() / B.t();
+		if (vectorsIsConstantEvaluated())
+		{
+			VectorUnroll<N>::each([&](const uint64_t& i) { this->value[i] /= B.value[i]; });
+		}
+		else
+		{
+			VectorBlockKernels<T, N>::div(this->value, B.value, this->value);
+		};
 		return (*this);
 	};
-	inline Vector4D<T>& operator/=(const T& B)
+	constexpr Vector<N, T>& operator/=(const T& B)
 	{
-		this->x() = this->x() / B;
-		this->y() = this->y() / B;
-		this->z() = this->z() / B;
-		this->t() = this->t() / B;
+		if (vectorsIsConstantEvaluated())
+		{
+			VectorUnroll<N>::each([&](const uint64_t& i) { this->value[i] /= B; });
+		}
+		else
+		{
+			VectorBlockKernels<T, N>::divScalar(this->value, B, this->value);
+		};
 		return (*this);
 	};
 };
 
+/* Scalar Operators */
+/*
+	The scalar-on-the-left forms of the binary operators, e.g. 2.0f * v. The scalar
+	is not deduced, so any type convertible to T is accepted.
+*/
+template <typename T>
+inline Vector2D<T> operator+(const typename std::common_type<T>::type& A, const Vector2D<T>& B) { return (B + A); };
+template <typename T>
+inline Vector2D<T> operator-(const typename std::common_type<T>::type& A, const Vector2D<T>& B) { return ((-B) + A); };
+template <typename T>
+inline Vector2D<T> operator*(const typename std::common_type<T>::type& A, const Vector2D<T>& B) { return (B * A); };
+template <typename T>
+inline Vector2D<T> operator/(const typename std::common_type<T>::type& A, const Vector2D<T>& B) { return (Vector2D<T>(A, A) / B); };
+
+template <typename T>
+inline Vector3D<T> operator+(const typename std::common_type<T>::type& A, const Vector3D<T>& B) { return (B + A); };
+template <typename T>
+inline Vector3D<T> operator-(const typename std::common_type<T>::type& A, const Vector3D<T>& B) { return ((-B) + A); };
+template <typename T>
+inline Vector3D<T> operator*(const typename std::common_type<T>::type& A, const Vector3D<T>& B) { return (B * A); };
+template <typename T>
+inline Vector3D<T> operator/(const typename std::common_type<T>::type& A, const Vector3D<T>& B) { return (Vector3D<T>(A, A, A) / B); };
+
+template <typename T>
+inline Vector4D<T> operator+(const typename std::common_type<T>::type& A, const Vector4D<T>& B) { return (B + A); };
+template <typename T>
+inline Vector4D<T> operator-(const typename std::common_type<T>::type& A, const Vector4D<T>& B) { return ((-B) + A); };
+template <typename T>
+inline Vector4D<T> operator*(const typename std::common_type<T>::type& A, const Vector4D<T>& B) { return (B * A); };
+template <typename T>
+inline Vector4D<T> operator/(const typename std::common_type<T>::type& A, const Vector4D<T>& B) { return (Vector4D<T>(A, A, A, A) / B); };
+
 template <uint64_t N, typename T>
-struct Vector
+constexpr Vector<N, T> operator+(const typename std::common_type<T>::type& A, const Vector<N, T>& B) { return (B + A); };
+template <uint64_t N, typename T>
+constexpr Vector<N, T> operator*(const typename std::common_type<T>::type& A, const Vector<N, T>& B) { return (B * A); };
+template <uint64_t N, typename T>
+constexpr Vector<N, T> operator-(const typename std::common_type<T>::type& A, const Vector<N, T>& B)
+{
+	Vector<N, T> C = B;
+	if (vectorsIsConstantEvaluated())
+	{
+		VectorUnroll<N>::each([&](const uint64_t& i) { C.value[i] = A - B.value[i]; });
+	}
+	else
+	{
+		VectorBlockKernels<T, N>::scalarSub(A, B.value, C.value);
+	};
+	return C;
+};
+template <uint64_t N, typename T>
+constexpr Vector<N, T> operator/(const typename std::common_type<T>::type& A, const Vector<N, T>& B)
+{
+	Vector<N, T> C = B;
+	if (vectorsIsConstantEvaluated())
+	{
+		VectorUnroll<N>::each([&](const uint64_t& i) { C.value[i] = A / B.value[i]; });
+	}
+	else
+	{
+		VectorBlockKernels<T, N>::scalarDiv(A, B.value, C.value);
+	};
+	return C;
+};
+
+/* Layout Guarantees */
+/*
+	Every vector type is a plain array of its elements, with no vtable or padding,
+	so that arrays of vectors can be copied with memcpy and uploaded or written
+	as-is.
+*/
+static_assert(sizeof(Vector2D<float>) == (2 * sizeof(float)), "Vector2D must be exactly 2 elements.");
+static_assert(sizeof(Vector3D<float>) == (3 * sizeof(float)), "Vector3D must be exactly 3 elements.");
+static_assert(sizeof(Vector4D<float>) == (4 * sizeof(float)), "Vector4D must be exactly 4 elements.");
+static_assert(sizeof(Vector<8, float>) == (8 * sizeof(float)), "Vector<N,T> must be exactly N elements.");
+static_assert(sizeof(Vector2D<double>) == (2 * sizeof(double)), "Vector2D must be exactly 2 elements.");
+static_assert(sizeof(Vector3D<double>) == (3 * sizeof(double)), "Vector3D must be exactly 3 elements.");
+static_assert(sizeof(Vector4D<double>) == (4 * sizeof(double)), "Vector4D must be exactly 4 elements.");
+static_assert(sizeof(Vector<8, double>) == (8 * sizeof(double)), "Vector<N,T> must be exactly N elements.");
+static_assert(std::is_trivially_copyable<Vector2D<float>>::value, "Vector2D must be trivially copyable.");
+static_assert(std::is_trivially_copyable<Vector3D<float>>::value, "Vector3D must be trivially copyable.");
+static_assert(std::is_trivially_copyable<Vector4D<float>>::value, "Vector4D must be trivially copyable.");
+static_assert(std::is_trivially_copyable<Vector<8, float>>::value, "Vector<N,T> must be trivially copyable.");
+static_assert(std::is_standard_layout<Vector2D<float>>::value, "Vector2D must be standard layout.");
+static_assert(std::is_standard_layout<Vector3D<float>>::value, "Vector3D must be standard layout.");
+static_assert(std::is_standard_layout<Vector4D<float>>::value, "Vector4D must be standard layout.");
+static_assert(std::is_standard_layout<Vector<8, float>>::value, "Vector<N,T> must be standard layout.");
+
+/* Serialization */
+template <typename T>
+constexpr size_t vectorsFormatElementLength()
 {
 	/*
-		# Vector (struct)
+		An upper bound on the characters needed to format one element, e.g.
+		"-1.2345678e-38" for a float.
 	*/
 
-	/* Elements */
-	T value[N];
+	return !std::numeric_limits<T>::is_integer ?
+		(size_t)(std::numeric_limits<T>::max_digits10 + 8) :
+		(size_t)(std::numeric_limits<T>::digits10 + 3);
+};
+template <typename V>
+constexpr size_t vectorsFormatLength()
+{
+	/*
+		An upper bound on the characters formatTo() writes for a vector of type V,
+		excluding the null terminator.
+	*/
 
-	/* Methods */
-	
-	// Constructors & Destructor
-	Vector()
-	{
-		for (uint64_t i = 0; i < N; i++)
-		{
-			this->value[i] = T();
-		};
-	};
-	Vector(const T v...)
+	return (2 + (VectorTraits<V>::dimensions * (vectorsFormatElementLength<typename VectorTraits<V>::ElementType>() + 1)));
+};
+
+template <typename T>
+inline char* vectorsFormatElement(char* first, char* last, const T& value)
+{
+	/*
+		Writes the shortest text which reads back as exactly value, returning the end
+		of the text, or nullptr if it does not fit.
+	*/
+
+#if !defined(__cpp_lib_to_chars)
+	if constexpr (std::is_floating_point<T>::value)
 	{
-		va_list args;
-		va_start(args, v);
-		this->value[0] = v;
-		for (uint64_t i = 1; i < N; i++)
+		char buffer[64];
+		const int length = snprintf(buffer, sizeof(buffer), "%.*g", std::numeric_limits<T>::max_digits10, (double)value);
+		if ((length < 0) || (length > (last - first)))
 		{
-			this->value[i] = va_arg(args, T);
+			return nullptr;
 		};
-		va_end(args);
-	};
-	Vector(const Vector<N, T>& source)
+		memcpy(first, buffer, (size_t)length);
+		return (first + length);
+	}
+	else
+#endif
 	{
-		for (uint64_t i = 0; i < N; i++)
-		{
-			this->value[i] = source.value[i];
-		};
+		const std::to_chars_result result = std::to_chars(first, last, value);
+		return (result.ec == std::errc()) ? result.ptr : nullptr;
 	};
+};
 
-	// Access Operators
-	inline T& operator[](const uint64_t& i)
-	{
-		return this->value[i];
-	};
-	inline T& get(const uint64_t& i)
+template <typename T>
+inline size_t vectorsFormatElements(char* buffer, const size_t& size, const T* A, const uint64_t& n)
+{
+	/*
+		Formats the n elements of A as "(x,y,z)", see formatTo().
+	*/
+
+	char* cursor = buffer;
+	char* const last = (buffer + size);
+	if (size < 2)
 	{
-		return (*this)[i];
+		return 0;
 	};
 
-	// Serialization
-	virtual inline std::string toString() const
+	*cursor++ = '(';
+	for (uint64_t i = 0; i < n; i++)
 	{
-		std::string s = "(";
-		for (uint64_t i = 0; i < N; i++)
+		if (i != 0)
 		{
-			s += std::to_string(this->value[i]);
-			if ((i + 1) < N)
+			if (cursor == last)
 			{
-				s += ",";
+				return 0;
 			};
+			*cursor++ = ',';
 		};
-		s += ")";
-		return s;
-	};
-
-	// Magnitude Operators
-	inline T length()
-	{
-		T sum = T();
-		for (uint64_t i = 0; i < N; i++)
+		cursor = vectorsFormatElement(cursor, last, A[i]);
+		if (cursor == nullptr)
 		{
-			sum += pow((double)this->get(i), 2.0);
+			return 0;
 		};
-
-		return sqrt(sum);
 	};
-	inline T sum()
+	if (cursor == last)
 	{
-		T sum = T();
-		for (uint64_t i = 0; i < N; i++)
-		{
-			sum += abs(this->value[i]);
-		};
-
-		return sum;
+		return 0;
+	};
+	*cursor++ = ')';
+	if (cursor != last)
+	{
+		*cursor = '\0';
 	};
+	return (size_t)(cursor - buffer);
+};
+template <typename V>
+typename std::enable_if<VectorTraits<V>::isVector, size_t>::type formatTo(char* buffer, const size_t& size, const V& value)
+{
+	/*
+		Formats value as "(x,y,z)" into buffer without allocating, using the shortest
+		representation of each element which parses back to the same value. The text
+		is null terminated when there is room. Returns the number of characters
+		written, or 0 if the buffer is too small; vectorsFormatLength<V>() characters
+		always suffice.
+	*/
 
-	// Normalization Methods
-	inline T norm() const
+	return vectorsFormatElements(buffer, size, value.value, VectorTraits<V>::dimensions);
+};
+
+template <typename T>
+std::string toString(const Vector2D<T>& value)
+{
+	char buffer[vectorsFormatLength<Vector2D<T>>()];
+	return std::string(buffer, formatTo(buffer, sizeof(buffer), value));
+};
+template <typename T>
+std::string toString(const Vector3D<T>& value)
+{
+	char buffer[vectorsFormatLength<Vector3D<T>>()];
+	return std::string(buffer, formatTo(buffer, sizeof(buffer), value));
+};
+template <typename T>
+std::string toString(const Vector4D<T>& value)
+{
+	char buffer[vectorsFormatLength<Vector4D<T>>()];
+	return std::string(buffer, formatTo(buffer, sizeof(buffer), value));
+};
+template <uint64_t N, typename T>
+std::string toString(const Vector<N, T>& value)
+{
+	/*
+		Formatted straight into the string, which may be too large for the stack.
+	*/
+
+	std::string s(vectorsFormatLength<Vector<N, T>>(), '\0');
+	s.resize(formatTo(&s[0], s.size(), value));
+	return s;
+};
+
+/* Parsing */
+template <typename T>
+inline const char* vectorsParseElement(const char* first, const char* last, T& value)
+{
+	/*
+		Reads one element, returning the end of its text or nullptr if there is no
+		valid element at first.
+	*/
+
+#if !defined(__cpp_lib_to_chars)
+	if constexpr (std::is_floating_point<T>::value)
 	{
-		T sum = T();
-		for (uint64_t i = 0; i < N; i++)
+		char buffer[64];
+		const size_t length = std::min((size_t)(last - first), sizeof(buffer) - 1);
+		memcpy(buffer, first, length);
+		buffer[length] = '\0';
+		char* end = nullptr;
+		const double parsed = strtod(buffer, &end);
+		if (end == buffer)
 		{
-			sum += pow((double)this->value[i], 2.0);
+			return nullptr;
 		};
-
-		return sqrt(sum);
-	};
-	inline T pNorm(const uint64_t& p) const
-	{
-		T sum = T();
-		for (uint64_t i = 0; i < N; i++)
+		value = (T)parsed;
+		return (first + (end - buffer));
+	}
+	else
+#endif
+	{
+		const std::from_chars_result result = std::from_chars(first, last, value);
+		if constexpr (std::is_floating_point<T>::value)
 		{
-			sum += pow((double)this->value[i], (double)p);
+			// libstdc++ before GCC 12 reports subnormal values as out of range, so
+			// those are read again with the C library and kept if they are subnormal.
+			char buffer[64];
+			const size_t length = (size_t)(result.ptr - first);
+			if ((result.ec == std::errc::result_out_of_range) && (length < sizeof(buffer)))
+			{
+				memcpy(buffer, first, length);
+				buffer[length] = '\0';
+				T parsed;
+				if constexpr (std::is_same<T, float>::value)
+				{
+					parsed = strtof(buffer, nullptr);
+				}
+				else if constexpr (std::is_same<T, double>::value)
+				{
+					parsed = strtod(buffer, nullptr);
+				}
+				else
+				{
+					parsed = (T)strtold(buffer, nullptr);
+				};
+				if (std::fpclassify(parsed) != FP_SUBNORMAL)
+				{
+					return nullptr;
+				};
+				value = parsed;
+				return result.ptr;
+			};
 		};
-
-		return pow(sum, (1.0/(double)p));
+		return (result.ec == std::errc()) ? result.ptr : nullptr;
 	};
-	
-	inline Vector<N, T> unitNormal()
+};
+inline const char* vectorsSkipSpace(const char* first, const char* last)
+{
+	while ((first != last) && ((*first == ' ') || (*first == '\t') || (*first == '\r') || (*first == '\n')))
 	{
-		// @todo: Compiler error arises here - because the binary operators aren't defined.
-		return ((*this) / this->norm());
+		first++;
 	};
-	inline Vector<N, T> normal() const
-	{
-		T _sum = this->sum();
-		Vector<N, T> v;
+	return first;
+};
 
-		for (uint64_t i = 0; i < N; i++)
-		{
-			v.get(i) = (this->get(i) / _sum);
-		};
+template <typename V>
+typename std::enable_if<VectorTraits<V>::isVector, const char*>::type parse(const char* first, const char* last, V& value)
+{
+	/*
+		Parses a vector written as "(x,y,z)", as produced by formatTo() and
+		toString(), from the text [first, last). Whitespace is allowed around the
+		parentheses and elements. Returns the end of the parsed text, so records can
+		be read one after another, or nullptr if the text is not a vector of exactly
+		the right dimensions; value is only modified on success.
+	*/
+
+	typedef typename VectorTraits<V>::ElementType T;
 
-		return v;
+	V parsed;
+	first = vectorsSkipSpace(first, last);
+	if ((first == last) || (*first != '('))
+	{
+		return nullptr;
 	};
+	first++;
 
-	// Product Operators
-	inline T dot(const Vector<N, T>& B) const
+	for (uint64_t i = 0; i < VectorTraits<V>::dimensions; i++)
 	{
-		T value = T();
-		for (uint64_t i = 0; i < N; i++)
+		first = vectorsSkipSpace(first, last);
+		T element;
+		first = vectorsParseElement(first, last, element);
+		if (first == nullptr)
 		{
-			value += (this->value[i] * ((Vector<N,T>&)B).value[i]);
+			return nullptr;
 		};
+		parsed.value[i] = element;
 
-		return value;
+		first = vectorsSkipSpace(first, last);
+		const char expected = ((i + 1) < VectorTraits<V>::dimensions) ? ',' : ')';
+		if ((first == last) || (*first != expected))
+		{
+			return nullptr;
+		};
+		first++;
 	};
 
-	// Vector Projection Methods
-	inline T scalarProjection(Vector<N, T>& B) const
+	value = parsed;
+	return first;
+};
+template <typename V>
+typename std::enable_if<VectorTraits<V>::isVector, bool>::type parse(const std::string_view& text, V& value)
+{
+	/*
+		Parses text which holds exactly one vector, optionally surrounded by
+		whitespace. As with the other form, value is only modified on success.
+	*/
+
+	const char* last = (text.data() + text.size());
+	V parsed;
+	const char* end = parse(text.data(), last, parsed);
+	if ((end == nullptr) || (vectorsSkipSpace(end, last) != last))
 	{
-		return (*this).dot(B.unitNormal());
+		return false;
 	};
+	value = parsed;
+	return true;
 };
 
 /* Pipe Operators */
 template <typename T>
+std::ostream& vectorsWriteElements(std::ostream& stream, const T* A, const uint64_t& n)
+{
+	/*
+		Streams the n elements of A without building a string, one element at a time.
+	*/
+
+	char buffer[vectorsFormatElementLength<T>() + 1];
+	stream.put('(');
+	for (uint64_t i = 0; i < n; i++)
+	{
+		char* end = buffer;
+		if (i != 0)
+		{
+			*end++ = ',';
+		};
+		end = vectorsFormatElement(end, (buffer + sizeof(buffer)), A[i]);
+		stream.write(buffer, (end - buffer));
+	};
+	return stream.put(')');
+};
+template <typename V>
+std::ostream& vectorsWrite(std::ostream& stream, const V& value)
+{
+	return vectorsWriteElements(stream, value.value, VectorTraits<V>::dimensions);
+};
+template <typename T>
 std::ostream& operator<<(std::ostream& stream, const Vector2D<T>& value)
 {
-	return stream << value.toString();
+	return vectorsWrite(stream, value);
 };
 template <typename T>
 std::ostream& operator<<(std::ostream& stream, const Vector3D<T>& value)
 {
-	return stream << value.toString();
+	return vectorsWrite(stream, value);
 };
 template <typename T>
 std::ostream& operator<<(std::ostream& stream, const Vector4D<T>& value)
 {
-	return stream << value.toString();
+	return vectorsWrite(stream, value);
 };
 template <uint64_t N, typename T>
 std::ostream& operator<<(std::ostream& stream, const Vector<N,T>& value)
 {
-	return stream << value.toString();
+	return vectorsWrite(stream, value);
+};
+
+/* Formatters */
+/*
+	std::format (C++20) and {fmt} support. The {fmt} formatters are only defined
+	when fmt is included before this header. Both accept only an empty format
+	specification, e.g. "{}".
+*/
+template <typename V>
+struct VectorFormatter
+{
+	template <typename Context>
+	constexpr auto parse(Context& context) -> decltype(context.begin())
+	{
+		auto cursor = context.begin();
+		if ((cursor != context.end()) && (*cursor != '}'))
+		{
+			VectorFormatter::invalidSpecification();
+		};
+		return cursor;
+	};
+	template <typename Context>
+	auto format(const V& value, Context& context) const -> decltype(context.out())
+	{
+		char buffer[vectorsFormatLength<V>()];
+		const size_t length = formatTo(buffer, sizeof(buffer), value);
+		auto out = context.out();
+		for (size_t i = 0; i < length; i++)
+		{
+			*out++ = buffer[i];
+		};
+		return out;
+	};
+
+private:
+	static void invalidSpecification()
+	{
+		/*
+			Not constexpr, so an invalid specification is a compile time error in a
+			checked format string.
+		*/
+	};
 };
 
+#if defined(__cpp_lib_format)
+template <typename T>
+struct std::formatter<Vector2D<T>, char> : VectorFormatter<Vector2D<T>> {};
+template <typename T>
+struct std::formatter<Vector3D<T>, char> : VectorFormatter<Vector3D<T>> {};
+template <typename T>
+struct std::formatter<Vector4D<T>, char> : VectorFormatter<Vector4D<T>> {};
+template <uint64_t N, typename T>
+struct std::formatter<Vector<N, T>, char> : VectorFormatter<Vector<N, T>> {};
+#endif
+#if defined(FMT_VERSION)
+template <typename T>
+struct fmt::formatter<Vector2D<T>, char> : VectorFormatter<Vector2D<T>> {};
+template <typename T>
+struct fmt::formatter<Vector3D<T>, char> : VectorFormatter<Vector3D<T>> {};
+template <typename T>
+struct fmt::formatter<Vector4D<T>, char> : VectorFormatter<Vector4D<T>> {};
+template <uint64_t N, typename T>
+struct fmt::formatter<Vector<N, T>, char> : VectorFormatter<Vector<N, T>> {};
+#endif
+
 #endif
\ No newline at end of file
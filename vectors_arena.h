@@ -0,0 +1,583 @@
+#pragma once
+/*
+	# Vector Template Library - Arenas & Aligned Arrays
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	Allocation for short lived arrays of vectors, such as per-frame scratch
+	space or the candidate lists of a query:
+
+		* VectorArena, a bump allocator over large blocks which hands out cache
+		  line aligned memory, frees all of it at once with an O(1) reset(), and
+		  can place its blocks on a given NUMA node.
+		* AlignedVectorArray<V, Alignment>, a contiguous array of vectors, like
+		  std::vector, whose storage is aligned to 32 or 64 bytes for the aligned
+		  and streaming loads and stores of SIMD kernels, and which comes from an
+		  arena or from the heap.
+		* VectorArenaAllocator<T>, an allocator adapter for the standard
+		  containers.
+
+		VectorArena frame;
+		AlignedVectorArray<Vector3D<float>> scratch(frame);
+		for (each frame)
+		{
+			frame.reset();
+			scratch.clear();
+			...
+		}
+
+	Arenas aren't thread safe; give each thread (or each frame in flight) its
+	own. Without a NUMA node, a block's pages are placed by the usual first
+	touch policy, on the node of the thread that first writes to them, so an
+	arena is best created and first used on the thread which uses it.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+#ifndef VECTOR_TEMPLATE_LIBRARY_ARENA__H
+#define VECTOR_TEMPLATE_LIBRARY_ARENA__H
+/* Deps */
+#include "vectors.h"
+#include "vectors_soa.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if defined(__linux__)
+	#include <sys/syscall.h>
+	#include <unistd.h>
+#endif
+
+/* NUMA */
+inline int vectorsNumaNode()
+{
+	/*
+		The NUMA node the calling thread is running on, or -1 if it isn't known.
+	*/
+
+#if defined(__linux__) && defined(SYS_getcpu)
+	unsigned int cpu = 0;
+	unsigned int node = 0;
+	if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+	{
+		return (int)node;
+	};
+#endif
+	return -1;
+};
+inline bool vectorsPlaceOnNode(void* pointer, const size_t& size, const int& node)
+{
+	/*
+		Asks for the pages of the page aligned range at pointer to be placed on the
+		given NUMA node when they are first touched, falling back to other nodes
+		when it is full. Returns false if that isn't supported.
+	*/
+
+#if defined(__linux__) && defined(SYS_mbind)
+	if ((node < 0) || (node >= 64))
+	{
+		return false;
+	};
+	const unsigned long mask = (1UL << node);
+	const long preferred = 1; // MPOL_PREFERRED
+	return (syscall(SYS_mbind, pointer, (unsigned long)size, preferred, &mask, (unsigned long)(8 * sizeof(mask)), 0U) == 0);
+#else
+	(void)pointer;
+	(void)size;
+	(void)node;
+	return false;
+#endif
+};
+
+/* Arena */
+struct VectorArena
+{
+	/*
+		# Vector Arena (struct)
+		Hands out memory from a list of page aligned blocks, one after another.
+		Nothing is freed on its own: reset() (or rewind()) makes all (or the latest)
+		of it available again without returning the blocks, so an arena stops
+		allocating once it has grown to its peak use.
+	*/
+
+	static constexpr size_t alignment = 64; // The default alignment, a cache line.
+	static constexpr size_t page = 4096;
+
+	struct Marker
+	{
+		size_t block;
+		size_t offset;
+	};
+
+	/* Methods */
+
+	// Constructors & Destructor
+	explicit VectorArena(const size_t& blockSize = (1 << 20), const int& node = -1) : blockSize(std::max(blockSize, page)), node(node) {};
+	VectorArena(const VectorArena&) = delete;
+	VectorArena& operator=(const VectorArena&) = delete;
+	~VectorArena()
+	{
+		this->release();
+	};
+
+	// Allocation
+	inline void* allocate(const size_t& size, const size_t& align = alignment)
+	{
+		/*
+			Returns size bytes aligned to align, a power of two no larger than a page.
+			Throws std::bad_alloc if a new block can't be allocated.
+		*/
+
+		for (;;)
+		{
+			if (this->current < this->blocks.size())
+			{
+				const Block& block = this->blocks[this->current];
+				const size_t start = ((this->offset + align - 1) & ~(align - 1));
+				if ((start + size) <= block.size)
+				{
+					this->offset = (start + size);
+					return (block.data + start);
+				};
+				if ((this->current + 1) < this->blocks.size())
+				{
+					this->current++;
+					this->offset = 0;
+					continue;
+				};
+			};
+			this->grow(size);
+		};
+	};
+	template <typename V>
+	inline V* allocate(const size_t& n, const size_t& align = alignment)
+	{
+		/*
+			Returns room for n vectors. The memory isn't initialized.
+		*/
+
+		static_assert(std::is_trivially_destructible<V>::value, "Arena memory is never destroyed.");
+		return (V*)this->allocate((n * sizeof(V)), std::max(align, alignof(V)));
+	};
+
+	// Resetting
+	inline Marker mark() const
+	{
+		return Marker{this->current, this->offset};
+	};
+	inline void rewind(const Marker& marker)
+	{
+		/*
+			Frees everything allocated since marker was taken.
+		*/
+
+		this->current = marker.block;
+		this->offset = marker.offset;
+	};
+	inline void reset()
+	{
+		/*
+			Frees everything allocated, keeping the blocks for reuse.
+		*/
+
+		this->rewind(Marker{0, 0});
+		this->generation++;
+	};
+	inline void release()
+	{
+		/*
+			Frees everything allocated and returns the blocks to the heap.
+		*/
+
+		for (const Block& block : this->blocks)
+		{
+			vectorsAlignedFree(block.data, page);
+		};
+		this->blocks.clear();
+		this->reset();
+	};
+
+	// Capacity Methods
+	inline size_t reserved() const
+	{
+		/*
+			The total size of the blocks, in bytes.
+		*/
+
+		size_t total = 0;
+		for (const Block& block : this->blocks)
+		{
+			total += block.size;
+		};
+		return total;
+	};
+	inline uint64_t resets() const
+	{
+		/*
+			The number of times the arena has been reset, which AlignedVectorArray uses
+			to tell that its storage has been freed.
+		*/
+
+		return this->generation;
+	};
+	inline int numaNode() const
+	{
+		return this->node;
+	};
+
+private:
+	struct Block
+	{
+		unsigned char* data;
+		size_t size;
+	};
+
+	/* Elements */
+	std::vector<Block> blocks;
+	size_t current = 0;
+	size_t offset = 0;
+	size_t blockSize;
+	int node;
+	uint64_t generation = 0;
+
+	/* Methods */
+	inline void grow(const size_t& size)
+	{
+		/*
+			Adds a block with room for at least size bytes after the current one.
+		*/
+
+		const size_t bytes = (((std::max(this->blockSize, (size + page)) + page - 1) / page) * page);
+		Block block;
+		block.data = (unsigned char*)vectorsAlignedAlloc(bytes, page);
+		block.size = bytes;
+		if (this->node >= 0)
+		{
+			vectorsPlaceOnNode(block.data, bytes, this->node);
+		};
+
+		const size_t position = std::min(this->blocks.size(), (this->current + 1));
+		this->blocks.insert(this->blocks.begin() + position, block);
+		this->current = position;
+		this->offset = 0;
+	};
+};
+
+/* Arena Allocator */
+template <typename T>
+struct VectorArenaAllocator
+{
+	/*
+		# Vector Arena Allocator (struct)
+		Lets standard containers allocate from a VectorArena, cache line aligned.
+		Deallocation does nothing; the memory is freed when the arena is reset.
+	*/
+
+	typedef T value_type;
+
+	/* Elements */
+	VectorArena* arena;
+
+	/* Methods */
+
+	// Constructors & Destructor
+	VectorArenaAllocator(VectorArena& arena) : arena(&arena) {};
+	template <typename U>
+	VectorArenaAllocator(const VectorArenaAllocator<U>& source) : arena(source.arena) {};
+
+	// Allocation
+	inline T* allocate(const size_t& n)
+	{
+		return (T*)this->arena->allocate((n * sizeof(T)), std::max(VectorArena::alignment, alignof(T)));
+	};
+	inline void deallocate(T*, const size_t&) {};
+
+	// Comparison Operators
+	template <typename U>
+	inline bool operator==(const VectorArenaAllocator<U>& B) const
+	{
+		return (this->arena == B.arena);
+	};
+	template <typename U>
+	inline bool operator!=(const VectorArenaAllocator<U>& B) const
+	{
+		return (this->arena != B.arena);
+	};
+};
+
+/* Aligned Vector Array */
+template <typename V, size_t Alignment = 64>
+struct AlignedVectorArray
+{
+	/*
+		# Aligned Vector Array (struct)
+		A growable, contiguous array of vectors whose storage starts on an Alignment
+		byte boundary and is a whole number of Alignment bytes long, so kernels can
+		use aligned (and streaming) loads and stores over all of it, tail included.
+
+		The storage comes from the heap, or from an arena if one is given. Growing an
+		arena backed array leaves its old storage in the arena until it is reset.
+		Once the arena is reset the array is empty again, and takes new storage from
+		the arena when it next grows.
+	*/
+
+	static_assert(std::is_trivially_copyable<V>::value, "Aligned arrays copy vectors bytewise.");
+	static_assert(((Alignment & (Alignment - 1)) == 0) && (Alignment >= alignof(V)), "The alignment must be a power of two, at least the vector's own.");
+
+	typedef V value_type;
+
+	static constexpr size_t alignment = Alignment;
+
+	/* Methods */
+
+	// Constructors & Destructor
+	AlignedVectorArray() {};
+	explicit AlignedVectorArray(VectorArena& arena) : arena(&arena), generation(arena.resets()) {};
+	explicit AlignedVectorArray(const size_t& n, VectorArena* arena = nullptr) : arena(arena), generation((arena != nullptr) ? arena->resets() : 0)
+	{
+		this->resize(n);
+	};
+	AlignedVectorArray(const AlignedVectorArray& source) : arena(source.arena), generation(source.generation)
+	{
+		(*this) = source;
+	};
+	AlignedVectorArray(AlignedVectorArray&& source) noexcept
+	{
+		this->swap(source);
+	};
+	~AlignedVectorArray()
+	{
+		this->release();
+	};
+
+	// Assignment Operators
+	inline AlignedVectorArray& operator=(const AlignedVectorArray& source)
+	{
+		if (this != &source)
+		{
+			const size_t n = source.size();
+			this->clear();
+			this->reserve(n);
+			if (n > 0)
+			{
+				memcpy((void*)this->vectors, (const void*)source.vectors, (n * sizeof(V)));
+			};
+			this->count = n;
+		};
+		return (*this);
+	};
+	inline AlignedVectorArray& operator=(AlignedVectorArray&& source) noexcept
+	{
+		this->swap(source);
+		return (*this);
+	};
+
+	// Capacity Methods
+	inline size_t size() const
+	{
+		return this->stale() ? 0 : this->count;
+	};
+	inline bool empty() const
+	{
+		return (this->size() == 0);
+	};
+	inline size_t capacity() const
+	{
+		return this->stale() ? 0 : this->slots;
+	};
+	inline void reserve(const size_t& n)
+	{
+		this->refresh();
+		if (n <= this->slots)
+		{
+			return;
+		};
+
+		const size_t bytes = (((n * sizeof(V)) + Alignment - 1) & ~(Alignment - 1));
+		V* storage = (V*)((this->arena != nullptr) ? this->arena->allocate(bytes, Alignment) : vectorsAlignedAlloc(bytes, Alignment));
+		if (this->count > 0)
+		{
+			memcpy((void*)storage, (const void*)this->vectors, (this->count * sizeof(V)));
+		};
+		this->deallocate();
+		this->vectors = storage;
+		this->slots = (bytes / sizeof(V));
+	};
+	inline void resize(const size_t& n)
+	{
+		/*
+			Resizes to n vectors, with new vectors set to V().
+		*/
+
+		this->reserve(n);
+		for (size_t i = this->count; i < n; i++)
+		{
+			this->vectors[i] = V();
+		};
+		this->count = n;
+	};
+	inline void clear()
+	{
+		/*
+			Empties the array in O(1), keeping its storage unless its arena has been
+			reset since it was allocated.
+		*/
+
+		this->refresh();
+		this->count = 0;
+	};
+	inline void release()
+	{
+		/*
+			Empties the array and frees its storage (or leaves it to the arena).
+		*/
+
+		this->deallocate();
+		this->vectors = nullptr;
+		this->count = 0;
+		this->slots = 0;
+	};
+	inline void swap(AlignedVectorArray& B) noexcept
+	{
+		std::swap(this->vectors, B.vectors);
+		std::swap(this->count, B.count);
+		std::swap(this->slots, B.slots);
+		std::swap(this->arena, B.arena);
+		std::swap(this->generation, B.generation);
+	};
+
+	// Insertion
+	inline void push_back(const V& B)
+	{
+		/*
+			Appends B, which may be an element of the array: it is copied before the
+			array grows.
+		*/
+
+		this->refresh();
+		const V value = B;
+		if (this->count == this->slots)
+		{
+			this->reserve(std::max((this->slots * 2), (size_t)16));
+		};
+		this->vectors[this->count] = value;
+		this->count++;
+	};
+	inline void append(const V* A, const size_t& n)
+	{
+		/*
+			Appends A[0] .. A[n - 1], which must not point into the array.
+		*/
+
+		this->refresh();
+		if ((this->count + n) > this->slots)
+		{
+			this->reserve(std::max((this->slots * 2), (this->count + n)));
+		};
+		if (n > 0)
+		{
+			memcpy((void*)(this->vectors + this->count), (const void*)A, (n * sizeof(V)));
+		};
+		this->count += n;
+	};
+	inline void pop_back()
+	{
+		this->count--;
+	};
+
+	// Access Operators
+	inline V* data()
+	{
+		this->refresh();
+		return vectorsAssumeAligned<Alignment>(this->vectors);
+	};
+	inline const V* data() const
+	{
+		return this->stale() ? nullptr : vectorsAssumeAligned<Alignment>((const V*)this->vectors);
+	};
+	inline V& operator[](const size_t& i)
+	{
+		return this->vectors[i];
+	};
+	inline const V& operator[](const size_t& i) const
+	{
+		return this->vectors[i];
+	};
+	inline V& get(const size_t& i)
+	{
+		return (*this)[i];
+	};
+	inline const V& get(const size_t& i) const
+	{
+		return (*this)[i];
+	};
+	inline V& back()
+	{
+		return this->vectors[this->count - 1];
+	};
+	inline const V& back() const
+	{
+		return this->vectors[this->count - 1];
+	};
+	inline V* begin()
+	{
+		return this->data();
+	};
+	inline const V* begin() const
+	{
+		return this->data();
+	};
+	inline V* end()
+	{
+		return (this->data() + this->count);
+	};
+	inline const V* end() const
+	{
+		return (this->data() + this->size());
+	};
+
+private:
+	/* Elements */
+	V* vectors = nullptr;
+	size_t count = 0;
+	size_t slots = 0;
+	VectorArena* arena = nullptr;
+	uint64_t generation = 0;
+
+	/* Methods */
+	inline bool stale() const
+	{
+		/*
+			Whether the storage was freed by an arena reset since it was allocated.
+		*/
+
+		return ((this->arena != nullptr) && (this->generation != this->arena->resets()));
+	};
+	inline void refresh()
+	{
+		/*
+			Forgets storage which an arena reset has freed.
+		*/
+
+		if (this->stale())
+		{
+			this->vectors = nullptr;
+			this->count = 0;
+			this->slots = 0;
+			this->generation = this->arena->resets();
+		};
+	};
+	inline void deallocate()
+	{
+		if ((this->arena == nullptr) && (this->vectors != nullptr))
+		{
+			vectorsAlignedFree(this->vectors, Alignment);
+		};
+	};
+};
+
+#endif
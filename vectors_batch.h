@@ -0,0 +1,700 @@
+#pragma once
+/*
+	# Vector Template Library - Batch Operations
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	Free functions which apply the vector operations over contiguous arrays of
+	vectors (a pointer and a count), such as a std::vector<Vector3D<float>>. Each
+	operation is compiled for several instruction sets and the best one supported
+	by the running CPU (SSE2, AVX2 or AVX-512) is picked the first time a batch
+	operation is called.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+#ifndef VECTOR_TEMPLATE_LIBRARY_BATCH__H
+#define VECTOR_TEMPLATE_LIBRARY_BATCH__H
+/* Deps */
+#include "vectors.h"
+#include <stddef.h>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#if defined(__has_include)
+	#if __has_include(<span>)
+		#include <span>
+	#endif
+#endif
+
+/* Dispatch */
+#if !defined(VECTORS_NO_SIMD) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+	#define VECTORS_DISPATCH 1
+#else
+	#define VECTORS_DISPATCH 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+	#define VECTORS_ALWAYS_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+	#define VECTORS_ALWAYS_INLINE __forceinline
+#else
+	#define VECTORS_ALWAYS_INLINE inline
+#endif
+
+#if VECTORS_DISPATCH
+	#define VECTORS_TARGET_AVX2 __attribute__((target("avx2,fma,f16c")))
+	#define VECTORS_TARGET_AVX512 __attribute__((target("avx512f,avx512vl,avx512dq,avx2,fma,f16c")))
+#endif
+
+enum VectorsISA : int
+{
+	VECTORS_ISA_GENERIC = 0,
+	VECTORS_ISA_AVX2 = 1,
+	VECTORS_ISA_AVX512 = 2
+};
+
+inline int& vectorsISAOverride()
+{
+	static int isa = -1;
+	return isa;
+};
+inline VectorsISA vectorsDetectISA()
+{
+	/*
+		Returns the widest instruction set the running CPU supports out of the ones the
+		batch operations are compiled for.
+	*/
+
+#if VECTORS_DISPATCH
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("f16c"))
+	{
+		return VECTORS_ISA_AVX512;
+	};
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") && __builtin_cpu_supports("f16c"))
+	{
+		return VECTORS_ISA_AVX2;
+	};
+#endif
+	return VECTORS_ISA_GENERIC;
+};
+inline VectorsISA vectorsBatchISA()
+{
+	/*
+		The instruction set batch operations run with. Detected once, unless forced
+		with vectorsForceISA().
+	*/
+
+	static const VectorsISA detected = vectorsDetectISA();
+	const int forced = vectorsISAOverride();
+	return ((forced >= 0) && (forced < detected)) ? (VectorsISA)forced : detected;
+};
+inline void vectorsForceISA(const VectorsISA& isa)
+{
+	/*
+		Caps the instruction set used by batch operations, e.g. to compare paths in a
+		benchmark. It can't raise the level past what the CPU supports.
+	*/
+
+	vectorsISAOverride() = (int)isa;
+};
+inline void vectorsResetISA()
+{
+	vectorsISAOverride() = -1;
+};
+
+/* Math Helpers */
+template <int ISA>
+struct VectorsBatchMath
+{
+	/*
+		# Vectors Batch Math (struct)
+		Square roots over a small block of values. The compiler won't vectorize sqrt
+		while it may set errno, so the wider instruction sets use intrinsics for it.
+	*/
+
+	template <typename T>
+	static VECTORS_ALWAYS_INLINE void sqrt(T* values, const size_t& n)
+	{
+		for (size_t i = 0; i < n; i++)
+		{
+			values[i] = (T)std::sqrt(values[i]);
+		};
+	};
+#if VECTORS_SSE
+	static VECTORS_ALWAYS_INLINE void sqrt(float* values, const size_t& n)
+	{
+		size_t i = 0;
+		for (; (i + 4) <= n; i += 4)
+		{
+			_mm_storeu_ps(values + i, _mm_sqrt_ps(_mm_loadu_ps(values + i)));
+		};
+		for (; i < n; i++)
+		{
+			values[i] = std::sqrt(values[i]);
+		};
+	};
+	static VECTORS_ALWAYS_INLINE void sqrt(double* values, const size_t& n)
+	{
+		size_t i = 0;
+		for (; (i + 2) <= n; i += 2)
+		{
+			_mm_storeu_pd(values + i, _mm_sqrt_pd(_mm_loadu_pd(values + i)));
+		};
+		for (; i < n; i++)
+		{
+			values[i] = std::sqrt(values[i]);
+		};
+	};
+#endif
+};
+
+#if VECTORS_DISPATCH
+template <>
+struct VectorsBatchMath<VECTORS_ISA_AVX2>
+{
+	template <typename T>
+	static VECTORS_ALWAYS_INLINE void sqrt(T* values, const size_t& n)
+	{
+		VectorsBatchMath<VECTORS_ISA_GENERIC>::sqrt(values, n);
+	};
+	VECTORS_TARGET_AVX2 static inline void sqrt(float* values, const size_t& n)
+	{
+		size_t i = 0;
+		for (; (i + 8) <= n; i += 8)
+		{
+			_mm256_storeu_ps(values + i, _mm256_sqrt_ps(_mm256_loadu_ps(values + i)));
+		};
+		for (; i < n; i++)
+		{
+			values[i] = std::sqrt(values[i]);
+		};
+	};
+	VECTORS_TARGET_AVX2 static inline void sqrt(double* values, const size_t& n)
+	{
+		size_t i = 0;
+		for (; (i + 4) <= n; i += 4)
+		{
+			_mm256_storeu_pd(values + i, _mm256_sqrt_pd(_mm256_loadu_pd(values + i)));
+		};
+		for (; i < n; i++)
+		{
+			values[i] = std::sqrt(values[i]);
+		};
+	};
+};
+
+template <>
+struct VectorsBatchMath<VECTORS_ISA_AVX512>
+{
+	template <typename T>
+	static VECTORS_ALWAYS_INLINE void sqrt(T* values, const size_t& n)
+	{
+		VectorsBatchMath<VECTORS_ISA_GENERIC>::sqrt(values, n);
+	};
+	VECTORS_TARGET_AVX512 static inline void sqrt(float* values, const size_t& n)
+	{
+		size_t i = 0;
+		for (; (i + 16) <= n; i += 16)
+		{
+			_mm512_storeu_ps(values + i, _mm512_maskz_sqrt_ps((__mmask16)0xFFFF, _mm512_loadu_ps(values + i)));
+		};
+		for (; i < n; i++)
+		{
+			values[i] = std::sqrt(values[i]);
+		};
+	};
+	VECTORS_TARGET_AVX512 static inline void sqrt(double* values, const size_t& n)
+	{
+		size_t i = 0;
+		for (; (i + 8) <= n; i += 8)
+		{
+			_mm512_storeu_pd(values + i, _mm512_maskz_sqrt_pd((__mmask8)0xFF, _mm512_loadu_pd(values + i)));
+		};
+		for (; i < n; i++)
+		{
+			values[i] = std::sqrt(values[i]);
+		};
+	};
+};
+
+/* Reduction Helpers */
+VECTORS_TARGET_AVX2 inline float vectorsReduceAdd(const __m256 v)
+{
+	return vectorsHorizontalSum(_mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1)));
+};
+VECTORS_TARGET_AVX2 inline int32_t vectorsReduceAdd(const __m256i v)
+{
+	__m128i sums = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+	sums = _mm_add_epi32(sums, _mm_shuffle_epi32(sums, _MM_SHUFFLE(1, 0, 3, 2)));
+	sums = _mm_add_epi32(sums, _mm_shuffle_epi32(sums, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtsi128_si32(sums);
+};
+VECTORS_TARGET_AVX512 inline float vectorsReduceAdd(const __m512 v)
+{
+	/*
+		_mm512_reduce_add_* and the 512 to 256 bit casts trip a spurious uninitialized
+		warning in GCC 12, so both halves are extracted with a zeroing mask instead.
+	*/
+
+	const __m256 halves = _mm256_add_ps(
+		_mm256_castpd_ps(_mm512_maskz_extractf64x4_pd((__mmask8)0xF, _mm512_castps_pd(v), 0)),
+		_mm256_castpd_ps(_mm512_maskz_extractf64x4_pd((__mmask8)0xF, _mm512_castps_pd(v), 1))
+	);
+	return vectorsHorizontalSum(_mm_add_ps(_mm256_castps256_ps128(halves), _mm256_extractf128_ps(halves, 1)));
+};
+VECTORS_TARGET_AVX512 inline double vectorsReduceAdd(const __m512d v)
+{
+	const __m256d halves = _mm256_add_pd(_mm512_maskz_extractf64x4_pd((__mmask8)0xF, v, 0), _mm512_maskz_extractf64x4_pd((__mmask8)0xF, v, 1));
+	const __m128d quarters = _mm_add_pd(_mm256_castpd256_pd128(halves), _mm256_extractf128_pd(halves, 1));
+	return _mm_cvtsd_f64(_mm_add_sd(quarters, _mm_unpackhi_pd(quarters, quarters)));
+};
+VECTORS_TARGET_AVX512 inline int32_t vectorsReduceAdd(const __m512i v)
+{
+	return vectorsReduceAdd(_mm256_add_epi32(_mm512_maskz_extracti64x4_epi64((__mmask8)0xF, v, 0), _mm512_maskz_extracti64x4_epi64((__mmask8)0xF, v, 1)));
+};
+
+template <typename Kernel, typename... Args>
+VECTORS_TARGET_AVX2 inline auto vectorsRunAVX2(Args... args) -> decltype(Kernel::template run<VECTORS_ISA_GENERIC>(args...))
+{
+	return Kernel::template run<VECTORS_ISA_AVX2>(args...);
+};
+template <typename Kernel, typename... Args>
+VECTORS_TARGET_AVX512 inline auto vectorsRunAVX512(Args... args) -> decltype(Kernel::template run<VECTORS_ISA_GENERIC>(args...))
+{
+	return Kernel::template run<VECTORS_ISA_AVX512>(args...);
+};
+#endif
+
+template <typename Kernel, typename... Args>
+inline auto vectorsDispatch(Args... args) -> decltype(Kernel::template run<VECTORS_ISA_GENERIC>(args...))
+{
+	/*
+		Runs Kernel::run<ISA>() compiled for the instruction set picked by
+		vectorsBatchISA(). The kernel bodies are force-inlined into per instruction set
+		entry points, so the same source is vectorized once for each of them.
+	*/
+
+#if VECTORS_DISPATCH
+	switch (vectorsBatchISA())
+	{
+	case VECTORS_ISA_AVX512:
+		return vectorsRunAVX512<Kernel>(args...);
+	case VECTORS_ISA_AVX2:
+		return vectorsRunAVX2<Kernel>(args...);
+	default:
+		break;
+	};
+#endif
+	return Kernel::template run<VECTORS_ISA_GENERIC>(args...);
+};
+
+/* Kernels */
+template <typename V>
+struct VectorsBatchKernels
+{
+	/*
+		# Vectors Batch Kernels (struct)
+		The loop bodies behind the batch operations. They work on the raw elements
+		rather than the vector methods so the compiler can vectorize across vectors,
+		and work in blocks of a fixed number of vectors so square roots and
+		reductions have something wide to work on.
+	*/
+
+	typedef typename VectorTraits<V>::ElementType T;
+	static constexpr uint64_t D = VectorTraits<V>::dimensions;
+	static constexpr size_t block = 16;
+	// The components per pass of Sum and Bounds, which keep block partial results
+	// for each, so their stack use is bounded (at 4 KiB an array) whatever D is.
+	static constexpr uint64_t columns = (((D * block * sizeof(T)) <= 4096) ? D : std::max<uint64_t>(1, (4096 / (block * sizeof(T)))));
+
+	struct Dot
+	{
+		template <int ISA>
+		static VECTORS_ALWAYS_INLINE void run(const V* A, const V* B, T* out, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				T value = A[i].value[0] * B[i].value[0];
+				for (uint64_t c = 1; c < D; c++)
+				{
+					value += A[i].value[c] * B[i].value[c];
+				};
+				out[i] = value;
+			};
+		};
+	};
+
+	struct Norm
+	{
+		template <int ISA>
+		static VECTORS_ALWAYS_INLINE void run(const V* A, T* out, size_t n)
+		{
+			Dot::template run<ISA>(A, A, out, n);
+			VectorsBatchMath<ISA>::sqrt(out, n);
+		};
+	};
+
+	struct Normalize
+	{
+		template <int ISA>
+		static VECTORS_ALWAYS_INLINE void run(const V* A, V* out, size_t n)
+		{
+			for (size_t i = 0; i < n; i += block)
+			{
+				const size_t count = ((n - i) < block) ? (n - i) : block;
+				T scales[block];
+				Dot::template run<ISA>(A + i, A + i, scales, count);
+				VectorsBatchMath<ISA>::sqrt(scales, count);
+				for (size_t j = 0; j < count; j++)
+				{
+					scales[j] = (scales[j] > T()) ? ((T)1 / scales[j]) : (T)1;
+				};
+				for (size_t j = 0; j < count; j++)
+				{
+					for (uint64_t c = 0; c < D; c++)
+					{
+						out[i + j].value[c] = A[i + j].value[c] * scales[j];
+					};
+				};
+			};
+		};
+	};
+
+	struct Cross
+	{
+		template <int ISA>
+		static VECTORS_ALWAYS_INLINE void run(const V* A, const V* B, V* out, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				const T a0 = A[i].value[0], a1 = A[i].value[1], a2 = A[i].value[2];
+				const T b0 = B[i].value[0], b1 = B[i].value[1], b2 = B[i].value[2];
+				out[i].value[0] = (a1 * b2) - (a2 * b1);
+				out[i].value[1] = (a2 * b0) - (a0 * b2);
+				out[i].value[2] = (a0 * b1) - (a1 * b0);
+			};
+		};
+	};
+
+	struct Axpy
+	{
+		template <int ISA>
+		static VECTORS_ALWAYS_INLINE void run(T a, const V* X, V* Y, size_t n)
+		{
+			// Not restrict, as X and Y may be the same array.
+			T* y = reinterpret_cast<T*>(Y);
+			const T* x = reinterpret_cast<const T*>(X);
+			const size_t elements = n * D;
+			for (size_t i = 0; i < elements; i++)
+			{
+				y[i] = (a * x[i]) + y[i];
+			};
+		};
+	};
+
+	struct Sum
+	{
+		template <int ISA>
+		static VECTORS_ALWAYS_INLINE V run(const V* A, size_t n)
+		{
+			/*
+				Accumulates into one partial sum per slot of a block, then adds the partial
+				sums pairwise. The order doesn't depend on the instruction set, so every
+				path gives the same result.
+			*/
+
+			V result;
+			constexpr uint64_t whole = ((D / columns) * columns);
+			for (uint64_t first = 0; first < whole; first += columns)
+			{
+				sum<columns>(A, n, first, result);
+			};
+			if constexpr ((D % columns) != 0)
+			{
+				sum<(D % columns)>(A, n, whole, result);
+			};
+			return result;
+		};
+		template <uint64_t W>
+		static VECTORS_ALWAYS_INLINE void sum(const V* A, size_t n, uint64_t first, V& result)
+		{
+			/*
+				Sums components first .. first + W - 1 into result.
+			*/
+
+			T partial[block][W] = {};
+			size_t i = 0;
+			for (; (i + block) <= n; i += block)
+			{
+				for (size_t j = 0; j < block; j++)
+				{
+					for (uint64_t c = 0; c < W; c++)
+					{
+						partial[j][c] += A[i + j].value[first + c];
+					};
+				};
+			};
+			for (size_t j = 0; i < n; i++, j++)
+			{
+				for (uint64_t c = 0; c < W; c++)
+				{
+					partial[j][c] += A[i].value[first + c];
+				};
+			};
+			for (size_t width = (block / 2); width > 0; width /= 2)
+			{
+				for (size_t j = 0; j < width; j++)
+				{
+					for (uint64_t c = 0; c < W; c++)
+					{
+						partial[j][c] += partial[j + width][c];
+					};
+				};
+			};
+
+			for (uint64_t c = 0; c < W; c++)
+			{
+				result.value[first + c] = partial[0][c];
+			};
+		};
+	};
+
+	struct Bounds
+	{
+		template <int ISA>
+		static VECTORS_ALWAYS_INLINE void run(const V* A, size_t n, V* lower, V* upper)
+		{
+			constexpr uint64_t whole = ((D / columns) * columns);
+			for (uint64_t first = 0; first < whole; first += columns)
+			{
+				bounds<columns>(A, n, first, lower, upper);
+			};
+			if constexpr ((D % columns) != 0)
+			{
+				bounds<(D % columns)>(A, n, whole, lower, upper);
+			};
+		};
+		template <uint64_t W>
+		static VECTORS_ALWAYS_INLINE void bounds(const V* A, size_t n, uint64_t first, V* lower, V* upper)
+		{
+			/*
+				The bounds of components first .. first + W - 1, of n > 0 vectors.
+			*/
+
+			T low[block][W];
+			T high[block][W];
+			for (size_t j = 0; j < block; j++)
+			{
+				for (uint64_t c = 0; c < W; c++)
+				{
+					low[j][c] = A[0].value[first + c];
+					high[j][c] = A[0].value[first + c];
+				};
+			};
+
+			size_t i = 0;
+			for (; (i + block) <= n; i += block)
+			{
+				for (size_t j = 0; j < block; j++)
+				{
+					for (uint64_t c = 0; c < W; c++)
+					{
+						const T v = A[i + j].value[first + c];
+						low[j][c] = (v < low[j][c]) ? v : low[j][c];
+						high[j][c] = (v > high[j][c]) ? v : high[j][c];
+					};
+				};
+			};
+			for (; i < n; i++)
+			{
+				for (uint64_t c = 0; c < W; c++)
+				{
+					const T v = A[i].value[first + c];
+					low[0][c] = (v < low[0][c]) ? v : low[0][c];
+					high[0][c] = (v > high[0][c]) ? v : high[0][c];
+				};
+			};
+
+			for (uint64_t c = 0; c < W; c++)
+			{
+				T l = low[0][c];
+				T h = high[0][c];
+				for (size_t j = 1; j < block; j++)
+				{
+					l = (low[j][c] < l) ? low[j][c] : l;
+					h = (high[j][c] > h) ? high[j][c] : h;
+				};
+				lower->value[first + c] = l;
+				upper->value[first + c] = h;
+			};
+		};
+	};
+};
+
+/* Batch Operations */
+template <typename V>
+inline void batchDot(const V* A, const V* B, typename VectorTraits<V>::ElementType* out, const size_t& n)
+{
+	/*
+		Writes the dot product of each A[i] and B[i] into out[i].
+	*/
+
+	vectorsDispatch<typename VectorsBatchKernels<V>::Dot>(A, B, out, (size_t)n);
+};
+template <typename V>
+inline void batchNorm(const V* A, typename VectorTraits<V>::ElementType* out, const size_t& n)
+{
+	/*
+		Writes the euclidean norm of each A[i] into out[i].
+	*/
+
+	vectorsDispatch<typename VectorsBatchKernels<V>::Norm>(A, out, (size_t)n);
+};
+template <typename V>
+inline void batchNormalize(const V* A, V* out, const size_t& n)
+{
+	/*
+		Writes A[i] scaled to unit length into out[i]. A and out may be the same array.
+		Zero length vectors are copied as they are.
+	*/
+
+	vectorsDispatch<typename VectorsBatchKernels<V>::Normalize>(A, out, (size_t)n);
+};
+template <typename V>
+inline void batchNormalize(V* A, const size_t& n)
+{
+	batchNormalize(A, A, n);
+};
+template <typename T>
+inline void batchCross(const Vector3D<T>* A, const Vector3D<T>* B, Vector3D<T>* out, const size_t& n)
+{
+	/*
+		Writes the cross product of each A[i] and B[i] into out[i].
+	*/
+
+	vectorsDispatch<typename VectorsBatchKernels<Vector3D<T>>::Cross>(A, B, out, (size_t)n);
+};
+template <typename V>
+inline void batchAxpy(const typename VectorTraits<V>::ElementType& a, const V* X, V* Y, const size_t& n)
+{
+	/*
+		Computes Y[i] = a * X[i] + Y[i]. X and Y may be the same array, but must not
+		otherwise overlap.
+	*/
+
+	vectorsDispatch<typename VectorsBatchKernels<V>::Axpy>(a, X, Y, (size_t)n);
+};
+template <typename V>
+inline V batchSum(const V* A, const size_t& n)
+{
+	/*
+		Returns the element-wise sum of A[0] .. A[n - 1].
+	*/
+
+	return vectorsDispatch<typename VectorsBatchKernels<V>::Sum>(A, (size_t)n);
+};
+template <typename V>
+inline bool batchBounds(const V* A, const size_t& n, V& lower, V& upper)
+{
+	/*
+		Finds the axis aligned bounding box of A[0] .. A[n - 1], as the element-wise
+		minimum (lower) and maximum (upper). Returns false, leaving the bounds
+		untouched, when n is zero.
+	*/
+
+	if (n == 0)
+	{
+		return false;
+	};
+	vectorsDispatch<typename VectorsBatchKernels<V>::Bounds>(A, (size_t)n, &lower, &upper);
+	return true;
+};
+
+#if defined(__cpp_lib_span)
+/* Span Helpers */
+template <typename S>
+using VectorsSpanElement = typename std::remove_const<typename S::element_type>::type;
+
+template <typename S, typename V, bool Writable = false>
+struct VectorsSpanOf
+{
+	/*
+		# Vectors Span Of (struct)
+		Whether S is a std::span, of any extent, over V (or const V, unless Writable
+		is set). The span overloads take each span as its own deduced type checked
+		with this, as a std::span<const V> parameter can't be deduced from the
+		std::span<V> of e.g. std::span(vector).
+	*/
+
+	static constexpr bool value = false;
+};
+template <typename E, size_t Extent, typename V, bool Writable>
+struct VectorsSpanOf<std::span<E, Extent>, V, Writable>
+{
+	static constexpr bool value = (std::is_same<typename std::remove_const<E>::type, V>::value && (!Writable || !std::is_const<E>::value));
+};
+
+/* Span Overloads */
+// The overloads taking several spans return false, doing nothing, unless they
+// are all the same size.
+template <typename SA, typename SB, typename SO, typename V = VectorsSpanElement<SA>>
+inline typename std::enable_if<VectorsSpanOf<SA, V>::value && VectorsSpanOf<SB, V>::value && VectorsSpanOf<SO, typename VectorTraits<V>::ElementType, true>::value, bool>::type batchDot(SA A, SB B, SO out)
+{
+	if ((B.size() != A.size()) || (out.size() != A.size()))
+	{
+		return false;
+	};
+	batchDot(A.data(), B.data(), out.data(), A.size());
+	return true;
+};
+template <typename SA, typename SO, typename V = VectorsSpanElement<SA>>
+inline typename std::enable_if<VectorsSpanOf<SA, V>::value && VectorsSpanOf<SO, typename VectorTraits<V>::ElementType, true>::value, bool>::type batchNorm(SA A, SO out)
+{
+	if (out.size() != A.size())
+	{
+		return false;
+	};
+	batchNorm(A.data(), out.data(), A.size());
+	return true;
+};
+template <typename SA, typename V = VectorsSpanElement<SA>>
+inline typename std::enable_if<VectorsSpanOf<SA, V, true>::value && VectorTraits<V>::isVector>::type batchNormalize(SA A)
+{
+	batchNormalize(A.data(), A.size());
+};
+template <typename SA, typename SB, typename SO, typename V = VectorsSpanElement<SA>>
+inline typename std::enable_if<VectorsSpanOf<SA, V>::value && VectorsSpanOf<SB, V>::value && VectorsSpanOf<SO, V, true>::value && (VectorTraits<V>::dimensions == 3), bool>::type batchCross(SA A, SB B, SO out)
+{
+	if ((B.size() != A.size()) || (out.size() != A.size()))
+	{
+		return false;
+	};
+	batchCross(A.data(), B.data(), out.data(), A.size());
+	return true;
+};
+template <typename SX, typename SY, typename V = VectorsSpanElement<SX>>
+inline typename std::enable_if<VectorsSpanOf<SX, V>::value && VectorsSpanOf<SY, V, true>::value, bool>::type batchAxpy(const typename VectorTraits<V>::ElementType& a, SX X, SY Y)
+{
+	if (Y.size() != X.size())
+	{
+		return false;
+	};
+	batchAxpy(a, X.data(), Y.data(), X.size());
+	return true;
+};
+template <typename SA, typename V = VectorsSpanElement<SA>>
+inline typename std::enable_if<VectorsSpanOf<SA, V>::value && VectorTraits<V>::isVector, V>::type batchSum(SA A)
+{
+	return batchSum(A.data(), A.size());
+};
+template <typename SA, typename V = VectorsSpanElement<SA>>
+inline typename std::enable_if<VectorsSpanOf<SA, V>::value && VectorTraits<V>::isVector, bool>::type batchBounds(SA A, V& lower, V& upper)
+{
+	return batchBounds(A.data(), A.size(), lower, upper);
+};
+#endif
+
+#endif
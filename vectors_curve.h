@@ -0,0 +1,736 @@
+#pragma once
+/*
+	# Vector Template Library - Space Filling Curves
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	Morton (Z-order) and Hilbert codes for Vector2D and Vector3D, and a parallel
+	radix sort to order arrays of points by them. Points close together in space
+	get codes close together, so after sorting, a pass over the array which
+	looks at each point's neighbours finds them nearby in memory:
+
+		spatialSort(points.data(), points.size(), VECTOR_CURVE_HILBERT, colours.data());
+
+	The codes are 64 bit, interleaving 32 bits per axis in 2D and 21 in 3D.
+	Integer elements are used as grid coordinates directly and must be within
+	that range; floating point elements are first quantized onto a grid of 2^24
+	(2D) or 2^21 (3D) cells per axis spanning the points' bounds, or bounds you
+	give so separate batches share a grid. The Hilbert curve never jumps between
+	cells which aren't adjacent, so it keeps neighbours together a little better
+	than the Morton curve, which is cheaper to compute.
+
+	Encoding a batch works a block of points at a time so the compiler can
+	vectorize across them, compiled for each instruction set and dispatched at
+	runtime like the batch operations (see vectors_batch.h). The bits are
+	interleaved with BMI2 pdep where the CPU has a fast one.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+#ifndef VECTOR_TEMPLATE_LIBRARY_CURVE__H
+#define VECTOR_TEMPLATE_LIBRARY_CURVE__H
+/* Deps */
+#include "vectors.h"
+#include "vectors_batch.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/* Types */
+enum VectorCurve : int
+{
+	VECTOR_CURVE_MORTON = 0,
+	VECTOR_CURVE_HILBERT = 1
+};
+
+/* Bit Helpers */
+/*
+	Spreading moves bit i of a coordinate to bit 2i (or 3i), compacting moves it
+	back. Interleaving a point puts its first axis in the highest bit of each
+	group, so codes compare like the coordinates at every level.
+*/
+constexpr uint64_t vectorsSpreadBits2(const uint32_t& value)
+{
+	uint64_t x = value;
+	x = (x | (x << 16)) & 0x0000FFFF0000FFFFull;
+	x = (x | (x << 8)) & 0x00FF00FF00FF00FFull;
+	x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0Full;
+	x = (x | (x << 2)) & 0x3333333333333333ull;
+	x = (x | (x << 1)) & 0x5555555555555555ull;
+	return x;
+};
+constexpr uint64_t vectorsSpreadBits3(const uint32_t& value)
+{
+	uint64_t x = (value & 0x1FFFFFu);
+	x = (x | (x << 32)) & 0x001F00000000FFFFull;
+	x = (x | (x << 16)) & 0x001F0000FF0000FFull;
+	x = (x | (x << 8)) & 0x100F00F00F00F00Full;
+	x = (x | (x << 4)) & 0x10C30C30C30C30C3ull;
+	x = (x | (x << 2)) & 0x1249249249249249ull;
+	return x;
+};
+constexpr uint32_t vectorsCompactBits2(const uint64_t& value)
+{
+	uint64_t x = (value & 0x5555555555555555ull);
+	x = (x | (x >> 1)) & 0x3333333333333333ull;
+	x = (x | (x >> 2)) & 0x0F0F0F0F0F0F0F0Full;
+	x = (x | (x >> 4)) & 0x00FF00FF00FF00FFull;
+	x = (x | (x >> 8)) & 0x0000FFFF0000FFFFull;
+	x = (x | (x >> 16)) & 0x00000000FFFFFFFFull;
+	return (uint32_t)x;
+};
+constexpr uint32_t vectorsCompactBits3(const uint64_t& value)
+{
+	uint64_t x = (value & 0x1249249249249249ull);
+	x = (x | (x >> 2)) & 0x10C30C30C30C30C3ull;
+	x = (x | (x >> 4)) & 0x100F00F00F00F00Full;
+	x = (x | (x >> 8)) & 0x001F0000FF0000FFull;
+	x = (x | (x >> 16)) & 0x001F00000000FFFFull;
+	x = (x | (x >> 32)) & 0x00000000001FFFFFull;
+	return (uint32_t)x;
+};
+
+template <uint64_t D>
+struct VectorCurveBits;
+
+template <>
+struct VectorCurveBits<2>
+{
+	static constexpr uint32_t bits = 32; // Per axis
+	static constexpr uint32_t gridBits = 24; // Per axis, for quantized floating point
+
+	static inline uint64_t interleave(const uint32_t& x, const uint32_t& y)
+	{
+#if VECTORS_SSE && defined(__BMI2__)
+		return (_pdep_u64(x, 0xAAAAAAAAAAAAAAAAull) | _pdep_u64(y, 0x5555555555555555ull));
+#else
+		return ((vectorsSpreadBits2(x) << 1) | vectorsSpreadBits2(y));
+#endif
+	};
+};
+
+template <>
+struct VectorCurveBits<3>
+{
+	static constexpr uint32_t bits = 21;
+	static constexpr uint32_t gridBits = 21;
+
+	static inline uint64_t interleave(const uint32_t& x, const uint32_t& y, const uint32_t& z)
+	{
+#if VECTORS_SSE && defined(__BMI2__)
+		return (_pdep_u64(x, 0x4924924924924924ull) | _pdep_u64(y, 0x2492492492492492ull) | _pdep_u64(z, 0x1249249249249249ull));
+#else
+		return ((vectorsSpreadBits3(x) << 2) | (vectorsSpreadBits3(y) << 1) | vectorsSpreadBits3(z));
+#endif
+	};
+};
+
+template <uint64_t D, uint32_t Bit>
+struct VectorHilbertLevels
+{
+	/*
+		The levels of vectorsHilbertTranspose() from Bit down to 1, unrolled, on the
+		axes of one point (z is unused in 2D).
+	*/
+
+	static VECTORS_ALWAYS_INLINE void exchange(uint32_t& x, uint32_t& axis)
+	{
+		// Invert the lower bits of x if this bit of axis is set, else swap them with it
+		constexpr uint32_t P = ((1u << Bit) - 1u);
+		const uint32_t set = (0u - ((axis >> Bit) & 1u));
+		const uint32_t t = ((x ^ axis) & P & ~set);
+		x ^= ((P & set) ^ t);
+		axis ^= t;
+	};
+	static VECTORS_ALWAYS_INLINE void undo(uint32_t& x, uint32_t& y, uint32_t& z)
+	{
+		// Undo the excess work of the rotations and reflections at this level
+		x ^= (((1u << Bit) - 1u) & (0u - ((x >> Bit) & 1u)));
+		exchange(x, y);
+		if (D == 3)
+		{
+			exchange(x, z);
+		};
+		VectorHilbertLevels<D, Bit - 1>::undo(x, y, z);
+	};
+	static VECTORS_ALWAYS_INLINE uint32_t gray(const uint32_t& last)
+	{
+		return ((((1u << Bit) - 1u) & (0u - ((last >> Bit) & 1u))) ^ VectorHilbertLevels<D, Bit - 1>::gray(last));
+	};
+};
+template <uint64_t D>
+struct VectorHilbertLevels<D, 0>
+{
+	static VECTORS_ALWAYS_INLINE void undo(uint32_t&, uint32_t&, uint32_t&) {};
+	static VECTORS_ALWAYS_INLINE uint32_t gray(const uint32_t&)
+	{
+		return 0;
+	};
+};
+
+template <uint64_t D, size_t Lanes>
+VECTORS_ALWAYS_INLINE void vectorsHilbertTranspose(uint32_t (&X)[D][Lanes], const size_t& count)
+{
+	/*
+		Turns the grid coordinates of count points, one array of lanes per axis,
+		into the transposed form of their Hilbert indexes (J. Skilling, "Programming
+		the Hilbert curve", 2004): interleaving the results gives the index. The
+		branches of the original are replaced with masks and the levels unrolled,
+		so the compiler can vectorize across the lanes.
+	*/
+
+	static_assert((D == 2) || (D == 3), "Curves are only defined for 2D and 3D vectors.");
+
+	for (size_t l = 0; l < count; l++)
+	{
+		uint32_t x = X[0][l];
+		uint32_t y = X[1][l];
+		uint32_t z = X[D - 1][l];
+		VectorHilbertLevels<D, VectorCurveBits<D>::bits - 1>::undo(x, y, z);
+
+		// Gray encode
+		y ^= x;
+		z ^= y;
+		const uint32_t t = VectorHilbertLevels<D, VectorCurveBits<D>::bits - 1>::gray((D == 3) ? z : y);
+		X[0][l] = (x ^ t);
+		X[1][l] = (y ^ t);
+		if (D == 3)
+		{
+			X[D - 1][l] = (z ^ t);
+		};
+	};
+};
+
+/* Encoding */
+inline uint64_t mortonEncode(const Vector2D<uint32_t>& point)
+{
+	return VectorCurveBits<2>::interleave(point.value[0], point.value[1]);
+};
+inline uint64_t mortonEncode(const Vector3D<uint32_t>& point)
+{
+	/*
+		The Morton code of a point on the 2^21 grid; higher bits are ignored.
+	*/
+
+	return VectorCurveBits<3>::interleave(point.value[0] & 0x1FFFFFu, point.value[1] & 0x1FFFFFu, point.value[2] & 0x1FFFFFu);
+};
+inline Vector2D<uint32_t> mortonDecode2D(const uint64_t& code)
+{
+	return Vector2D<uint32_t>(vectorsCompactBits2(code >> 1), vectorsCompactBits2(code));
+};
+inline Vector3D<uint32_t> mortonDecode3D(const uint64_t& code)
+{
+	return Vector3D<uint32_t>(vectorsCompactBits3(code >> 2), vectorsCompactBits3(code >> 1), vectorsCompactBits3(code));
+};
+inline uint64_t hilbertEncode(const Vector2D<uint32_t>& point)
+{
+	uint32_t X[2][1] = { { point.value[0] }, { point.value[1] } };
+	vectorsHilbertTranspose<2, 1>(X, 1);
+	return VectorCurveBits<2>::interleave(X[0][0], X[1][0]);
+};
+inline uint64_t hilbertEncode(const Vector3D<uint32_t>& point)
+{
+	/*
+		The Hilbert index of a point on the 2^21 grid; higher bits are ignored.
+	*/
+
+	uint32_t X[3][1] = { { point.value[0] & 0x1FFFFFu }, { point.value[1] & 0x1FFFFFu }, { point.value[2] & 0x1FFFFFu } };
+	vectorsHilbertTranspose<3, 1>(X, 1);
+	return VectorCurveBits<3>::interleave(X[0][0], X[1][0], X[2][0]);
+};
+
+/* Kernels */
+#if VECTORS_DISPATCH
+#define VECTORS_TARGET_BMI2 __attribute__((target("bmi,bmi2")))
+#define VECTORS_TARGET_AVX2_BMI2 __attribute__((target("avx2,fma,f16c,bmi,bmi2")))
+#define VECTORS_TARGET_AVX512_BMI2 __attribute__((target("avx512f,avx512vl,avx512dq,avx2,fma,f16c,bmi,bmi2")))
+
+inline bool vectorsHasBMI2()
+{
+	/*
+		Whether the CPU has a fast pdep. AMD processors before Zen 3 have one, but
+		in microcode, and it's far slower than shifting and masking there.
+	*/
+
+	static const bool supported = []() {
+		__builtin_cpu_init();
+		return (__builtin_cpu_supports("bmi2") && !__builtin_cpu_is("znver1") && !__builtin_cpu_is("znver2"));
+	}();
+	return supported;
+};
+
+VECTORS_TARGET_BMI2 inline uint64_t vectorsInterleaveBMI2(const uint32_t& x, const uint32_t& y)
+{
+	return (_pdep_u64(x, 0xAAAAAAAAAAAAAAAAull) | _pdep_u64(y, 0x5555555555555555ull));
+};
+VECTORS_TARGET_BMI2 inline uint64_t vectorsInterleaveBMI2(const uint32_t& x, const uint32_t& y, const uint32_t& z)
+{
+	return (_pdep_u64(x, 0x4924924924924924ull) | _pdep_u64(y, 0x2492492492492492ull) | _pdep_u64(z, 0x1249249249249249ull));
+};
+#endif
+
+template <typename V>
+struct VectorCurveKernels
+{
+	/*
+		# Vector Curve Kernels (struct)
+		Encodes points a block at a time: quantizes the block into one array of grid
+		coordinates per axis, applies the Hilbert transform across them if asked, and
+		interleaves them into codes. lower and scale map floating point elements
+		onto the grid, cell = (element - lower) * scale, and are unused for integers.
+	*/
+
+	typedef typename VectorTraits<V>::ElementType T;
+	static constexpr uint64_t D = VectorTraits<V>::dimensions;
+	static constexpr size_t block = 64;
+
+	static_assert((D == 2) || (D == 3), "Curves are only defined for 2D and 3D vectors.");
+
+	template <bool BMI2>
+	static VECTORS_ALWAYS_INLINE void encode(const V* points, size_t n, const T* lower, const T* scale, int curve, uint64_t* VECTORS_RESTRICT codes)
+	{
+		constexpr uint32_t mask = (uint32_t)((1ull << VectorCurveBits<D>::bits) - 1ull);
+		constexpr T top = (T)((1ull << VectorCurveBits<D>::gridBits) - 1ull);
+
+		uint32_t X[D][block];
+		for (size_t first = 0; first < n; first += block)
+		{
+			const size_t count = ((n - first) < block) ? (n - first) : block;
+			const V* VECTORS_RESTRICT source = (points + first);
+
+			for (uint64_t c = 0; c < D; c++)
+			{
+				if (std::is_floating_point<T>::value)
+				{
+					for (size_t l = 0; l < count; l++)
+					{
+						// Written so NaN lands in cell 0
+						T cell = (source[l].value[c] - lower[c]) * scale[c];
+						cell = (cell > T()) ? cell : T();
+						cell = (cell < top) ? cell : top;
+						X[c][l] = (uint32_t)(int32_t)cell;
+					};
+				}
+				else
+				{
+					for (size_t l = 0; l < count; l++)
+					{
+						X[c][l] = ((uint32_t)source[l].value[c] & mask);
+					};
+				};
+			};
+			if (curve == VECTOR_CURVE_HILBERT)
+			{
+				vectorsHilbertTranspose<D, block>(X, count);
+			};
+			for (size_t l = 0; l < count; l++)
+			{
+				codes[first + l] = interleave<BMI2>(X, l);
+			};
+		};
+	};
+
+	template <bool BMI2>
+	static VECTORS_ALWAYS_INLINE uint64_t interleave(const uint32_t (&X)[D][block], const size_t& l)
+	{
+#if VECTORS_DISPATCH
+		if (BMI2)
+		{
+			return (D == 2) ? vectorsInterleaveBMI2(X[0][l], X[D - 1][l]) : vectorsInterleaveBMI2(X[0][l], X[1][l], X[D - 1][l]);
+		};
+#endif
+		return (D == 2) ?
+			((vectorsSpreadBits2(X[0][l]) << 1) | vectorsSpreadBits2(X[D - 1][l])) :
+			((vectorsSpreadBits3(X[0][l]) << 2) | (vectorsSpreadBits3(X[1][l]) << 1) | vectorsSpreadBits3(X[D - 1][l]));
+	};
+
+	struct Encode
+	{
+		template <int ISA>
+		static VECTORS_ALWAYS_INLINE void run(const V* points, size_t n, const T* lower, const T* scale, int curve, uint64_t* codes)
+		{
+			encode<false>(points, n, lower, scale, curve, codes);
+		};
+	};
+};
+
+#if VECTORS_DISPATCH
+template <typename V>
+VECTORS_TARGET_AVX2_BMI2 inline void vectorsCurveEncodeAVX2(const V* points, size_t n, const typename VectorTraits<V>::ElementType* lower, const typename VectorTraits<V>::ElementType* scale, int curve, uint64_t* codes)
+{
+	VectorCurveKernels<V>::template encode<true>(points, n, lower, scale, curve, codes);
+};
+template <typename V>
+VECTORS_TARGET_AVX512_BMI2 inline void vectorsCurveEncodeAVX512(const V* points, size_t n, const typename VectorTraits<V>::ElementType* lower, const typename VectorTraits<V>::ElementType* scale, int curve, uint64_t* codes)
+{
+	VectorCurveKernels<V>::template encode<true>(points, n, lower, scale, curve, codes);
+};
+#endif
+
+template <typename V>
+inline void curveCodes(const V* points, const size_t& n, const V& lower, const V& upper, uint64_t* codes, const VectorCurve& curve = VECTOR_CURVE_HILBERT)
+{
+	/*
+		Writes the code of each points[i] on curve into codes[i]. Floating point
+		elements are quantized onto a grid spanning lower to upper, with points
+		outside it clamped to its edges; integer elements ignore the bounds.
+	*/
+
+	typedef typename VectorTraits<V>::ElementType T;
+	constexpr uint64_t D = VectorTraits<V>::dimensions;
+	constexpr T cells = (T)(1ull << VectorCurveBits<D>::gridBits);
+
+	T scale[D];
+	for (uint64_t c = 0; c < D; c++)
+	{
+		const T extent = (upper.value[c] - lower.value[c]);
+		scale[c] = (extent > T()) ? (cells / extent) : T();
+	};
+
+#if VECTORS_DISPATCH
+	// The kernels with pdep are only worth it where it's fast, see vectorsHasBMI2()
+	if (vectorsHasBMI2())
+	{
+		switch (vectorsBatchISA())
+		{
+		case VECTORS_ISA_AVX512:
+			vectorsCurveEncodeAVX512<V>(points, n, lower.value, scale, (int)curve, codes);
+			return;
+		case VECTORS_ISA_AVX2:
+			vectorsCurveEncodeAVX2<V>(points, n, lower.value, scale, (int)curve, codes);
+			return;
+		default:
+			break;
+		};
+	};
+#endif
+	vectorsDispatch<typename VectorCurveKernels<V>::Encode>(points, n, (const T*)lower.value, (const T*)scale, (int)curve, codes);
+};
+template <typename V>
+inline void curveCodes(const V* points, const size_t& n, uint64_t* codes, const VectorCurve& curve = VECTOR_CURVE_HILBERT)
+{
+	/*
+		Writes the code of each points[i] on curve into codes[i], quantizing floating
+		point elements onto a grid spanning the points' bounds.
+	*/
+
+	typedef typename VectorTraits<V>::ElementType T;
+	constexpr uint64_t D = VectorTraits<V>::dimensions;
+
+	V lower;
+	V upper;
+	for (uint64_t c = 0; c < D; c++)
+	{
+		lower.value[c] = std::numeric_limits<T>::max();
+		upper.value[c] = std::numeric_limits<T>::lowest();
+	};
+	for (size_t i = 0; i < n; i++)
+	{
+		for (uint64_t c = 0; c < D; c++)
+		{
+			lower.value[c] = (points[i].value[c] < lower.value[c]) ? points[i].value[c] : lower.value[c];
+			upper.value[c] = (points[i].value[c] > upper.value[c]) ? points[i].value[c] : upper.value[c];
+		};
+	};
+	curveCodes(points, n, lower, upper, codes, curve);
+};
+
+/* Sorting */
+inline size_t vectorsSortWorkers(const size_t& threads, const size_t& n)
+{
+	/*
+		The number of threads to split a pass over n elements across: threads, or
+		one per hardware thread if that is 0, but no fewer than 64K elements each.
+	*/
+
+	size_t workers = threads;
+	if (workers == 0)
+	{
+		workers = (size_t)std::thread::hardware_concurrency();
+	};
+	return std::max((size_t)1, std::min(workers, (n >> 16)));
+};
+
+template <typename Work>
+inline void vectorsSortParallel(const size_t& n, const size_t& workers, const Work& work)
+{
+	/*
+		Calls work(worker, first, last) for workers contiguous ranges of [0, n),
+		the first on this thread.
+	*/
+
+	const size_t share = ((n + workers - 1) / workers);
+	std::vector<std::thread> pool;
+	for (size_t worker = 1; worker < workers; worker++)
+	{
+		pool.emplace_back([&, worker]() { work(worker, std::min(n, worker * share), std::min(n, (worker + 1) * share)); });
+	};
+	work((size_t)0, (size_t)0, std::min(n, share));
+	for (std::thread& thread : pool)
+	{
+		thread.join();
+	};
+};
+
+static constexpr size_t VECTORS_RADIX_SORT_CACHED = ((size_t)1 << 15);
+
+template <typename P>
+inline void vectorsRadixSortInto(uint64_t* sourceKeys, P* sourcePayloads, uint64_t* keys, P* payloads, const size_t& n, const uint64_t& difference, const int& shift)
+{
+	/*
+		Sorts the n keys in sourceKeys by their bytes from shift down, writing them
+		and their payloads to keys and payloads; the source is clobbered. Ranges too
+		big for the cache are split on the byte at shift and each part is sorted the
+		same way, smaller ones take a least significant digit pass per byte that
+		differs, back and forth between the two arrays.
+	*/
+
+	if (n <= 32)
+	{
+		// Insertion sort, which is stable
+		for (size_t i = 0; i < n; i++)
+		{
+			size_t j = i;
+			for (; (j > 0) && (sourceKeys[i] < keys[j - 1]); j--)
+			{
+				keys[j] = keys[j - 1];
+				payloads[j] = payloads[j - 1];
+			};
+			keys[j] = sourceKeys[i];
+			payloads[j] = sourcePayloads[i];
+		};
+		return;
+	};
+
+	size_t counts[256];
+	if ((n > VECTORS_RADIX_SORT_CACHED) && (shift > 0))
+	{
+		std::fill(counts, counts + 256, (size_t)0);
+		for (size_t i = 0; i < n; i++)
+		{
+			counts[(sourceKeys[i] >> shift) & 0xFF]++;
+		};
+		size_t total = 0;
+		for (size_t digit = 0; digit < 256; digit++)
+		{
+			const size_t count = counts[digit];
+			counts[digit] = total;
+			total += count;
+		};
+		for (size_t i = 0; i < n; i++)
+		{
+			const size_t target = counts[(sourceKeys[i] >> shift) & 0xFF]++;
+			keys[target] = sourceKeys[i];
+			payloads[target] = sourcePayloads[i];
+		};
+
+		// Each part goes back to the source sorted, then on to the target while it's still in cache
+		size_t first = 0;
+		for (size_t digit = 0; digit < 256; digit++)
+		{
+			const size_t last = counts[digit];
+			vectorsRadixSortInto(keys + first, payloads + first, sourceKeys + first, sourcePayloads + first, (last - first), difference, (shift - 8));
+			std::copy(sourceKeys + first, sourceKeys + last, keys + first);
+			std::copy(sourcePayloads + first, sourcePayloads + last, payloads + first);
+			first = last;
+		};
+		return;
+	};
+
+	uint64_t* fromKeys = sourceKeys;
+	P* fromPayloads = sourcePayloads;
+	uint64_t* toKeys = keys;
+	P* toPayloads = payloads;
+	for (int digitShift = 0; digitShift <= shift; digitShift += 8)
+	{
+		if (((difference >> digitShift) & 0xFF) == 0)
+		{
+			continue;
+		};
+		std::fill(counts, counts + 256, (size_t)0);
+		for (size_t i = 0; i < n; i++)
+		{
+			counts[(fromKeys[i] >> digitShift) & 0xFF]++;
+		};
+		if (counts[fromKeys[0] >> digitShift & 0xFF] == n)
+		{
+			continue;
+		};
+		size_t total = 0;
+		for (size_t digit = 0; digit < 256; digit++)
+		{
+			const size_t count = counts[digit];
+			counts[digit] = total;
+			total += count;
+		};
+		for (size_t i = 0; i < n; i++)
+		{
+			const size_t target = counts[(fromKeys[i] >> digitShift) & 0xFF]++;
+			toKeys[target] = fromKeys[i];
+			toPayloads[target] = fromPayloads[i];
+		};
+		std::swap(fromKeys, toKeys);
+		std::swap(fromPayloads, toPayloads);
+	};
+	if (fromKeys != keys)
+	{
+		std::copy(fromKeys, fromKeys + n, keys);
+		std::copy(fromPayloads, fromPayloads + n, payloads);
+	};
+};
+
+template <typename P>
+inline void radixSort(uint64_t* keys, P* payloads, const size_t& n, const size_t& threads = 0)
+{
+	/*
+		Sorts keys ascending, moving payloads[i] along with keys[i]. The sort is
+		stable, so equal keys keep their order, and skips bytes which are the same
+		in every key.
+
+		The keys are first split on their highest byte which differs, with each
+		thread counting and then scattering its own range, so the parts are small
+		enough to sort in cache. The threads then take parts in turn and sort them
+		on the lower bytes.
+	*/
+
+	static_assert(std::is_trivially_copyable<P>::value, "Payloads must be trivially copyable.");
+
+	if (n < 2)
+	{
+		return;
+	};
+	const size_t workers = vectorsSortWorkers(threads, n);
+
+	// Find which bytes differ between keys
+	std::vector<uint64_t> differences(workers, 0);
+	vectorsSortParallel(n, workers, [&](const size_t& worker, const size_t& first, const size_t& last) {
+		uint64_t difference = 0;
+		for (size_t i = first; i < last; i++)
+		{
+			difference |= (keys[i] ^ keys[0]);
+		};
+		differences[worker] = difference;
+	});
+	uint64_t difference = 0;
+	for (const uint64_t& d : differences)
+	{
+		difference |= d;
+	};
+	if (difference == 0)
+	{
+		return;
+	};
+	int shift = 56;
+	while (((difference >> shift) & 0xFF) == 0)
+	{
+		shift -= 8;
+	};
+
+	std::vector<uint64_t> keyBuffer(n);
+	std::vector<P> payloadBuffer(n);
+	if (n <= VECTORS_RADIX_SORT_CACHED)
+	{
+		std::copy(keys, keys + n, keyBuffer.data());
+		std::copy(payloads, payloads + n, payloadBuffer.data());
+		vectorsRadixSortInto(keyBuffer.data(), payloadBuffer.data(), keys, payloads, n, difference, shift);
+		return;
+	};
+
+	// Split on the highest byte into the buffers
+	std::vector<size_t> offsets(workers * 256, 0);
+	vectorsSortParallel(n, workers, [&](const size_t& worker, const size_t& first, const size_t& last) {
+		size_t* counts = (offsets.data() + (worker * 256));
+		for (size_t i = first; i < last; i++)
+		{
+			counts[(keys[i] >> shift) & 0xFF]++;
+		};
+	});
+	std::vector<size_t> parts(257, 0);
+	size_t total = 0;
+	for (size_t digit = 0; digit < 256; digit++)
+	{
+		// Each digit's keys go after the smaller digits, and a worker's after the earlier workers'
+		parts[digit] = total;
+		for (size_t worker = 0; worker < workers; worker++)
+		{
+			const size_t count = offsets[(worker * 256) + digit];
+			offsets[(worker * 256) + digit] = total;
+			total += count;
+		};
+	};
+	parts[256] = total;
+	vectorsSortParallel(n, workers, [&](const size_t& worker, const size_t& first, const size_t& last) {
+		size_t* next = (offsets.data() + (worker * 256));
+		for (size_t i = first; i < last; i++)
+		{
+			const size_t target = next[(keys[i] >> shift) & 0xFF]++;
+			keyBuffer[target] = keys[i];
+			payloadBuffer[target] = payloads[i];
+		};
+	});
+
+	// Sort each part back into place
+	std::atomic<size_t> nextPart(0);
+	vectorsSortParallel(workers, workers, [&](const size_t&, const size_t&, const size_t&) {
+		for (size_t digit = nextPart++; digit < 256; digit = nextPart++)
+		{
+			const size_t first = parts[digit];
+			vectorsRadixSortInto(keyBuffer.data() + first, payloadBuffer.data() + first, keys + first, payloads + first, (parts[digit + 1] - first), difference, (shift - 8));
+		};
+	});
+};
+
+template <typename P>
+inline void vectorsPermute(P* values, const uint32_t* order, const size_t& n, const size_t& threads = 0)
+{
+	/*
+		Rearranges values so that values[i] becomes what was values[order[i]].
+		order must be a permutation of 0 to n - 1.
+	*/
+
+	static_assert(std::is_trivially_copyable<P>::value, "Values must be trivially copyable.");
+
+	const std::vector<P> source(values, values + n);
+	vectorsSortParallel(n, vectorsSortWorkers(threads, n), [&](const size_t&, const size_t& first, const size_t& last) {
+		for (size_t i = first; i < last; i++)
+		{
+			values[i] = source[order[i]];
+		};
+	});
+};
+
+template <typename V, typename... Payloads>
+inline std::vector<uint32_t> spatialSort(V* points, const size_t& n, const VectorCurve& curve, Payloads*... payloads)
+{
+	/*
+		Sorts points along curve, rearranging each payload array (one value per
+		point) the same way. Returns the order applied, where element i of the
+		result is the old index of the point now at i, or nothing if there are too
+		many points for 32 bit indexes.
+	*/
+
+	if (n > (size_t)std::numeric_limits<uint32_t>::max())
+	{
+		return std::vector<uint32_t>();
+	};
+
+	std::vector<uint64_t> codes(n);
+	curveCodes(points, n, codes.data(), curve);
+	std::vector<uint32_t> order(n);
+	std::iota(order.begin(), order.end(), (uint32_t)0);
+	radixSort(codes.data(), order.data(), n);
+
+	vectorsPermute(points, order.data(), n);
+	const int expand[] = { 0, (vectorsPermute(payloads, order.data(), n), 0)... };
+	(void)expand;
+	return order;
+};
+
+#endif
@@ -0,0 +1,805 @@
+#pragma once
+/*
+	# Vector Template Library - Dynamic Vectors
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	DynVector<T>, a vector whose number of dimensions is only known at runtime,
+	e.g. an embedding whose size comes from a model's config file, with the same
+	methods and operators as Vector<N,T>.
+
+		DynVector<float> embedding(config.dimensions);
+		...
+		const float score = embedding.dot(query);
+
+	Vectors of up to VECTORS_DYNAMIC_INLINE_BYTES (64 by default) are stored in
+	the DynVector itself, and larger ones on the heap, aligned to a cache line
+	either way. The common dimensions (2, 3, 4, 8, 16, 64, 128, 256 and 768)
+	dispatch to the unrolled kernels of Vector<N,T>, and other sizes run as 64
+	element blocks of the same kernels with a scalar loop for the remainder, so
+	one DynVector<T> replaces a switch over many Vector<N,T> instantiations.
+	Define VECTORS_DYNAMIC_DISPATCH as 0 to run every size on the blocks, for the
+	least code.
+
+	The operands of a binary operator should have the same size. If they don't,
+	the operator works over the leading elements they share, and never reads or
+	writes past the end of either.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+#ifndef VECTOR_TEMPLATE_LIBRARY_DYNAMIC__H
+#define VECTOR_TEMPLATE_LIBRARY_DYNAMIC__H
+/* Deps */
+#include "vectors.h"
+#include "vectors_soa.h"
+#include <stddef.h>
+#include <string.h>
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <string>
+#include <type_traits>
+
+/* Macros */
+#ifndef VECTORS_DYNAMIC_INLINE_BYTES
+	#define VECTORS_DYNAMIC_INLINE_BYTES 64
+#endif
+#ifndef VECTORS_DYNAMIC_DISPATCH
+	#define VECTORS_DYNAMIC_DISPATCH 1
+#endif
+
+/* Forward Declarations */
+template <typename T> struct DynVector;
+
+template <typename T> std::string toString(const DynVector<T>& value);
+template <typename T> size_t formatTo(char* buffer, const size_t& size, const DynVector<T>& value);
+
+/* Kernels */
+template <typename T, uint64_t N>
+struct VectorDynamicKernels
+{
+	/*
+		# Vector Dynamic Kernels (struct)
+		The operations of a DynVector<T> of exactly N elements, which are those of
+		Vector<N,T>. The size arguments are only there to match the kernels for
+		other sizes, VectorDynamicKernels<T, 0>.
+
+		Whole multiples of 64 elements past the first run their element-wise
+		operations as a fixed number of 64 element blocks instead, as the unrolled
+		body of a block is quicker than the loop of one long kernel. The results are
+		the same either way.
+	*/
+
+	typedef VectorBlockKernels<T, N> Kernels;
+	typedef VectorBlockKernels<T, 64> Blocks;
+
+	static constexpr bool blocked = ((N > 64) && ((N % 64) == 0));
+
+	template <typename Operation>
+	static inline void apply(const size_t&, const T* A, const T* B, T* C)
+	{
+		if constexpr (blocked)
+		{
+			for (size_t i = 0; i < N; i += 64)
+			{
+				Blocks::template apply<Operation>((A + i), (B + i), (C + i));
+			};
+		}
+		else
+		{
+			Kernels::template apply<Operation>(A, B, C);
+		};
+	};
+	template <typename Operation>
+	static inline void applyScalar(const size_t&, const T* A, const T& B, T* C)
+	{
+		if constexpr (blocked)
+		{
+			for (size_t i = 0; i < N; i += 64)
+			{
+				Blocks::template applyScalar<Operation>((A + i), B, (C + i));
+			};
+		}
+		else
+		{
+			Kernels::template applyScalar<Operation>(A, B, C);
+		};
+	};
+	static inline void negate(const size_t&, const T* A, T* C)
+	{
+		if constexpr (blocked)
+		{
+			for (size_t i = 0; i < N; i += 64)
+			{
+				Blocks::negate((A + i), (C + i));
+			};
+		}
+		else
+		{
+			Kernels::negate(A, C);
+		};
+	};
+
+	// Reductions
+	static inline bool equal(const size_t&, const T* A, const T* B) { return Kernels::equal(A, B); };
+	static inline T dot(const size_t&, const T* A, const T* B) { return Kernels::dot(A, B); };
+	static inline T sumAbs(const size_t&, const T* A) { return VectorNorms<N, T>::sumAbs(A); };
+	static inline T infNorm(const size_t&, const T* A) { return VectorNorms<N, T>::infNorm(A); };
+	static inline T pNorm(const size_t&, const T* A, const uint64_t& p) { return VectorNorms<N, T>::pNorm(A, p); };
+};
+template <typename T>
+struct VectorDynamicKernels<T, 0>
+{
+	/*
+		The operations for any other number of elements, n, as blocks of the kernels
+		for 64 elements followed by a scalar loop. Each block starts a multiple of
+		64 elements into DynVector's aligned storage, so stays aligned.
+	*/
+
+	static constexpr size_t block = 64;
+
+	typedef VectorBlockKernels<T, block> Kernels;
+
+	template <typename Operation>
+	static inline void apply(const size_t& n, const T* A, const T* B, T* C)
+	{
+		size_t i = 0;
+		for (; (i + block) <= n; i += block)
+		{
+			Kernels::template apply<Operation>((A + i), (B + i), (C + i));
+		};
+		for (; i < n; i++)
+		{
+			C[i] = Operation::apply(A[i], B[i]);
+		};
+	};
+	template <typename Operation>
+	static inline void applyScalar(const size_t& n, const T* A, const T& B, T* C)
+	{
+		size_t i = 0;
+		for (; (i + block) <= n; i += block)
+		{
+			Kernels::template applyScalar<Operation>((A + i), B, (C + i));
+		};
+		for (; i < n; i++)
+		{
+			C[i] = Operation::apply(A[i], B);
+		};
+	};
+	static inline void negate(const size_t& n, const T* A, T* C)
+	{
+		size_t i = 0;
+		for (; (i + block) <= n; i += block)
+		{
+			Kernels::negate((A + i), (C + i));
+		};
+		for (; i < n; i++)
+		{
+			C[i] = -A[i];
+		};
+	};
+
+	// Reductions
+	static inline bool equal(const size_t& n, const T* A, const T* B)
+	{
+		size_t i = 0;
+		for (; (i + block) <= n; i += block)
+		{
+			if (!Kernels::equal((A + i), (B + i)))
+			{
+				return false;
+			};
+		};
+		for (; i < n; i++)
+		{
+			if (!(A[i] == B[i]))
+			{
+				return false;
+			};
+		};
+		return true;
+	};
+	static inline T dot(const size_t& n, const T* A, const T* B)
+	{
+		T value = T();
+		size_t i = 0;
+		for (; (i + block) <= n; i += block)
+		{
+			value += Kernels::dot((A + i), (B + i));
+		};
+		for (; i < n; i++)
+		{
+			value = vectorsMultiplyAdd(A[i], B[i], value);
+		};
+		return value;
+	};
+	static inline T sumAbs(const size_t& n, const T* A)
+	{
+		T sum = T();
+		size_t i = 0;
+		for (; (i + block) <= n; i += block)
+		{
+			sum += VectorNorms<block, T>::sumAbs(A + i);
+		};
+		for (; i < n; i++)
+		{
+			sum += vectorsAbs(A[i]);
+		};
+		return sum;
+	};
+	static inline T infNorm(const size_t& n, const T* A)
+	{
+		T largest = T();
+		for (size_t i = 0; i < n; i++)
+		{
+			const T a = vectorsAbs(A[i]);
+			largest = (a > largest) ? a : largest;
+		};
+		return largest;
+	};
+	static inline T pNorm(const size_t& n, const T* A, const uint64_t& p)
+	{
+		/*
+			As VectorNorms::pNorm(), with the 2-norm from dot().
+		*/
+
+		if (p == 1)
+		{
+			return sumAbs(n, A);
+		};
+		if (p == 2)
+		{
+			return (T)std::sqrt(dot(n, A, A));
+		};
+
+		T sum = T();
+		for (size_t i = 0; i < n; i++)
+		{
+			sum += vectorsIntegerPower(vectorsAbs(A[i]), p);
+		};
+		return vectorsRoot(sum, p);
+	};
+};
+
+template <typename T, typename F>
+inline auto vectorsDynamicDispatch(const size_t& n, const F& f) -> decltype(f(VectorDynamicKernels<T, 0>()))
+{
+	/*
+		Calls f with the kernels for n elements of type T: those of Vector<N,T> for
+		the common dimensions, and the blocked kernels for any other.
+	*/
+
+#if VECTORS_DYNAMIC_DISPATCH
+	switch (n)
+	{
+	case 2:
+		return f(VectorDynamicKernels<T, 2>());
+	case 3:
+		return f(VectorDynamicKernels<T, 3>());
+	case 4:
+		return f(VectorDynamicKernels<T, 4>());
+	case 8:
+		return f(VectorDynamicKernels<T, 8>());
+	case 16:
+		return f(VectorDynamicKernels<T, 16>());
+	case 64:
+		return f(VectorDynamicKernels<T, 64>());
+	case 128:
+		return f(VectorDynamicKernels<T, 128>());
+	case 256:
+		return f(VectorDynamicKernels<T, 256>());
+	case 768:
+		return f(VectorDynamicKernels<T, 768>());
+	default:
+		break;
+	};
+#endif
+	return f(VectorDynamicKernels<T, 0>());
+};
+
+/* Structures */
+template <typename T>
+struct DynVector
+{
+	/*
+		# Dynamic Vector (struct)
+		A vector of size() elements, chosen at runtime. Up to inlineCapacity elements
+		are stored in the vector itself, and more on the heap; the storage is aligned
+		to a cache line either way, for the aligned loads of the kernels.
+	*/
+
+	static_assert(std::is_trivially_copyable<T>::value, "Dynamic vectors copy their elements bytewise.");
+
+	typedef T value_type;
+
+	static constexpr size_t alignment = 64;
+	static constexpr size_t inlineCapacity = std::max<size_t>((VECTORS_DYNAMIC_INLINE_BYTES / sizeof(T)), 1);
+
+	/* Methods */
+
+	// Constructors & Destructor
+	DynVector() {};
+	explicit DynVector(const size_t& n)
+	{
+		this->resize(n);
+	};
+	DynVector(const size_t& n, const T& fill)
+	{
+		this->allocate(n);
+		std::fill(this->elements, (this->elements + n), fill);
+	};
+	DynVector(const T* A, const size_t& n)
+	{
+		this->allocate(n);
+		this->copy(A, n);
+	};
+	DynVector(std::initializer_list<T> values) : DynVector(values.begin(), values.size()) {};
+	template <uint64_t N>
+	explicit DynVector(const Vector<N, T>& source) : DynVector(source.value, N) {};
+	DynVector(const DynVector<T>& source) : DynVector(source.elements, source.count) {};
+	DynVector(DynVector<T>&& source) noexcept
+	{
+		(*this) = std::move(source);
+	};
+	~DynVector()
+	{
+		this->deallocate();
+	};
+
+	// Assignment Operators
+	inline DynVector<T>& operator=(const DynVector<T>& source)
+	{
+		if (this != &source)
+		{
+			this->allocate(source.count);
+			this->copy(source.elements, source.count);
+		};
+		return (*this);
+	};
+	inline DynVector<T>& operator=(DynVector<T>&& source) noexcept
+	{
+		/*
+			Takes over the source's heap storage, or copies its inline elements, and
+			leaves it empty.
+		*/
+
+		if (this == &source)
+		{
+			return (*this);
+		};
+		if (source.elements == source.local)
+		{
+			if (this->elements != this->local)
+			{
+				this->deallocate();
+				this->elements = this->local;
+				this->slots = inlineCapacity;
+			};
+			this->copy(source.elements, source.count);
+		}
+		else
+		{
+			this->deallocate();
+			this->elements = source.elements;
+			this->slots = source.slots;
+			this->count = source.count;
+			source.elements = source.local;
+			source.slots = inlineCapacity;
+		};
+		source.count = 0;
+		return (*this);
+	};
+
+	// Capacity Methods
+	inline size_t size() const
+	{
+		return this->count;
+	};
+	inline bool empty() const
+	{
+		return (this->count == 0);
+	};
+	inline size_t capacity() const
+	{
+		return this->slots;
+	};
+	inline void resize(const size_t& n)
+	{
+		/*
+			Resizes to n elements, keeping the leading elements and setting new ones
+			to T().
+		*/
+
+		this->reserve(n, true);
+		for (size_t i = this->count; i < n; i++)
+		{
+			this->elements[i] = T();
+		};
+		this->count = n;
+	};
+	inline void swap(DynVector<T>& B) noexcept
+	{
+		DynVector<T> C = std::move(B);
+		B = std::move(*this);
+		(*this) = std::move(C);
+	};
+
+	// Conversion
+	template <uint64_t N>
+	inline bool toVector(Vector<N, T>& out) const
+	{
+		/*
+			Copies this into a Vector<N,T>. Returns false, leaving out as it was, if
+			the sizes differ.
+		*/
+
+		if (this->count != N)
+		{
+			return false;
+		};
+		memcpy((void*)out.value, (const void*)this->elements, (N * sizeof(T)));
+		return true;
+	};
+
+	// Access Operators
+	inline T& operator[](const size_t& i)
+	{
+		return this->elements[i];
+	};
+	inline const T& operator[](const size_t& i) const
+	{
+		return this->elements[i];
+	};
+	inline T& get(const size_t& i)
+	{
+		return (*this)[i];
+	};
+	inline const T& get(const size_t& i) const
+	{
+		return (*this)[i];
+	};
+	inline T* data()
+	{
+		return vectorsAssumeAligned<alignment>(this->elements);
+	};
+	inline const T* data() const
+	{
+		return vectorsAssumeAligned<alignment>((const T*)this->elements);
+	};
+	inline T* begin()
+	{
+		return this->elements;
+	};
+	inline T* end()
+	{
+		return (this->elements + this->count);
+	};
+	inline const T* begin() const
+	{
+		return this->elements;
+	};
+	inline const T* end() const
+	{
+		return (this->elements + this->count);
+	};
+
+	// Serialization
+	inline size_t formatLength() const
+	{
+		/*
+			An upper bound on the characters formatTo() writes, as vectorsFormatLength().
+		*/
+
+		return (2 + (this->count * (vectorsFormatElementLength<T>() + 1)));
+	};
+	inline std::string toString() const
+	{
+		return ::toString(*this);
+	};
+	inline size_t formatTo(char* buffer, const size_t& size) const
+	{
+		return ::formatTo(buffer, size, *this);
+	};
+
+	// Magnitude Operators
+	inline T length() const
+	{
+		return this->norm();
+	};
+	inline T sum() const
+	{
+		const size_t n = this->count;
+		return vectorsDynamicDispatch<T>(n, [&](auto kernels) { return decltype(kernels)::sumAbs(n, this->elements); });
+	};
+	template <typename Reduction>
+	inline T sum() const
+	{
+		/*
+			sum() accumulated as the Reduction policy says, see vectors_reduce.h.
+		*/
+
+		return Reduction::template sum<T>(this->count, [this](const size_t& i) { return vectorsAbs(this->elements[i]); });
+	};
+
+	// Normalization Methods
+	inline T squaredNorm() const
+	{
+		return this->dot(*this);
+	};
+	inline T norm() const
+	{
+		return (T)std::sqrt(this->squaredNorm());
+	};
+	template <typename Reduction>
+	inline T squaredNorm() const
+	{
+		return Reduction::template dot<T>(this->elements, this->elements, this->count);
+	};
+	template <typename Reduction>
+	inline T norm() const
+	{
+		return (T)std::sqrt(this->template squaredNorm<Reduction>());
+	};
+	inline T fastInvNorm() const
+	{
+		/*
+			An approximation of 1 / norm(), see vectorsFastInverseSqrt().
+		*/
+
+		return vectorsFastInverseSqrt(this->squaredNorm());
+	};
+	inline T pNorm(const uint64_t& p) const
+	{
+		const size_t n = this->count;
+		return vectorsDynamicDispatch<T>(n, [&](auto kernels) { return decltype(kernels)::pNorm(n, this->elements, p); });
+	};
+	inline T infNorm() const
+	{
+		/*
+			The infinity norm, the limit of pNorm() as p grows: the largest absolute
+			element.
+		*/
+
+		const size_t n = this->count;
+		return vectorsDynamicDispatch<T>(n, [&](auto kernels) { return decltype(kernels)::infNorm(n, this->elements); });
+	};
+
+	inline DynVector<T> unitNormal() const
+	{
+		return ((*this) / this->norm());
+	};
+	inline DynVector<T> fastUnitNormal() const
+	{
+		return ((*this) * this->fastInvNorm());
+	};
+	inline DynVector<T> normal() const
+	{
+		/*
+			Returns the normal vector, calculated from dividing each element by the sum
+			of all the elements.
+		*/
+
+		return ((*this) / this->sum());
+	};
+
+	// Product Operators
+	inline T dot(const DynVector<T>& B) const
+	{
+		const size_t n = std::min(this->count, B.count);
+		return vectorsDynamicDispatch<T>(n, [&](auto kernels) { return decltype(kernels)::dot(n, this->elements, B.elements); });
+	};
+	template <typename Reduction>
+	inline T dot(const DynVector<T>& B) const
+	{
+		/*
+			The dot product accumulated as the Reduction policy says, see
+			vectors_reduce.h.
+		*/
+
+		return Reduction::template dot<T>(this->elements, B.elements, std::min(this->count, B.count));
+	};
+
+	// Vector Projection Methods
+	inline T scalarProjection(const DynVector<T>& B) const
+	{
+		return (*this).dot(B.unitNormal());
+	};
+
+	// Unary Operators
+	inline DynVector<T> operator+() const
+	{
+		return (*this);
+	};
+	inline DynVector<T> operator-() const
+	{
+		DynVector<T> C = (*this);
+		const size_t n = this->count;
+		vectorsDynamicDispatch<T>(n, [&](auto kernels) { decltype(kernels)::negate(n, this->elements, C.elements); });
+		return C;
+	};
+
+	// Comparison Operators
+	inline bool operator==(const DynVector<T>& B) const
+	{
+		/*
+			Vectors are equal if they have the same size and their elements are exactly
+			equal, so as with the elements, a vector containing NaN is not equal to
+			anything.
+		*/
+
+		if (this->count != B.count)
+		{
+			return false;
+		};
+		const size_t n = this->count;
+		return vectorsDynamicDispatch<T>(n, [&](auto kernels) { return decltype(kernels)::equal(n, this->elements, B.elements); });
+	};
+	inline bool operator!=(const DynVector<T>& B) const
+	{
+		return !((*this) == B);
+	};
+
+	// Binary Operators
+	inline DynVector<T> operator+(const DynVector<T>& B) const
+	{
+		DynVector<T> C = (*this);
+		return (C += B);
+	};
+	inline DynVector<T> operator+(const T& B) const
+	{
+		DynVector<T> C = (*this);
+		return (C += B);
+	};
+
+	inline DynVector<T> operator-(const DynVector<T>& B) const
+	{
+		DynVector<T> C = (*this);
+		return (C -= B);
+	};
+	inline DynVector<T> operator-(const T& B) const
+	{
+		DynVector<T> C = (*this);
+		return (C -= B);
+	};
+
+	inline DynVector<T> operator*(const DynVector<T>& B) const
+	{
+		DynVector<T> C = (*this);
+		return (C *= B);
+	};
+	inline DynVector<T> operator*(const T& B) const
+	{
+		DynVector<T> C = (*this);
+		return (C *= B);
+	};
+
+	inline DynVector<T> operator/(const DynVector<T>& B) const
+	{
+		DynVector<T> C = (*this);
+		return (C /= B);
+	};
+	inline DynVector<T> operator/(const T& B) const
+	{
+		DynVector<T> C = (*this);
+		return (C /= B);
+	};
+
+	// Binary Assignment Operators
+	inline DynVector<T>& operator+=(const DynVector<T>& B) { return this->apply<VectorAddOperation>(B); };
+	inline DynVector<T>& operator+=(const T& B) { return this->apply<VectorAddOperation>(B); };
+	inline DynVector<T>& operator-=(const DynVector<T>& B) { return this->apply<VectorSubOperation>(B); };
+	inline DynVector<T>& operator-=(const T& B) { return this->apply<VectorSubOperation>(B); };
+	inline DynVector<T>& operator*=(const DynVector<T>& B) { return this->apply<VectorMulOperation>(B); };
+	inline DynVector<T>& operator*=(const T& B) { return this->apply<VectorMulOperation>(B); };
+	inline DynVector<T>& operator/=(const DynVector<T>& B) { return this->apply<VectorDivOperation>(B); };
+	inline DynVector<T>& operator/=(const T& B) { return this->apply<VectorDivOperation>(B); };
+
+private:
+	/* Elements */
+	alignas(alignment) T local[inlineCapacity];
+	T* elements = local;
+	size_t count = 0;
+	size_t slots = inlineCapacity;
+
+	/* Methods */
+	inline void reserve(const size_t& n, const bool& keep)
+	{
+		/*
+			Makes room for n elements, on the heap if they don't fit where they are, in
+			a whole number of cache lines. The current elements are kept if keep is set.
+		*/
+
+		if (n <= this->slots)
+		{
+			return;
+		};
+
+		const size_t bytes = (((n * sizeof(T)) + alignment - 1) & ~(alignment - 1));
+		T* storage = (T*)vectorsAlignedAlloc(bytes, alignment);
+		if (keep && (this->count > 0))
+		{
+			memcpy((void*)storage, (const void*)this->elements, (this->count * sizeof(T)));
+		};
+		this->deallocate();
+		this->elements = storage;
+		this->slots = (bytes / sizeof(T));
+	};
+	inline void allocate(const size_t& n)
+	{
+		/*
+			Makes room for n elements without keeping the current ones, and sets the
+			size to n.
+		*/
+
+		this->reserve(n, false);
+		this->count = n;
+	};
+	inline void copy(const T* A, const size_t& n)
+	{
+		if (n > 0)
+		{
+			memcpy((void*)this->elements, (const void*)A, (n * sizeof(T)));
+		};
+		this->count = n;
+	};
+	inline void deallocate()
+	{
+		if (this->elements != this->local)
+		{
+			vectorsAlignedFree(this->elements, alignment);
+		};
+	};
+
+	template <typename Operation>
+	inline DynVector<T>& apply(const DynVector<T>& B)
+	{
+		const size_t n = std::min(this->count, B.count);
+		vectorsDynamicDispatch<T>(n, [&](auto kernels) { decltype(kernels)::template apply<Operation>(n, this->elements, B.elements, this->elements); });
+		return (*this);
+	};
+	template <typename Operation>
+	inline DynVector<T>& apply(const T& B)
+	{
+		const size_t n = this->count;
+		vectorsDynamicDispatch<T>(n, [&](auto kernels) { decltype(kernels)::template applyScalar<Operation>(n, this->elements, B, this->elements); });
+		return (*this);
+	};
+};
+
+/* Scalar Operators */
+template <typename T>
+inline DynVector<T> operator+(const typename std::common_type<T>::type& A, const DynVector<T>& B) { return (B + A); };
+template <typename T>
+inline DynVector<T> operator-(const typename std::common_type<T>::type& A, const DynVector<T>& B) { return ((-B) + A); };
+template <typename T>
+inline DynVector<T> operator*(const typename std::common_type<T>::type& A, const DynVector<T>& B) { return (B * A); };
+template <typename T>
+inline DynVector<T> operator/(const typename std::common_type<T>::type& A, const DynVector<T>& B) { return (DynVector<T>(B.size(), A) / B); };
+
+/* Serialization */
+template <typename T>
+inline size_t formatTo(char* buffer, const size_t& size, const DynVector<T>& value)
+{
+	/*
+		Formats value as "(x,y,z)", as formatTo() does fixed size vectors;
+		value.formatLength() characters always suffice.
+	*/
+
+	return vectorsFormatElements(buffer, size, value.data(), value.size());
+};
+template <typename T>
+std::string toString(const DynVector<T>& value)
+{
+	std::string s(value.formatLength(), '\0');
+	s.resize(formatTo(&s[0], s.size(), value));
+	return s;
+};
+template <typename T>
+std::ostream& operator<<(std::ostream& stream, const DynVector<T>& value)
+{
+	return vectorsWriteElements(stream, value.data(), value.size());
+};
+
+#endif
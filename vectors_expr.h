@@ -0,0 +1,309 @@
+#pragma once
+/*
+	# Vector Template Library - Expression Templates
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	An opt-in layer of lazily evaluated vector arithmetic. Wrapping a vector with
+	lazy() makes the operators build an expression instead of a temporary vector
+	for every step, and the whole expression is evaluated in one fused loop when
+	it is assigned to a vector:
+
+		Vector<256, float> r = lazy(a) + lazy(b) * s - lazy(c);
+
+	Reductions such as dot(lazy(a) + lazy(b), c) run over the expression directly
+	without building the intermediate vector at all.
+
+	Expressions reference the vectors they were built from, so like any reference
+	they must not outlive them. Temporaries used directly in an expression are
+	held by value, so e.g. lazy(a) + (b * s) is safe.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+#ifndef VECTOR_TEMPLATE_LIBRARY_EXPR__H
+#define VECTOR_TEMPLATE_LIBRARY_EXPR__H
+/* Deps */
+#include "vectors.h"
+#include <cmath>
+#include <utility>
+
+/* Expressions */
+template <typename V>
+struct VectorReferenceExpression
+{
+	/*
+		# Vector Reference Expression (struct)
+		A leaf referring to an existing vector.
+	*/
+
+	typedef V VectorType;
+	typedef typename VectorTraits<V>::ElementType ElementType;
+	static constexpr uint64_t dimensions = VectorTraits<V>::dimensions;
+
+	/* Elements */
+	const V& vector;
+
+	/* Methods */
+	constexpr explicit VectorReferenceExpression(const V& vector) : vector(vector) {};
+	constexpr ElementType operator[](const uint64_t& i) const
+	{
+		return this->vector.value[i];
+	};
+};
+
+template <typename V>
+struct VectorValueExpression
+{
+	/*
+		# Vector Value Expression (struct)
+		A leaf holding its own copy of a vector, used for temporaries so that they
+		live as long as the expression does.
+	*/
+
+	typedef V VectorType;
+	typedef typename VectorTraits<V>::ElementType ElementType;
+	static constexpr uint64_t dimensions = VectorTraits<V>::dimensions;
+
+	/* Elements */
+	V vector;
+
+	/* Methods */
+	constexpr explicit VectorValueExpression(V vector) : vector(std::move(vector)) {};
+	constexpr ElementType operator[](const uint64_t& i) const
+	{
+		return this->vector.value[i];
+	};
+};
+
+template <typename Operation, typename L, typename R>
+struct VectorBinaryExpression
+{
+	/*
+		# Vector Binary Expression (struct)
+		The element-wise combination of two expressions.
+	*/
+
+	static_assert(L::dimensions == R::dimensions, "Both sides of a vector expression must have the same dimensions.");
+
+	typedef typename L::VectorType VectorType;
+	typedef typename L::ElementType ElementType;
+	static constexpr uint64_t dimensions = L::dimensions;
+
+	/* Elements */
+	L left;
+	R right;
+
+	/* Methods */
+	constexpr VectorBinaryExpression(L left, R right) : left(std::move(left)), right(std::move(right)) {};
+	constexpr ElementType operator[](const uint64_t& i) const
+	{
+		return Operation::apply(this->left[i], this->right[i]);
+	};
+};
+
+template <typename Operation, typename L, bool Reversed>
+struct VectorScalarExpression
+{
+	/*
+		# Vector Scalar Expression (struct)
+		The element-wise combination of an expression with a scalar. When Reversed is
+		set the scalar is the left hand side, e.g. s - lazy(a).
+	*/
+
+	typedef typename L::VectorType VectorType;
+	typedef typename L::ElementType ElementType;
+	static constexpr uint64_t dimensions = L::dimensions;
+
+	/* Elements */
+	L left;
+	ElementType scalar;
+
+	/* Methods */
+	constexpr VectorScalarExpression(L left, const ElementType& scalar) : left(std::move(left)), scalar(scalar) {};
+	constexpr ElementType operator[](const uint64_t& i) const
+	{
+		return Reversed ? Operation::apply(this->scalar, this->left[i]) : Operation::apply(this->left[i], this->scalar);
+	};
+};
+
+template <typename L>
+struct VectorNegateExpression
+{
+	typedef typename L::VectorType VectorType;
+	typedef typename L::ElementType ElementType;
+	static constexpr uint64_t dimensions = L::dimensions;
+
+	/* Elements */
+	L left;
+
+	/* Methods */
+	constexpr explicit VectorNegateExpression(L left) : left(std::move(left)) {};
+	constexpr ElementType operator[](const uint64_t& i) const
+	{
+		return -this->left[i];
+	};
+};
+
+/* Traits */
+template <typename V>
+struct VectorExpressionTraits<VectorReferenceExpression<V>>
+{
+	static constexpr bool isExpression = true;
+};
+template <typename V>
+struct VectorExpressionTraits<VectorValueExpression<V>>
+{
+	static constexpr bool isExpression = true;
+};
+template <typename Operation, typename L, typename R>
+struct VectorExpressionTraits<VectorBinaryExpression<Operation, L, R>>
+{
+	static constexpr bool isExpression = true;
+};
+template <typename Operation, typename L, bool Reversed>
+struct VectorExpressionTraits<VectorScalarExpression<Operation, L, Reversed>>
+{
+	static constexpr bool isExpression = true;
+};
+template <typename L>
+struct VectorExpressionTraits<VectorNegateExpression<L>>
+{
+	static constexpr bool isExpression = true;
+};
+
+template <typename X>
+struct VectorExpressionOperand
+{
+	/*
+		Maps an operand of an expression operator to the node stored for it: nodes are
+		stored as they are, vectors by reference and temporary vectors by value.
+	*/
+
+	typedef typename std::remove_cv<typename std::remove_reference<X>::type>::type Type;
+	typedef typename std::conditional<
+		VectorExpressionTraits<Type>::isExpression,
+		Type,
+		typename std::conditional<
+			std::is_lvalue_reference<X>::value,
+			VectorReferenceExpression<Type>,
+			VectorValueExpression<Type>
+		>::type
+	>::type NodeType;
+
+	static constexpr bool isExpression = VectorExpressionTraits<Type>::isExpression;
+	static constexpr bool isVector = VectorTraits<Type>::isVector;
+};
+
+template <typename A, typename B>
+struct VectorExpressionOperands
+{
+	/*
+		Whether A and B can be combined by an expression operator: both must be
+		vectors or expressions, and at least one an expression, so the eager vector
+		operators are left alone.
+	*/
+
+	static constexpr bool value =
+		(VectorExpressionOperand<A>::isExpression || VectorExpressionOperand<A>::isVector) &&
+		(VectorExpressionOperand<B>::isExpression || VectorExpressionOperand<B>::isVector) &&
+		(VectorExpressionOperand<A>::isExpression || VectorExpressionOperand<B>::isExpression);
+};
+
+/* Construction */
+template <typename V, typename = typename std::enable_if<VectorTraits<V>::isVector>::type>
+constexpr VectorReferenceExpression<V> lazy(const V& vector)
+{
+	/*
+		Starts a lazily evaluated expression from the given vector.
+	*/
+
+	return VectorReferenceExpression<V>(vector);
+};
+
+template <typename E, typename = typename std::enable_if<VectorExpressionTraits<E>::isExpression>::type>
+constexpr typename E::VectorType evaluate(const E& expression)
+{
+	/*
+		Evaluates an expression into a new vector of the type it was built from.
+	*/
+
+	return typename E::VectorType(expression);
+};
+
+/* Expression Operators */
+#define VECTORS_EXPRESSION_OPERATOR(symbol, Operation) \
+	template <typename A, typename B, typename std::enable_if<VectorExpressionOperands<A&&, B&&>::value, int>::type = 0> \
+	constexpr VectorBinaryExpression<Operation, typename VectorExpressionOperand<A&&>::NodeType, typename VectorExpressionOperand<B&&>::NodeType> \
+	operator symbol(A&& left, B&& right) \
+	{ \
+		return VectorBinaryExpression<Operation, typename VectorExpressionOperand<A&&>::NodeType, typename VectorExpressionOperand<B&&>::NodeType>( \
+			typename VectorExpressionOperand<A&&>::NodeType(std::forward<A>(left)), \
+			typename VectorExpressionOperand<B&&>::NodeType(std::forward<B>(right)) \
+		); \
+	}; \
+	template <typename E, typename std::enable_if<VectorExpressionTraits<E>::isExpression, int>::type = 0> \
+	constexpr VectorScalarExpression<Operation, E, false> operator symbol(const E& left, const typename E::ElementType& right) \
+	{ \
+		return VectorScalarExpression<Operation, E, false>(left, right); \
+	}; \
+	template <typename E, typename std::enable_if<VectorExpressionTraits<E>::isExpression, int>::type = 0> \
+	constexpr VectorScalarExpression<Operation, E, true> operator symbol(const typename E::ElementType& left, const E& right) \
+	{ \
+		return VectorScalarExpression<Operation, E, true>(right, left); \
+	};
+
+VECTORS_EXPRESSION_OPERATOR(+, VectorAddOperation)
+VECTORS_EXPRESSION_OPERATOR(-, VectorSubOperation)
+VECTORS_EXPRESSION_OPERATOR(*, VectorMulOperation)
+VECTORS_EXPRESSION_OPERATOR(/, VectorDivOperation)
+
+#undef VECTORS_EXPRESSION_OPERATOR
+
+template <typename E, typename std::enable_if<VectorExpressionTraits<E>::isExpression, int>::type = 0>
+constexpr VectorNegateExpression<E> operator-(const E& expression)
+{
+	return VectorNegateExpression<E>(expression);
+};
+
+/* Reductions */
+template <typename A, typename B, typename std::enable_if<VectorExpressionOperands<const A&, const B&>::value, int>::type = 0>
+constexpr typename VectorExpressionOperand<const A&>::NodeType::ElementType dot(const A& left, const B& right)
+{
+	/*
+		The dot product of two expressions (or an expression and a vector), computed
+		in a single pass without evaluating either side into a vector.
+	*/
+
+	typedef typename VectorExpressionOperand<const A&>::NodeType L;
+	typedef typename VectorExpressionOperand<const B&>::NodeType R;
+	static_assert(L::dimensions == R::dimensions, "Both sides of a dot product must have the same dimensions.");
+
+	const L l(left);
+	const R r(right);
+	typename L::ElementType value = typename L::ElementType();
+	VectorUnroll<L::dimensions>::each([&](const uint64_t& i) { value += (l[i] * r[i]); });
+	return value;
+};
+
+template <typename E, typename std::enable_if<VectorExpressionTraits<E>::isExpression, int>::type = 0>
+constexpr typename E::ElementType sum(const E& expression)
+{
+	/*
+		The sum of the absolute values of the elements, matching the vector sum()
+		methods.
+	*/
+
+	typename E::ElementType value = typename E::ElementType();
+	VectorUnroll<E::dimensions>::each([&](const uint64_t& i) { value += vectorsAbs(expression[i]); });
+	return value;
+};
+
+template <typename E, typename std::enable_if<VectorExpressionTraits<E>::isExpression, int>::type = 0>
+inline typename E::ElementType norm(const E& expression)
+{
+	return (typename E::ElementType)std::sqrt(dot(expression, expression));
+};
+
+#endif
@@ -0,0 +1,718 @@
+#pragma once
+/*
+	# Vector Template Library - Approximate Nearest Neighbour Search
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	HnswIndex<N,T>, an approximate k nearest neighbour index over Vector<N,T>
+	built as a Hierarchical Navigable Small World graph (Malkov & Yashunin, 2016).
+	Each vector is a node linked to its nearest neighbours on layer 0 and, with
+	exponentially decreasing probability, on sparser layers above it. A search
+	descends greedily through the upper layers and then runs a best-first search
+	of width efSearch on layer 0, visiting a tiny fraction of the vectors:
+
+		HnswIndex<128, float> index(VECTOR_METRIC_COSINE);
+		index.add(embeddings.data(), embeddings.size());
+		index.efSearch = 128;
+		index.search(query, 10, results);
+
+	It uses the metrics and result type of FlatIndex (see vectors_index.h), which
+	gives the exact answers to measure recall against. Searches may run from any
+	number of threads at once; inserts are serialized against them.
+
+	## Tuning
+	- M: links per node on the upper layers (2 * M on layer 0). Higher M gives
+	  better recall on high dimensional data at the cost of memory and build time.
+	- efConstruction: the search width used to find the links of a new node. It
+	  is raised to M when smaller.
+	- efSearch: the search width of queries, the main recall/latency trade-off. It
+	  is raised to k when smaller.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+#ifndef VECTOR_TEMPLATE_LIBRARY_HNSW__H
+#define VECTOR_TEMPLATE_LIBRARY_HNSW__H
+/* Deps */
+#include "vectors.h"
+#include "vectors_index.h"
+#include "vectors_io.h"
+#include <stddef.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <mutex>
+#include <queue>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/* Macros */
+#if defined(__GNUC__) || defined(__clang__)
+	#define VECTORS_PREFETCH(address) __builtin_prefetch((const void*)(address))
+#else
+	#define VECTORS_PREFETCH(address) ((void)0)
+#endif
+
+/* Helpers */
+struct VectorVisitedSet
+{
+	/*
+		# Vector Visited Set (struct)
+		Marks the nodes a search has visited. Clearing is O(1): each search uses a new
+		generation number, and a node counts as visited when its mark equals it.
+	*/
+
+	/* Elements */
+	std::vector<uint32_t> marks;
+	uint32_t generation = 0;
+
+	/* Methods */
+	inline void reset(const size_t& size)
+	{
+		if (this->marks.size() < size)
+		{
+			this->marks.resize(size, 0);
+		};
+		this->generation++;
+		if (this->generation == 0)
+		{
+			std::fill(this->marks.begin(), this->marks.end(), 0);
+			this->generation = 1;
+		};
+	};
+	inline bool visit(const uint32_t& id)
+	{
+		/*
+			Marks id, returning whether it was unvisited.
+		*/
+
+		if (this->marks[id] == this->generation)
+		{
+			return false;
+		};
+		this->marks[id] = this->generation;
+		return true;
+	};
+};
+
+/* Index */
+template <uint64_t N, typename T>
+struct HnswIndex
+{
+	/*
+		# HNSW Index (struct)
+		An approximate nearest neighbour index over N dimensional vectors. Vectors are
+		identified by the order they were added in, starting at 0. For the cosine
+		metric they are stored normalized.
+	*/
+
+	typedef Vector<N, T> V;
+	typedef std::pair<T, uint32_t> Candidate;
+
+	static constexpr uint32_t magic = 0x484C5456; // "VTLH" read as a little-endian uint32
+	static constexpr uint16_t version = 1;
+
+	/* Elements */
+	std::vector<V> vectors;
+	std::vector<T> norms;
+	std::vector<uint32_t> levels;
+	std::vector<uint32_t> links;
+	std::vector<std::vector<uint32_t>> upperLinks;
+	VectorMetric metric;
+	size_t M;
+	size_t efConstruction;
+	size_t efSearch;
+	uint32_t entry;
+	int32_t maxLevel;
+	uint64_t seed;
+	mutable std::shared_mutex lock;
+
+	/* Methods */
+
+	// Constructors & Destructor
+	explicit HnswIndex(const VectorMetric& metric = VECTOR_METRIC_L2, const size_t& M = 16, const size_t& efConstruction = 200, const uint64_t& seed = 42) :
+		metric(metric), M((M < 2) ? 2 : M), efConstruction(std::max(efConstruction, ((M < 2) ? (size_t)2 : M))), efSearch(64), entry(0), maxLevel(-1), seed(seed ? seed : 1) {};
+
+	// Capacity Methods
+	inline size_t size() const
+	{
+		return this->vectors.size();
+	};
+	inline bool empty() const
+	{
+		return this->vectors.empty();
+	};
+	inline void reserve(const size_t& capacity)
+	{
+		std::unique_lock<std::shared_mutex> guard(this->lock);
+		this->vectors.reserve(capacity);
+		this->norms.reserve(capacity);
+		this->levels.reserve(capacity);
+		this->links.reserve(capacity * this->linkStride());
+		this->upperLinks.reserve(capacity);
+	};
+
+	// Access Operators
+	inline const V& operator[](const uint64_t& id) const
+	{
+		return this->vectors[id];
+	};
+	inline const V& get(const uint64_t& id) const
+	{
+		return (*this)[id];
+	};
+
+	// Modifiers
+	inline uint64_t add(const V& vector)
+	{
+		/*
+			Inserts one vector, returning its id. The index stays searchable throughout;
+			concurrent searches wait while the graph is updated.
+		*/
+
+		std::unique_lock<std::shared_mutex> guard(this->lock);
+		return this->insert(vector);
+	};
+	inline void add(const V* vectors, const size_t& n)
+	{
+		std::unique_lock<std::shared_mutex> guard(this->lock);
+		this->reserveUnlocked(this->size() + n);
+		for (size_t i = 0; i < n; i++)
+		{
+			this->insert(vectors[i]);
+		};
+	};
+
+	// Search Methods
+	inline size_t search(const V& query, const size_t& k, VectorNeighbour<T>* out, size_t ef = 0) const
+	{
+		/*
+			Finds approximately the k nearest vectors to query, writing them to out best
+			first in the format of FlatIndex::search. ef overrides efSearch for this
+			query. Returns how many were found; the remaining slots are padded.
+		*/
+
+		std::shared_lock<std::shared_mutex> guard(this->lock);
+		const T sign = (this->metric == VECTOR_METRIC_L2) ? (T)1 : (T)-1;
+		size_t found = 0;
+		if ((this->maxLevel >= 0) && (k > 0))
+		{
+			const V q = this->prepare(query);
+			const T qNorm = q.dot(q);
+
+			uint32_t current = this->entry;
+			T currentCost = this->cost(q, qNorm, current);
+			for (int32_t level = this->maxLevel; level > 0; level--)
+			{
+				this->descend(q, qNorm, level, current, currentCost);
+			};
+
+			std::vector<Candidate> results;
+			this->searchLayer(q, qNorm, { Candidate(currentCost, current) }, std::max(((ef > 0) ? ef : this->efSearch), k), 0, results);
+			found = std::min(k, results.size());
+			for (size_t i = 0; i < found; i++)
+			{
+				out[i].id = results[i].second;
+				out[i].distance = (results[i].first * sign);
+			};
+		};
+		for (size_t i = found; i < k; i++)
+		{
+			out[i].id = VECTOR_NO_NEIGHBOUR;
+			out[i].distance = (std::numeric_limits<T>::max() * sign);
+		};
+		return found;
+	};
+	inline void search(const V* queries, const size_t& count, const size_t& k, VectorNeighbour<T>* out, size_t threads = 0) const
+	{
+		/*
+			Answers count queries at once, writing k results for queries[i] to
+			out[i * k] onwards, split across threads (by default one per hardware
+			thread).
+		*/
+
+		if ((count == 0) || (k == 0))
+		{
+			return;
+		};
+		if (threads == 0)
+		{
+			threads = std::thread::hardware_concurrency();
+		};
+		threads = std::max((size_t)1, std::min(threads, count));
+
+		const size_t share = ((count + threads - 1) / threads);
+		auto scan = [&](const size_t& first) {
+			const size_t last = std::min(count, (first + share));
+			for (size_t i = first; i < last; i++)
+			{
+				this->search(queries[i], k, out + (i * k));
+			};
+		};
+
+		std::vector<std::thread> workers;
+		for (size_t first = share; first < count; first += share)
+		{
+			workers.emplace_back(scan, first);
+		};
+		scan(0);
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		};
+	};
+
+	// Serialization
+	inline bool save(std::ostream& stream) const
+	{
+		/*
+			Writes the index, graph included, so it can be loaded without rebuilding.
+			Returns whether the stream is still good afterwards.
+		*/
+
+		std::shared_lock<std::shared_mutex> guard(this->lock);
+		const uint64_t header[] = {
+			(uint64_t)magic,
+			(uint64_t)version,
+			(uint64_t)VectorElementType<T>::code,
+			(uint64_t)sizeof(T),
+			(uint64_t)N,
+			(uint64_t)this->metric,
+			(uint64_t)this->M,
+			(uint64_t)this->efConstruction,
+			(uint64_t)this->efSearch,
+			(uint64_t)this->entry,
+			(uint64_t)(int64_t)this->maxLevel,
+			this->seed,
+			(uint64_t)this->size()
+		};
+		writeValues(stream, header, (sizeof(header) / sizeof(header[0])));
+		writeVectors(stream, this->vectors, false);
+		writeValues(stream, this->norms.data(), this->norms.size());
+		writeValues(stream, this->levels.data(), this->levels.size());
+		writeValues(stream, this->links.data(), this->links.size());
+		for (const std::vector<uint32_t>& upper : this->upperLinks)
+		{
+			writeValues(stream, upper.data(), upper.size());
+		};
+		return stream.good();
+	};
+	inline bool save(const std::string& path) const
+	{
+		std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+		return this->save(stream) && (stream.flush(), stream.good());
+	};
+	inline bool load(std::istream& stream)
+	{
+		/*
+			Replaces the index with one written by save(). Returns false, leaving the
+			index empty, if the stream holds a different type of index, ends early, or
+			holds a graph which isn't consistent (a link to a node which doesn't exist,
+			more links than M allows, ...), so a corrupt file can't crash a search.
+		*/
+
+		std::unique_lock<std::shared_mutex> guard(this->lock);
+		this->clearUnlocked();
+
+		uint64_t header[13];
+		if (
+			!readValues(stream, header, 13) ||
+			(header[0] != magic) || (header[1] != version) ||
+			(header[2] != (uint64_t)VectorElementType<T>::code) || (header[3] != sizeof(T)) || (header[4] != N)
+		)
+		{
+			return false;
+		};
+		const uint64_t count = header[12];
+		const uint64_t M = header[6];
+		const int64_t maxLevel = (int64_t)header[10];
+		if (
+			(header[5] > (uint64_t)VECTOR_METRIC_COSINE) ||
+			(M < 2) || (M > (UINT32_MAX / 2)) || (header[7] == 0) ||
+			(count > UINT32_MAX) || (maxLevel < -1) || (maxLevel > 31) ||
+			((count == 0) != (maxLevel == -1)) || ((count > 0) && (header[9] >= count))
+		)
+		{
+			return false;
+		};
+
+		// Every node takes at least this much of the stream, so a count past what's
+		// left is rejected before anything is allocated.
+		const uint64_t stride = ((2 * M) + 1);
+		const uint64_t nodeBytes = (sizeof(V) + sizeof(T) + sizeof(uint32_t) + (stride * sizeof(uint32_t)));
+		if ((count > 0) && (count > (vectorsStreamRemaining(stream) / nodeBytes)))
+		{
+			return false;
+		};
+
+		this->metric = (VectorMetric)header[5];
+		this->M = (size_t)M;
+		this->efConstruction = (size_t)header[7];
+		this->efSearch = (size_t)header[8];
+		this->entry = (uint32_t)header[9];
+		this->maxLevel = (int32_t)maxLevel;
+		this->seed = header[11];
+
+		bool good = (
+			readVectors(stream, this->vectors, count) &&
+			readValues(stream, this->norms, count) &&
+			readValues(stream, this->levels, count) &&
+			readValues(stream, this->links, (count * stride))
+		);
+		if (good)
+		{
+			this->upperLinks.resize((size_t)count);
+			for (size_t i = 0; good && (i < count); i++)
+			{
+				good = (this->levels[i] <= (uint32_t)maxLevel) && readValues(stream, this->upperLinks[i], (this->levels[i] * (M + 1)));
+			};
+		};
+		good = good && ((count == 0) || (this->levels[this->entry] == (uint32_t)maxLevel)) && this->linksValid();
+		if (!good)
+		{
+			this->clearUnlocked();
+		};
+		return good;
+	};
+	inline bool load(const std::string& path)
+	{
+		std::ifstream stream(path, std::ios::binary);
+		return this->load(stream);
+	};
+
+	// Graph Methods
+	inline size_t linkStride() const
+	{
+		/*
+			The size of a node's link list on layer 0: a count followed by 2 * M ids.
+		*/
+
+		return ((2 * this->M) + 1);
+	};
+	inline const uint32_t* neighbours(const uint32_t& id, const int32_t& level) const
+	{
+		/*
+			The link list of id on level, as a count followed by that many ids.
+		*/
+
+		if (level == 0)
+		{
+			return this->links.data() + ((size_t)id * this->linkStride());
+		};
+		return this->upperLinks[id].data() + ((size_t)(level - 1) * (this->M + 1));
+	};
+	inline uint32_t* neighbours(const uint32_t& id, const int32_t& level)
+	{
+		return const_cast<uint32_t*>(static_cast<const HnswIndex<N, T>*>(this)->neighbours(id, level));
+	};
+
+private:
+	inline bool linksValid() const
+	{
+		/*
+			Whether every link list fits its layer (at most 2 * M ids on layer 0 and M
+			above) and only links to nodes which exist on that layer.
+		*/
+
+		const uint32_t count = (uint32_t)this->size();
+		for (uint32_t id = 0; id < count; id++)
+		{
+			for (int32_t level = 0; level <= (int32_t)this->levels[id]; level++)
+			{
+				const uint32_t* list = this->neighbours(id, level);
+				if (list[0] > ((level == 0) ? (2 * this->M) : this->M))
+				{
+					return false;
+				};
+				for (uint32_t i = 1; i <= list[0]; i++)
+				{
+					if ((list[i] >= count) || (this->levels[list[i]] < (uint32_t)level))
+					{
+						return false;
+					};
+				};
+			};
+		};
+		return true;
+	};
+	inline void clearUnlocked()
+	{
+		this->vectors.clear();
+		this->norms.clear();
+		this->levels.clear();
+		this->links.clear();
+		this->upperLinks.clear();
+		this->entry = 0;
+		this->maxLevel = -1;
+	};
+	inline void reserveUnlocked(const size_t& capacity)
+	{
+		this->vectors.reserve(capacity);
+		this->norms.reserve(capacity);
+		this->levels.reserve(capacity);
+		this->links.reserve(capacity * this->linkStride());
+		this->upperLinks.reserve(capacity);
+	};
+
+	inline V prepare(const V& vector) const
+	{
+		/*
+			The form a vector is stored and searched in: normalized for cosine.
+		*/
+
+		if (this->metric == VECTOR_METRIC_COSINE)
+		{
+			const T squared = vector.dot(vector);
+			return (squared > T()) ? (vector * ((T)1 / (T)std::sqrt(squared))) : vector;
+		};
+		return vector;
+	};
+	inline T cost(const V& query, const T& queryNorm, const uint32_t& id) const
+	{
+		/*
+			The distance from query to a stored vector as a cost where smaller is better.
+		*/
+
+		const T dot = query.dot(this->vectors[id]);
+		if (this->metric == VECTOR_METRIC_L2)
+		{
+			const T squared = (queryNorm + this->norms[id]) - ((T)2 * dot);
+			return (squared > T()) ? squared : T();
+		};
+		return -dot;
+	};
+	inline T costBetween(const uint32_t& A, const uint32_t& B) const
+	{
+		return this->cost(this->vectors[A], this->norms[A], B);
+	};
+
+	inline int32_t randomLevel()
+	{
+		/*
+			Draws a level from the exponential distribution HNSW uses, with scale
+			1 / ln(M), from an xorshift generator so builds are reproducible.
+		*/
+
+		this->seed ^= (this->seed << 13);
+		this->seed ^= (this->seed >> 7);
+		this->seed ^= (this->seed << 17);
+		const double uniform = ((double)((this->seed >> 11) + 1) / 9007199254740993.0);
+		const double level = (-std::log(uniform) / std::log((double)this->M));
+		return (int32_t)std::min(level, 31.0);
+	};
+
+	inline void descend(const V& query, const T& queryNorm, const int32_t& level, uint32_t& current, T& currentCost) const
+	{
+		/*
+			Greedily walks level towards query until no neighbour is closer.
+		*/
+
+		bool changed = true;
+		while (changed)
+		{
+			changed = false;
+			const uint32_t* list = this->neighbours(current, level);
+			for (uint32_t i = 1; i <= list[0]; i++)
+			{
+				const T c = this->cost(query, queryNorm, list[i]);
+				if (c < currentCost)
+				{
+					current = list[i];
+					currentCost = c;
+					changed = true;
+				};
+			};
+		};
+	};
+
+	inline void searchLayer(const V& query, const T& queryNorm, const std::vector<Candidate>& entries, const size_t& ef, const int32_t& level, std::vector<Candidate>& out) const
+	{
+		/*
+			Best-first search of one layer from the entry points, keeping the ef closest
+			nodes found (at least one, whatever ef is). Writes them to out, closest
+			first.
+		*/
+
+		const size_t width = std::max(ef, (size_t)1);
+
+		static thread_local VectorVisitedSet visited;
+		visited.reset(this->size());
+
+		std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> candidates;
+		std::priority_queue<Candidate> results;
+		for (const Candidate& e : entries)
+		{
+			if (visited.visit(e.second))
+			{
+				candidates.push(e);
+				results.push(e);
+			};
+		};
+		while (results.size() > width)
+		{
+			results.pop();
+		};
+
+		while (!candidates.empty())
+		{
+			const Candidate closest = candidates.top();
+			if ((results.size() >= width) && (closest.first > results.top().first))
+			{
+				break;
+			};
+			candidates.pop();
+
+			const uint32_t* list = this->neighbours(closest.second, level);
+			const uint32_t count = list[0];
+			for (uint32_t i = 1; i <= count; i++)
+			{
+				VECTORS_PREFETCH(&this->vectors[list[i]]);
+				VECTORS_PREFETCH(&this->norms[list[i]]);
+			};
+			for (uint32_t i = 1; i <= count; i++)
+			{
+				const uint32_t id = list[i];
+				if (!visited.visit(id))
+				{
+					continue;
+				};
+				const T c = this->cost(query, queryNorm, id);
+				if ((results.size() < width) || (c < results.top().first))
+				{
+					candidates.push(Candidate(c, id));
+					results.push(Candidate(c, id));
+					if (results.size() > width)
+					{
+						results.pop();
+					};
+				};
+			};
+		};
+
+		out.resize(results.size());
+		for (size_t i = out.size(); i > 0; i--)
+		{
+			out[i - 1] = results.top();
+			results.pop();
+		};
+	};
+
+	inline void selectNeighbours(const std::vector<Candidate>& candidates, const size_t& maximum, std::vector<uint32_t>& out) const
+	{
+		/*
+			The neighbour selection heuristic of the HNSW paper: walking the candidates
+			closest first, keep one only if it is closer to the base than to every
+			neighbour already kept. This spreads links out in different directions,
+			which keeps clustered data connected.
+		*/
+
+		out.clear();
+		for (const Candidate& candidate : candidates)
+		{
+			if (out.size() >= maximum)
+			{
+				break;
+			};
+			bool keep = true;
+			for (const uint32_t& selected : out)
+			{
+				if (this->costBetween(selected, candidate.second) < candidate.first)
+				{
+					keep = false;
+					break;
+				};
+			};
+			if (keep)
+			{
+				out.push_back(candidate.second);
+			};
+		};
+	};
+
+	inline void connect(const uint32_t& id, const std::vector<uint32_t>& selected, const int32_t& level)
+	{
+		/*
+			Links id to the selected nodes on level, and each of them back to id. A node
+			with a full list re-selects its links from the old ones plus id.
+		*/
+
+		const size_t maximum = (level == 0) ? (2 * this->M) : this->M;
+		uint32_t* own = this->neighbours(id, level);
+		own[0] = (uint32_t)selected.size();
+		std::copy(selected.begin(), selected.end(), own + 1);
+
+		std::vector<Candidate> candidates;
+		std::vector<uint32_t> pruned;
+		for (const uint32_t& other : selected)
+		{
+			uint32_t* list = this->neighbours(other, level);
+			if (list[0] < maximum)
+			{
+				list[++list[0]] = id;
+				continue;
+			};
+
+			candidates.clear();
+			candidates.push_back(Candidate(this->costBetween(other, id), id));
+			for (uint32_t i = 1; i <= list[0]; i++)
+			{
+				candidates.push_back(Candidate(this->costBetween(other, list[i]), list[i]));
+			};
+			std::sort(candidates.begin(), candidates.end());
+			this->selectNeighbours(candidates, maximum, pruned);
+			list[0] = (uint32_t)pruned.size();
+			std::copy(pruned.begin(), pruned.end(), list + 1);
+		};
+	};
+
+	inline uint64_t insert(const V& vector)
+	{
+		const uint32_t id = (uint32_t)this->size();
+		const int32_t level = this->randomLevel();
+
+		this->vectors.push_back(this->prepare(vector));
+		const V& q = this->vectors.back();
+		const T qNorm = q.dot(q);
+		this->norms.push_back(qNorm);
+		this->levels.push_back((uint32_t)level);
+		this->links.resize(this->links.size() + this->linkStride(), 0);
+		this->upperLinks.emplace_back((size_t)level * (this->M + 1), 0);
+
+		if (this->maxLevel < 0)
+		{
+			this->entry = id;
+			this->maxLevel = level;
+			return id;
+		};
+
+		uint32_t current = this->entry;
+		T currentCost = this->cost(q, qNorm, current);
+		for (int32_t l = this->maxLevel; l > level; l--)
+		{
+			this->descend(q, qNorm, l, current, currentCost);
+		};
+
+		std::vector<Candidate> entries = { Candidate(currentCost, current) };
+		std::vector<Candidate> found;
+		std::vector<uint32_t> selected;
+		for (int32_t l = std::min(level, this->maxLevel); l >= 0; l--)
+		{
+			this->searchLayer(q, qNorm, entries, this->efConstruction, l, found);
+			this->selectNeighbours(found, this->M, selected);
+			this->connect(id, selected, l);
+			entries.swap(found);
+		};
+
+		if (level > this->maxLevel)
+		{
+			this->entry = id;
+			this->maxLevel = level;
+		};
+		return id;
+	};
+};
+
+#endif
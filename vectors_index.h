@@ -0,0 +1,606 @@
+#pragma once
+/*
+	# Vector Template Library - Nearest Neighbour Search
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	FlatIndex<N,T>, an exact (brute force) k nearest neighbour index over
+	Vector<N,T>, such as a collection of embeddings. Vectors are stored
+	contiguously with their norms precomputed, and queries are answered by
+	scanning the whole collection:
+
+		FlatIndex<128, float> index(VECTOR_METRIC_COSINE);
+		index.add(embeddings.data(), embeddings.size());
+		index.search(queries.data(), queries.size(), 10, results.data());
+
+	The scan works on a tile of queries against a block of stored vectors at a
+	time, like a blocked matrix product, so each stored vector is loaded once per
+	tile rather than once per query. The distance kernels are compiled for each
+	instruction set and dispatched at runtime like the batch operations (see
+	vectors_batch.h), the best k of each query are kept in a bounded heap, and
+	batches of queries are split across threads.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+#ifndef VECTOR_TEMPLATE_LIBRARY_INDEX__H
+#define VECTOR_TEMPLATE_LIBRARY_INDEX__H
+/* Deps */
+#include "vectors.h"
+#include "vectors_batch.h"
+#include <stddef.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <vector>
+
+/* Metrics */
+enum VectorMetric : int
+{
+	VECTOR_METRIC_L2 = 0,
+	VECTOR_METRIC_INNER_PRODUCT = 1,
+	VECTOR_METRIC_COSINE = 2
+};
+
+static constexpr uint64_t VECTOR_NO_NEIGHBOUR = std::numeric_limits<uint64_t>::max();
+
+template <typename T>
+struct VectorNeighbour
+{
+	/*
+		# Vector Neighbour (struct)
+		One search result: the id of a stored vector (the order it was added in) and
+		its distance to the query. For VECTOR_METRIC_L2 the distance is the squared
+		euclidean distance, smallest first; for the inner product and cosine metrics
+		it is the similarity, largest first. Unused result slots have the id
+		VECTOR_NO_NEIGHBOUR.
+	*/
+
+	/* Elements */
+	uint64_t id;
+	T distance;
+};
+
+template <typename T>
+struct VectorTopK
+{
+	/*
+		# Vector Top K (struct)
+		Keeps the k best candidates seen so far in a max-heap keyed on a cost where
+		smaller is better, so a candidate only has to beat the worst kept one (the
+		root) to get in. Ties are broken by id, so results don't depend on the order
+		candidates arrive in.
+	*/
+
+	/* Elements */
+	std::vector<VectorNeighbour<T>> heap;
+	size_t k;
+
+	/* Methods */
+
+	// Constructors & Destructor
+	VectorTopK() : k(0) {};
+
+	static inline bool worse(const VectorNeighbour<T>& A, const VectorNeighbour<T>& B)
+	{
+		return (A.distance < B.distance) || ((A.distance == B.distance) && (A.id < B.id));
+	};
+
+	// Modifiers
+	inline void reset(const size_t& k)
+	{
+		this->k = k;
+		this->heap.clear();
+		this->heap.reserve(k);
+	};
+	inline T threshold() const
+	{
+		/*
+			The cost a candidate has to beat to be kept.
+		*/
+
+		return (this->heap.size() < this->k) ? std::numeric_limits<T>::max() : this->heap.front().distance;
+	};
+	inline void push(const uint64_t& id, const T& cost)
+	{
+		const VectorNeighbour<T> candidate = { id, cost };
+		if (this->heap.size() < this->k)
+		{
+			this->heap.push_back(candidate);
+			std::push_heap(this->heap.begin(), this->heap.end(), worse);
+		}
+		else if (worse(candidate, this->heap.front()))
+		{
+			std::pop_heap(this->heap.begin(), this->heap.end(), worse);
+			this->heap.back() = candidate;
+			std::push_heap(this->heap.begin(), this->heap.end(), worse);
+		};
+	};
+
+	// Results
+	inline size_t take(VectorNeighbour<T>* out, const T& sign)
+	{
+		/*
+			Writes the kept candidates into out best first, multiplying each cost by sign
+			to turn it back into a distance or similarity, and pads the rest of the k
+			slots. Returns the number of candidates.
+		*/
+
+		std::sort_heap(this->heap.begin(), this->heap.end(), worse);
+		const size_t found = this->heap.size();
+		for (size_t i = 0; i < found; i++)
+		{
+			out[i].id = this->heap[i].id;
+			out[i].distance = (this->heap[i].distance * sign);
+		};
+		for (size_t i = found; i < this->k; i++)
+		{
+			out[i].id = VECTOR_NO_NEIGHBOUR;
+			out[i].distance = (std::numeric_limits<T>::max() * sign);
+		};
+		this->heap.clear();
+		return found;
+	};
+};
+
+/* Math Helpers */
+template <int ISA>
+struct VectorIndexMath
+{
+	/*
+		# Vector Index Math (struct)
+		The dot products of a tile of 4 queries against count stored vectors of n
+		elements each, written to out[q][j]. The generic form keeps an accumulator
+		per lane of a cache line; the AVX2 and AVX-512 forms hold the 4 running sums
+		in registers so each stored vector is loaded once for all 4 queries.
+	*/
+
+	static constexpr size_t tile = 4;
+
+	template <typename T, size_t Block>
+	static VECTORS_ALWAYS_INLINE void dots(const T* const* queries, const T* base, const size_t& count, const uint64_t& n, T (*out)[Block])
+	{
+		const uint64_t lanes = (64 / sizeof(T));
+		const uint64_t chunks = ((n / lanes) * lanes);
+		for (size_t j = 0; j < count; j++)
+		{
+			const T* x = base + (j * n);
+			for (size_t q = 0; q < tile; q++)
+			{
+				const T* y = queries[q];
+				T sums[64 / sizeof(T)] = {};
+				for (uint64_t c = 0; c < chunks; c += lanes)
+				{
+					for (uint64_t l = 0; l < lanes; l++)
+					{
+						sums[l] += (x[c + l] * y[c + l]);
+					};
+				};
+				T value = T();
+				for (uint64_t l = 0; l < lanes; l++)
+				{
+					value += sums[l];
+				};
+				for (uint64_t c = chunks; c < n; c++)
+				{
+					value += (x[c] * y[c]);
+				};
+				out[q][j] = value;
+			};
+		};
+	};
+};
+
+#if VECTORS_DISPATCH
+template <>
+struct VectorIndexMath<VECTORS_ISA_AVX2>
+{
+	static constexpr size_t tile = 4;
+
+	template <typename T, size_t Block>
+	static VECTORS_ALWAYS_INLINE void dots(const T* const* queries, const T* base, const size_t& count, const uint64_t& n, T (*out)[Block])
+	{
+		VectorIndexMath<VECTORS_ISA_GENERIC>::dots(queries, base, count, n, out);
+	};
+	template <size_t Block>
+	VECTORS_TARGET_AVX2 static inline void dots(const float* const* queries, const float* base, const size_t& count, const uint64_t& n, float (*out)[Block])
+	{
+		const uint64_t chunks = ((n / 8) * 8);
+		for (size_t j = 0; j < count; j++)
+		{
+			const float* x = base + (j * n);
+			__m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps(), s2 = _mm256_setzero_ps(), s3 = _mm256_setzero_ps();
+			for (uint64_t c = 0; c < chunks; c += 8)
+			{
+				const __m256 v = _mm256_loadu_ps(x + c);
+				s0 = _mm256_fmadd_ps(v, _mm256_loadu_ps(queries[0] + c), s0);
+				s1 = _mm256_fmadd_ps(v, _mm256_loadu_ps(queries[1] + c), s1);
+				s2 = _mm256_fmadd_ps(v, _mm256_loadu_ps(queries[2] + c), s2);
+				s3 = _mm256_fmadd_ps(v, _mm256_loadu_ps(queries[3] + c), s3);
+			};
+			const __m256 sums[4] = { s0, s1, s2, s3 };
+			for (size_t q = 0; q < tile; q++)
+			{
+				float value = vectorsHorizontalSum(_mm_add_ps(_mm256_castps256_ps128(sums[q]), _mm256_extractf128_ps(sums[q], 1)));
+				for (uint64_t c = chunks; c < n; c++)
+				{
+					value += (x[c] * queries[q][c]);
+				};
+				out[q][j] = value;
+			};
+		};
+	};
+	template <size_t Block>
+	VECTORS_TARGET_AVX2 static inline void dots(const double* const* queries, const double* base, const size_t& count, const uint64_t& n, double (*out)[Block])
+	{
+		const uint64_t chunks = ((n / 4) * 4);
+		for (size_t j = 0; j < count; j++)
+		{
+			const double* x = base + (j * n);
+			__m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd(), s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+			for (uint64_t c = 0; c < chunks; c += 4)
+			{
+				const __m256d v = _mm256_loadu_pd(x + c);
+				s0 = _mm256_fmadd_pd(v, _mm256_loadu_pd(queries[0] + c), s0);
+				s1 = _mm256_fmadd_pd(v, _mm256_loadu_pd(queries[1] + c), s1);
+				s2 = _mm256_fmadd_pd(v, _mm256_loadu_pd(queries[2] + c), s2);
+				s3 = _mm256_fmadd_pd(v, _mm256_loadu_pd(queries[3] + c), s3);
+			};
+			const __m256d sums[4] = { s0, s1, s2, s3 };
+			for (size_t q = 0; q < tile; q++)
+			{
+				const __m128d halves = _mm_add_pd(_mm256_castpd256_pd128(sums[q]), _mm256_extractf128_pd(sums[q], 1));
+				double value = _mm_cvtsd_f64(_mm_add_sd(halves, _mm_unpackhi_pd(halves, halves)));
+				for (uint64_t c = chunks; c < n; c++)
+				{
+					value += (x[c] * queries[q][c]);
+				};
+				out[q][j] = value;
+			};
+		};
+	};
+};
+
+template <>
+struct VectorIndexMath<VECTORS_ISA_AVX512>
+{
+	static constexpr size_t tile = 4;
+
+	template <typename T, size_t Block>
+	static VECTORS_ALWAYS_INLINE void dots(const T* const* queries, const T* base, const size_t& count, const uint64_t& n, T (*out)[Block])
+	{
+		VectorIndexMath<VECTORS_ISA_GENERIC>::dots(queries, base, count, n, out);
+	};
+	template <size_t Block>
+	VECTORS_TARGET_AVX512 static inline void dots(const float* const* queries, const float* base, const size_t& count, const uint64_t& n, float (*out)[Block])
+	{
+		// The remainder of each vector is read with a masked load, so any n works.
+		const uint64_t chunks = ((n / 16) * 16);
+		const __mmask16 tail = (__mmask16)((1u << (n - chunks)) - 1u);
+		for (size_t j = 0; j < count; j++)
+		{
+			const float* x = base + (j * n);
+			__m512 s0 = _mm512_setzero_ps(), s1 = _mm512_setzero_ps(), s2 = _mm512_setzero_ps(), s3 = _mm512_setzero_ps();
+			for (uint64_t c = 0; c < chunks; c += 16)
+			{
+				const __m512 v = _mm512_loadu_ps(x + c);
+				s0 = _mm512_fmadd_ps(v, _mm512_loadu_ps(queries[0] + c), s0);
+				s1 = _mm512_fmadd_ps(v, _mm512_loadu_ps(queries[1] + c), s1);
+				s2 = _mm512_fmadd_ps(v, _mm512_loadu_ps(queries[2] + c), s2);
+				s3 = _mm512_fmadd_ps(v, _mm512_loadu_ps(queries[3] + c), s3);
+			};
+			if (tail != 0)
+			{
+				const __m512 v = _mm512_maskz_loadu_ps(tail, x + chunks);
+				s0 = _mm512_fmadd_ps(v, _mm512_maskz_loadu_ps(tail, queries[0] + chunks), s0);
+				s1 = _mm512_fmadd_ps(v, _mm512_maskz_loadu_ps(tail, queries[1] + chunks), s1);
+				s2 = _mm512_fmadd_ps(v, _mm512_maskz_loadu_ps(tail, queries[2] + chunks), s2);
+				s3 = _mm512_fmadd_ps(v, _mm512_maskz_loadu_ps(tail, queries[3] + chunks), s3);
+			};
+			out[0][j] = vectorsReduceAdd(s0);
+			out[1][j] = vectorsReduceAdd(s1);
+			out[2][j] = vectorsReduceAdd(s2);
+			out[3][j] = vectorsReduceAdd(s3);
+		};
+	};
+	template <size_t Block>
+	VECTORS_TARGET_AVX512 static inline void dots(const double* const* queries, const double* base, const size_t& count, const uint64_t& n, double (*out)[Block])
+	{
+		const uint64_t chunks = ((n / 8) * 8);
+		const __mmask8 tail = (__mmask8)((1u << (n - chunks)) - 1u);
+		for (size_t j = 0; j < count; j++)
+		{
+			const double* x = base + (j * n);
+			__m512d s0 = _mm512_setzero_pd(), s1 = _mm512_setzero_pd(), s2 = _mm512_setzero_pd(), s3 = _mm512_setzero_pd();
+			for (uint64_t c = 0; c < chunks; c += 8)
+			{
+				const __m512d v = _mm512_loadu_pd(x + c);
+				s0 = _mm512_fmadd_pd(v, _mm512_loadu_pd(queries[0] + c), s0);
+				s1 = _mm512_fmadd_pd(v, _mm512_loadu_pd(queries[1] + c), s1);
+				s2 = _mm512_fmadd_pd(v, _mm512_loadu_pd(queries[2] + c), s2);
+				s3 = _mm512_fmadd_pd(v, _mm512_loadu_pd(queries[3] + c), s3);
+			};
+			if (tail != 0)
+			{
+				const __m512d v = _mm512_maskz_loadu_pd(tail, x + chunks);
+				s0 = _mm512_fmadd_pd(v, _mm512_maskz_loadu_pd(tail, queries[0] + chunks), s0);
+				s1 = _mm512_fmadd_pd(v, _mm512_maskz_loadu_pd(tail, queries[1] + chunks), s1);
+				s2 = _mm512_fmadd_pd(v, _mm512_maskz_loadu_pd(tail, queries[2] + chunks), s2);
+				s3 = _mm512_fmadd_pd(v, _mm512_maskz_loadu_pd(tail, queries[3] + chunks), s3);
+			};
+			out[0][j] = vectorsReduceAdd(s0);
+			out[1][j] = vectorsReduceAdd(s1);
+			out[2][j] = vectorsReduceAdd(s2);
+			out[3][j] = vectorsReduceAdd(s3);
+		};
+	};
+};
+#endif
+
+/* Kernels */
+template <uint64_t N, typename T>
+struct VectorIndexKernels
+{
+	/*
+		# Vector Index Kernels (struct)
+		The scan behind FlatIndex::search. Distances are computed for a tile of
+		queries against a block of stored vectors into a small buffer (see
+		VectorIndexMath), which is then fed to the heaps.
+	*/
+
+	typedef Vector<N, T> V;
+
+	static constexpr size_t tile = VectorIndexMath<VECTORS_ISA_GENERIC>::tile;
+	static constexpr size_t block = 256;
+
+	struct Scan
+	{
+		template <int ISA>
+		static VECTORS_ALWAYS_INLINE void run(const V* base, const T* norms, size_t size, VectorMetric metric, const V* queries, size_t count, size_t k, VectorNeighbour<T>* out)
+		{
+			/*
+				Searches count queries against the size stored vectors, writing k results
+				per query to out. norms holds the squared norm of each stored vector for L2,
+				or its reciprocal norm for cosine.
+			*/
+
+			/*
+				The loops run over blocks of stored vectors on the outside and tiles of
+				queries on the inside, so a block stays in cache while every query is
+				compared against it.
+			*/
+
+			std::vector<VectorTopK<T>> heaps(count);
+			std::vector<T> scales(count);
+			T distances[tile][block];
+			const T sign = (metric == VECTOR_METRIC_L2) ? (T)1 : (T)-1;
+
+			for (size_t q = 0; q < count; q++)
+			{
+				heaps[q].reset(k);
+				const T squared = queries[q].dot(queries[q]);
+				if (metric == VECTOR_METRIC_L2)
+				{
+					scales[q] = squared;
+				}
+				else if (metric == VECTOR_METRIC_COSINE)
+				{
+					scales[q] = (squared > T()) ? ((T)1 / (T)std::sqrt(squared)) : T();
+				}
+				else
+				{
+					scales[q] = (T)1;
+				};
+			};
+
+			for (size_t j = 0; j < size; j += block)
+			{
+				const size_t span = ((size - j) < block) ? (size - j) : block;
+				for (size_t i = 0; i < count; i += tile)
+				{
+					const size_t active = ((count - i) < tile) ? (count - i) : tile;
+					const T* tiled[tile];
+					for (size_t q = 0; q < tile; q++)
+					{
+						// Short tiles repeat the last query rather than branching in the kernel.
+						tiled[q] = queries[i + ((q < active) ? q : (active - 1))].value;
+					};
+					VectorIndexMath<ISA>::dots(tiled, base[j].value, span, N, distances);
+
+					for (size_t q = 0; q < active; q++)
+					{
+						// Every metric is turned into a cost where smaller is better.
+						T* d = distances[q];
+						const T scale = scales[i + q];
+						if (metric == VECTOR_METRIC_L2)
+						{
+							for (size_t c = 0; c < span; c++)
+							{
+								const T cost = (scale + norms[j + c]) - ((T)2 * d[c]);
+								d[c] = (cost > T()) ? cost : T();
+							};
+						}
+						else if (metric == VECTOR_METRIC_COSINE)
+						{
+							for (size_t c = 0; c < span; c++)
+							{
+								d[c] = -(d[c] * scale * norms[j + c]);
+							};
+						}
+						else
+						{
+							for (size_t c = 0; c < span; c++)
+							{
+								d[c] = -d[c];
+							};
+						};
+
+						VectorTopK<T>& heap = heaps[i + q];
+						T threshold = heap.threshold();
+						for (size_t c = 0; c < span; c++)
+						{
+							if (d[c] <= threshold)
+							{
+								heap.push((uint64_t)(j + c), d[c]);
+								threshold = heap.threshold();
+							};
+						};
+					};
+				};
+			};
+
+			for (size_t q = 0; q < count; q++)
+			{
+				heaps[q].take(out + (q * k), sign);
+			};
+		};
+	};
+};
+
+/* Index */
+template <uint64_t N, typename T>
+struct FlatIndex
+{
+	/*
+		# Flat Index (struct)
+		An exact nearest neighbour index over N dimensional vectors. Vectors are
+		identified by the order they were added in, starting at 0.
+	*/
+
+	typedef Vector<N, T> V;
+
+	/* Elements */
+	std::vector<V> vectors;
+	std::vector<T> norms;
+	VectorMetric metric;
+
+	/* Methods */
+
+	// Constructors & Destructor
+	explicit FlatIndex(const VectorMetric& metric = VECTOR_METRIC_L2) : metric(metric) {};
+
+	// Capacity Methods
+	inline size_t size() const
+	{
+		return this->vectors.size();
+	};
+	inline bool empty() const
+	{
+		return this->vectors.empty();
+	};
+	inline void reserve(const size_t& capacity)
+	{
+		this->vectors.reserve(capacity);
+		this->norms.reserve(capacity);
+	};
+	inline void clear()
+	{
+		this->vectors.clear();
+		this->norms.clear();
+	};
+
+	// Access Operators
+	inline const V& operator[](const uint64_t& id) const
+	{
+		return this->vectors[id];
+	};
+	inline const V& get(const uint64_t& id) const
+	{
+		return (*this)[id];
+	};
+	inline const V* data() const
+	{
+		return this->vectors.data();
+	};
+
+	// Modifiers
+	inline uint64_t add(const V& vector)
+	{
+		/*
+			Adds one vector, returning its id.
+		*/
+
+		this->add(&vector, 1);
+		return (uint64_t)(this->vectors.size() - 1);
+	};
+	inline void add(const V* vectors, const size_t& n)
+	{
+		/*
+			Adds n vectors, which get consecutive ids.
+		*/
+
+		const size_t first = this->vectors.size();
+		this->vectors.insert(this->vectors.end(), vectors, vectors + n);
+		this->norms.resize(first + n);
+
+		T* norms = this->norms.data() + first;
+		batchDot(vectors, vectors, norms, n);
+		if (this->metric == VECTOR_METRIC_COSINE)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				norms[i] = (norms[i] > T()) ? ((T)1 / (T)std::sqrt(norms[i])) : T();
+			};
+		};
+	};
+
+	// Search Methods
+	inline size_t search(const V& query, const size_t& k, VectorNeighbour<T>* out) const
+	{
+		/*
+			Finds the k nearest stored vectors to query, writing them to out best first.
+			Returns how many were found, which is less than k only when fewer than k
+			vectors are stored; the remaining slots are padded.
+		*/
+
+		this->search(&query, 1, k, out, 1);
+		return (k < this->size()) ? k : this->size();
+	};
+	inline void search(const V* queries, const size_t& count, const size_t& k, VectorNeighbour<T>* out, size_t threads = 0) const
+	{
+		/*
+			Answers count queries at once, writing k results for queries[i] to
+			out[i * k] onwards. The queries are split into contiguous ranges across
+			threads (by default one per hardware thread), each of which scans the whole
+			index.
+		*/
+
+		if ((count == 0) || (k == 0))
+		{
+			return;
+		};
+		if (threads == 0)
+		{
+			threads = std::thread::hardware_concurrency();
+		};
+
+		// Don't split finer than a tile of queries per thread.
+		const size_t tile = VectorIndexKernels<N, T>::tile;
+		const size_t tiles = ((count + tile - 1) / tile);
+		threads = std::max((size_t)1, std::min(threads, tiles));
+
+		const size_t share = (((tiles + threads - 1) / threads) * tile);
+		auto scan = [&](const size_t& first) {
+			const size_t n = std::min(share, (count - first));
+			vectorsDispatch<typename VectorIndexKernels<N, T>::Scan>(
+				this->vectors.data(), this->norms.data(), this->vectors.size(), this->metric,
+				queries + first, n, k, out + (first * k)
+			);
+		};
+
+		std::vector<std::thread> workers;
+		for (size_t first = share; first < count; first += share)
+		{
+			workers.emplace_back(scan, first);
+		};
+		scan(0);
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		};
+	};
+};
+
+#endif
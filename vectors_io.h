@@ -0,0 +1,495 @@
+#pragma once
+/*
+	# Vector Template Library - Binary Serialization
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	A compact binary format for arrays of vectors: the raw little-endian elements,
+	optionally preceded by a 32 byte header recording the element type, the
+	dimensions and the number of vectors. Since the vector types are plain arrays
+	of their elements, writing and reading on little-endian machines is a single
+	bulk copy, and VectorView reinterprets a buffer (e.g. a memory mapped file) as
+	an array of vectors without parsing or copying it.
+
+	## Format
+	| Offset | Size | Field                                        |
+	|--------|------|----------------------------------------------|
+	| 0      | 4    | Magic, "VTLB"                                |
+	| 4      | 2    | Format version (1)                           |
+	| 6      | 1    | Element type, see VectorElementCode          |
+	| 7      | 1    | Element size in bytes                        |
+	| 8      | 8    | Dimensions                                   |
+	| 16     | 8    | Number of vectors                            |
+	| 24     | 8    | Reserved, zero                               |
+
+	All fields are little-endian, followed by the elements of each vector in order.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+#ifndef VECTOR_TEMPLATE_LIBRARY_IO__H
+#define VECTOR_TEMPLATE_LIBRARY_IO__H
+/* Deps */
+#include "vectors.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+/* Macros */
+#ifndef VECTORS_READ_BLOCK_BYTES
+	#define VECTORS_READ_BLOCK_BYTES ((size_t)1 << 20)
+#endif
+
+/* Endianness */
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+	#define VECTORS_BIG_ENDIAN 1
+#else
+	#define VECTORS_BIG_ENDIAN 0
+#endif
+
+template <typename T>
+inline T vectorsByteSwap(const T& value)
+{
+	T swapped;
+	const unsigned char* source = (const unsigned char*)&value;
+	unsigned char* destination = (unsigned char*)&swapped;
+	for (size_t i = 0; i < sizeof(T); i++)
+	{
+		destination[i] = source[sizeof(T) - 1 - i];
+	};
+	return swapped;
+};
+template <typename T>
+inline T vectorsToLittleEndian(const T& value)
+{
+#if VECTORS_BIG_ENDIAN
+	return vectorsByteSwap(value);
+#else
+	return value;
+#endif
+};
+
+/* Element Types */
+enum VectorElementCode : uint8_t
+{
+	VECTOR_ELEMENT_UNKNOWN = 0,
+	VECTOR_ELEMENT_FLOAT32 = 1,
+	VECTOR_ELEMENT_FLOAT64 = 2,
+	VECTOR_ELEMENT_INT8 = 3,
+	VECTOR_ELEMENT_INT16 = 4,
+	VECTOR_ELEMENT_INT32 = 5,
+	VECTOR_ELEMENT_INT64 = 6,
+	VECTOR_ELEMENT_UINT8 = 7,
+	VECTOR_ELEMENT_UINT16 = 8,
+	VECTOR_ELEMENT_UINT32 = 9,
+	VECTOR_ELEMENT_UINT64 = 10,
+	VECTOR_ELEMENT_FLOAT16 = 11,
+	VECTOR_ELEMENT_BFLOAT16 = 12
+};
+
+template <typename T>
+struct VectorElementType
+{
+	static constexpr VectorElementCode code = VECTOR_ELEMENT_UNKNOWN;
+};
+template <> struct VectorElementType<float> { static constexpr VectorElementCode code = VECTOR_ELEMENT_FLOAT32; };
+template <> struct VectorElementType<double> { static constexpr VectorElementCode code = VECTOR_ELEMENT_FLOAT64; };
+template <> struct VectorElementType<int8_t> { static constexpr VectorElementCode code = VECTOR_ELEMENT_INT8; };
+template <> struct VectorElementType<int16_t> { static constexpr VectorElementCode code = VECTOR_ELEMENT_INT16; };
+template <> struct VectorElementType<int32_t> { static constexpr VectorElementCode code = VECTOR_ELEMENT_INT32; };
+template <> struct VectorElementType<int64_t> { static constexpr VectorElementCode code = VECTOR_ELEMENT_INT64; };
+template <> struct VectorElementType<uint8_t> { static constexpr VectorElementCode code = VECTOR_ELEMENT_UINT8; };
+template <> struct VectorElementType<uint16_t> { static constexpr VectorElementCode code = VECTOR_ELEMENT_UINT16; };
+template <> struct VectorElementType<uint32_t> { static constexpr VectorElementCode code = VECTOR_ELEMENT_UINT32; };
+template <> struct VectorElementType<uint64_t> { static constexpr VectorElementCode code = VECTOR_ELEMENT_UINT64; };
+
+/* Header */
+struct VectorFileHeader
+{
+	/*
+		# Vector File Header (struct)
+		The optional header in front of a block of serialized vectors. It is stored
+		in host byte order here and converted to little-endian on the way in or out.
+	*/
+
+	static constexpr uint32_t magic = 0x424C5456; // "VTLB" read as a little-endian uint32
+	static constexpr uint16_t currentVersion = 1;
+
+	/* Elements */
+	uint32_t signature;
+	uint16_t version;
+	uint8_t elementType;
+	uint8_t elementSize;
+	uint64_t dimensions;
+	uint64_t count;
+	uint64_t reserved;
+
+	/* Methods */
+
+	// Constructors & Destructor
+	VectorFileHeader() : signature(magic), version(currentVersion), elementType(0), elementSize(0), dimensions(0), count(0), reserved(0) {};
+
+	template <typename V>
+	static inline VectorFileHeader describe(const uint64_t& count)
+	{
+		typedef typename VectorTraits<V>::ElementType T;
+
+		VectorFileHeader header;
+		header.elementType = VectorElementType<T>::code;
+		header.elementSize = (uint8_t)sizeof(T);
+		header.dimensions = VectorTraits<V>::dimensions;
+		header.count = count;
+		return header;
+	};
+
+	// Validation
+	template <typename V>
+	inline bool matches() const
+	{
+		/*
+			Whether the header is well formed and describes vectors of type V.
+		*/
+
+		typedef typename VectorTraits<V>::ElementType T;
+		return (
+			(this->signature == magic) &&
+			(this->version == currentVersion) &&
+			(this->elementType == VectorElementType<T>::code) &&
+			(this->elementSize == sizeof(T)) &&
+			(this->dimensions == VectorTraits<V>::dimensions)
+		);
+	};
+
+	// Serialization
+	inline void encode(unsigned char* out) const
+	{
+		const uint32_t signature = vectorsToLittleEndian(this->signature);
+		const uint16_t version = vectorsToLittleEndian(this->version);
+		const uint64_t dimensions = vectorsToLittleEndian(this->dimensions);
+		const uint64_t count = vectorsToLittleEndian(this->count);
+		const uint64_t reserved = vectorsToLittleEndian(this->reserved);
+		memcpy(out + 0, &signature, 4);
+		memcpy(out + 4, &version, 2);
+		out[6] = this->elementType;
+		out[7] = this->elementSize;
+		memcpy(out + 8, &dimensions, 8);
+		memcpy(out + 16, &count, 8);
+		memcpy(out + 24, &reserved, 8);
+	};
+	static inline VectorFileHeader decode(const unsigned char* in)
+	{
+		VectorFileHeader header;
+		memcpy(&header.signature, in + 0, 4);
+		memcpy(&header.version, in + 4, 2);
+		header.elementType = in[6];
+		header.elementSize = in[7];
+		memcpy(&header.dimensions, in + 8, 8);
+		memcpy(&header.count, in + 16, 8);
+		memcpy(&header.reserved, in + 24, 8);
+		header.signature = vectorsToLittleEndian(header.signature);
+		header.version = vectorsToLittleEndian(header.version);
+		header.dimensions = vectorsToLittleEndian(header.dimensions);
+		header.count = vectorsToLittleEndian(header.count);
+		header.reserved = vectorsToLittleEndian(header.reserved);
+		return header;
+	};
+};
+
+static constexpr size_t VECTOR_FILE_HEADER_SIZE = 32;
+
+/* Values */
+template <typename T>
+inline bool writeValues(std::ostream& stream, const T* values, const size_t& count)
+{
+	/*
+		Writes count plain values (elements, ids, ...) little-endian, in one bulk
+		write on little-endian hosts. Returns whether the stream is still good.
+	*/
+
+	static_assert(std::is_arithmetic<T>::value || (VectorElementType<T>::code != VECTOR_ELEMENT_UNKNOWN), "Only arithmetic values and known element types can be written.");
+
+#if VECTORS_BIG_ENDIAN
+	for (size_t i = 0; i < count; i++)
+	{
+		const T value = vectorsByteSwap(values[i]);
+		stream.write((const char*)&value, sizeof(T));
+	};
+#else
+	stream.write((const char*)values, (std::streamsize)(count * sizeof(T)));
+#endif
+	return stream.good();
+};
+template <typename T>
+inline bool readValues(std::istream& stream, T* values, const size_t& count)
+{
+	/*
+		Reads count values written by writeValues(). Returns false if the stream ran
+		out first.
+	*/
+
+	static_assert(std::is_arithmetic<T>::value || (VectorElementType<T>::code != VECTOR_ELEMENT_UNKNOWN), "Only arithmetic values and known element types can be read.");
+
+	stream.read((char*)values, (std::streamsize)(count * sizeof(T)));
+	if ((size_t)stream.gcount() != (count * sizeof(T)))
+	{
+		return false;
+	};
+#if VECTORS_BIG_ENDIAN
+	for (size_t i = 0; i < count; i++)
+	{
+		values[i] = vectorsByteSwap(values[i]);
+	};
+#endif
+	return true;
+};
+
+template <typename T>
+inline bool readValues(std::istream& stream, std::vector<T>& values, const uint64_t& count)
+{
+	/*
+		Reads count values into values, replacing its contents. It grows values a
+		block at a time as they arrive, so a corrupt count can't allocate more than
+		the stream holds. Returns false, leaving values empty, if the stream ran out
+		first.
+	*/
+
+	const size_t block = std::max((size_t)1, (VECTORS_READ_BLOCK_BYTES / sizeof(T)));
+	values.clear();
+	for (uint64_t read = 0; read < count;)
+	{
+		const size_t n = (size_t)std::min((uint64_t)block, (count - read));
+		values.resize(values.size() + n);
+		if (!readValues(stream, (values.data() + read), n))
+		{
+			values.clear();
+			return false;
+		};
+		read += n;
+	};
+	return true;
+};
+inline uint64_t vectorsStreamRemaining(std::istream& stream)
+{
+	/*
+		The number of bytes left in the stream, or UINT64_MAX if it can't be told,
+		e.g. for a pipe. Leaves the stream where it was.
+	*/
+
+	const std::streampos position = stream.tellg();
+	if (position == std::streampos(-1))
+	{
+		return UINT64_MAX;
+	};
+	stream.seekg(0, std::ios::end);
+	const std::streampos end = stream.tellg();
+	stream.clear(stream.rdstate() & ~std::ios::failbit);
+	stream.seekg(position);
+	if ((end == std::streampos(-1)) || (end < position))
+	{
+		return UINT64_MAX;
+	};
+	return (uint64_t)(end - position);
+};
+
+/* Writing */
+template <typename V>
+inline bool writeVectors(std::ostream& stream, const V* vectors, const size_t& count, const bool& header = true)
+{
+	/*
+		Writes count vectors to the stream, preceded by a header unless header is
+		false. Returns whether the stream is still good afterwards.
+	*/
+
+	static_assert(std::is_trivially_copyable<V>::value, "Only trivially copyable vectors can be serialized.");
+	typedef typename VectorTraits<V>::ElementType T;
+
+	if (header)
+	{
+		unsigned char encoded[VECTOR_FILE_HEADER_SIZE];
+		VectorFileHeader::describe<V>(count).encode(encoded);
+		stream.write((const char*)encoded, VECTOR_FILE_HEADER_SIZE);
+	};
+
+	// Every vector type is a plain array of its elements (see vectors.h).
+	return writeValues(stream, (const T*)vectors, (count * VectorTraits<V>::dimensions));
+};
+template <typename V>
+inline bool writeVectors(std::ostream& stream, const std::vector<V>& vectors, const bool& header = true)
+{
+	return writeVectors(stream, vectors.data(), vectors.size(), header);
+};
+
+/* Reading */
+template <typename V>
+inline bool readVectors(std::istream& stream, V* vectors, const size_t& count)
+{
+	/*
+		Reads count headerless vectors from the stream. Returns false if the stream
+		ran out first.
+	*/
+
+	static_assert(std::is_trivially_copyable<V>::value, "Only trivially copyable vectors can be serialized.");
+	typedef typename VectorTraits<V>::ElementType T;
+
+	return readValues(stream, (T*)vectors, (count * VectorTraits<V>::dimensions));
+};
+template <typename V>
+inline bool readVectors(std::istream& stream, std::vector<V>& vectors, const uint64_t& count)
+{
+	/*
+		Reads count headerless vectors, replacing the contents of vectors, a block at
+		a time as for readValues(). Returns false, leaving vectors empty, if the
+		stream ran out first.
+	*/
+
+	const size_t block = std::max((size_t)1, (VECTORS_READ_BLOCK_BYTES / sizeof(V)));
+	vectors.clear();
+	for (uint64_t read = 0; read < count;)
+	{
+		const size_t n = (size_t)std::min((uint64_t)block, (count - read));
+		vectors.resize(vectors.size() + n);
+		if (!readVectors(stream, (vectors.data() + read), n))
+		{
+			vectors.clear();
+			return false;
+		};
+		read += n;
+	};
+	return true;
+};
+inline bool readVectorHeader(std::istream& stream, VectorFileHeader& header)
+{
+	unsigned char encoded[VECTOR_FILE_HEADER_SIZE];
+	stream.read((char*)encoded, VECTOR_FILE_HEADER_SIZE);
+	if (stream.gcount() != (std::streamsize)VECTOR_FILE_HEADER_SIZE)
+	{
+		return false;
+	};
+	header = VectorFileHeader::decode(encoded);
+	return true;
+};
+template <typename V>
+inline bool readVectors(std::istream& stream, std::vector<V>& vectors)
+{
+	/*
+		Reads a header followed by the vectors it describes, replacing the contents
+		of vectors. Returns false, leaving vectors empty, if the header is missing,
+		is for a different vector type, or counts more vectors than the stream
+		holds.
+	*/
+
+	VectorFileHeader header;
+	vectors.clear();
+	if (!readVectorHeader(stream, header) || !header.matches<V>() || (header.count > (vectorsStreamRemaining(stream) / sizeof(V))))
+	{
+		return false;
+	};
+	return readVectors(stream, vectors, header.count);
+};
+
+/* Views */
+template <typename V>
+struct VectorView
+{
+	/*
+		# Vector View (struct)
+		A read-only, zero-copy view of serialized vectors in memory, e.g. a memory
+		mapped file. The buffer is reinterpreted in place, so it must outlive the view
+		and be aligned for V. A view is only valid on little-endian hosts, where the
+		serialized and in-memory layouts are the same.
+	*/
+
+	static_assert(std::is_trivially_copyable<V>::value, "Only trivially copyable vectors can be viewed.");
+
+	/* Elements */
+	const V* vectors;
+	size_t count;
+
+	/* Methods */
+
+	// Constructors & Destructor
+	VectorView() : vectors(nullptr), count(0) {};
+	VectorView(const void* buffer, const size_t& size, const bool& header = true) : VectorView()
+	{
+		/*
+			Views size bytes at buffer. With header set the buffer must start with a
+			header for vectors of type V, and only the vectors it counts are viewed;
+			otherwise the whole buffer is taken as vectors. On any mismatch the view is
+			left empty and valid() returns false.
+		*/
+
+		if ((buffer == nullptr) || VECTORS_BIG_ENDIAN)
+		{
+			return;
+		};
+
+		const unsigned char* bytes = (const unsigned char*)buffer;
+		size_t available = size;
+		size_t count = (size / sizeof(V));
+		if (header)
+		{
+			if (size < VECTOR_FILE_HEADER_SIZE)
+			{
+				return;
+			};
+			const VectorFileHeader decoded = VectorFileHeader::decode(bytes);
+			bytes += VECTOR_FILE_HEADER_SIZE;
+			available -= VECTOR_FILE_HEADER_SIZE;
+			if (!decoded.matches<V>() || (decoded.count > (available / sizeof(V))))
+			{
+				return;
+			};
+			count = (size_t)decoded.count;
+		};
+
+		if ((((uintptr_t)bytes) % alignof(V)) != 0)
+		{
+			return;
+		};
+		this->vectors = (const V*)bytes;
+		this->count = count;
+	};
+
+	// Capacity Methods
+	inline bool valid() const
+	{
+		return (this->vectors != nullptr);
+	};
+	inline size_t size() const
+	{
+		return this->count;
+	};
+	inline bool empty() const
+	{
+		return (this->count == 0);
+	};
+
+	// Access Operators
+	inline const V* data() const
+	{
+		return this->vectors;
+	};
+	inline const V& operator[](const size_t& i) const
+	{
+		return this->vectors[i];
+	};
+	inline const V& get(const size_t& i) const
+	{
+		return (*this)[i];
+	};
+	inline const V* begin() const
+	{
+		return this->vectors;
+	};
+	inline const V* end() const
+	{
+		return (this->vectors + this->count);
+	};
+};
+
+#endif
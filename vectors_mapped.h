@@ -0,0 +1,462 @@
+#pragma once
+/*
+	# Vector Template Library - Memory Mapped Storage
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	MappedVectorStore<V>, an append-only file of vectors which is memory mapped
+	rather than read, so opening even a very large file is instant and pages of
+	it are only read from disk when they are first touched:
+
+		MappedVectorStore<Vector<128, float>> store;
+		store.open("embeddings.vtlb");
+		store.advise(VECTORS_ACCESS_SEQUENTIAL);
+		for (const Vector<128, float>& v : store) { ... }
+
+	The file is in the format of vectors_io.h (a header then the raw vectors),
+	so it can also be read with readVectors() or viewed with VectorView, and
+	records are the in-memory vector types themselves. A store opened for
+	writing appends through the mapping, growing the file in large steps, and
+	makes the new vectors durable in batches (see setSyncInterval() and
+	flush()). The header's count is only updated once the vectors it covers are
+	on disk, so after a crash the file holds the vectors of the last flush.
+
+	Memory mapping is only available on POSIX systems, and like VectorView only
+	on little-endian hosts; elsewhere open() and create() return false.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+#ifndef VECTOR_TEMPLATE_LIBRARY_MAPPED__H
+#define VECTOR_TEMPLATE_LIBRARY_MAPPED__H
+/* Deps */
+#include "vectors.h"
+#include "vectors_io.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <type_traits>
+
+#if (defined(__unix__) || defined(__APPLE__)) && !VECTORS_BIG_ENDIAN
+	#define VECTORS_MAPPED 1
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#else
+	#define VECTORS_MAPPED 0
+#endif
+
+/* Access Hints */
+enum VectorsAccessHint : int
+{
+	VECTORS_ACCESS_NORMAL = 0, // Default read ahead.
+	VECTORS_ACCESS_SEQUENTIAL = 1, // Read ahead aggressively and drop pages once passed.
+	VECTORS_ACCESS_RANDOM = 2, // Don't read ahead.
+	VECTORS_ACCESS_WILLNEED = 3, // Start reading the range in now.
+	VECTORS_ACCESS_DONTNEED = 4 // The range won't be needed soon, its pages can be dropped.
+};
+
+/* Mapped Vector Store */
+template <typename V>
+struct MappedVectorStore
+{
+	/*
+		# Mapped Vector Store (struct)
+		An append-only array of vectors in a memory mapped file. Vectors are read in
+		place, as const V&, without being copied. As with std::vector, appending may
+		move the mapping when the file has to grow, which invalidates pointers and
+		references into the store.
+	*/
+
+	static_assert(std::is_trivially_copyable<V>::value, "Only trivially copyable vectors can be mapped.");
+	static_assert(alignof(V) <= VECTOR_FILE_HEADER_SIZE, "The vectors must be aligned by the file header.");
+
+	static constexpr size_t growth = (1 << 20); // The least the file grows by, in bytes.
+
+	/* Methods */
+
+	// Constructors & Destructor
+	MappedVectorStore() {};
+	MappedVectorStore(const MappedVectorStore&) = delete;
+	MappedVectorStore& operator=(const MappedVectorStore&) = delete;
+	MappedVectorStore(MappedVectorStore&& source)
+	{
+		this->swap(source);
+	};
+	MappedVectorStore& operator=(MappedVectorStore&& source)
+	{
+		if (this != &source)
+		{
+			this->close();
+			this->swap(source);
+		};
+		return *this;
+	};
+	~MappedVectorStore()
+	{
+		this->close();
+	};
+
+	// File Methods
+	inline bool create(const std::string& path)
+	{
+		/*
+			Creates (or truncates) the file at path as an empty store, open for
+			appending. Returns false if it can't be created.
+		*/
+
+		this->close();
+#if VECTORS_MAPPED
+		this->file = ::open(path.c_str(), (O_RDWR | O_CREAT | O_TRUNC), 0644);
+		if (this->file < 0)
+		{
+			return false;
+		};
+		this->writable = true;
+
+		unsigned char header[VECTOR_FILE_HEADER_SIZE];
+		VectorFileHeader::describe<V>(0).encode(header);
+		if ((::pwrite(this->file, header, VECTOR_FILE_HEADER_SIZE, 0) != (ssize_t)VECTOR_FILE_HEADER_SIZE) || !this->map(this->capacityFor(0)) || (::fsync(this->file) != 0))
+		{
+			this->close();
+			return false;
+		};
+		return true;
+#else
+		(void)path;
+		return false;
+#endif
+	};
+	inline bool open(const std::string& path, const bool& writable = false)
+	{
+		/*
+			Opens an existing store, read-only or for appending. Returns false if the
+			file can't be opened or isn't a file of vectors of type V.
+		*/
+
+		this->close();
+#if VECTORS_MAPPED
+		this->file = ::open(path.c_str(), (writable ? O_RDWR : O_RDONLY));
+		if (this->file < 0)
+		{
+			return false;
+		};
+		this->writable = writable;
+
+		struct stat status;
+		unsigned char encoded[VECTOR_FILE_HEADER_SIZE];
+		if ((::fstat(this->file, &status) != 0) || (::pread(this->file, encoded, VECTOR_FILE_HEADER_SIZE, 0) != (ssize_t)VECTOR_FILE_HEADER_SIZE))
+		{
+			this->close();
+			return false;
+		};
+		const VectorFileHeader header = VectorFileHeader::decode(encoded);
+		const size_t available = (((size_t)status.st_size - VECTOR_FILE_HEADER_SIZE) / sizeof(V));
+		if (!header.matches<V>() || (header.count > available))
+		{
+			this->close();
+			return false;
+		};
+
+		this->count = (size_t)header.count;
+		this->synced = this->count;
+		if (!this->map(writable ? std::max(available, this->capacityFor(this->count)) : available))
+		{
+			this->close();
+			return false;
+		};
+		return true;
+#else
+		(void)path;
+		(void)writable;
+		return false;
+#endif
+	};
+	inline void close()
+	{
+		/*
+			Flushes any appended vectors, trims the file to them and closes it.
+		*/
+
+#if VECTORS_MAPPED
+		if (this->writable && (this->base != nullptr))
+		{
+			this->flush();
+			this->unmap();
+			if (::ftruncate(this->file, (off_t)this->bytesFor(this->count)) == 0)
+			{
+				::fsync(this->file);
+			};
+		};
+		this->unmap();
+		if (this->file >= 0)
+		{
+			::close(this->file);
+		};
+#endif
+		this->file = -1;
+		this->writable = false;
+		this->count = 0;
+		this->synced = 0;
+	};
+
+	// Capacity Methods
+	inline bool valid() const
+	{
+		return (this->base != nullptr);
+	};
+	inline bool isWritable() const
+	{
+		return this->writable;
+	};
+	inline size_t size() const
+	{
+		return this->count;
+	};
+	inline bool empty() const
+	{
+		return (this->count == 0);
+	};
+	inline size_t capacity() const
+	{
+		return this->slots;
+	};
+
+	// Access Operators
+	inline const V* data() const
+	{
+		return (this->base != nullptr) ? (const V*)(this->base + VECTOR_FILE_HEADER_SIZE) : nullptr;
+	};
+	inline const V& operator[](const size_t& i) const
+	{
+		return this->data()[i];
+	};
+	inline const V& get(const size_t& i) const
+	{
+		return (*this)[i];
+	};
+	inline const V* begin() const
+	{
+		return this->data();
+	};
+	inline const V* end() const
+	{
+		return (this->data() + this->count);
+	};
+	inline VectorView<V> view() const
+	{
+		return VectorView<V>(this->data(), (this->count * sizeof(V)), false);
+	};
+
+	// Writing
+	inline bool append(const V* A, const size_t& n)
+	{
+		/*
+			Appends A[0] .. A[n - 1], which must not point into the store. Returns false,
+			appending nothing, if the store isn't writable or the file can't grow.
+		*/
+
+		if (!this->writable || (this->base == nullptr))
+		{
+			return false;
+		};
+		if (((this->count + n) > this->slots) && !this->map(this->capacityFor(this->count + n)))
+		{
+			return false;
+		};
+
+		memcpy((void*)(this->data() + this->count), (const void*)A, (n * sizeof(V)));
+		this->count += n;
+		if ((this->interval > 0) && ((this->count - this->synced) >= this->interval))
+		{
+			return this->flush();
+		};
+		return true;
+	};
+	inline bool append(const V& B)
+	{
+		return this->append(&B, 1);
+	};
+	inline void setSyncInterval(const size_t& n)
+	{
+		/*
+			Flushes automatically once n vectors have been appended since the last
+			flush, or only on flush() and close() if n is 0 (the default).
+		*/
+
+		this->interval = n;
+	};
+	inline bool flush()
+	{
+		/*
+			Writes the vectors appended since the last flush to disk, then the header's
+			count, so the file always counts only vectors which are on disk.
+		*/
+
+		if (!this->writable || (this->base == nullptr))
+		{
+			return false;
+		};
+		if (this->synced == this->count)
+		{
+			return true;
+		};
+#if VECTORS_MAPPED
+		if (!this->sync(this->bytesFor(this->synced), this->bytesFor(this->count)))
+		{
+			return false;
+		};
+		VectorFileHeader header = VectorFileHeader::decode(this->base);
+		header.count = this->count;
+		header.encode(this->base);
+		if (!this->sync(0, VECTOR_FILE_HEADER_SIZE))
+		{
+			return false;
+		};
+#endif
+		this->synced = this->count;
+		return true;
+	};
+
+	// Access Hints
+	inline bool advise(const VectorsAccessHint& hint)
+	{
+		return this->advise(hint, 0, this->count);
+	};
+	inline bool advise(const VectorsAccessHint& hint, const size_t& first, const size_t& n)
+	{
+		/*
+			Tells the kernel how vectors first .. first + n - 1 are about to be read,
+			see VectorsAccessHint. It's only a hint; returns false if it was refused.
+		*/
+
+		if ((this->base == nullptr) || (first >= this->count))
+		{
+			return false;
+		};
+#if VECTORS_MAPPED
+		static const int advice[] = { MADV_NORMAL, MADV_SEQUENTIAL, MADV_RANDOM, MADV_WILLNEED, MADV_DONTNEED };
+		const size_t page = (size_t)::sysconf(_SC_PAGESIZE);
+		const size_t start = ((this->bytesFor(first) / page) * page);
+		const size_t stop = this->bytesFor(std::min(this->count, (first + n)));
+		return (::madvise((void*)(this->base + start), (stop - start), advice[(int)hint]) == 0);
+#else
+		return false;
+#endif
+	};
+
+	// Utility
+	inline void swap(MappedVectorStore& B)
+	{
+		std::swap(this->file, B.file);
+		std::swap(this->writable, B.writable);
+		std::swap(this->base, B.base);
+		std::swap(this->length, B.length);
+		std::swap(this->count, B.count);
+		std::swap(this->synced, B.synced);
+		std::swap(this->slots, B.slots);
+		std::swap(this->interval, B.interval);
+	};
+
+private:
+	/* Elements */
+	int file = -1;
+	bool writable = false;
+	unsigned char* base = nullptr;
+	size_t length = 0; // Bytes mapped.
+	size_t count = 0; // Vectors stored.
+	size_t synced = 0; // Vectors on disk and counted by the header.
+	size_t slots = 0; // Vectors the mapping has room for.
+	size_t interval = 0;
+
+	/* Methods */
+	static inline size_t bytesFor(const size_t& n)
+	{
+		return (VECTOR_FILE_HEADER_SIZE + (n * sizeof(V)));
+	};
+	inline size_t capacityFor(const size_t& n) const
+	{
+		/*
+			The room to grow to for n vectors: at least double the current capacity,
+			and at least growth bytes more.
+		*/
+
+		const size_t step = std::max((size_t)1, (growth / sizeof(V)));
+		return std::max(n, std::max((2 * this->slots), (this->slots + step)));
+	};
+	inline bool map(const size_t& n)
+	{
+		/*
+			Maps the file with room for n vectors, growing the file first if it is
+			writable.
+		*/
+
+#if VECTORS_MAPPED
+		const size_t bytes = bytesFor(n);
+		if (this->writable && (::ftruncate(this->file, (off_t)bytes) != 0))
+		{
+			return false;
+		};
+
+		void* mapped = MAP_FAILED;
+		const int protection = (this->writable ? (PROT_READ | PROT_WRITE) : PROT_READ);
+	#if defined(__linux__)
+		if (this->base != nullptr)
+		{
+			mapped = ::mremap(this->base, this->length, bytes, MREMAP_MAYMOVE);
+		}
+		else
+		{
+			mapped = ::mmap(nullptr, bytes, protection, MAP_SHARED, this->file, 0);
+		};
+	#else
+		mapped = ::mmap(nullptr, bytes, protection, MAP_SHARED, this->file, 0);
+		if (mapped != MAP_FAILED)
+		{
+			this->unmap();
+		};
+	#endif
+		if (mapped == MAP_FAILED)
+		{
+			return false;
+		};
+		this->base = (unsigned char*)mapped;
+		this->length = bytes;
+		this->slots = n;
+		return true;
+#else
+		(void)n;
+		return false;
+#endif
+	};
+	inline void unmap()
+	{
+#if VECTORS_MAPPED
+		if (this->base != nullptr)
+		{
+			::munmap(this->base, this->length);
+		};
+#endif
+		this->base = nullptr;
+		this->length = 0;
+		this->slots = 0;
+	};
+	inline bool sync(const size_t& start, const size_t& stop)
+	{
+#if VECTORS_MAPPED
+		const size_t page = (size_t)::sysconf(_SC_PAGESIZE);
+		const size_t first = ((start / page) * page);
+		return (::msync((void*)(this->base + first), (stop - first), MS_SYNC) == 0);
+#else
+		(void)start;
+		(void)stop;
+		return false;
+#endif
+	};
+};
+
+#endif
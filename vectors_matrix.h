@@ -0,0 +1,1105 @@
+#pragma once
+/*
+	# Vector Template Library - Matrices
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	3x3 and 4x4 matrices which work with Vector3D and Vector4D, and batched
+	transforms of arrays of them:
+
+		Matrix4<float> model = Matrix4<float>::translation(position) * Matrix4<float>::rotation(axis, angle);
+		transformPoints(model, vertices.data(), transformed.data(), vertices.size());
+
+	Matrices are row major and multiply column vectors, so M * v transforms v
+	and A * B applies B first. A Matrix4 used as an affine transform keeps its
+	translation in the last column.
+
+	transformPoints() and transformDirections() take points packed as x, y, z
+	triples. For float they're run with AVX2 or AVX-512 kernels picked at
+	runtime, which read three registers of packed points at a time and permute
+	the x, y and z each output element needs into place, so the points are
+	transposed and transformed without being unpacked.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+#ifndef VECTOR_TEMPLATE_LIBRARY_MATRIX__H
+#define VECTOR_TEMPLATE_LIBRARY_MATRIX__H
+/* Deps */
+#include "vectors.h"
+#include "vectors_batch.h"
+#include <stddef.h>
+#include <cmath>
+
+/* Matrices */
+template <typename T>
+struct Matrix3
+{
+	/*
+		# Matrix 3 (struct)
+		A 3x3 matrix, for the linear part of a transform (rotation, scale and
+		shear). A default constructed matrix is all zero.
+	*/
+
+	/* Elements */
+	T value[3][3]; // value[row][column]
+
+	/* Methods */
+
+	// Constructors & Destructor
+	constexpr Matrix3() : value{} {};
+	constexpr Matrix3(
+		const T& m00, const T& m01, const T& m02,
+		const T& m10, const T& m11, const T& m12,
+		const T& m20, const T& m21, const T& m22
+	) : value{ { m00, m01, m02 }, { m10, m11, m12 }, { m20, m21, m22 } } {};
+
+	// Factories
+	static constexpr Matrix3<T> identity()
+	{
+		return Matrix3<T>((T)1, T(), T(), T(), (T)1, T(), T(), T(), (T)1);
+	};
+	static inline Matrix3<T> fromRows(const Vector3D<T>& A, const Vector3D<T>& B, const Vector3D<T>& C)
+	{
+		return Matrix3<T>(
+			A.value[0], A.value[1], A.value[2],
+			B.value[0], B.value[1], B.value[2],
+			C.value[0], C.value[1], C.value[2]
+		);
+	};
+	static inline Matrix3<T> fromColumns(const Vector3D<T>& A, const Vector3D<T>& B, const Vector3D<T>& C)
+	{
+		return Matrix3<T>::fromRows(A, B, C).transpose();
+	};
+	static inline Matrix3<T> scaling(const Vector3D<T>& scale)
+	{
+		return Matrix3<T>(scale.value[0], T(), T(), T(), scale.value[1], T(), T(), T(), scale.value[2]);
+	};
+	static inline Matrix3<T> rotation(const Vector3D<T>& axis, const T& angle)
+	{
+		/*
+			A rotation by angle (in radians, counter-clockwise looking down the axis)
+			around axis, which must be of unit length.
+		*/
+
+		const T c = (T)std::cos(angle);
+		const T s = (T)std::sin(angle);
+		const T t = ((T)1 - c);
+		const T x = axis.value[0], y = axis.value[1], z = axis.value[2];
+		return Matrix3<T>(
+			((t * x * x) + c), ((t * x * y) - (s * z)), ((t * x * z) + (s * y)),
+			((t * x * y) + (s * z)), ((t * y * y) + c), ((t * y * z) - (s * x)),
+			((t * x * z) - (s * y)), ((t * y * z) + (s * x)), ((t * z * z) + c)
+		);
+	};
+
+	// Access Operators
+	constexpr T& operator()(const uint64_t& row, const uint64_t& column)
+	{
+		return this->value[row][column];
+	};
+	constexpr const T& operator()(const uint64_t& row, const uint64_t& column) const
+	{
+		return this->value[row][column];
+	};
+	inline Vector3D<T> row(const uint64_t& i) const
+	{
+		return Vector3D<T>(this->value[i][0], this->value[i][1], this->value[i][2]);
+	};
+	inline Vector3D<T> column(const uint64_t& i) const
+	{
+		return Vector3D<T>(this->value[0][i], this->value[1][i], this->value[2][i]);
+	};
+
+	// Matrix Operators
+	inline Matrix3<T> transpose() const
+	{
+		Matrix3<T> C;
+		for (uint64_t r = 0; r < 3; r++)
+		{
+			for (uint64_t c = 0; c < 3; c++)
+			{
+				C.value[c][r] = this->value[r][c];
+			};
+		};
+		return C;
+	};
+	inline T determinant() const
+	{
+		const T (&m)[3][3] = this->value;
+		return (
+			(m[0][0] * ((m[1][1] * m[2][2]) - (m[1][2] * m[2][1]))) -
+			(m[0][1] * ((m[1][0] * m[2][2]) - (m[1][2] * m[2][0]))) +
+			(m[0][2] * ((m[1][0] * m[2][1]) - (m[1][1] * m[2][0])))
+		);
+	};
+	inline bool inverse(Matrix3<T>& out) const
+	{
+		/*
+			Writes the inverse into out. Returns false, leaving out untouched, if the
+			matrix is singular (or not finite).
+		*/
+
+		const T (&m)[3][3] = this->value;
+		const T det = this->determinant();
+		if (!(det != T()) || !std::isfinite(det))
+		{
+			return false;
+		};
+		const T scale = ((T)1 / det);
+		out = Matrix3<T>(
+			(((m[1][1] * m[2][2]) - (m[1][2] * m[2][1])) * scale),
+			(((m[0][2] * m[2][1]) - (m[0][1] * m[2][2])) * scale),
+			(((m[0][1] * m[1][2]) - (m[0][2] * m[1][1])) * scale),
+			(((m[1][2] * m[2][0]) - (m[1][0] * m[2][2])) * scale),
+			(((m[0][0] * m[2][2]) - (m[0][2] * m[2][0])) * scale),
+			(((m[0][2] * m[1][0]) - (m[0][0] * m[1][2])) * scale),
+			(((m[1][0] * m[2][1]) - (m[1][1] * m[2][0])) * scale),
+			(((m[0][1] * m[2][0]) - (m[0][0] * m[2][1])) * scale),
+			(((m[0][0] * m[1][1]) - (m[0][1] * m[1][0])) * scale)
+		);
+		return true;
+	};
+
+	// Comparison Operators
+	inline bool operator==(const Matrix3<T>& B) const
+	{
+		for (uint64_t r = 0; r < 3; r++)
+		{
+			for (uint64_t c = 0; c < 3; c++)
+			{
+				if (this->value[r][c] != B.value[r][c])
+				{
+					return false;
+				};
+			};
+		};
+		return true;
+	};
+	inline bool operator!=(const Matrix3<T>& B) const
+	{
+		return !((*this) == B);
+	};
+
+	// Binary Operators
+	inline Matrix3<T> operator+(const Matrix3<T>& B) const
+	{
+		Matrix3<T> C;
+		for (uint64_t r = 0; r < 3; r++)
+		{
+			for (uint64_t c = 0; c < 3; c++)
+			{
+				C.value[r][c] = this->value[r][c] + B.value[r][c];
+			};
+		};
+		return C;
+	};
+	inline Matrix3<T> operator-(const Matrix3<T>& B) const
+	{
+		Matrix3<T> C;
+		for (uint64_t r = 0; r < 3; r++)
+		{
+			for (uint64_t c = 0; c < 3; c++)
+			{
+				C.value[r][c] = this->value[r][c] - B.value[r][c];
+			};
+		};
+		return C;
+	};
+	inline Matrix3<T> operator*(const T& B) const
+	{
+		Matrix3<T> C;
+		for (uint64_t r = 0; r < 3; r++)
+		{
+			for (uint64_t c = 0; c < 3; c++)
+			{
+				C.value[r][c] = this->value[r][c] * B;
+			};
+		};
+		return C;
+	};
+	inline Matrix3<T> operator*(const Matrix3<T>& B) const
+	{
+		Matrix3<T> C;
+		for (uint64_t r = 0; r < 3; r++)
+		{
+			for (uint64_t c = 0; c < 3; c++)
+			{
+				C.value[r][c] = (this->value[r][0] * B.value[0][c]) + (this->value[r][1] * B.value[1][c]) + (this->value[r][2] * B.value[2][c]);
+			};
+		};
+		return C;
+	};
+	inline Vector3D<T> operator*(const Vector3D<T>& B) const
+	{
+		Vector3D<T> C;
+		for (uint64_t r = 0; r < 3; r++)
+		{
+			C.value[r] = (this->value[r][0] * B.value[0]) + (this->value[r][1] * B.value[1]) + (this->value[r][2] * B.value[2]);
+		};
+		return C;
+	};
+
+	// Binary Assignment Operators
+	inline Matrix3<T>& operator*=(const Matrix3<T>& B)
+	{
+		(*this) = ((*this) * B);
+		return (*this);
+	};
+	inline Matrix3<T>& operator*=(const T& B)
+	{
+		(*this) = ((*this) * B);
+		return (*this);
+	};
+};
+
+template <typename T>
+struct Matrix4
+{
+	/*
+		# Matrix 4 (struct)
+		A 4x4 matrix, for affine transforms (a Matrix3 plus a translation in the
+		last column, with a last row of 0, 0, 0, 1) and projections. A default
+		constructed matrix is all zero.
+	*/
+
+	/* Elements */
+	T value[4][4]; // value[row][column]
+
+	/* Methods */
+
+	// Constructors & Destructor
+	constexpr Matrix4() : value{} {};
+	constexpr Matrix4(
+		const T& m00, const T& m01, const T& m02, const T& m03,
+		const T& m10, const T& m11, const T& m12, const T& m13,
+		const T& m20, const T& m21, const T& m22, const T& m23,
+		const T& m30, const T& m31, const T& m32, const T& m33
+	) : value{ { m00, m01, m02, m03 }, { m10, m11, m12, m13 }, { m20, m21, m22, m23 }, { m30, m31, m32, m33 } } {};
+
+	// Factories
+	static constexpr Matrix4<T> identity()
+	{
+		return Matrix4<T>(
+			(T)1, T(), T(), T(),
+			T(), (T)1, T(), T(),
+			T(), T(), (T)1, T(),
+			T(), T(), T(), (T)1
+		);
+	};
+	static inline Matrix4<T> fromRows(const Vector4D<T>& A, const Vector4D<T>& B, const Vector4D<T>& C, const Vector4D<T>& D)
+	{
+		return Matrix4<T>(
+			A.value[0], A.value[1], A.value[2], A.value[3],
+			B.value[0], B.value[1], B.value[2], B.value[3],
+			C.value[0], C.value[1], C.value[2], C.value[3],
+			D.value[0], D.value[1], D.value[2], D.value[3]
+		);
+	};
+	static inline Matrix4<T> fromColumns(const Vector4D<T>& A, const Vector4D<T>& B, const Vector4D<T>& C, const Vector4D<T>& D)
+	{
+		return Matrix4<T>::fromRows(A, B, C, D).transpose();
+	};
+	static inline Matrix4<T> affine(const Matrix3<T>& linear, const Vector3D<T>& offset)
+	{
+		/*
+			The transform applying linear and then moving by offset.
+		*/
+
+		Matrix4<T> C;
+		for (uint64_t r = 0; r < 3; r++)
+		{
+			for (uint64_t c = 0; c < 3; c++)
+			{
+				C.value[r][c] = linear.value[r][c];
+			};
+			C.value[r][3] = offset.value[r];
+		};
+		C.value[3][3] = (T)1;
+		return C;
+	};
+	static inline Matrix4<T> translation(const Vector3D<T>& offset)
+	{
+		return Matrix4<T>::affine(Matrix3<T>::identity(), offset);
+	};
+	static inline Matrix4<T> scaling(const Vector3D<T>& scale)
+	{
+		return Matrix4<T>::affine(Matrix3<T>::scaling(scale), Vector3D<T>());
+	};
+	static inline Matrix4<T> rotation(const Vector3D<T>& axis, const T& angle)
+	{
+		/*
+			See Matrix3::rotation().
+		*/
+
+		return Matrix4<T>::affine(Matrix3<T>::rotation(axis, angle), Vector3D<T>());
+	};
+
+	// Access Operators
+	constexpr T& operator()(const uint64_t& row, const uint64_t& column)
+	{
+		return this->value[row][column];
+	};
+	constexpr const T& operator()(const uint64_t& row, const uint64_t& column) const
+	{
+		return this->value[row][column];
+	};
+	inline Vector4D<T> row(const uint64_t& i) const
+	{
+		return Vector4D<T>(this->value[i][0], this->value[i][1], this->value[i][2], this->value[i][3]);
+	};
+	inline Vector4D<T> column(const uint64_t& i) const
+	{
+		return Vector4D<T>(this->value[0][i], this->value[1][i], this->value[2][i], this->value[3][i]);
+	};
+	inline Matrix3<T> linear() const
+	{
+		/*
+			The upper left 3x3 block.
+		*/
+
+		return Matrix3<T>(
+			this->value[0][0], this->value[0][1], this->value[0][2],
+			this->value[1][0], this->value[1][1], this->value[1][2],
+			this->value[2][0], this->value[2][1], this->value[2][2]
+		);
+	};
+	inline Vector3D<T> offset() const
+	{
+		/*
+			The translation, the top 3 elements of the last column.
+		*/
+
+		return Vector3D<T>(this->value[0][3], this->value[1][3], this->value[2][3]);
+	};
+	inline bool isAffine() const
+	{
+		return ((this->value[3][0] == T()) && (this->value[3][1] == T()) && (this->value[3][2] == T()) && (this->value[3][3] == (T)1));
+	};
+
+	// Matrix Operators
+	inline Matrix4<T> transpose() const
+	{
+		Matrix4<T> C;
+		for (uint64_t r = 0; r < 4; r++)
+		{
+			for (uint64_t c = 0; c < 4; c++)
+			{
+				C.value[c][r] = this->value[r][c];
+			};
+		};
+		return C;
+	};
+	inline T determinant() const
+	{
+		const T (&m)[4][4] = this->value;
+		const T s0 = (m[0][0] * m[1][1]) - (m[1][0] * m[0][1]);
+		const T s1 = (m[0][0] * m[1][2]) - (m[1][0] * m[0][2]);
+		const T s2 = (m[0][0] * m[1][3]) - (m[1][0] * m[0][3]);
+		const T s3 = (m[0][1] * m[1][2]) - (m[1][1] * m[0][2]);
+		const T s4 = (m[0][1] * m[1][3]) - (m[1][1] * m[0][3]);
+		const T s5 = (m[0][2] * m[1][3]) - (m[1][2] * m[0][3]);
+		const T c5 = (m[2][2] * m[3][3]) - (m[3][2] * m[2][3]);
+		const T c4 = (m[2][1] * m[3][3]) - (m[3][1] * m[2][3]);
+		const T c3 = (m[2][1] * m[3][2]) - (m[3][1] * m[2][2]);
+		const T c2 = (m[2][0] * m[3][3]) - (m[3][0] * m[2][3]);
+		const T c1 = (m[2][0] * m[3][2]) - (m[3][0] * m[2][2]);
+		const T c0 = (m[2][0] * m[3][1]) - (m[3][0] * m[2][1]);
+		return ((s0 * c5) - (s1 * c4) + (s2 * c3) + (s3 * c2) - (s4 * c1) + (s5 * c0));
+	};
+	inline bool inverse(Matrix4<T>& out) const
+	{
+		/*
+			Writes the inverse into out, from the 2x2 minors of the top and bottom
+			halves. Returns false, leaving out untouched, if the matrix is singular (or
+			not finite). affineInverse() is cheaper for affine transforms.
+		*/
+
+		const T (&m)[4][4] = this->value;
+		const T s0 = (m[0][0] * m[1][1]) - (m[1][0] * m[0][1]);
+		const T s1 = (m[0][0] * m[1][2]) - (m[1][0] * m[0][2]);
+		const T s2 = (m[0][0] * m[1][3]) - (m[1][0] * m[0][3]);
+		const T s3 = (m[0][1] * m[1][2]) - (m[1][1] * m[0][2]);
+		const T s4 = (m[0][1] * m[1][3]) - (m[1][1] * m[0][3]);
+		const T s5 = (m[0][2] * m[1][3]) - (m[1][2] * m[0][3]);
+		const T c5 = (m[2][2] * m[3][3]) - (m[3][2] * m[2][3]);
+		const T c4 = (m[2][1] * m[3][3]) - (m[3][1] * m[2][3]);
+		const T c3 = (m[2][1] * m[3][2]) - (m[3][1] * m[2][2]);
+		const T c2 = (m[2][0] * m[3][3]) - (m[3][0] * m[2][3]);
+		const T c1 = (m[2][0] * m[3][2]) - (m[3][0] * m[2][2]);
+		const T c0 = (m[2][0] * m[3][1]) - (m[3][0] * m[2][1]);
+		const T det = ((s0 * c5) - (s1 * c4) + (s2 * c3) + (s3 * c2) - (s4 * c1) + (s5 * c0));
+		if (!(det != T()) || !std::isfinite(det))
+		{
+			return false;
+		};
+
+		const T scale = ((T)1 / det);
+		out = Matrix4<T>(
+			(((m[1][1] * c5) - (m[1][2] * c4) + (m[1][3] * c3)) * scale),
+			(((-m[0][1] * c5) + (m[0][2] * c4) - (m[0][3] * c3)) * scale),
+			(((m[3][1] * s5) - (m[3][2] * s4) + (m[3][3] * s3)) * scale),
+			(((-m[2][1] * s5) + (m[2][2] * s4) - (m[2][3] * s3)) * scale),
+
+			(((-m[1][0] * c5) + (m[1][2] * c2) - (m[1][3] * c1)) * scale),
+			(((m[0][0] * c5) - (m[0][2] * c2) + (m[0][3] * c1)) * scale),
+			(((-m[3][0] * s5) + (m[3][2] * s2) - (m[3][3] * s1)) * scale),
+			(((m[2][0] * s5) - (m[2][2] * s2) + (m[2][3] * s1)) * scale),
+
+			(((m[1][0] * c4) - (m[1][1] * c2) + (m[1][3] * c0)) * scale),
+			(((-m[0][0] * c4) + (m[0][1] * c2) - (m[0][3] * c0)) * scale),
+			(((m[3][0] * s4) - (m[3][1] * s2) + (m[3][3] * s0)) * scale),
+			(((-m[2][0] * s4) + (m[2][1] * s2) - (m[2][3] * s0)) * scale),
+
+			(((-m[1][0] * c3) + (m[1][1] * c1) - (m[1][2] * c0)) * scale),
+			(((m[0][0] * c3) - (m[0][1] * c1) + (m[0][2] * c0)) * scale),
+			(((-m[3][0] * s3) + (m[3][1] * s1) - (m[3][2] * s0)) * scale),
+			(((m[2][0] * s3) - (m[2][1] * s1) + (m[2][2] * s0)) * scale)
+		);
+		return true;
+	};
+	inline bool affineInverse(Matrix4<T>& out) const
+	{
+		/*
+			Writes the inverse of an affine transform into out: the inverse of the
+			linear part, and the offset moved back through it. The last row is taken to
+			be 0, 0, 0, 1 whatever it holds. Returns false, leaving out untouched, if
+			the linear part is singular.
+		*/
+
+		Matrix3<T> linear;
+		if (!this->linear().inverse(linear))
+		{
+			return false;
+		};
+		out = Matrix4<T>::affine(linear, -(linear * this->offset()));
+		return true;
+	};
+
+	// Transforms
+	inline Vector3D<T> transformPoint(const Vector3D<T>& B) const
+	{
+		/*
+			Transforms B as a point (w = 1), ignoring the last row.
+		*/
+
+		Vector3D<T> C;
+		for (uint64_t r = 0; r < 3; r++)
+		{
+			C.value[r] = (this->value[r][0] * B.value[0]) + (this->value[r][1] * B.value[1]) + (this->value[r][2] * B.value[2]) + this->value[r][3];
+		};
+		return C;
+	};
+	inline Vector3D<T> transformDirection(const Vector3D<T>& B) const
+	{
+		/*
+			Transforms B as a direction (w = 0), which the translation doesn't move.
+		*/
+
+		Vector3D<T> C;
+		for (uint64_t r = 0; r < 3; r++)
+		{
+			C.value[r] = (this->value[r][0] * B.value[0]) + (this->value[r][1] * B.value[1]) + (this->value[r][2] * B.value[2]);
+		};
+		return C;
+	};
+
+	// Comparison Operators
+	inline bool operator==(const Matrix4<T>& B) const
+	{
+		for (uint64_t r = 0; r < 4; r++)
+		{
+			for (uint64_t c = 0; c < 4; c++)
+			{
+				if (this->value[r][c] != B.value[r][c])
+				{
+					return false;
+				};
+			};
+		};
+		return true;
+	};
+	inline bool operator!=(const Matrix4<T>& B) const
+	{
+		return !((*this) == B);
+	};
+
+	// Binary Operators
+	inline Matrix4<T> operator+(const Matrix4<T>& B) const
+	{
+		Matrix4<T> C;
+		for (uint64_t r = 0; r < 4; r++)
+		{
+			for (uint64_t c = 0; c < 4; c++)
+			{
+				C.value[r][c] = this->value[r][c] + B.value[r][c];
+			};
+		};
+		return C;
+	};
+	inline Matrix4<T> operator-(const Matrix4<T>& B) const
+	{
+		Matrix4<T> C;
+		for (uint64_t r = 0; r < 4; r++)
+		{
+			for (uint64_t c = 0; c < 4; c++)
+			{
+				C.value[r][c] = this->value[r][c] - B.value[r][c];
+			};
+		};
+		return C;
+	};
+	inline Matrix4<T> operator*(const T& B) const
+	{
+		Matrix4<T> C;
+		for (uint64_t r = 0; r < 4; r++)
+		{
+			for (uint64_t c = 0; c < 4; c++)
+			{
+				C.value[r][c] = this->value[r][c] * B;
+			};
+		};
+		return C;
+	};
+	inline Matrix4<T> operator*(const Matrix4<T>& B) const
+	{
+		Matrix4<T> C;
+		for (uint64_t r = 0; r < 4; r++)
+		{
+			for (uint64_t c = 0; c < 4; c++)
+			{
+				C.value[r][c] = (this->value[r][0] * B.value[0][c]) + (this->value[r][1] * B.value[1][c]) + (this->value[r][2] * B.value[2][c]) + (this->value[r][3] * B.value[3][c]);
+			};
+		};
+		return C;
+	};
+	inline Vector4D<T> operator*(const Vector4D<T>& B) const
+	{
+		Vector4D<T> C;
+		for (uint64_t r = 0; r < 4; r++)
+		{
+			C.value[r] = (this->value[r][0] * B.value[0]) + (this->value[r][1] * B.value[1]) + (this->value[r][2] * B.value[2]) + (this->value[r][3] * B.value[3]);
+		};
+		return C;
+	};
+
+	// Binary Assignment Operators
+	inline Matrix4<T>& operator*=(const Matrix4<T>& B)
+	{
+		(*this) = ((*this) * B);
+		return (*this);
+	};
+	inline Matrix4<T>& operator*=(const T& B)
+	{
+		(*this) = ((*this) * B);
+		return (*this);
+	};
+};
+
+/* Scalar Operators */
+template <typename T>
+inline Matrix3<T> operator*(const typename std::common_type<T>::type& A, const Matrix3<T>& B) { return (B * A); };
+template <typename T>
+inline Matrix4<T> operator*(const typename std::common_type<T>::type& A, const Matrix4<T>& B) { return (B * A); };
+
+/* Layout Guarantees */
+static_assert(sizeof(Matrix3<float>) == (9 * sizeof(float)), "Matrix3 must be exactly 9 elements.");
+static_assert(sizeof(Matrix4<float>) == (16 * sizeof(float)), "Matrix4 must be exactly 16 elements.");
+static_assert(std::is_trivially_copyable<Matrix4<float>>::value, "Matrix4 must be trivially copyable.");
+
+/* Transform Helpers */
+template <int ISA>
+struct VectorMatrixMath
+{
+	/*
+		# Vector Matrix Math (struct)
+		The loops behind the batched transforms. affine() computes the first three
+		rows of a transform, given as 12 values (a 3x4 matrix, row major), over
+		packed x, y, z points; a direction is a point under a matrix with a zero
+		last column. Both read a block of input before writing any output, so A and
+		out may be the same array.
+
+		The generic form copies each block into separate x, y and z arrays, which
+		the compiler can vectorize; the AVX2 and AVX-512 forms replace it for float.
+	*/
+
+	static constexpr size_t block = 32;
+
+	template <typename T>
+	static VECTORS_ALWAYS_INLINE void affine(const T* m, const Vector3D<T>* A, Vector3D<T>* out, size_t n)
+	{
+		T x[block], y[block], z[block];
+		for (size_t i = 0; i < n; i += block)
+		{
+			const size_t count = ((n - i) < block) ? (n - i) : block;
+			for (size_t j = 0; j < count; j++)
+			{
+				x[j] = A[i + j].value[0];
+				y[j] = A[i + j].value[1];
+				z[j] = A[i + j].value[2];
+			};
+			for (size_t j = 0; j < count; j++)
+			{
+				for (uint64_t r = 0; r < 3; r++)
+				{
+					out[i + j].value[r] = (m[4 * r] * x[j]) + (m[(4 * r) + 1] * y[j]) + (m[(4 * r) + 2] * z[j]) + m[(4 * r) + 3];
+				};
+			};
+		};
+	};
+	template <typename T>
+	static VECTORS_ALWAYS_INLINE void transform(const T* m, const Vector4D<T>* A, Vector4D<T>* out, size_t n)
+	{
+		T x[block], y[block], z[block], w[block];
+		for (size_t i = 0; i < n; i += block)
+		{
+			const size_t count = ((n - i) < block) ? (n - i) : block;
+			for (size_t j = 0; j < count; j++)
+			{
+				x[j] = A[i + j].value[0];
+				y[j] = A[i + j].value[1];
+				z[j] = A[i + j].value[2];
+				w[j] = A[i + j].value[3];
+			};
+			for (size_t j = 0; j < count; j++)
+			{
+				for (uint64_t r = 0; r < 4; r++)
+				{
+					out[i + j].value[r] = (m[4 * r] * x[j]) + (m[(4 * r) + 1] * y[j]) + (m[(4 * r) + 2] * z[j]) + (m[(4 * r) + 3] * w[j]);
+				};
+			};
+		};
+	};
+};
+
+#if VECTORS_DISPATCH
+/*
+	The packed kernels read 3 registers of W floats (W points) at a time and
+	write 3. Element l of output register k is element p = W * k + l of the
+	output, component p % 3 of point p / 3, and needs the x, y and z of that
+	point, elements 3 * (p / 3) + s for s = 0, 1, 2. Those are within a couple of
+	elements of p, so each comes from at most 3 neighbouring input registers, and
+	which ones is fixed by k and s.
+*/
+constexpr int vectorsPackedSource(const int& W, const int& k, const int& l, const int& s)
+{
+	return ((3 * (((W * k) + l) / 3)) + s);
+};
+constexpr int vectorsPackedLow(const int& W, const int& k, const int& s)
+{
+	return (vectorsPackedSource(W, k, 0, s) / W);
+};
+constexpr int vectorsPackedHigh(const int& W, const int& k, const int& s)
+{
+	return (vectorsPackedSource(W, k, (W - 1), s) / W);
+};
+constexpr int vectorsPackedMask(const int& k, const int& s, const int& from)
+{
+	/*
+		The lanes of an 8 wide output register taking their element from input
+		register from or later.
+	*/
+
+	int mask = 0;
+	for (int l = 0; l < 8; l++)
+	{
+		mask |= (((vectorsPackedSource(8, k, l, s) / 8) >= from) ? (1 << l) : 0);
+	};
+	return mask;
+};
+
+template <int k, int s>
+VECTORS_TARGET_AVX2 VECTORS_ALWAYS_INLINE __m256 vectorsPackedGather(const __m256* r, const __m256i& index)
+{
+	constexpr int low = vectorsPackedLow(8, k, s);
+	constexpr int high = vectorsPackedHigh(8, k, s);
+	const __m256 first = _mm256_permutevar8x32_ps(r[low], index);
+	if constexpr (high == low)
+	{
+		return first;
+	}
+	else if constexpr (high == (low + 1))
+	{
+		// Through constexpr locals, as unoptimized builds don't fold the calls into immediates
+		constexpr int mask = vectorsPackedMask(k, s, high);
+		return _mm256_blend_ps(first, _mm256_permutevar8x32_ps(r[high], index), mask);
+	}
+	else
+	{
+		constexpr int middle = vectorsPackedMask(k, s, (low + 1));
+		constexpr int mask = vectorsPackedMask(k, s, high);
+		const __m256 second = _mm256_blend_ps(first, _mm256_permutevar8x32_ps(r[low + 1], index), middle);
+		return _mm256_blend_ps(second, _mm256_permutevar8x32_ps(r[high], index), mask);
+	};
+};
+template <int k>
+VECTORS_TARGET_AVX2 VECTORS_ALWAYS_INLINE __m256 vectorsPackedAffine(const __m256* r, const __m256i* index, const __m256* coefficient)
+{
+	__m256 v = _mm256_fmadd_ps(coefficient[4 * k], vectorsPackedGather<k, 0>(r, index[3 * k]), coefficient[(4 * k) + 3]);
+	v = _mm256_fmadd_ps(coefficient[(4 * k) + 1], vectorsPackedGather<k, 1>(r, index[(3 * k) + 1]), v);
+	return _mm256_fmadd_ps(coefficient[(4 * k) + 2], vectorsPackedGather<k, 2>(r, index[(3 * k) + 2]), v);
+};
+
+template <>
+struct VectorMatrixMath<VECTORS_ISA_AVX2> : VectorMatrixMath<VECTORS_ISA_GENERIC>
+{
+	using VectorMatrixMath<VECTORS_ISA_GENERIC>::affine;
+
+	VECTORS_TARGET_AVX2 static inline void affine(const float* m, const Vector3D<float>* A, Vector3D<float>* out, size_t n)
+	{
+		/*
+			8 points at a time, each of x, y and z gathered with a permute of every
+			input register it comes from and blends.
+		*/
+
+		alignas(32) int32_t indices[9][8];
+		alignas(32) float coefficients[12][8];
+		for (int k = 0; k < 3; k++)
+		{
+			for (int l = 0; l < 8; l++)
+			{
+				const int c = (((8 * k) + l) % 3);
+				for (int s = 0; s < 3; s++)
+				{
+					indices[(3 * k) + s][l] = (vectorsPackedSource(8, k, l, s) % 8);
+				};
+				for (int s = 0; s < 4; s++)
+				{
+					coefficients[(4 * k) + s][l] = m[(4 * c) + s];
+				};
+			};
+		};
+		__m256i index[9];
+		__m256 coefficient[12];
+		for (int i = 0; i < 9; i++)
+		{
+			index[i] = _mm256_load_si256((const __m256i*)indices[i]);
+		};
+		for (int i = 0; i < 12; i++)
+		{
+			coefficient[i] = _mm256_load_ps(coefficients[i]);
+		};
+
+		const float* a = (const float*)A;
+		float* b = (float*)out;
+		size_t i = 0;
+		for (; (i + 8) <= n; i += 8)
+		{
+			const __m256 r[3] = { _mm256_loadu_ps(a + (3 * i)), _mm256_loadu_ps(a + (3 * i) + 8), _mm256_loadu_ps(a + (3 * i) + 16) };
+			const __m256 o0 = vectorsPackedAffine<0>(r, index, coefficient);
+			const __m256 o1 = vectorsPackedAffine<1>(r, index, coefficient);
+			const __m256 o2 = vectorsPackedAffine<2>(r, index, coefficient);
+			_mm256_storeu_ps(b + (3 * i), o0);
+			_mm256_storeu_ps(b + (3 * i) + 8, o1);
+			_mm256_storeu_ps(b + (3 * i) + 16, o2);
+		};
+		VectorMatrixMath<VECTORS_ISA_GENERIC>::affine(m, (A + i), (out + i), (n - i));
+	};
+
+	using VectorMatrixMath<VECTORS_ISA_GENERIC>::transform;
+
+	VECTORS_TARGET_AVX2 static inline void transform(const float* m, const Vector4D<float>* A, Vector4D<float>* out, size_t n)
+	{
+		/*
+			2 points at a time, each element broadcast across its point's half of the
+			register and multiplied by a column of m.
+		*/
+
+		__m256 columns[4];
+		for (int c = 0; c < 4; c++)
+		{
+			columns[c] = _mm256_setr_ps(m[c], m[4 + c], m[8 + c], m[12 + c], m[c], m[4 + c], m[8 + c], m[12 + c]);
+		};
+		const float* a = (const float*)A;
+		float* b = (float*)out;
+		size_t i = 0;
+		for (; (i + 2) <= n; i += 2)
+		{
+			const __m256 r = _mm256_loadu_ps(a + (4 * i));
+			__m256 v = _mm256_mul_ps(columns[0], _mm256_permute_ps(r, 0x00));
+			v = _mm256_fmadd_ps(columns[1], _mm256_permute_ps(r, 0x55), v);
+			v = _mm256_fmadd_ps(columns[2], _mm256_permute_ps(r, 0xAA), v);
+			v = _mm256_fmadd_ps(columns[3], _mm256_permute_ps(r, 0xFF), v);
+			_mm256_storeu_ps(b + (4 * i), v);
+		};
+		VectorMatrixMath<VECTORS_ISA_GENERIC>::transform(m, (A + i), (out + i), (n - i));
+	};
+};
+
+constexpr int vectorsPackedPair(const int& k, const int& s)
+{
+	/*
+		The first of the two neighbouring input registers a 16 wide output register
+		takes an element from, for a two source permute.
+	*/
+
+	return (vectorsPackedLow(16, k, s) < 2) ? vectorsPackedLow(16, k, s) : 1;
+};
+
+template <int k, int s>
+VECTORS_TARGET_AVX512 VECTORS_ALWAYS_INLINE __m512 vectorsPackedGather(const __m512* r, const __m512i& index)
+{
+	constexpr int low = vectorsPackedPair(k, s);
+	static_assert(vectorsPackedHigh(16, k, s) <= (low + 1), "16 wide elements come from at most 2 registers.");
+	return _mm512_permutex2var_ps(r[low], index, r[low + 1]);
+};
+template <int k>
+VECTORS_TARGET_AVX512 VECTORS_ALWAYS_INLINE __m512 vectorsPackedAffine(const __m512* r, const __m512i* index, const __m512* coefficient)
+{
+	__m512 v = _mm512_fmadd_ps(coefficient[4 * k], vectorsPackedGather<k, 0>(r, index[3 * k]), coefficient[(4 * k) + 3]);
+	v = _mm512_fmadd_ps(coefficient[(4 * k) + 1], vectorsPackedGather<k, 1>(r, index[(3 * k) + 1]), v);
+	return _mm512_fmadd_ps(coefficient[(4 * k) + 2], vectorsPackedGather<k, 2>(r, index[(3 * k) + 2]), v);
+};
+
+template <>
+struct VectorMatrixMath<VECTORS_ISA_AVX512> : VectorMatrixMath<VECTORS_ISA_GENERIC>
+{
+	using VectorMatrixMath<VECTORS_ISA_GENERIC>::affine;
+
+	VECTORS_TARGET_AVX512 static inline void affine(const float* m, const Vector3D<float>* A, Vector3D<float>* out, size_t n)
+	{
+		/*
+			16 points at a time, each of x, y and z gathered from a pair of input
+			registers with one two source permute.
+		*/
+
+		alignas(64) int32_t indices[9][16];
+		alignas(64) float coefficients[12][16];
+		for (int k = 0; k < 3; k++)
+		{
+			for (int l = 0; l < 16; l++)
+			{
+				const int c = (((16 * k) + l) % 3);
+				for (int s = 0; s < 3; s++)
+				{
+					indices[(3 * k) + s][l] = (vectorsPackedSource(16, k, l, s) - (16 * vectorsPackedPair(k, s)));
+				};
+				for (int s = 0; s < 4; s++)
+				{
+					coefficients[(4 * k) + s][l] = m[(4 * c) + s];
+				};
+			};
+		};
+		__m512i index[9];
+		__m512 coefficient[12];
+		for (int i = 0; i < 9; i++)
+		{
+			index[i] = _mm512_load_si512(indices[i]);
+		};
+		for (int i = 0; i < 12; i++)
+		{
+			coefficient[i] = _mm512_load_ps(coefficients[i]);
+		};
+
+		const float* a = (const float*)A;
+		float* b = (float*)out;
+		size_t i = 0;
+		for (; (i + 16) <= n; i += 16)
+		{
+			const __m512 r[3] = { _mm512_loadu_ps(a + (3 * i)), _mm512_loadu_ps(a + (3 * i) + 16), _mm512_loadu_ps(a + (3 * i) + 32) };
+			const __m512 o0 = vectorsPackedAffine<0>(r, index, coefficient);
+			const __m512 o1 = vectorsPackedAffine<1>(r, index, coefficient);
+			const __m512 o2 = vectorsPackedAffine<2>(r, index, coefficient);
+			_mm512_storeu_ps(b + (3 * i), o0);
+			_mm512_storeu_ps(b + (3 * i) + 16, o1);
+			_mm512_storeu_ps(b + (3 * i) + 32, o2);
+		};
+		VectorMatrixMath<VECTORS_ISA_GENERIC>::affine(m, (A + i), (out + i), (n - i));
+	};
+
+	using VectorMatrixMath<VECTORS_ISA_GENERIC>::transform;
+
+	VECTORS_TARGET_AVX512 static inline void transform(const float* m, const Vector4D<float>* A, Vector4D<float>* out, size_t n)
+	{
+		/*
+			As the AVX2 form, 4 points at a time. The broadcasts are shuffles of the
+			register with itself, as _mm512_permute_ps trips the same spurious GCC 12
+			warning as in vectorsReduceAdd().
+		*/
+
+		alignas(64) float repeated[4][16];
+		for (int c = 0; c < 4; c++)
+		{
+			for (int l = 0; l < 16; l++)
+			{
+				repeated[c][l] = m[(4 * (l % 4)) + c];
+			};
+		};
+		__m512 columns[4];
+		for (int c = 0; c < 4; c++)
+		{
+			columns[c] = _mm512_load_ps(repeated[c]);
+		};
+		const float* a = (const float*)A;
+		float* b = (float*)out;
+		size_t i = 0;
+		for (; (i + 4) <= n; i += 4)
+		{
+			const __m512 r = _mm512_loadu_ps(a + (4 * i));
+			__m512 v = _mm512_mul_ps(columns[0], _mm512_shuffle_ps(r, r, 0x00));
+			v = _mm512_fmadd_ps(columns[1], _mm512_shuffle_ps(r, r, 0x55), v);
+			v = _mm512_fmadd_ps(columns[2], _mm512_shuffle_ps(r, r, 0xAA), v);
+			v = _mm512_fmadd_ps(columns[3], _mm512_shuffle_ps(r, r, 0xFF), v);
+			_mm512_storeu_ps(b + (4 * i), v);
+		};
+		VectorMatrixMath<VECTORS_ISA_GENERIC>::transform(m, (A + i), (out + i), (n - i));
+	};
+};
+#endif
+
+/* Kernels */
+struct VectorMatrixAffine
+{
+	template <int ISA, typename... Args>
+	static VECTORS_ALWAYS_INLINE void run(Args... args)
+	{
+		VectorMatrixMath<ISA>::affine(args...);
+	};
+};
+struct VectorMatrixTransform
+{
+	template <int ISA, typename... Args>
+	static VECTORS_ALWAYS_INLINE void run(Args... args)
+	{
+		VectorMatrixMath<ISA>::transform(args...);
+	};
+};
+
+/* Batch Transforms */
+template <typename T>
+inline void transformPoints(const Matrix4<T>& M, const Vector3D<T>* A, Vector3D<T>* out, const size_t& n)
+{
+	/*
+		Writes M.transformPoint(A[i]) into out[i]: M applied to each point with
+		w = 1, ignoring its last row. A and out may be the same array.
+	*/
+
+	vectorsDispatch<VectorMatrixAffine>(&M.value[0][0], A, out, (size_t)n);
+};
+template <typename T>
+inline void transformPoints(const Matrix4<T>& M, Vector3D<T>* A, const size_t& n)
+{
+	transformPoints(M, A, A, n);
+};
+template <typename T>
+inline void transformDirections(const Matrix4<T>& M, const Vector3D<T>* A, Vector3D<T>* out, const size_t& n)
+{
+	/*
+		Writes M.transformDirection(A[i]) into out[i]: M applied to each direction
+		with w = 0. A and out may be the same array.
+	*/
+
+	T m[12];
+	for (uint64_t r = 0; r < 3; r++)
+	{
+		for (uint64_t c = 0; c < 3; c++)
+		{
+			m[(4 * r) + c] = M.value[r][c];
+		};
+		m[(4 * r) + 3] = T();
+	};
+	vectorsDispatch<VectorMatrixAffine>((const T*)m, A, out, (size_t)n);
+};
+template <typename T>
+inline void transformDirections(const Matrix4<T>& M, Vector3D<T>* A, const size_t& n)
+{
+	transformDirections(M, A, A, n);
+};
+template <typename T>
+inline void transformVectors(const Matrix3<T>& M, const Vector3D<T>* A, Vector3D<T>* out, const size_t& n)
+{
+	/*
+		Writes M * A[i] into out[i]. A and out may be the same array.
+	*/
+
+	transformDirections(Matrix4<T>::affine(M, Vector3D<T>()), A, out, n);
+};
+template <typename T>
+inline void transformVectors(const Matrix3<T>& M, Vector3D<T>* A, const size_t& n)
+{
+	transformVectors(M, A, A, n);
+};
+template <typename T>
+inline void transformVectors(const Matrix4<T>& M, const Vector4D<T>* A, Vector4D<T>* out, const size_t& n)
+{
+	/*
+		Writes M * A[i] into out[i], using all of M. A and out may be the same
+		array.
+	*/
+
+	vectorsDispatch<VectorMatrixTransform>(&M.value[0][0], A, out, (size_t)n);
+};
+template <typename T>
+inline void transformVectors(const Matrix4<T>& M, Vector4D<T>* A, const size_t& n)
+{
+	transformVectors(M, A, A, n);
+};
+
+#if defined(__cpp_lib_span)
+/* Span Overloads */
+// The overloads writing into another span return false, doing nothing, unless
+// it is the same size as A.
+template <typename T, typename SA, typename SO>
+inline typename std::enable_if<VectorsSpanOf<SA, Vector3D<T>>::value && VectorsSpanOf<SO, Vector3D<T>, true>::value, bool>::type transformPoints(const Matrix4<T>& M, SA A, SO out)
+{
+	if (out.size() != A.size())
+	{
+		return false;
+	};
+	transformPoints(M, A.data(), out.data(), A.size());
+	return true;
+};
+template <typename T, typename SA>
+inline typename std::enable_if<VectorsSpanOf<SA, Vector3D<T>, true>::value>::type transformPoints(const Matrix4<T>& M, SA A)
+{
+	transformPoints(M, A.data(), A.size());
+};
+template <typename T, typename SA, typename SO>
+inline typename std::enable_if<VectorsSpanOf<SA, Vector3D<T>>::value && VectorsSpanOf<SO, Vector3D<T>, true>::value, bool>::type transformDirections(const Matrix4<T>& M, SA A, SO out)
+{
+	if (out.size() != A.size())
+	{
+		return false;
+	};
+	transformDirections(M, A.data(), out.data(), A.size());
+	return true;
+};
+template <typename T, typename SA>
+inline typename std::enable_if<VectorsSpanOf<SA, Vector3D<T>, true>::value>::type transformDirections(const Matrix4<T>& M, SA A)
+{
+	transformDirections(M, A.data(), A.size());
+};
+template <typename T, typename SA, typename SO>
+inline typename std::enable_if<VectorsSpanOf<SA, Vector3D<T>>::value && VectorsSpanOf<SO, Vector3D<T>, true>::value, bool>::type transformVectors(const Matrix3<T>& M, SA A, SO out)
+{
+	if (out.size() != A.size())
+	{
+		return false;
+	};
+	transformVectors(M, A.data(), out.data(), A.size());
+	return true;
+};
+template <typename T, typename SA>
+inline typename std::enable_if<VectorsSpanOf<SA, Vector3D<T>, true>::value>::type transformVectors(const Matrix3<T>& M, SA A)
+{
+	transformVectors(M, A.data(), A.size());
+};
+template <typename T, typename SA, typename SO>
+inline typename std::enable_if<VectorsSpanOf<SA, Vector4D<T>>::value && VectorsSpanOf<SO, Vector4D<T>, true>::value, bool>::type transformVectors(const Matrix4<T>& M, SA A, SO out)
+{
+	if (out.size() != A.size())
+	{
+		return false;
+	};
+	transformVectors(M, A.data(), out.data(), A.size());
+	return true;
+};
+template <typename T, typename SA>
+inline typename std::enable_if<VectorsSpanOf<SA, Vector4D<T>, true>::value>::type transformVectors(const Matrix4<T>& M, SA A)
+{
+	transformVectors(M, A.data(), A.size());
+};
+#endif
+
+#endif
@@ -0,0 +1,672 @@
+#pragma once
+/*
+	# Vector Template Library - Parallel Execution
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	Overloads of the bulk vector operations (vectors_batch.h and
+	vectors_matrix.h) which take an execution policy as their first argument,
+	like the standard algorithms:
+
+		batchNormalize(vectorsPar, points.data(), points.size());
+		batchSum(vectorsSeq, points.data(), points.size());
+		transformPoints(vectorsPar.on(pool), M, points.data(), points.size());
+
+	The range is cut into chunks of about 64 KiB of input each, which are run
+	by a VectorsThreadPool. Each thread starts on a contiguous share of the
+	chunks and, when it runs out, steals half of what is left of another
+	thread's share, so uneven or interrupted threads don't hold up the rest.
+
+	The chunks only depend on the length of the range and the policy's chunk
+	size, never on the number of threads. Reductions add up the partial result
+	of each chunk pairwise in chunk order, so they give the same result for
+	any number of threads, and vectorsSeq gives the same result as vectorsPar.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+#ifndef VECTOR_TEMPLATE_LIBRARY_PARALLEL__H
+#define VECTOR_TEMPLATE_LIBRARY_PARALLEL__H
+/* Deps */
+#include "vectors.h"
+#include "vectors_batch.h"
+#include "vectors_matrix.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if defined(__has_include)
+	#if __has_include(<span>)
+		#include <span>
+	#endif
+#endif
+
+/* Thread Pool */
+inline bool& vectorsInsidePool()
+{
+	/*
+		Whether the calling thread is running chunks of a pool's job, in which case
+		further jobs it submits run inline rather than waiting on the pool.
+	*/
+
+	static thread_local bool inside = false;
+	return inside;
+};
+
+struct VectorsThreadPool
+{
+	/*
+		# Vectors Thread Pool (struct)
+		A fixed set of worker threads which run jobs of numbered chunks. The thread
+		calling run() takes part as well, so a pool of size() threads starts
+		size() - 1 workers. Jobs from different threads are run one at a time.
+	*/
+
+	/* Methods */
+
+	// Constructors & Destructor
+	explicit VectorsThreadPool(const size_t& threads = 0)
+	{
+		/*
+			Starts a pool of threads threads, or one per hardware thread if that is 0.
+		*/
+
+		size_t n = threads;
+		if (n == 0)
+		{
+			n = (size_t)std::thread::hardware_concurrency();
+		};
+		this->count = std::max((size_t)1, n);
+		this->slots.reset(new Slot[this->count]);
+		for (size_t i = 1; i < this->count; i++)
+		{
+			this->workers.emplace_back([this, i]() { this->work(i); });
+		};
+	};
+	VectorsThreadPool(const VectorsThreadPool&) = delete;
+	VectorsThreadPool& operator=(const VectorsThreadPool&) = delete;
+	~VectorsThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> guard(this->lock);
+			this->stopping = true;
+		};
+		this->wake.notify_all();
+		for (std::thread& worker : this->workers)
+		{
+			worker.join();
+		};
+	};
+
+	// Capacity Methods
+	inline size_t size() const
+	{
+		return this->count;
+	};
+
+	// Execution
+	template <typename Run>
+	inline void run(const size_t& chunks, const Run& task)
+	{
+		/*
+			Calls task(chunk) once for each chunk in 0 .. chunks - 1, across the pool,
+			and returns when all of them are done. Runs them in order on the calling
+			thread if there is nothing to split, or if it is called from inside a job.
+		*/
+
+		if ((chunks <= 1) || (this->count == 1) || vectorsInsidePool() || (chunks > (size_t)UINT32_MAX))
+		{
+			for (size_t chunk = 0; chunk < chunks; chunk++)
+			{
+				task(chunk);
+			};
+			return;
+		};
+
+		std::lock_guard<std::mutex> serial(this->submit);
+		this->job = [](const void* context, const size_t& chunk) { (*(const Run*)context)(chunk); };
+		this->context = &task;
+		for (size_t i = 0; i < this->count; i++)
+		{
+			const uint64_t first = ((chunks * i) / this->count);
+			const uint64_t last = ((chunks * (i + 1)) / this->count);
+			this->slots[i].range.store(((first << 32) | last), std::memory_order_relaxed);
+		};
+		{
+			std::lock_guard<std::mutex> guard(this->lock);
+			this->generation++;
+			this->active = this->workers.size();
+		};
+		this->wake.notify_all();
+
+		vectorsInsidePool() = true;
+		this->drain(0);
+		vectorsInsidePool() = false;
+
+		std::unique_lock<std::mutex> guard(this->lock);
+		this->done.wait(guard, [this]() { return (this->active == 0); });
+	};
+	static inline VectorsThreadPool& shared()
+	{
+		/*
+			The pool used by vectorsPar, with one thread per hardware thread, started
+			the first time it is used.
+		*/
+
+		static VectorsThreadPool pool;
+		return pool;
+	};
+
+private:
+	struct alignas(64) Slot
+	{
+		/*
+			The chunks a thread has left, as (first << 32) | last. The owner takes
+			chunks from the front, thieves take them from the back.
+		*/
+
+		std::atomic<uint64_t> range{0};
+	};
+
+	/* Elements */
+	size_t count = 1;
+	std::unique_ptr<Slot[]> slots;
+	std::vector<std::thread> workers;
+	std::mutex submit;
+	std::mutex lock;
+	std::condition_variable wake;
+	std::condition_variable done;
+	uint64_t generation = 0;
+	size_t active = 0;
+	bool stopping = false;
+	void (*job)(const void*, const size_t&) = nullptr;
+	const void* context = nullptr;
+
+	/* Methods */
+	inline void work(const size_t& index)
+	{
+		vectorsInsidePool() = true;
+		uint64_t seen = 0;
+		for (;;)
+		{
+			{
+				std::unique_lock<std::mutex> guard(this->lock);
+				this->wake.wait(guard, [&]() { return (this->stopping || (this->generation != seen)); });
+				if (this->stopping)
+				{
+					return;
+				};
+				seen = this->generation;
+			};
+
+			this->drain(index);
+
+			std::lock_guard<std::mutex> guard(this->lock);
+			this->active--;
+			if (this->active == 0)
+			{
+				this->done.notify_one();
+			};
+		};
+	};
+	inline void drain(const size_t& index)
+	{
+		size_t chunk = 0;
+		while (this->pop(index, chunk) || this->steal(index, chunk))
+		{
+			this->job(this->context, chunk);
+		};
+	};
+	inline bool pop(const size_t& index, size_t& chunk)
+	{
+		std::atomic<uint64_t>& range = this->slots[index].range;
+		uint64_t current = range.load(std::memory_order_acquire);
+		for (;;)
+		{
+			const uint64_t first = (current >> 32);
+			const uint64_t last = (current & 0xFFFFFFFFu);
+			if (first >= last)
+			{
+				return false;
+			};
+			if (range.compare_exchange_weak(current, (((first + 1) << 32) | last), std::memory_order_acq_rel))
+			{
+				chunk = (size_t)first;
+				return true;
+			};
+		};
+	};
+	inline bool steal(const size_t& index, size_t& chunk)
+	{
+		/*
+			Takes the back half of the first other share with chunks left, runs the
+			first of them next and keeps the rest as this thread's share.
+		*/
+
+		for (size_t k = 1; k < this->count; k++)
+		{
+			std::atomic<uint64_t>& range = this->slots[(index + k) % this->count].range;
+			uint64_t current = range.load(std::memory_order_acquire);
+			for (;;)
+			{
+				const uint64_t first = (current >> 32);
+				const uint64_t last = (current & 0xFFFFFFFFu);
+				if (first >= last)
+				{
+					break;
+				};
+				const uint64_t middle = (last - ((last - first + 1) / 2));
+				if (range.compare_exchange_weak(current, ((first << 32) | middle), std::memory_order_acq_rel))
+				{
+					chunk = (size_t)middle;
+					this->slots[index].range.store((((middle + 1) << 32) | last), std::memory_order_release);
+					return true;
+				};
+			};
+		};
+		return false;
+	};
+};
+
+/* Execution Policies */
+struct VectorsSequencedPolicy
+{
+	/*
+		# Vectors Sequenced Policy (struct)
+		Runs an operation on the calling thread, chunk by chunk, so reductions give
+		exactly what VectorsParallelPolicy does with the same chunk size.
+	*/
+
+	size_t chunk = 0; // Vectors per chunk, 0 for about 64 KiB of input.
+
+	constexpr VectorsSequencedPolicy withChunk(const size_t& n) const
+	{
+		return VectorsSequencedPolicy{n};
+	};
+};
+
+struct VectorsParallelPolicy
+{
+	/*
+		# Vectors Parallel Policy (struct)
+		Runs an operation's chunks across a thread pool: pool, or the shared one if
+		it is null.
+	*/
+
+	VectorsThreadPool* pool = nullptr;
+	size_t chunk = 0; // Vectors per chunk, 0 for about 64 KiB of input.
+
+	constexpr VectorsParallelPolicy on(VectorsThreadPool& target) const
+	{
+		return VectorsParallelPolicy{&target, this->chunk};
+	};
+	constexpr VectorsParallelPolicy withChunk(const size_t& n) const
+	{
+		return VectorsParallelPolicy{this->pool, n};
+	};
+};
+
+inline constexpr VectorsSequencedPolicy vectorsSeq{};
+inline constexpr VectorsParallelPolicy vectorsPar{};
+
+template <typename P>
+struct VectorsExecutionTraits
+{
+	static constexpr bool isPolicy = false;
+};
+template <>
+struct VectorsExecutionTraits<VectorsSequencedPolicy>
+{
+	static constexpr bool isPolicy = true;
+};
+template <>
+struct VectorsExecutionTraits<VectorsParallelPolicy>
+{
+	static constexpr bool isPolicy = true;
+};
+
+/* Execution Helpers */
+inline constexpr size_t vectorsExecutionBytes = (64 * 1024);
+
+template <typename Policy>
+inline size_t vectorsExecutionChunk(const Policy& policy, const size_t& n, const size_t& bytes)
+{
+	/*
+		The number of vectors per chunk for a range of n vectors of bytes bytes each.
+		Chunks are a multiple of 64 vectors, so they start on whole blocks of the
+		batch kernels and give the same results as one call over the whole range.
+	*/
+
+	size_t chunk = policy.chunk;
+	if (chunk == 0)
+	{
+		chunk = std::max((size_t)64, ((vectorsExecutionBytes / bytes) & ~(size_t)63));
+	};
+	return std::max(chunk, ((n + UINT32_MAX - 1) / UINT32_MAX));
+};
+
+template <typename Run>
+inline void vectorsExecuteChunks(const VectorsSequencedPolicy&, const size_t& chunks, const Run& run)
+{
+	for (size_t chunk = 0; chunk < chunks; chunk++)
+	{
+		run(chunk);
+	};
+};
+template <typename Run>
+inline void vectorsExecuteChunks(const VectorsParallelPolicy& policy, const size_t& chunks, const Run& run)
+{
+	VectorsThreadPool& pool = (policy.pool != nullptr) ? *policy.pool : VectorsThreadPool::shared();
+	pool.run(chunks, run);
+};
+
+template <typename Policy, typename Run>
+inline void vectorsExecute(const Policy& policy, const size_t& n, const size_t& bytes, const Run& run)
+{
+	/*
+		Calls run(first, last) for each chunk of the range 0 .. n - 1.
+	*/
+
+	const size_t chunk = vectorsExecutionChunk(policy, n, bytes);
+	vectorsExecuteChunks(policy, ((n + chunk - 1) / chunk), [&](const size_t& i) {
+		const size_t first = (i * chunk);
+		run(first, std::min(n, (first + chunk)));
+	});
+};
+
+template <typename R, typename Policy, typename Run, typename Combine>
+inline R vectorsExecuteReduce(const Policy& policy, const size_t& n, const size_t& bytes, const Run& run, const Combine& combine)
+{
+	/*
+		Reduces the range 0 .. n - 1 (n > 0) to the partial results run(first, last)
+		of its chunks, then adds those up pairwise with combine(a, b) in chunk order.
+	*/
+
+	const size_t chunk = vectorsExecutionChunk(policy, n, bytes);
+	const size_t chunks = ((n + chunk - 1) / chunk);
+	std::vector<R> partial(chunks);
+	vectorsExecuteChunks(policy, chunks, [&](const size_t& i) {
+		const size_t first = (i * chunk);
+		partial[i] = run(first, std::min(n, (first + chunk)));
+	});
+	for (size_t width = 1; width < chunks; width *= 2)
+	{
+		for (size_t i = 0; (i + width) < chunks; i += (2 * width))
+		{
+			partial[i] = combine(partial[i], partial[i + width]);
+		};
+	};
+	return partial[0];
+};
+
+/* Parallel Batch Operations */
+template <typename Policy, typename V>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy>::type batchDot(const Policy& policy, const V* A, const V* B, typename VectorTraits<V>::ElementType* out, const size_t& n)
+{
+	vectorsExecute(policy, n, (2 * sizeof(V)), [&](const size_t& first, const size_t& last) {
+		batchDot(A + first, B + first, out + first, (last - first));
+	});
+};
+template <typename Policy, typename V>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy>::type batchNorm(const Policy& policy, const V* A, typename VectorTraits<V>::ElementType* out, const size_t& n)
+{
+	vectorsExecute(policy, n, sizeof(V), [&](const size_t& first, const size_t& last) {
+		batchNorm(A + first, out + first, (last - first));
+	});
+};
+template <typename Policy, typename V>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy>::type batchNormalize(const Policy& policy, const V* A, V* out, const size_t& n)
+{
+	vectorsExecute(policy, n, sizeof(V), [&](const size_t& first, const size_t& last) {
+		batchNormalize(A + first, out + first, (last - first));
+	});
+};
+template <typename Policy, typename V>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy>::type batchNormalize(const Policy& policy, V* A, const size_t& n)
+{
+	batchNormalize(policy, (const V*)A, A, n);
+};
+template <typename Policy, typename T>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy>::type batchCross(const Policy& policy, const Vector3D<T>* A, const Vector3D<T>* B, Vector3D<T>* out, const size_t& n)
+{
+	vectorsExecute(policy, n, (2 * sizeof(Vector3D<T>)), [&](const size_t& first, const size_t& last) {
+		batchCross(A + first, B + first, out + first, (last - first));
+	});
+};
+template <typename Policy, typename V>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy>::type batchAxpy(const Policy& policy, const typename VectorTraits<V>::ElementType& a, const V* X, V* Y, const size_t& n)
+{
+	vectorsExecute(policy, n, (2 * sizeof(V)), [&](const size_t& first, const size_t& last) {
+		batchAxpy(a, X + first, Y + first, (last - first));
+	});
+};
+template <typename Policy, typename V>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy, V>::type batchSum(const Policy& policy, const V* A, const size_t& n)
+{
+	/*
+		Returns the element-wise sum of A[0] .. A[n - 1]. The result is the same for
+		any number of threads, though it may differ in the last bits from the
+		unchunked batchSum(A, n).
+	*/
+
+	if (n == 0)
+	{
+		return V();
+	};
+	return vectorsExecuteReduce<V>(policy, n, sizeof(V), [&](const size_t& first, const size_t& last) {
+		return batchSum(A + first, (last - first));
+	}, [](const V& a, const V& b) { return (a + b); });
+};
+template <typename Policy, typename V>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy, bool>::type batchBounds(const Policy& policy, const V* A, const size_t& n, V& lower, V& upper)
+{
+	/*
+		Finds the axis aligned bounding box of A[0] .. A[n - 1], see batchBounds().
+	*/
+
+	if (n == 0)
+	{
+		return false;
+	};
+	typedef typename VectorTraits<V>::ElementType T;
+	typedef std::pair<V, V> Box;
+	const Box box = vectorsExecuteReduce<Box>(policy, n, sizeof(V), [&](const size_t& first, const size_t& last) {
+		Box part;
+		batchBounds(A + first, (last - first), part.first, part.second);
+		return part;
+	}, [](const Box& a, const Box& b) {
+		Box merged;
+		for (uint64_t c = 0; c < VectorTraits<V>::dimensions; c++)
+		{
+			const T l = a.first.value[c];
+			const T h = a.second.value[c];
+			merged.first.value[c] = (b.first.value[c] < l) ? b.first.value[c] : l;
+			merged.second.value[c] = (b.second.value[c] > h) ? b.second.value[c] : h;
+		};
+		return merged;
+	});
+	lower = box.first;
+	upper = box.second;
+	return true;
+};
+
+/* Parallel Transforms */
+template <typename Policy, typename T>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy>::type transformPoints(const Policy& policy, const Matrix4<T>& M, const Vector3D<T>* A, Vector3D<T>* out, const size_t& n)
+{
+	vectorsExecute(policy, n, sizeof(Vector3D<T>), [&](const size_t& first, const size_t& last) {
+		transformPoints(M, A + first, out + first, (last - first));
+	});
+};
+template <typename Policy, typename T>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy>::type transformPoints(const Policy& policy, const Matrix4<T>& M, Vector3D<T>* A, const size_t& n)
+{
+	transformPoints(policy, M, (const Vector3D<T>*)A, A, n);
+};
+template <typename Policy, typename T>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy>::type transformDirections(const Policy& policy, const Matrix4<T>& M, const Vector3D<T>* A, Vector3D<T>* out, const size_t& n)
+{
+	vectorsExecute(policy, n, sizeof(Vector3D<T>), [&](const size_t& first, const size_t& last) {
+		transformDirections(M, A + first, out + first, (last - first));
+	});
+};
+template <typename Policy, typename T>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy>::type transformDirections(const Policy& policy, const Matrix4<T>& M, Vector3D<T>* A, const size_t& n)
+{
+	transformDirections(policy, M, (const Vector3D<T>*)A, A, n);
+};
+template <typename Policy, typename T>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy>::type transformVectors(const Policy& policy, const Matrix3<T>& M, const Vector3D<T>* A, Vector3D<T>* out, const size_t& n)
+{
+	vectorsExecute(policy, n, sizeof(Vector3D<T>), [&](const size_t& first, const size_t& last) {
+		transformVectors(M, A + first, out + first, (last - first));
+	});
+};
+template <typename Policy, typename T>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy>::type transformVectors(const Policy& policy, const Matrix3<T>& M, Vector3D<T>* A, const size_t& n)
+{
+	transformVectors(policy, M, (const Vector3D<T>*)A, A, n);
+};
+template <typename Policy, typename T>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy>::type transformVectors(const Policy& policy, const Matrix4<T>& M, const Vector4D<T>* A, Vector4D<T>* out, const size_t& n)
+{
+	vectorsExecute(policy, n, sizeof(Vector4D<T>), [&](const size_t& first, const size_t& last) {
+		transformVectors(M, A + first, out + first, (last - first));
+	});
+};
+template <typename Policy, typename T>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy>::type transformVectors(const Policy& policy, const Matrix4<T>& M, Vector4D<T>* A, const size_t& n)
+{
+	transformVectors(policy, M, (const Vector4D<T>*)A, A, n);
+};
+
+#if defined(__cpp_lib_span)
+/* Span Overloads */
+// The overloads taking several spans return false, doing nothing, unless they
+// are all the same size.
+template <typename Policy, typename SA, typename SB, typename SO, typename V = VectorsSpanElement<SA>>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy && VectorsSpanOf<SA, V>::value && VectorsSpanOf<SB, V>::value && VectorsSpanOf<SO, typename VectorTraits<V>::ElementType, true>::value, bool>::type batchDot(const Policy& policy, SA A, SB B, SO out)
+{
+	if ((B.size() != A.size()) || (out.size() != A.size()))
+	{
+		return false;
+	};
+	batchDot(policy, A.data(), B.data(), out.data(), A.size());
+	return true;
+};
+template <typename Policy, typename SA, typename SO, typename V = VectorsSpanElement<SA>>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy && VectorsSpanOf<SA, V>::value && VectorsSpanOf<SO, typename VectorTraits<V>::ElementType, true>::value, bool>::type batchNorm(const Policy& policy, SA A, SO out)
+{
+	if (out.size() != A.size())
+	{
+		return false;
+	};
+	batchNorm(policy, A.data(), out.data(), A.size());
+	return true;
+};
+template <typename Policy, typename SA, typename V = VectorsSpanElement<SA>>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy && VectorsSpanOf<SA, V, true>::value && VectorTraits<V>::isVector>::type batchNormalize(const Policy& policy, SA A)
+{
+	batchNormalize(policy, A.data(), A.size());
+};
+template <typename Policy, typename SA, typename SB, typename SO, typename V = VectorsSpanElement<SA>>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy && VectorsSpanOf<SA, V>::value && VectorsSpanOf<SB, V>::value && VectorsSpanOf<SO, V, true>::value && (VectorTraits<V>::dimensions == 3), bool>::type batchCross(const Policy& policy, SA A, SB B, SO out)
+{
+	if ((B.size() != A.size()) || (out.size() != A.size()))
+	{
+		return false;
+	};
+	batchCross(policy, A.data(), B.data(), out.data(), A.size());
+	return true;
+};
+template <typename Policy, typename SX, typename SY, typename V = VectorsSpanElement<SX>>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy && VectorsSpanOf<SX, V>::value && VectorsSpanOf<SY, V, true>::value, bool>::type batchAxpy(const Policy& policy, const typename VectorTraits<V>::ElementType& a, SX X, SY Y)
+{
+	if (Y.size() != X.size())
+	{
+		return false;
+	};
+	batchAxpy(policy, a, X.data(), Y.data(), X.size());
+	return true;
+};
+template <typename Policy, typename SA, typename V = VectorsSpanElement<SA>>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy && VectorsSpanOf<SA, V>::value && VectorTraits<V>::isVector, V>::type batchSum(const Policy& policy, SA A)
+{
+	return batchSum(policy, A.data(), A.size());
+};
+template <typename Policy, typename SA, typename V = VectorsSpanElement<SA>>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy && VectorsSpanOf<SA, V>::value && VectorTraits<V>::isVector, bool>::type batchBounds(const Policy& policy, SA A, V& lower, V& upper)
+{
+	return batchBounds(policy, A.data(), A.size(), lower, upper);
+};
+template <typename Policy, typename T, typename SA, typename SO>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy && VectorsSpanOf<SA, Vector3D<T>>::value && VectorsSpanOf<SO, Vector3D<T>, true>::value, bool>::type transformPoints(const Policy& policy, const Matrix4<T>& M, SA A, SO out)
+{
+	if (out.size() != A.size())
+	{
+		return false;
+	};
+	transformPoints(policy, M, A.data(), out.data(), A.size());
+	return true;
+};
+template <typename Policy, typename T, typename SA>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy && VectorsSpanOf<SA, Vector3D<T>, true>::value>::type transformPoints(const Policy& policy, const Matrix4<T>& M, SA A)
+{
+	transformPoints(policy, M, A.data(), A.size());
+};
+template <typename Policy, typename T, typename SA, typename SO>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy && VectorsSpanOf<SA, Vector3D<T>>::value && VectorsSpanOf<SO, Vector3D<T>, true>::value, bool>::type transformDirections(const Policy& policy, const Matrix4<T>& M, SA A, SO out)
+{
+	if (out.size() != A.size())
+	{
+		return false;
+	};
+	transformDirections(policy, M, A.data(), out.data(), A.size());
+	return true;
+};
+template <typename Policy, typename T, typename SA>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy && VectorsSpanOf<SA, Vector3D<T>, true>::value>::type transformDirections(const Policy& policy, const Matrix4<T>& M, SA A)
+{
+	transformDirections(policy, M, A.data(), A.size());
+};
+template <typename Policy, typename T, typename SA, typename SO>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy && VectorsSpanOf<SA, Vector3D<T>>::value && VectorsSpanOf<SO, Vector3D<T>, true>::value, bool>::type transformVectors(const Policy& policy, const Matrix3<T>& M, SA A, SO out)
+{
+	if (out.size() != A.size())
+	{
+		return false;
+	};
+	transformVectors(policy, M, A.data(), out.data(), A.size());
+	return true;
+};
+template <typename Policy, typename T, typename SA>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy && VectorsSpanOf<SA, Vector3D<T>, true>::value>::type transformVectors(const Policy& policy, const Matrix3<T>& M, SA A)
+{
+	transformVectors(policy, M, A.data(), A.size());
+};
+template <typename Policy, typename T, typename SA, typename SO>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy && VectorsSpanOf<SA, Vector4D<T>>::value && VectorsSpanOf<SO, Vector4D<T>, true>::value, bool>::type transformVectors(const Policy& policy, const Matrix4<T>& M, SA A, SO out)
+{
+	if (out.size() != A.size())
+	{
+		return false;
+	};
+	transformVectors(policy, M, A.data(), out.data(), A.size());
+	return true;
+};
+template <typename Policy, typename T, typename SA>
+inline typename std::enable_if<VectorsExecutionTraits<Policy>::isPolicy && VectorsSpanOf<SA, Vector4D<T>, true>::value>::type transformVectors(const Policy& policy, const Matrix4<T>& M, SA A)
+{
+	transformVectors(policy, M, A.data(), A.size());
+};
+#endif
+
+#endif
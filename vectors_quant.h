@@ -0,0 +1,1057 @@
+#pragma once
+/*
+	# Vector Template Library - Quantization
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	Reduced precision storage for large collections of vectors, such as
+	embeddings, so more of them fit in memory and cache:
+
+		* half and bfloat16, 16 bit floating point element types for Vector<N,T>.
+		  They convert to and from float implicitly and do their arithmetic in
+		  float, so Vector<N,half> supports everything Vector<N,float> does at
+		  half the size.
+		* QuantizedVector<N>, a float vector stored as N signed bytes with a scale
+		  and offset for the whole vector, about a quarter of the size.
+
+	Dot products and distances on these work directly on the compressed form.
+	The elements are widened to float (or 16 bit integers for the bytes) a
+	register at a time and accumulated at full precision; the kernels are
+	compiled for each instruction set and dispatched at runtime like the batch
+	operations (see vectors_batch.h), and use AVX-512 VNNI for the byte dot
+	products where the CPU has it:
+
+		QuantizedVector<128> stored(embedding);
+		const float score = stored.dot(query);
+		const float similarity = wideDot(halfA, halfB);
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+#ifndef VECTOR_TEMPLATE_LIBRARY_QUANT__H
+#define VECTOR_TEMPLATE_LIBRARY_QUANT__H
+/* Deps */
+#include "vectors.h"
+#include "vectors_batch.h"
+#include "vectors_io.h"
+#include <stdint.h>
+#include <string.h>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+/* Conversions */
+inline uint32_t vectorsFloatBits(const float& value)
+{
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return bits;
+};
+inline float vectorsBitsFloat(const uint32_t& bits)
+{
+	float value;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+};
+
+inline uint16_t vectorsFloatToHalf(const float& value)
+{
+	/*
+		Rounds a float to the nearest IEEE 754 binary16 value, ties to even. Values
+		too large for a half become infinity and NaNs stay NaN.
+	*/
+
+#if defined(__F16C__)
+	return (uint16_t)_cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT);
+#else
+	uint32_t bits = vectorsFloatBits(value);
+	const uint16_t sign = (uint16_t)((bits >> 16) & 0x8000);
+	bits &= 0x7FFFFFFF;
+
+	if (bits >= 0x7F800000)
+	{
+		// Infinity, or NaN kept quiet
+		return (uint16_t)(sign | 0x7C00 | ((bits > 0x7F800000) ? 0x0200 : 0));
+	};
+	if (bits >= 0x477FF000)
+	{
+		// Rounds past the largest half, 65504
+		return (uint16_t)(sign | 0x7C00);
+	};
+	if (bits < 0x38800000)
+	{
+		// Subnormal or zero: adding 0.5 lines the half's last bit up with the
+		// float's, so the hardware does the rounding.
+		const float shifted = vectorsBitsFloat(bits) + 0.5f;
+		return (uint16_t)(sign | (uint16_t)(vectorsFloatBits(shifted) - 0x3F000000));
+	};
+
+	// Normal: rebias the exponent and round the mantissa to 10 bits
+	const uint32_t odd = ((bits >> 13) & 1);
+	bits += 0xC8000FFF;
+	bits += odd;
+	return (uint16_t)(sign | (uint16_t)(bits >> 13));
+#endif
+};
+inline float vectorsHalfToFloat(const uint16_t& value)
+{
+	/*
+		Widens a binary16 value to float, which is exact.
+	*/
+
+#if defined(__F16C__)
+	return _cvtsh_ss(value);
+#else
+	const uint32_t sign = ((uint32_t)(value & 0x8000) << 16);
+	const uint32_t exponent = ((value >> 10) & 0x1F);
+	const uint32_t mantissa = (value & 0x3FF);
+
+	if (exponent == 0x1F)
+	{
+		return vectorsBitsFloat(sign | 0x7F800000 | (mantissa << 13));
+	};
+	if (exponent == 0)
+	{
+		// Zero or subnormal: mantissa * 2^-24
+		return vectorsBitsFloat(sign | vectorsFloatBits((float)mantissa * 5.9604644775390625e-8f));
+	};
+	return vectorsBitsFloat(sign | ((exponent + 112) << 23) | (mantissa << 13));
+#endif
+};
+
+inline uint16_t vectorsFloatToBFloat16(const float& value)
+{
+	/*
+		Rounds a float to the nearest bfloat16 (the top 16 bits of a float), ties to
+		even. NaNs stay NaN.
+	*/
+
+	const uint32_t bits = vectorsFloatBits(value);
+	if ((bits & 0x7FFFFFFF) > 0x7F800000)
+	{
+		return (uint16_t)((bits >> 16) | 0x0040);
+	};
+	return (uint16_t)((bits + 0x7FFF + ((bits >> 16) & 1)) >> 16);
+};
+inline float vectorsBFloat16ToFloat(const uint16_t& value)
+{
+	return vectorsBitsFloat((uint32_t)value << 16);
+};
+
+/* Formats */
+struct VectorsHalfFormat
+{
+	/*
+		# Vectors Half Format (struct)
+		IEEE 754 binary16: 1 sign, 5 exponent and 10 mantissa bits. About 3 decimal
+		digits over +-65504.
+	*/
+
+	static constexpr VectorElementCode code = VECTOR_ELEMENT_FLOAT16;
+
+	static constexpr int digits = 11;
+	static constexpr int digits10 = 3;
+	static constexpr int maxDigits10 = 5;
+	static constexpr int minExponent = -13;
+	static constexpr int minExponent10 = -4;
+	static constexpr int maxExponent = 16;
+	static constexpr int maxExponent10 = 4;
+
+	static constexpr uint16_t minBits = 0x0400;
+	static constexpr uint16_t maxBits = 0x7BFF;
+	static constexpr uint16_t epsilonBits = 0x1400;
+	static constexpr uint16_t roundErrorBits = 0x3800;
+	static constexpr uint16_t infinityBits = 0x7C00;
+	static constexpr uint16_t quietNaNBits = 0x7E00;
+	static constexpr uint16_t signalingNaNBits = 0x7D00;
+
+	static inline uint16_t encode(const float& value) { return vectorsFloatToHalf(value); };
+	static inline float decode(const uint16_t& bits) { return vectorsHalfToFloat(bits); };
+};
+struct VectorsBFloat16Format
+{
+	/*
+		# Vectors BFloat16 Format (struct)
+		The top half of a float: 1 sign, 8 exponent and 7 mantissa bits. The same
+		range as float with about 2 decimal digits.
+	*/
+
+	static constexpr VectorElementCode code = VECTOR_ELEMENT_BFLOAT16;
+
+	static constexpr int digits = 8;
+	static constexpr int digits10 = 2;
+	static constexpr int maxDigits10 = 4;
+	static constexpr int minExponent = -125;
+	static constexpr int minExponent10 = -37;
+	static constexpr int maxExponent = 128;
+	static constexpr int maxExponent10 = 38;
+
+	static constexpr uint16_t minBits = 0x0080;
+	static constexpr uint16_t maxBits = 0x7F7F;
+	static constexpr uint16_t epsilonBits = 0x3C00;
+	static constexpr uint16_t roundErrorBits = 0x3F00;
+	static constexpr uint16_t infinityBits = 0x7F80;
+	static constexpr uint16_t quietNaNBits = 0x7FC0;
+	static constexpr uint16_t signalingNaNBits = 0x7FA0;
+
+	static inline uint16_t encode(const float& value) { return vectorsFloatToBFloat16(value); };
+	static inline float decode(const uint16_t& bits) { return vectorsBFloat16ToFloat(bits); };
+};
+
+/* Types */
+struct VectorsFloat16Bits {};
+
+template <typename Format>
+struct VectorsFloat16
+{
+	/*
+		# Vectors Float16 (struct)
+		A 16 bit floating point number in the given format, see half and bfloat16.
+		It is a storage type: values convert to float implicitly, arithmetic is
+		done in float, and results are rounded back on assignment.
+	*/
+
+	/* Elements */
+	uint16_t bits;
+
+	/* Methods */
+
+	// Constructors & Destructor
+	VectorsFloat16() = default;
+	VectorsFloat16(const float& value) : bits(Format::encode(value)) {};
+	constexpr VectorsFloat16(const uint16_t& bits, VectorsFloat16Bits) : bits(bits) {};
+
+	static constexpr VectorsFloat16<Format> fromBits(const uint16_t& bits)
+	{
+		return VectorsFloat16<Format>(bits, VectorsFloat16Bits());
+	};
+
+	// Conversion Operators
+	inline operator float() const
+	{
+		return Format::decode(this->bits);
+	};
+
+	// Unary Operators
+	constexpr VectorsFloat16<Format> operator+() const
+	{
+		return (*this);
+	};
+	constexpr VectorsFloat16<Format> operator-() const
+	{
+		return fromBits((uint16_t)(this->bits ^ 0x8000));
+	};
+
+	// Binary Assignment Operators
+	template <typename U>
+	inline VectorsFloat16<Format>& operator+=(const U& B)
+	{
+		(*this) = VectorsFloat16<Format>((float)(*this) + (float)B);
+		return (*this);
+	};
+	template <typename U>
+	inline VectorsFloat16<Format>& operator-=(const U& B)
+	{
+		(*this) = VectorsFloat16<Format>((float)(*this) - (float)B);
+		return (*this);
+	};
+	template <typename U>
+	inline VectorsFloat16<Format>& operator*=(const U& B)
+	{
+		(*this) = VectorsFloat16<Format>((float)(*this) * (float)B);
+		return (*this);
+	};
+	template <typename U>
+	inline VectorsFloat16<Format>& operator/=(const U& B)
+	{
+		(*this) = VectorsFloat16<Format>((float)(*this) / (float)B);
+		return (*this);
+	};
+};
+
+typedef VectorsFloat16<VectorsHalfFormat> half;
+typedef VectorsFloat16<VectorsBFloat16Format> bfloat16;
+
+/*
+	Operators between two 16 bit values give a 16 bit value, and operators with any
+	other arithmetic type are done in float (or wider) and give that type, so
+	mixed expressions are never ambiguous.
+*/
+#define VECTORS_FLOAT16_ARITHMETIC(op) \
+	template <typename F> \
+	inline VectorsFloat16<F> operator op(const VectorsFloat16<F>& A, const VectorsFloat16<F>& B) { return VectorsFloat16<F>((float)A op (float)B); }; \
+	template <typename F, typename U, typename = typename std::enable_if<std::is_arithmetic<U>::value>::type> \
+	inline auto operator op(const VectorsFloat16<F>& A, const U& B) -> decltype((float)A op B) { return ((float)A op B); }; \
+	template <typename F, typename U, typename = typename std::enable_if<std::is_arithmetic<U>::value>::type> \
+	inline auto operator op(const U& A, const VectorsFloat16<F>& B) -> decltype(A op (float)B) { return (A op (float)B); };
+#define VECTORS_FLOAT16_COMPARISON(op) \
+	template <typename F> \
+	inline bool operator op(const VectorsFloat16<F>& A, const VectorsFloat16<F>& B) { return ((float)A op (float)B); }; \
+	template <typename F, typename U, typename = typename std::enable_if<std::is_arithmetic<U>::value>::type> \
+	inline bool operator op(const VectorsFloat16<F>& A, const U& B) { return ((float)A op B); }; \
+	template <typename F, typename U, typename = typename std::enable_if<std::is_arithmetic<U>::value>::type> \
+	inline bool operator op(const U& A, const VectorsFloat16<F>& B) { return (A op (float)B); };
+
+VECTORS_FLOAT16_ARITHMETIC(+)
+VECTORS_FLOAT16_ARITHMETIC(-)
+VECTORS_FLOAT16_ARITHMETIC(*)
+VECTORS_FLOAT16_ARITHMETIC(/)
+VECTORS_FLOAT16_COMPARISON(==)
+VECTORS_FLOAT16_COMPARISON(!=)
+VECTORS_FLOAT16_COMPARISON(<)
+VECTORS_FLOAT16_COMPARISON(<=)
+VECTORS_FLOAT16_COMPARISON(>)
+VECTORS_FLOAT16_COMPARISON(>=)
+
+#undef VECTORS_FLOAT16_ARITHMETIC
+#undef VECTORS_FLOAT16_COMPARISON
+
+/* Traits */
+template <typename Format>
+class std::numeric_limits<VectorsFloat16<Format>>
+{
+public:
+	typedef VectorsFloat16<Format> T;
+
+	static constexpr bool is_specialized = true;
+	static constexpr bool is_signed = true;
+	static constexpr bool is_integer = false;
+	static constexpr bool is_exact = false;
+	static constexpr bool has_infinity = true;
+	static constexpr bool has_quiet_NaN = true;
+	static constexpr bool has_signaling_NaN = true;
+	static constexpr std::float_denorm_style has_denorm = std::denorm_present;
+	static constexpr bool has_denorm_loss = false;
+	static constexpr std::float_round_style round_style = std::round_to_nearest;
+	static constexpr bool is_iec559 = std::is_same<Format, VectorsHalfFormat>::value;
+	static constexpr bool is_bounded = true;
+	static constexpr bool is_modulo = false;
+	static constexpr int digits = Format::digits;
+	static constexpr int digits10 = Format::digits10;
+	static constexpr int max_digits10 = Format::maxDigits10;
+	static constexpr int radix = 2;
+	static constexpr int min_exponent = Format::minExponent;
+	static constexpr int min_exponent10 = Format::minExponent10;
+	static constexpr int max_exponent = Format::maxExponent;
+	static constexpr int max_exponent10 = Format::maxExponent10;
+	static constexpr bool traps = false;
+	static constexpr bool tinyness_before = false;
+
+	static constexpr T min() noexcept { return T::fromBits(Format::minBits); };
+	static constexpr T lowest() noexcept { return T::fromBits((uint16_t)(Format::maxBits | 0x8000)); };
+	static constexpr T max() noexcept { return T::fromBits(Format::maxBits); };
+	static constexpr T epsilon() noexcept { return T::fromBits(Format::epsilonBits); };
+	static constexpr T round_error() noexcept { return T::fromBits(Format::roundErrorBits); };
+	static constexpr T infinity() noexcept { return T::fromBits(Format::infinityBits); };
+	static constexpr T quiet_NaN() noexcept { return T::fromBits(Format::quietNaNBits); };
+	static constexpr T signaling_NaN() noexcept { return T::fromBits(Format::signalingNaNBits); };
+	static constexpr T denorm_min() noexcept { return T::fromBits(0x0001); };
+};
+
+template <typename Format>
+struct VectorElementType<VectorsFloat16<Format>>
+{
+	static constexpr VectorElementCode code = Format::code;
+};
+
+/* Serialization */
+template <typename Format>
+inline char* vectorsFormatElement(char* first, char* last, const VectorsFloat16<Format>& value)
+{
+	/*
+		Writes the fewest significant digits which read back as exactly value, found
+		by trying each precision in turn.
+	*/
+
+	const float f = (float)value;
+	char buffer[32];
+	size_t length = 0;
+	for (int precision = 1; precision <= Format::maxDigits10; precision++)
+	{
+#if defined(__cpp_lib_to_chars)
+		length = (size_t)(std::to_chars(buffer, buffer + sizeof(buffer), f, std::chars_format::general, precision).ptr - buffer);
+#else
+		length = (size_t)snprintf(buffer, sizeof(buffer), "%.*g", precision, (double)f);
+#endif
+		float parsed = 0.0f;
+		if ((vectorsParseElement(buffer, buffer + length, parsed) != nullptr) && (VectorsFloat16<Format>(parsed).bits == value.bits))
+		{
+			break;
+		};
+	};
+	if (length > (size_t)(last - first))
+	{
+		return nullptr;
+	};
+	memcpy(first, buffer, length);
+	return (first + length);
+};
+template <typename Format>
+inline const char* vectorsParseElement(const char* first, const char* last, VectorsFloat16<Format>& value)
+{
+	float parsed = 0.0f;
+	const char* end = vectorsParseElement(first, last, parsed);
+	if (end != nullptr)
+	{
+		value = VectorsFloat16<Format>(parsed);
+	};
+	return end;
+};
+
+/* Packets */
+/*
+	Vector<N,half> and Vector<N,bfloat16> use VectorBlockKernels like float does:
+	a packet loads a register's worth of 16 bit elements widened to float, does
+	float arithmetic, and rounds back when stored.
+*/
+#if VECTORS_AVX && defined(__F16C__)
+template <>
+struct VectorPacket<half>
+{
+	typedef __m256 Type;
+	static constexpr size_t width = 8;
+	static inline Type load(const half* A) { return _mm256_cvtph_ps(_mm_load_si128((const __m128i*)A)); };
+	static inline Type loadUnaligned(const half* A) { return _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)A)); };
+	static inline void store(half* C, const Type v) { _mm_store_si128((__m128i*)C, _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT)); };
+	static inline void storeUnaligned(half* C, const Type v) { _mm_storeu_si128((__m128i*)C, _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT)); };
+	static inline Type set(const half& A) { return _mm256_set1_ps((float)A); };
+	static inline Type zero() { return _mm256_setzero_ps(); };
+	static inline Type add(const Type A, const Type B) { return _mm256_add_ps(A, B); };
+	static inline Type sub(const Type A, const Type B) { return _mm256_sub_ps(A, B); };
+	static inline Type mul(const Type A, const Type B) { return _mm256_mul_ps(A, B); };
+	static inline Type div(const Type A, const Type B) { return _mm256_div_ps(A, B); };
+	static inline Type negate(const Type A) { return _mm256_xor_ps(A, _mm256_set1_ps(-0.0f)); };
+	static inline Type multiplyAdd(const Type A, const Type B, const Type C) { return _mm256_add_ps(_mm256_mul_ps(A, B), C); };
+	static inline bool equal(const Type A, const Type B) { return vectorsPacketEqual(A, B); };
+	static inline half sum(const Type v) { return half(vectorsPacketSum(v)); };
+};
+#endif
+
+#if VECTORS_SSE
+inline __m128 vectorsWidenBFloat16(const __m128i v)
+{
+	return _mm_castsi128_ps(_mm_unpacklo_epi16(_mm_setzero_si128(), v));
+};
+inline __m128i vectorsNarrowBFloat16(const __m128 v)
+{
+	/*
+		Rounds four floats to bfloat16 in the low half of the result, ties to even
+		and keeping NaNs quiet as in vectorsFloatToBFloat16(). The arithmetic shift
+		leaves each result sign extended, so the saturating pack keeps it intact.
+	*/
+
+	const __m128i bits = _mm_castps_si128(v);
+	const __m128i odd = _mm_and_si128(_mm_srli_epi32(bits, 16), _mm_set1_epi32(1));
+	const __m128i rounded = _mm_add_epi32(bits, _mm_add_epi32(_mm_set1_epi32(0x7FFF), odd));
+	const __m128i nan = _mm_castps_si128(_mm_cmpunord_ps(v, v));
+	const __m128i result = _mm_or_si128(
+		_mm_andnot_si128(nan, rounded),
+		_mm_and_si128(nan, _mm_or_si128(bits, _mm_set1_epi32(0x00400000)))
+	);
+	return _mm_packs_epi32(_mm_srai_epi32(result, 16), _mm_setzero_si128());
+};
+
+template <>
+struct VectorPacket<bfloat16>
+{
+	typedef __m128 Type;
+	static constexpr size_t width = 4;
+	static inline Type load(const bfloat16* A) { return vectorsWidenBFloat16(_mm_loadl_epi64((const __m128i*)A)); };
+	static inline Type loadUnaligned(const bfloat16* A) { return load(A); };
+	static inline void store(bfloat16* C, const Type v) { _mm_storel_epi64((__m128i*)C, vectorsNarrowBFloat16(v)); };
+	static inline void storeUnaligned(bfloat16* C, const Type v) { store(C, v); };
+	static inline Type set(const bfloat16& A) { return _mm_set1_ps((float)A); };
+	static inline Type zero() { return _mm_setzero_ps(); };
+	static inline Type add(const Type A, const Type B) { return _mm_add_ps(A, B); };
+	static inline Type sub(const Type A, const Type B) { return _mm_sub_ps(A, B); };
+	static inline Type mul(const Type A, const Type B) { return _mm_mul_ps(A, B); };
+	static inline Type div(const Type A, const Type B) { return _mm_div_ps(A, B); };
+	static inline Type negate(const Type A) { return _mm_xor_ps(A, _mm_set1_ps(-0.0f)); };
+	static inline Type multiplyAdd(const Type A, const Type B, const Type C) { return _mm_add_ps(_mm_mul_ps(A, B), C); };
+	static inline bool equal(const Type A, const Type B) { return vectorsPacketEqual(A, B); };
+	static inline bfloat16 sum(const Type v) { return bfloat16(vectorsPacketSum(v)); };
+};
+#endif
+
+/* Math Helpers */
+template <int ISA>
+struct VectorQuantMath
+{
+	/*
+		# Vector Quant Math (struct)
+		Dot products and squared distances over n compressed elements, accumulated
+		in float (or int32 for bytes). The generic form keeps a separate sum per
+		lane so the compiler can vectorize it; the AVX2 and AVX-512 forms widen a
+		register of elements at a time with intrinsics.
+
+		The byte forms taking a scale and offset compare a quantized vector with a
+		float one, dequantizing each element (offset + scale * A[i]) on the fly.
+	*/
+
+	template <typename E>
+	static VECTORS_ALWAYS_INLINE float dot(const E* A, const E* B, const size_t& n)
+	{
+		float sums[8] = {};
+		const size_t chunks = ((n / 8) * 8);
+		for (size_t c = 0; c < chunks; c += 8)
+		{
+			for (size_t l = 0; l < 8; l++)
+			{
+				sums[l] += ((float)A[c + l] * (float)B[c + l]);
+			};
+		};
+		float value = 0.0f;
+		for (size_t l = 0; l < 8; l++)
+		{
+			value += sums[l];
+		};
+		for (size_t c = chunks; c < n; c++)
+		{
+			value += ((float)A[c] * (float)B[c]);
+		};
+		return value;
+	};
+	template <typename E>
+	static VECTORS_ALWAYS_INLINE float squaredDistance(const E* A, const E* B, const size_t& n)
+	{
+		float sums[8] = {};
+		const size_t chunks = ((n / 8) * 8);
+		for (size_t c = 0; c < chunks; c += 8)
+		{
+			for (size_t l = 0; l < 8; l++)
+			{
+				const float d = ((float)A[c + l] - (float)B[c + l]);
+				sums[l] += (d * d);
+			};
+		};
+		float value = 0.0f;
+		for (size_t l = 0; l < 8; l++)
+		{
+			value += sums[l];
+		};
+		for (size_t c = chunks; c < n; c++)
+		{
+			const float d = ((float)A[c] - (float)B[c]);
+			value += (d * d);
+		};
+		return value;
+	};
+
+	static VECTORS_ALWAYS_INLINE int32_t dot(const int8_t* A, const int8_t* B, const size_t& n)
+	{
+		int32_t value = 0;
+		for (size_t c = 0; c < n; c++)
+		{
+			value += ((int32_t)A[c] * (int32_t)B[c]);
+		};
+		return value;
+	};
+	static VECTORS_ALWAYS_INLINE float dot(const int8_t* A, const float& scale, const float& offset, const float* B, const size_t& n)
+	{
+		float sums[8] = {};
+		const size_t chunks = ((n / 8) * 8);
+		for (size_t c = 0; c < chunks; c += 8)
+		{
+			for (size_t l = 0; l < 8; l++)
+			{
+				sums[l] += ((offset + (scale * (float)A[c + l])) * B[c + l]);
+			};
+		};
+		float value = 0.0f;
+		for (size_t l = 0; l < 8; l++)
+		{
+			value += sums[l];
+		};
+		for (size_t c = chunks; c < n; c++)
+		{
+			value += ((offset + (scale * (float)A[c])) * B[c]);
+		};
+		return value;
+	};
+	static VECTORS_ALWAYS_INLINE float squaredDistance(const int8_t* A, const float& scale, const float& offset, const float* B, const size_t& n)
+	{
+		float sums[8] = {};
+		const size_t chunks = ((n / 8) * 8);
+		for (size_t c = 0; c < chunks; c += 8)
+		{
+			for (size_t l = 0; l < 8; l++)
+			{
+				const float d = ((offset + (scale * (float)A[c + l])) - B[c + l]);
+				sums[l] += (d * d);
+			};
+		};
+		float value = 0.0f;
+		for (size_t l = 0; l < 8; l++)
+		{
+			value += sums[l];
+		};
+		for (size_t c = chunks; c < n; c++)
+		{
+			const float d = ((offset + (scale * (float)A[c])) - B[c]);
+			value += (d * d);
+		};
+		return value;
+	};
+};
+
+#if VECTORS_DISPATCH
+VECTORS_TARGET_AVX2 inline __m256 vectorsWiden(const half* A)
+{
+	return _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)A));
+};
+VECTORS_TARGET_AVX2 inline __m256 vectorsWiden(const bfloat16* A)
+{
+	return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)A)), 16));
+};
+VECTORS_TARGET_AVX2 inline __m256 vectorsWiden(const int8_t* A)
+{
+	return _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i*)A)));
+};
+
+template <>
+struct VectorQuantMath<VECTORS_ISA_AVX2>
+{
+	template <typename E>
+	VECTORS_TARGET_AVX2 static inline float dot(const E* A, const E* B, const size_t& n)
+	{
+		__m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps();
+		size_t c = 0;
+		for (; (c + 16) <= n; c += 16)
+		{
+			s0 = _mm256_fmadd_ps(vectorsWiden(A + c), vectorsWiden(B + c), s0);
+			s1 = _mm256_fmadd_ps(vectorsWiden(A + c + 8), vectorsWiden(B + c + 8), s1);
+		};
+		for (; (c + 8) <= n; c += 8)
+		{
+			s0 = _mm256_fmadd_ps(vectorsWiden(A + c), vectorsWiden(B + c), s0);
+		};
+		float value = vectorsReduceAdd(_mm256_add_ps(s0, s1));
+		for (; c < n; c++)
+		{
+			value += ((float)A[c] * (float)B[c]);
+		};
+		return value;
+	};
+	template <typename E>
+	VECTORS_TARGET_AVX2 static inline float squaredDistance(const E* A, const E* B, const size_t& n)
+	{
+		__m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps();
+		size_t c = 0;
+		for (; (c + 16) <= n; c += 16)
+		{
+			const __m256 d0 = _mm256_sub_ps(vectorsWiden(A + c), vectorsWiden(B + c));
+			const __m256 d1 = _mm256_sub_ps(vectorsWiden(A + c + 8), vectorsWiden(B + c + 8));
+			s0 = _mm256_fmadd_ps(d0, d0, s0);
+			s1 = _mm256_fmadd_ps(d1, d1, s1);
+		};
+		for (; (c + 8) <= n; c += 8)
+		{
+			const __m256 d = _mm256_sub_ps(vectorsWiden(A + c), vectorsWiden(B + c));
+			s0 = _mm256_fmadd_ps(d, d, s0);
+		};
+		float value = vectorsReduceAdd(_mm256_add_ps(s0, s1));
+		for (; c < n; c++)
+		{
+			const float d = ((float)A[c] - (float)B[c]);
+			value += (d * d);
+		};
+		return value;
+	};
+
+	VECTORS_TARGET_AVX2 static inline int32_t dot(const int8_t* A, const int8_t* B, const size_t& n)
+	{
+		/*
+			Bytes are sign extended to 16 bits so pairs of products can be summed
+			exactly into 32 bit lanes by madd.
+		*/
+
+		__m256i s0 = _mm256_setzero_si256(), s1 = _mm256_setzero_si256();
+		size_t c = 0;
+		for (; (c + 32) <= n; c += 32)
+		{
+			const __m256i a0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(A + c)));
+			const __m256i b0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(B + c)));
+			const __m256i a1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(A + c + 16)));
+			const __m256i b1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(B + c + 16)));
+			s0 = _mm256_add_epi32(s0, _mm256_madd_epi16(a0, b0));
+			s1 = _mm256_add_epi32(s1, _mm256_madd_epi16(a1, b1));
+		};
+		for (; (c + 16) <= n; c += 16)
+		{
+			const __m256i a = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(A + c)));
+			const __m256i b = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(B + c)));
+			s0 = _mm256_add_epi32(s0, _mm256_madd_epi16(a, b));
+		};
+		int32_t value = vectorsReduceAdd(_mm256_add_epi32(s0, s1));
+		for (; c < n; c++)
+		{
+			value += ((int32_t)A[c] * (int32_t)B[c]);
+		};
+		return value;
+	};
+	VECTORS_TARGET_AVX2 static inline float dot(const int8_t* A, const float& scale, const float& offset, const float* B, const size_t& n)
+	{
+		const __m256 s = _mm256_set1_ps(scale);
+		const __m256 o = _mm256_set1_ps(offset);
+		__m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps();
+		size_t c = 0;
+		for (; (c + 16) <= n; c += 16)
+		{
+			s0 = _mm256_fmadd_ps(_mm256_fmadd_ps(vectorsWiden(A + c), s, o), _mm256_loadu_ps(B + c), s0);
+			s1 = _mm256_fmadd_ps(_mm256_fmadd_ps(vectorsWiden(A + c + 8), s, o), _mm256_loadu_ps(B + c + 8), s1);
+		};
+		for (; (c + 8) <= n; c += 8)
+		{
+			s0 = _mm256_fmadd_ps(_mm256_fmadd_ps(vectorsWiden(A + c), s, o), _mm256_loadu_ps(B + c), s0);
+		};
+		float value = vectorsReduceAdd(_mm256_add_ps(s0, s1));
+		for (; c < n; c++)
+		{
+			value += ((offset + (scale * (float)A[c])) * B[c]);
+		};
+		return value;
+	};
+	VECTORS_TARGET_AVX2 static inline float squaredDistance(const int8_t* A, const float& scale, const float& offset, const float* B, const size_t& n)
+	{
+		const __m256 s = _mm256_set1_ps(scale);
+		const __m256 o = _mm256_set1_ps(offset);
+		__m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps();
+		size_t c = 0;
+		for (; (c + 16) <= n; c += 16)
+		{
+			const __m256 d0 = _mm256_sub_ps(_mm256_fmadd_ps(vectorsWiden(A + c), s, o), _mm256_loadu_ps(B + c));
+			const __m256 d1 = _mm256_sub_ps(_mm256_fmadd_ps(vectorsWiden(A + c + 8), s, o), _mm256_loadu_ps(B + c + 8));
+			s0 = _mm256_fmadd_ps(d0, d0, s0);
+			s1 = _mm256_fmadd_ps(d1, d1, s1);
+		};
+		for (; (c + 8) <= n; c += 8)
+		{
+			const __m256 d = _mm256_sub_ps(_mm256_fmadd_ps(vectorsWiden(A + c), s, o), _mm256_loadu_ps(B + c));
+			s0 = _mm256_fmadd_ps(d, d, s0);
+		};
+		float value = vectorsReduceAdd(_mm256_add_ps(s0, s1));
+		for (; c < n; c++)
+		{
+			const float d = ((offset + (scale * (float)A[c])) - B[c]);
+			value += (d * d);
+		};
+		return value;
+	};
+};
+
+#define VECTORS_TARGET_AVX512_VNNI __attribute__((target("avx512f,avx512bw,avx512vnni,avx512vl,avx512dq,avx2,fma,f16c")))
+
+inline bool vectorsHasVNNI()
+{
+	/*
+		Whether the CPU has the AVX-512 byte dot product instructions. They are
+		only used on the AVX-512 path, so vectorsForceISA() still turns them off.
+	*/
+
+	static const bool supported = []() {
+		__builtin_cpu_init();
+		return (__builtin_cpu_supports("avx512vnni") && __builtin_cpu_supports("avx512bw"));
+	}();
+	return supported;
+};
+
+VECTORS_TARGET_AVX512 inline __m512 vectorsWiden16(const half* A)
+{
+	// Masked with all lanes set, see vectorsReduceAdd()
+	return _mm512_maskz_cvtph_ps((__mmask16)0xFFFF, _mm256_loadu_si256((const __m256i*)A));
+};
+VECTORS_TARGET_AVX512 inline __m512 vectorsWiden16(const bfloat16* A)
+{
+	return _mm512_castsi512_ps(_mm512_maskz_slli_epi32((__mmask16)0xFFFF, _mm512_maskz_cvtepu16_epi32((__mmask16)0xFFFF, _mm256_loadu_si256((const __m256i*)A)), 16));
+};
+VECTORS_TARGET_AVX512 inline __m512 vectorsWiden16(const int8_t* A)
+{
+	return _mm512_maskz_cvtepi32_ps((__mmask16)0xFFFF, _mm512_maskz_cvtepi8_epi32((__mmask16)0xFFFF, _mm_loadu_si128((const __m128i*)A)));
+};
+
+VECTORS_TARGET_AVX512_VNNI inline int32_t vectorsDotVNNI(const int8_t* A, const int8_t* B, const size_t& n)
+{
+	/*
+		vpdpbusd multiplies unsigned bytes by signed ones, so A is biased by 128
+		(flipping its top bit) and 128 times the sum of B, counted with a second
+		vpdpbusd against ones, is taken off at the end. The remainder is read with
+		a masked load, whose zeros add nothing to either sum.
+	*/
+
+	const __m512i bias = _mm512_set1_epi8((char)0x80);
+	const __m512i ones = _mm512_set1_epi8(1);
+	__m512i products = _mm512_setzero_si512();
+	__m512i sums = _mm512_setzero_si512();
+	size_t c = 0;
+	for (; (c + 64) <= n; c += 64)
+	{
+		const __m512i a = _mm512_loadu_si512((const void*)(A + c));
+		const __m512i b = _mm512_loadu_si512((const void*)(B + c));
+		products = _mm512_dpbusd_epi32(products, _mm512_xor_si512(a, bias), b);
+		sums = _mm512_dpbusd_epi32(sums, ones, b);
+	};
+	if (c < n)
+	{
+		const __mmask64 mask = (((__mmask64)1 << (n - c)) - 1);
+		const __m512i a = _mm512_maskz_loadu_epi8(mask, (const void*)(A + c));
+		const __m512i b = _mm512_maskz_loadu_epi8(mask, (const void*)(B + c));
+		products = _mm512_dpbusd_epi32(products, _mm512_xor_si512(a, bias), b);
+		sums = _mm512_dpbusd_epi32(sums, ones, b);
+	};
+	return (vectorsReduceAdd(products) - (128 * vectorsReduceAdd(sums)));
+};
+
+template <>
+struct VectorQuantMath<VECTORS_ISA_AVX512>
+{
+	/*
+		16 elements a register; whatever is left over goes through the AVX2 form.
+	*/
+
+	template <typename E>
+	VECTORS_TARGET_AVX512 static inline float dot(const E* A, const E* B, const size_t& n)
+	{
+		__m512 s0 = _mm512_setzero_ps(), s1 = _mm512_setzero_ps();
+		size_t c = 0;
+		for (; (c + 32) <= n; c += 32)
+		{
+			s0 = _mm512_fmadd_ps(vectorsWiden16(A + c), vectorsWiden16(B + c), s0);
+			s1 = _mm512_fmadd_ps(vectorsWiden16(A + c + 16), vectorsWiden16(B + c + 16), s1);
+		};
+		for (; (c + 16) <= n; c += 16)
+		{
+			s0 = _mm512_fmadd_ps(vectorsWiden16(A + c), vectorsWiden16(B + c), s0);
+		};
+		return (vectorsReduceAdd(_mm512_add_ps(s0, s1)) + VectorQuantMath<VECTORS_ISA_AVX2>::dot(A + c, B + c, n - c));
+	};
+	template <typename E>
+	VECTORS_TARGET_AVX512 static inline float squaredDistance(const E* A, const E* B, const size_t& n)
+	{
+		__m512 s0 = _mm512_setzero_ps(), s1 = _mm512_setzero_ps();
+		size_t c = 0;
+		for (; (c + 32) <= n; c += 32)
+		{
+			const __m512 d0 = _mm512_sub_ps(vectorsWiden16(A + c), vectorsWiden16(B + c));
+			const __m512 d1 = _mm512_sub_ps(vectorsWiden16(A + c + 16), vectorsWiden16(B + c + 16));
+			s0 = _mm512_fmadd_ps(d0, d0, s0);
+			s1 = _mm512_fmadd_ps(d1, d1, s1);
+		};
+		for (; (c + 16) <= n; c += 16)
+		{
+			const __m512 d = _mm512_sub_ps(vectorsWiden16(A + c), vectorsWiden16(B + c));
+			s0 = _mm512_fmadd_ps(d, d, s0);
+		};
+		return (vectorsReduceAdd(_mm512_add_ps(s0, s1)) + VectorQuantMath<VECTORS_ISA_AVX2>::squaredDistance(A + c, B + c, n - c));
+	};
+
+	VECTORS_TARGET_AVX512 static inline int32_t dot(const int8_t* A, const int8_t* B, const size_t& n)
+	{
+		if (vectorsHasVNNI())
+		{
+			return vectorsDotVNNI(A, B, n);
+		};
+		return VectorQuantMath<VECTORS_ISA_AVX2>::dot(A, B, n);
+	};
+	VECTORS_TARGET_AVX512 static inline float dot(const int8_t* A, const float& scale, const float& offset, const float* B, const size_t& n)
+	{
+		const __m512 s = _mm512_set1_ps(scale);
+		const __m512 o = _mm512_set1_ps(offset);
+		__m512 s0 = _mm512_setzero_ps(), s1 = _mm512_setzero_ps();
+		size_t c = 0;
+		for (; (c + 32) <= n; c += 32)
+		{
+			s0 = _mm512_fmadd_ps(_mm512_fmadd_ps(vectorsWiden16(A + c), s, o), _mm512_loadu_ps(B + c), s0);
+			s1 = _mm512_fmadd_ps(_mm512_fmadd_ps(vectorsWiden16(A + c + 16), s, o), _mm512_loadu_ps(B + c + 16), s1);
+		};
+		for (; (c + 16) <= n; c += 16)
+		{
+			s0 = _mm512_fmadd_ps(_mm512_fmadd_ps(vectorsWiden16(A + c), s, o), _mm512_loadu_ps(B + c), s0);
+		};
+		return (vectorsReduceAdd(_mm512_add_ps(s0, s1)) + VectorQuantMath<VECTORS_ISA_AVX2>::dot(A + c, scale, offset, B + c, n - c));
+	};
+	VECTORS_TARGET_AVX512 static inline float squaredDistance(const int8_t* A, const float& scale, const float& offset, const float* B, const size_t& n)
+	{
+		const __m512 s = _mm512_set1_ps(scale);
+		const __m512 o = _mm512_set1_ps(offset);
+		__m512 s0 = _mm512_setzero_ps(), s1 = _mm512_setzero_ps();
+		size_t c = 0;
+		for (; (c + 32) <= n; c += 32)
+		{
+			const __m512 d0 = _mm512_sub_ps(_mm512_fmadd_ps(vectorsWiden16(A + c), s, o), _mm512_loadu_ps(B + c));
+			const __m512 d1 = _mm512_sub_ps(_mm512_fmadd_ps(vectorsWiden16(A + c + 16), s, o), _mm512_loadu_ps(B + c + 16));
+			s0 = _mm512_fmadd_ps(d0, d0, s0);
+			s1 = _mm512_fmadd_ps(d1, d1, s1);
+		};
+		for (; (c + 16) <= n; c += 16)
+		{
+			const __m512 d = _mm512_sub_ps(_mm512_fmadd_ps(vectorsWiden16(A + c), s, o), _mm512_loadu_ps(B + c));
+			s0 = _mm512_fmadd_ps(d, d, s0);
+		};
+		return (vectorsReduceAdd(_mm512_add_ps(s0, s1)) + VectorQuantMath<VECTORS_ISA_AVX2>::squaredDistance(A + c, scale, offset, B + c, n - c));
+	};
+};
+#endif
+
+/* Kernels */
+struct VectorQuantDot
+{
+	template <int ISA, typename... Args>
+	static VECTORS_ALWAYS_INLINE auto run(Args... args) -> decltype(VectorQuantMath<ISA>::dot(args...))
+	{
+		return VectorQuantMath<ISA>::dot(args...);
+	};
+};
+struct VectorQuantDistance
+{
+	template <int ISA, typename... Args>
+	static VECTORS_ALWAYS_INLINE auto run(Args... args) -> decltype(VectorQuantMath<ISA>::squaredDistance(args...))
+	{
+		return VectorQuantMath<ISA>::squaredDistance(args...);
+	};
+};
+
+/* Wide Products */
+template <uint64_t N, typename Format>
+inline float wideDot(const Vector<N, VectorsFloat16<Format>>& A, const Vector<N, VectorsFloat16<Format>>& B)
+{
+	/*
+		The dot product of two half or bfloat16 vectors, accumulated and returned in
+		float rather than rounded to 16 bits like A.dot(B).
+	*/
+
+	return vectorsDispatch<VectorQuantDot>(A.value, B.value, (size_t)N);
+};
+template <uint64_t N, typename Format>
+inline float wideSquaredDistance(const Vector<N, VectorsFloat16<Format>>& A, const Vector<N, VectorsFloat16<Format>>& B)
+{
+	return vectorsDispatch<VectorQuantDistance>(A.value, B.value, (size_t)N);
+};
+
+template <typename To, uint64_t N, typename From>
+inline Vector<N, To> vectorCast(const Vector<N, From>& source)
+{
+	/*
+		Converts each element, e.g. vectorCast<half>(v) for a Vector<N,float> v.
+	*/
+
+	Vector<N, To> C;
+	for (uint64_t i = 0; i < N; i++)
+	{
+		C.value[i] = static_cast<To>(source.value[i]);
+	};
+	return C;
+};
+
+/* Quantized Vectors */
+template <uint64_t N>
+struct QuantizedVector
+{
+	/*
+		# Quantized Vector (struct)
+		An N dimensional float vector stored as N signed bytes, element i standing
+		for offset + (scale * value[i]). The scale and offset are chosen per vector
+		to spread its range over -127 to 127, so the error in each element is at
+		most half a step of (max - min) / 254. The sum of the bytes and the squared
+		norm are kept alongside, so dot products between two quantized vectors reduce
+		to a single byte dot product.
+	*/
+
+	static_assert(N > 0, "A vector needs at least one dimension.");
+
+	/* Elements */
+	int8_t value[N];
+	float scale;
+	float offset;
+	int32_t valueSum;
+	float normSquared;
+
+	/* Methods */
+
+	// Constructors & Destructor
+	QuantizedVector() : value{}, scale(0.0f), offset(0.0f), valueSum(0), normSquared(0.0f) {};
+	template <typename T>
+	explicit QuantizedVector(const Vector<N, T>& source)
+	{
+		float lowest = (float)source.value[0];
+		float highest = lowest;
+		for (uint64_t i = 1; i < N; i++)
+		{
+			const float v = (float)source.value[i];
+			lowest = (v < lowest) ? v : lowest;
+			highest = (v > highest) ? v : highest;
+		};
+
+		this->offset = (0.5f * (lowest + highest));
+		this->scale = ((highest - lowest) / 254.0f);
+		const float inverse = (this->scale > 0.0f) ? (1.0f / this->scale) : 0.0f;
+
+		int64_t sum = 0;
+		int64_t squares = 0;
+		for (uint64_t i = 0; i < N; i++)
+		{
+			float q = std::nearbyint(((float)source.value[i] - this->offset) * inverse);
+			q = (q < -127.0f) ? -127.0f : ((q > 127.0f) ? 127.0f : q);
+			this->value[i] = (int8_t)q;
+			sum += this->value[i];
+			squares += (this->value[i] * this->value[i]);
+		};
+		this->valueSum = (int32_t)sum;
+
+		// Of the dequantized vector, so distances between quantized vectors are consistent
+		this->normSquared = (float)(
+			((double)N * this->offset * this->offset) +
+			(2.0 * this->offset * this->scale * (double)sum) +
+			((double)this->scale * this->scale * (double)squares)
+		);
+	};
+
+	// Access Operators
+	inline float get(const uint64_t& i) const
+	{
+		return (this->offset + (this->scale * (float)this->value[i]));
+	};
+	inline Vector<N, float> dequantize() const
+	{
+		Vector<N, float> C;
+		for (uint64_t i = 0; i < N; i++)
+		{
+			C.value[i] = this->get(i);
+		};
+		return C;
+	};
+
+	// Product Operators
+	inline float dot(const QuantizedVector<N>& B) const
+	{
+		/*
+			Expanding sum((oA + sA a) * (oB + sB b)) leaves one byte dot product, with
+			the rest made up from the stored sums.
+		*/
+
+		const int32_t products = vectorsDispatch<VectorQuantDot>((const int8_t*)this->value, (const int8_t*)B.value, (size_t)N);
+		return (float)(
+			((double)N * this->offset * B.offset) +
+			((double)this->offset * B.scale * B.valueSum) +
+			((double)B.offset * this->scale * this->valueSum) +
+			((double)this->scale * B.scale * products)
+		);
+	};
+	inline float dot(const Vector<N, float>& B) const
+	{
+		return vectorsDispatch<VectorQuantDot>((const int8_t*)this->value, this->scale, this->offset, (const float*)B.value, (size_t)N);
+	};
+
+	// Distance Operators
+	inline float squaredDistance(const QuantizedVector<N>& B) const
+	{
+		const float squared = ((this->normSquared + B.normSquared) - (2.0f * this->dot(B)));
+		return (squared > 0.0f) ? squared : 0.0f;
+	};
+	inline float squaredDistance(const Vector<N, float>& B) const
+	{
+		return vectorsDispatch<VectorQuantDistance>((const int8_t*)this->value, this->scale, this->offset, (const float*)B.value, (size_t)N);
+	};
+};
+
+#endif
@@ -0,0 +1,622 @@
+#pragma once
+/*
+	# Vector Template Library - Quaternions
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	Quaternion<T>, for rotations of Vector3D, with composition, conversion to and
+	from axis-angle pairs and matrices, and interpolation:
+
+		Quaternion<float> q = Quaternion<float>::fromAxisAngle(axis, angle);
+		Vector3D<float> turned = q.rotate(v);
+		Quaternion<float> blended = slerp(a, b, 0.25f);
+
+	The batch operations rotate and interpolate whole arrays, e.g. the joints of
+	a skeleton, through the same runtime dispatch as vectors_batch.h. Each block
+	of quaternions is split into separate x, y, z and w arrays on the way in so
+	the arithmetic vectorizes across quaternions. batchSlerp() uses a polynomial
+	form of slerp with no trigonometry in it, so it vectorizes too.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+#ifndef VECTOR_TEMPLATE_LIBRARY_QUATERNION__H
+#define VECTOR_TEMPLATE_LIBRARY_QUATERNION__H
+/* Deps */
+#include "vectors.h"
+#include "vectors_batch.h"
+#include "vectors_matrix.h"
+#include <stddef.h>
+#include <cmath>
+
+/* Quaternions */
+template <typename T>
+struct Quaternion
+{
+	/*
+		# Quaternion (struct)
+		A quaternion x i + y j + z k + w, stored x, y, z, w like a Vector4D. Rotations
+		are unit quaternions; q and -q are the same rotation. A default constructed
+		quaternion is all zero, identity() is the rotation that does nothing.
+	*/
+
+	/* Elements */
+	alignas(VectorLayout<T, 4>::alignment) T value[4];
+
+	/* Methods */
+
+	// Constructors & Destructor
+	constexpr Quaternion() : value{} {};
+	constexpr Quaternion(const T& x, const T& y, const T& z, const T& w) : value{ x, y, z, w } {};
+	constexpr Quaternion(const Vector3D<T>& vector, const T& w) : value{ vector.value[0], vector.value[1], vector.value[2], w } {};
+	explicit constexpr Quaternion(const Vector4D<T>& B) : value{ B.value[0], B.value[1], B.value[2], B.value[3] } {};
+
+	// Factories
+	static constexpr Quaternion<T> identity()
+	{
+		return Quaternion<T>(T(), T(), T(), (T)1);
+	};
+	static inline Quaternion<T> fromAxisAngle(const Vector3D<T>& axis, const T& angle)
+	{
+		/*
+			A rotation by angle (in radians, counter-clockwise looking down the axis)
+			around axis, which must be of unit length, as Matrix3::rotation().
+		*/
+
+		const T s = (T)std::sin(angle / (T)2);
+		return Quaternion<T>(axis * s, (T)std::cos(angle / (T)2));
+	};
+	static inline Quaternion<T> fromMatrix(const Matrix3<T>& M)
+	{
+		/*
+			The rotation of M, which must be a rotation matrix. Built from the largest
+			of the diagonal terms so it doesn't divide by a small number.
+		*/
+
+		const T (&m)[3][3] = M.value;
+		const T trace = (m[0][0] + m[1][1] + m[2][2]);
+		if (trace > T())
+		{
+			const T s = ((T)std::sqrt(trace + (T)1) * (T)2);
+			return Quaternion<T>(((m[2][1] - m[1][2]) / s), ((m[0][2] - m[2][0]) / s), ((m[1][0] - m[0][1]) / s), (s / (T)4));
+		};
+		if ((m[0][0] > m[1][1]) && (m[0][0] > m[2][2]))
+		{
+			const T s = ((T)std::sqrt((T)1 + m[0][0] - m[1][1] - m[2][2]) * (T)2);
+			return Quaternion<T>((s / (T)4), ((m[0][1] + m[1][0]) / s), ((m[0][2] + m[2][0]) / s), ((m[2][1] - m[1][2]) / s));
+		};
+		if (m[1][1] > m[2][2])
+		{
+			const T s = ((T)std::sqrt((T)1 + m[1][1] - m[0][0] - m[2][2]) * (T)2);
+			return Quaternion<T>(((m[0][1] + m[1][0]) / s), (s / (T)4), ((m[1][2] + m[2][1]) / s), ((m[0][2] - m[2][0]) / s));
+		};
+		const T s = ((T)std::sqrt((T)1 + m[2][2] - m[0][0] - m[1][1]) * (T)2);
+		return Quaternion<T>(((m[0][2] + m[2][0]) / s), ((m[1][2] + m[2][1]) / s), (s / (T)4), ((m[1][0] - m[0][1]) / s));
+	};
+
+	// Access Operators
+	constexpr T& x()
+	{
+		return this->value[0];
+	};
+	constexpr const T& x() const
+	{
+		return this->value[0];
+	};
+	constexpr T& y()
+	{
+		return this->value[1];
+	};
+	constexpr const T& y() const
+	{
+		return this->value[1];
+	};
+	constexpr T& z()
+	{
+		return this->value[2];
+	};
+	constexpr const T& z() const
+	{
+		return this->value[2];
+	};
+	constexpr T& w()
+	{
+		return this->value[3];
+	};
+	constexpr const T& w() const
+	{
+		return this->value[3];
+	};
+	inline Vector3D<T> vector() const
+	{
+		/*
+			The vector part, x, y and z.
+		*/
+
+		return Vector3D<T>(this->value[0], this->value[1], this->value[2]);
+	};
+	inline Vector4D<T> toVector4D() const
+	{
+		return Vector4D<T>(this->value[0], this->value[1], this->value[2], this->value[3]);
+	};
+
+	// Conversions
+	inline void toAxisAngle(Vector3D<T>& axis, T& angle) const
+	{
+		/*
+			Splits a unit quaternion into a unit axis and an angle in [0, 2 pi]. With
+			no rotation the axis is (1, 0, 0).
+		*/
+
+		const T w = (this->value[3] < (T)-1) ? (T)-1 : ((this->value[3] > (T)1) ? (T)1 : this->value[3]);
+		angle = ((T)2 * (T)std::acos(w));
+		const T s = (T)std::sqrt((T)1 - (w * w));
+		axis = (s > std::numeric_limits<T>::epsilon()) ? (this->vector() / s) : Vector3D<T>((T)1, T(), T());
+	};
+	inline Matrix3<T> toMatrix3() const
+	{
+		/*
+			The rotation matrix of a unit quaternion.
+		*/
+
+		const T x = this->value[0], y = this->value[1], z = this->value[2], w = this->value[3];
+		return Matrix3<T>(
+			((T)1 - ((T)2 * ((y * y) + (z * z)))), ((T)2 * ((x * y) - (z * w))), ((T)2 * ((x * z) + (y * w))),
+			((T)2 * ((x * y) + (z * w))), ((T)1 - ((T)2 * ((x * x) + (z * z)))), ((T)2 * ((y * z) - (x * w))),
+			((T)2 * ((x * z) - (y * w))), ((T)2 * ((y * z) + (x * w))), ((T)1 - ((T)2 * ((x * x) + (y * y))))
+		);
+	};
+	inline Matrix4<T> toMatrix4() const
+	{
+		return Matrix4<T>::affine(this->toMatrix3(), Vector3D<T>());
+	};
+
+	// Normalization Methods
+	inline T dot(const Quaternion<T>& B) const
+	{
+		return VectorKernels<T, 4>::dot(this->value, B.value);
+	};
+	inline T squaredNorm() const
+	{
+		return this->dot(*this);
+	};
+	inline T norm() const
+	{
+		return (T)std::sqrt(this->squaredNorm());
+	};
+	inline Quaternion<T> unitNormal() const
+	{
+		return ((*this) * ((T)1 / this->norm()));
+	};
+	inline Quaternion<T> conjugate() const
+	{
+		/*
+			The vector part negated, which for a unit quaternion is its inverse: the
+			opposite rotation.
+		*/
+
+		return Quaternion<T>(-this->value[0], -this->value[1], -this->value[2], this->value[3]);
+	};
+	inline Quaternion<T> inverse() const
+	{
+		return (this->conjugate() * ((T)1 / this->squaredNorm()));
+	};
+
+	// Rotation
+	inline Vector3D<T> rotate(const Vector3D<T>& B) const
+	{
+		/*
+			Rotates B by a unit quaternion, as v + 2w(q x v) + 2q x (q x v) with the
+			2(q x v) shared, which is cheaper than q v q* or building the matrix.
+		*/
+
+		const Vector3D<T> q = this->vector();
+		const Vector3D<T> t = (q.cross(B) * (T)2);
+		return (B + (t * this->value[3]) + q.cross(t));
+	};
+
+	// Unary Operators
+	constexpr Quaternion<T> operator-() const
+	{
+		return Quaternion<T>(-this->value[0], -this->value[1], -this->value[2], -this->value[3]);
+	};
+
+	// Comparison Operators
+	constexpr bool operator==(const Quaternion<T>& B) const
+	{
+		return ((this->value[0] == B.value[0]) && (this->value[1] == B.value[1]) && (this->value[2] == B.value[2]) && (this->value[3] == B.value[3]));
+	};
+	constexpr bool operator!=(const Quaternion<T>& B) const
+	{
+		return !((*this) == B);
+	};
+
+	// Binary Operators
+	inline Quaternion<T> operator+(const Quaternion<T>& B) const
+	{
+		Quaternion<T> C;
+		VectorKernels<T, 4>::add(this->value, B.value, C.value);
+		return C;
+	};
+	inline Quaternion<T> operator-(const Quaternion<T>& B) const
+	{
+		Quaternion<T> C;
+		VectorKernels<T, 4>::sub(this->value, B.value, C.value);
+		return C;
+	};
+	inline Quaternion<T> operator*(const T& B) const
+	{
+		Quaternion<T> C;
+		VectorKernels<T, 4>::mulScalar(this->value, B, C.value);
+		return C;
+	};
+	inline Quaternion<T> operator*(const Quaternion<T>& B) const
+	{
+		/*
+			The Hamilton product. As a rotation, (*this) * B applies B first.
+		*/
+
+		const T (&a)[4] = this->value;
+		const T (&b)[4] = B.value;
+		return Quaternion<T>(
+			((a[3] * b[0]) + (a[0] * b[3]) + (a[1] * b[2]) - (a[2] * b[1])),
+			((a[3] * b[1]) - (a[0] * b[2]) + (a[1] * b[3]) + (a[2] * b[0])),
+			((a[3] * b[2]) + (a[0] * b[1]) - (a[1] * b[0]) + (a[2] * b[3])),
+			((a[3] * b[3]) - (a[0] * b[0]) - (a[1] * b[1]) - (a[2] * b[2]))
+		);
+	};
+
+	// Binary Assignment Operators
+	inline Quaternion<T>& operator*=(const Quaternion<T>& B)
+	{
+		(*this) = ((*this) * B);
+		return (*this);
+	};
+	inline Quaternion<T>& operator*=(const T& B)
+	{
+		VectorKernels<T, 4>::mulScalar(this->value, B, this->value);
+		return (*this);
+	};
+};
+
+/* Layout Guarantees */
+static_assert(sizeof(Quaternion<float>) == (4 * sizeof(float)), "Quaternion must be exactly 4 elements.");
+static_assert(std::is_trivially_copyable<Quaternion<float>>::value, "Quaternion must be trivially copyable.");
+
+/* Traits */
+template <typename Q>
+struct QuaternionTraits
+{
+	/*
+		# Quaternion Traits (struct)
+		Gives the element type of a quaternion type, like VectorTraits does for the
+		vector types.
+	*/
+
+	static constexpr bool isQuaternion = false;
+};
+template <typename T>
+struct QuaternionTraits<Quaternion<T>>
+{
+	typedef T ElementType;
+	static constexpr bool isQuaternion = true;
+};
+
+/* Interpolation */
+template <typename T>
+inline Quaternion<T> nlerp(const Quaternion<T>& A, const Quaternion<T>& B, const T& t)
+{
+	/*
+		Interpolates from A (t = 0) to B (t = 1) along a straight line and
+		renormalizes, taking the shorter way round. Cheaper than slerp() but its
+		speed along the arc isn't constant.
+	*/
+
+	const T s = (A.dot(B) < T()) ? -t : t;
+	return ((A * ((T)1 - t)) + (B * s)).unitNormal();
+};
+template <typename T>
+inline Quaternion<T> slerp(const Quaternion<T>& A, const Quaternion<T>& B, const T& t)
+{
+	/*
+		Interpolates from unit quaternion A (t = 0) to B (t = 1) along the arc
+		between them at a constant speed, taking the shorter way round. Falls back
+		to nlerp() when they are close enough that the arc is a straight line.
+	*/
+
+	T cosine = A.dot(B);
+	const T sign = (cosine < T()) ? (T)-1 : (T)1;
+	cosine *= sign;
+	if (cosine > (T)0.9995)
+	{
+		return nlerp(A, B, t);
+	};
+	const T angle = (T)std::acos(cosine);
+	const T scale = ((T)1 / (T)std::sin(angle));
+	return ((A * ((T)std::sin(((T)1 - t) * angle) * scale)) + (B * ((T)std::sin(t * angle) * scale * sign)));
+};
+
+/* Batch Kernels */
+template <typename T>
+struct QuaternionBatchKernels
+{
+	/*
+		# Quaternion Batch Kernels (struct)
+		The loops behind the batch operations, in the style of VectorsBatchKernels.
+		Each block of quaternions (and vectors) is copied into separate arrays of
+		their elements first, so the arithmetic vectorizes across the block and A
+		and out may be the same array.
+
+		The interpolations take their weights as t[i * step], so a step of 0 uses
+		one weight for the whole batch.
+	*/
+
+	typedef Quaternion<T> Q;
+	typedef Vector3D<T> V;
+	static constexpr size_t block = 16;
+
+	static VECTORS_ALWAYS_INLINE void split(const Q* A, const size_t& count, T (&q)[4][block])
+	{
+		for (size_t j = 0; j < count; j++)
+		{
+			for (uint64_t c = 0; c < 4; c++)
+			{
+				q[c][j] = A[j].value[c];
+			};
+		};
+	};
+
+	struct Rotate
+	{
+		template <int ISA>
+		static VECTORS_ALWAYS_INLINE void run(const Q* R, const V* A, V* out, size_t n)
+		{
+			for (size_t i = 0; i < n; i += block)
+			{
+				const size_t count = ((n - i) < block) ? (n - i) : block;
+				T q[4][block];
+				T v[3][block];
+				split((R + i), count, q);
+				for (size_t j = 0; j < count; j++)
+				{
+					for (uint64_t c = 0; c < 3; c++)
+					{
+						v[c][j] = A[i + j].value[c];
+					};
+				};
+				for (size_t j = 0; j < count; j++)
+				{
+					const T x = q[0][j], y = q[1][j], z = q[2][j], w = q[3][j];
+					const T a = v[0][j], b = v[1][j], c = v[2][j];
+					const T tx = (T)2 * ((y * c) - (z * b));
+					const T ty = (T)2 * ((z * a) - (x * c));
+					const T tz = (T)2 * ((x * b) - (y * a));
+					out[i + j].value[0] = a + (w * tx) + ((y * tz) - (z * ty));
+					out[i + j].value[1] = b + (w * ty) + ((z * tx) - (x * tz));
+					out[i + j].value[2] = c + (w * tz) + ((x * ty) - (y * tx));
+				};
+			};
+		};
+	};
+
+	struct Nlerp
+	{
+		template <int ISA>
+		static VECTORS_ALWAYS_INLINE void run(const Q* A, const Q* B, const T* t, size_t step, Q* out, size_t n)
+		{
+			for (size_t i = 0; i < n; i += block)
+			{
+				const size_t count = ((n - i) < block) ? (n - i) : block;
+				T a[4][block];
+				T b[4][block];
+				T r[4][block];
+				T scales[block];
+				split((A + i), count, a);
+				split((B + i), count, b);
+				for (size_t j = 0; j < count; j++)
+				{
+					const T u = t[(i + j) * step];
+					const T d = ((a[0][j] * b[0][j]) + (a[1][j] * b[1][j])) + ((a[2][j] * b[2][j]) + (a[3][j] * b[3][j]));
+					const T s = (d < T()) ? -u : u;
+					for (uint64_t c = 0; c < 4; c++)
+					{
+						r[c][j] = (a[c][j] * ((T)1 - u)) + (b[c][j] * s);
+					};
+					scales[j] = ((r[0][j] * r[0][j]) + (r[1][j] * r[1][j])) + ((r[2][j] * r[2][j]) + (r[3][j] * r[3][j]));
+				};
+				VectorsBatchMath<ISA>::sqrt(scales, count);
+				for (size_t j = 0; j < count; j++)
+				{
+					const T scale = (scales[j] > T()) ? ((T)1 / scales[j]) : (T)1;
+					for (uint64_t c = 0; c < 4; c++)
+					{
+						out[i + j].value[c] = r[c][j] * scale;
+					};
+				};
+			};
+		};
+	};
+
+	struct Slerp
+	{
+		/*
+			The polynomial slerp of Eberly, "A Fast and Accurate Algorithm for
+			Computing SLERP": the weights sin((1 - t) a) / sin(a) and sin(t a) / sin(a)
+			as truncated series in cos(a) - 1, with the last term scaled by mu to make
+			up for the ones left off. Taking the shorter way round keeps a within
+			pi / 2, where 12 terms with this mu are within 7e-7 of the exact weights.
+		*/
+
+		static constexpr int terms = 12;
+		static constexpr T mu = (T)1.8937206662323194;
+
+		static constexpr T u(const int& i)
+		{
+			return ((T)1 / (T)((i + 1) * ((2 * (i + 1)) + 1))) * ((i == (terms - 1)) ? mu : (T)1);
+		};
+		static constexpr T v(const int& i)
+		{
+			return ((T)(i + 1) / (T)((2 * (i + 1)) + 1)) * ((i == (terms - 1)) ? mu : (T)1);
+		};
+		static VECTORS_ALWAYS_INLINE T weight(const T& t, const T& xm1)
+		{
+			const T t2 = (t * t);
+			T sum = (T)1;
+			for (int i = (terms - 1); i >= 0; i--)
+			{
+				sum = (T)1 + (((u(i) * t2) - v(i)) * xm1 * sum);
+			};
+			return (t * sum);
+		};
+
+		template <int ISA>
+		static VECTORS_ALWAYS_INLINE void run(const Q* A, const Q* B, const T* t, size_t step, Q* out, size_t n)
+		{
+			for (size_t i = 0; i < n; i += block)
+			{
+				const size_t count = ((n - i) < block) ? (n - i) : block;
+				T a[4][block];
+				T b[4][block];
+				split((A + i), count, a);
+				split((B + i), count, b);
+				for (size_t j = 0; j < count; j++)
+				{
+					const T u = t[(i + j) * step];
+					const T d = ((a[0][j] * b[0][j]) + (a[1][j] * b[1][j])) + ((a[2][j] * b[2][j]) + (a[3][j] * b[3][j]));
+					const T sign = (d < T()) ? (T)-1 : (T)1;
+					const T xm1 = ((d * sign) - (T)1);
+					const T wa = weight(((T)1 - u), xm1);
+					const T wb = (weight(u, xm1) * sign);
+					for (uint64_t c = 0; c < 4; c++)
+					{
+						out[i + j].value[c] = (a[c][j] * wa) + (b[c][j] * wb);
+					};
+				};
+			};
+		};
+	};
+};
+
+/* Batch Operations */
+template <typename T>
+inline void batchRotate(const Quaternion<T>* R, const Vector3D<T>* A, Vector3D<T>* out, const size_t& n)
+{
+	/*
+		Writes R[i].rotate(A[i]) into out[i]. A and out may be the same array.
+	*/
+
+	vectorsDispatch<typename QuaternionBatchKernels<T>::Rotate>(R, A, out, (size_t)n);
+};
+template <typename T>
+inline void batchRotate(const Quaternion<T>& R, const Vector3D<T>* A, Vector3D<T>* out, const size_t& n)
+{
+	/*
+		Writes R.rotate(A[i]) into out[i], through R's matrix and transformVectors().
+		A and out may be the same array.
+	*/
+
+	transformVectors(R.toMatrix3(), A, out, n);
+};
+template <typename T>
+inline void batchNlerp(const Quaternion<T>* A, const Quaternion<T>* B, const T* t, Quaternion<T>* out, const size_t& n)
+{
+	/*
+		Writes nlerp(A[i], B[i], t[i]) into out[i]. out may be the same array as A
+		or B.
+	*/
+
+	vectorsDispatch<typename QuaternionBatchKernels<T>::Nlerp>(A, B, t, (size_t)1, out, (size_t)n);
+};
+template <typename T>
+inline void batchNlerp(const Quaternion<T>* A, const Quaternion<T>* B, const T& t, Quaternion<T>* out, const size_t& n)
+{
+	/*
+		Writes nlerp(A[i], B[i], t) into out[i].
+	*/
+
+	vectorsDispatch<typename QuaternionBatchKernels<T>::Nlerp>(A, B, &t, (size_t)0, out, (size_t)n);
+};
+template <typename T>
+inline void batchSlerp(const Quaternion<T>* A, const Quaternion<T>* B, const T* t, Quaternion<T>* out, const size_t& n)
+{
+	/*
+		Writes slerp(A[i], B[i], t[i]) into out[i], for unit quaternions and t in
+		[0, 1], to within about 1e-6 (see QuaternionBatchKernels::Slerp). out may be
+		the same array as A or B.
+	*/
+
+	vectorsDispatch<typename QuaternionBatchKernels<T>::Slerp>(A, B, t, (size_t)1, out, (size_t)n);
+};
+template <typename T>
+inline void batchSlerp(const Quaternion<T>* A, const Quaternion<T>* B, const T& t, Quaternion<T>* out, const size_t& n)
+{
+	/*
+		Writes slerp(A[i], B[i], t) into out[i], as above.
+	*/
+
+	vectorsDispatch<typename QuaternionBatchKernels<T>::Slerp>(A, B, &t, (size_t)0, out, (size_t)n);
+};
+
+#if defined(__cpp_lib_span)
+/* Span Overloads */
+// The overloads taking several spans return false, doing nothing, unless they
+// are all the same size.
+template <typename SR, typename SA, typename SO, typename Q = VectorsSpanElement<SR>, typename T = typename QuaternionTraits<Q>::ElementType>
+inline typename std::enable_if<VectorsSpanOf<SR, Q>::value && VectorsSpanOf<SA, Vector3D<T>>::value && VectorsSpanOf<SO, Vector3D<T>, true>::value, bool>::type batchRotate(SR R, SA A, SO out)
+{
+	if ((R.size() != A.size()) || (out.size() != A.size()))
+	{
+		return false;
+	};
+	batchRotate(R.data(), A.data(), out.data(), A.size());
+	return true;
+};
+template <typename T, typename SA>
+inline typename std::enable_if<VectorsSpanOf<SA, Vector3D<T>, true>::value>::type batchRotate(const Quaternion<T>& R, SA A)
+{
+	batchRotate(R, A.data(), A.data(), A.size());
+};
+template <typename SA, typename SB, typename SW, typename SO, typename Q = VectorsSpanElement<SA>, typename T = typename QuaternionTraits<Q>::ElementType>
+inline typename std::enable_if<VectorsSpanOf<SA, Q>::value && VectorsSpanOf<SB, Q>::value && VectorsSpanOf<SW, T>::value && VectorsSpanOf<SO, Q, true>::value, bool>::type batchNlerp(SA A, SB B, SW t, SO out)
+{
+	if ((B.size() != A.size()) || (t.size() != A.size()) || (out.size() != A.size()))
+	{
+		return false;
+	};
+	batchNlerp(A.data(), B.data(), t.data(), out.data(), A.size());
+	return true;
+};
+template <typename SA, typename SB, typename SO, typename Q = VectorsSpanElement<SA>>
+inline typename std::enable_if<VectorsSpanOf<SA, Q>::value && VectorsSpanOf<SB, Q>::value && VectorsSpanOf<SO, Q, true>::value, bool>::type batchNlerp(SA A, SB B, const typename QuaternionTraits<Q>::ElementType& t, SO out)
+{
+	if ((B.size() != A.size()) || (out.size() != A.size()))
+	{
+		return false;
+	};
+	batchNlerp(A.data(), B.data(), t, out.data(), A.size());
+	return true;
+};
+template <typename SA, typename SB, typename SW, typename SO, typename Q = VectorsSpanElement<SA>, typename T = typename QuaternionTraits<Q>::ElementType>
+inline typename std::enable_if<VectorsSpanOf<SA, Q>::value && VectorsSpanOf<SB, Q>::value && VectorsSpanOf<SW, T>::value && VectorsSpanOf<SO, Q, true>::value, bool>::type batchSlerp(SA A, SB B, SW t, SO out)
+{
+	if ((B.size() != A.size()) || (t.size() != A.size()) || (out.size() != A.size()))
+	{
+		return false;
+	};
+	batchSlerp(A.data(), B.data(), t.data(), out.data(), A.size());
+	return true;
+};
+template <typename SA, typename SB, typename SO, typename Q = VectorsSpanElement<SA>>
+inline typename std::enable_if<VectorsSpanOf<SA, Q>::value && VectorsSpanOf<SB, Q>::value && VectorsSpanOf<SO, Q, true>::value, bool>::type batchSlerp(SA A, SB B, const typename QuaternionTraits<Q>::ElementType& t, SO out)
+{
+	if ((B.size() != A.size()) || (out.size() != A.size()))
+	{
+		return false;
+	};
+	batchSlerp(A.data(), B.data(), t, out.data(), A.size());
+	return true;
+};
+#endif
+
+#endif
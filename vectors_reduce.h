@@ -0,0 +1,502 @@
+#pragma once
+/*
+	# Vector Template Library - Reduction Policies
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	Policies for how sums, dot products and norms are accumulated, chosen as a
+	template argument:
+
+		* VectorsFastReduction, plain sums split over independent accumulators.
+		* VectorsPairwiseReduction, sums added up in a balanced tree, so the error
+		  grows with log n rather than n.
+		* VectorsKahanReduction, compensated (TwoSum) sums, with the rounding
+		  error of each product carried along, which is about as accurate as
+		  summing in twice the precision.
+		* VectorsDoubleReduction, float summed in double.
+
+		v.dot<VectorsKahanReduction>(w);
+		v.norm<VectorsPairwiseReduction>();
+		vectorsSum<VectorsDoubleReduction>(values, n);
+		batchSum<VectorsKahanReduction>(points.data(), points.size());
+
+	Every policy accumulates into 16 lanes, term i into lane i % 16, whatever
+	the width of the SIMD registers, and combines them in a fixed order. The
+	pairwise, compensated and double policies also never let a product be fused
+	with the addition after it, so they give the same result on every machine;
+	the fast one may use fused multiply-adds where the target has them.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+#ifndef VECTOR_TEMPLATE_LIBRARY_REDUCE__H
+#define VECTOR_TEMPLATE_LIBRARY_REDUCE__H
+/* Deps */
+#include "vectors.h"
+#include "vectors_batch.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+/* Error Free Products */
+template <typename T>
+inline void vectorsTwoProduct(const T& a, const T& b, T& product, T& error)
+{
+	/*
+		Splits a * b into its rounded product and the rounding error, so that
+		product + error is exactly a * b. Uses a fused multiply-add where the target
+		has one, and Dekker's splitting otherwise; both give the same result.
+	*/
+
+	product = (a * b);
+#if defined(__FMA__) || defined(FP_FAST_FMA)
+	error = std::fma(a, b, -product);
+#else
+	const T split = std::is_same<T, float>::value ? (T)4097 : (T)134217729; // 2^12 + 1, 2^27 + 1
+	const T ca = (split * a);
+	const T cb = (split * b);
+	const T ah = (ca - (ca - a));
+	const T bh = (cb - (cb - b));
+	const T al = (a - ah);
+	const T bl = (b - bh);
+	error = ((((ah * bh) - product) + (ah * bl) + (al * bh)) + (al * bl));
+#endif
+};
+
+/* Reduction Driver */
+template <typename Policy, typename T>
+using VectorsAccumulator = typename Policy::template Accumulator<T>;
+
+template <typename Policy>
+struct VectorsReduction
+{
+	/*
+		# Vectors Reduction (struct)
+		The loops shared by the reduction policies, which derive from it. (The
+		accumulator types are named through a defaulted parameter P, as a policy
+		is incomplete while its base is instantiated.) A policy provides a
+		VectorsAccumulator<Policy, T> (add(), addProduct(), merge() and value())
+		and whether blocks of terms are combined pairwise. Terms are added to lanes
+		accumulators, in blocks of rows * lanes terms.
+	*/
+
+	static constexpr size_t lanes = 16;
+	static constexpr size_t rows = 16;
+
+	template <typename T, size_t L, typename Block, typename P = Policy>
+	static inline void reduce(const size_t& n, const Block& block, VectorsAccumulator<P, T> (&out)[L])
+	{
+		/*
+			Calls block(first, last, accumulators) for consecutive blocks of the range
+			0 .. n - 1, each adding term i to accumulators[i % L]. With a pairwise
+			policy each block starts from zero and the block sums are combined like a
+			binary counter, each with the one before it of the same size.
+		*/
+
+		if constexpr (!Policy::pairwise)
+		{
+			block((size_t)0, n, out);
+		}
+		else
+		{
+			const size_t size = (rows * L);
+			if (n <= size)
+			{
+				block((size_t)0, n, out);
+				return;
+			};
+
+			// levels[(k * L) + l] holds lane l of the sum of 2^k blocks while bit k of
+			// filled is set, so a level is needed for each bit of the block count.
+			size_t depth = 0;
+			for (size_t blocks = ((n + size - 1) / size); blocks != 0; blocks >>= 1)
+			{
+				depth++;
+			};
+			std::vector<VectorsAccumulator<Policy, T>> levels(depth * L);
+			uint64_t filled = 0;
+			for (size_t first = 0; first < n; first += size)
+			{
+				VectorsAccumulator<Policy, T> sums[L] = {};
+				block(first, std::min(n, (first + size)), sums);
+				size_t level = 0;
+				for (; (filled >> level) & 1; level++)
+				{
+					for (size_t l = 0; l < L; l++)
+					{
+						levels[(level * L) + l].merge(sums[l]);
+						sums[l] = levels[(level * L) + l];
+					};
+					filled &= ~((uint64_t)1 << level);
+				};
+				for (size_t l = 0; l < L; l++)
+				{
+					levels[(level * L) + l] = sums[l];
+				};
+				filled |= ((uint64_t)1 << level);
+			};
+			for (size_t level = 0; level < depth; level++)
+			{
+				if ((filled >> level) & 1)
+				{
+					for (size_t l = 0; l < L; l++)
+					{
+						levels[(level * L) + l].merge(out[l]);
+						out[l] = levels[(level * L) + l];
+					};
+				};
+			};
+		};
+	};
+	template <typename T, size_t L, typename P = Policy>
+	static inline VectorsAccumulator<P, T> combine(VectorsAccumulator<P, T> (&sums)[L], const size_t& first, const size_t& stride)
+	{
+		/*
+			Adds up sums[first], sums[first + stride], ... pairwise.
+		*/
+
+		const size_t count = ((L - first + stride - 1) / stride);
+		for (size_t width = 1; width < count; width *= 2)
+		{
+			for (size_t j = 0; (j + width) < count; j += (2 * width))
+			{
+				sums[first + (j * stride)].merge(sums[first + ((j + width) * stride)]);
+			};
+		};
+		return sums[first];
+	};
+
+	template <typename T, typename P = Policy>
+	static inline void add(const T* A, const size_t& n, VectorsAccumulator<P, T> (&out)[lanes])
+	{
+		size_t i = 0;
+		for (; (i + lanes) <= n; i += lanes)
+		{
+			for (size_t l = 0; l < lanes; l++)
+			{
+				out[l].add(A[i + l]);
+			};
+		};
+		for (size_t l = 0; (l < lanes) && (i < n); i++, l++)
+		{
+			out[l].add(A[i]);
+		};
+	};
+
+	// Reductions
+	template <typename T, typename Load>
+	static inline T sum(const size_t& n, const Load& load)
+	{
+		/*
+			The sum of load(0) .. load(n - 1).
+		*/
+
+		VectorsAccumulator<Policy, T> sums[lanes] = {};
+		reduce<T>(n, [&](const size_t& first, const size_t& last, VectorsAccumulator<Policy, T> (&out)[lanes]) {
+			size_t i = first;
+			for (; (i + lanes) <= last; i += lanes)
+			{
+				for (size_t l = 0; l < lanes; l++)
+				{
+					out[l].add(load(i + l));
+				};
+			};
+			for (size_t l = 0; (l < lanes) && (i < last); i++, l++)
+			{
+				out[l].add(load(i));
+			};
+		}, sums);
+		return combine<T>(sums, 0, 1).value();
+	};
+	template <typename T>
+	static inline T dot(const T* A, const T* B, const size_t& n)
+	{
+		/*
+			The dot product of A[0] .. A[n - 1] and B[0] .. B[n - 1].
+		*/
+
+		VectorsAccumulator<Policy, T> sums[lanes] = {};
+		reduce<T>(n, [&](const size_t& first, const size_t& last, VectorsAccumulator<Policy, T> (&out)[lanes]) {
+			if constexpr (Policy::pairwise)
+			{
+				/*
+					The products are rounded into a buffer first, so the compiler can't fuse
+					them into the additions on targets with fused multiply-adds.
+				*/
+
+				T products[rows * lanes];
+				for (size_t i = first; i < last; i++)
+				{
+					products[i - first] = (A[i] * B[i]);
+				};
+				add(products, (last - first), out);
+			}
+			else
+			{
+				size_t i = first;
+				for (; (i + lanes) <= last; i += lanes)
+				{
+					for (size_t l = 0; l < lanes; l++)
+					{
+						out[l].addProduct(A[i + l], B[i + l]);
+					};
+				};
+				for (size_t l = 0; (l < lanes) && (i < last); i++, l++)
+				{
+					out[l].addProduct(A[i], B[i]);
+				};
+			};
+		}, sums);
+		return combine<T>(sums, 0, 1).value();
+	};
+};
+
+/* Reduction Policies */
+struct VectorsFastReduction : VectorsReduction<VectorsFastReduction>
+{
+	/*
+		# Vectors Fast Reduction (struct)
+		Sums over independent accumulators, which the compiler keeps in SIMD
+		registers, with products fused into the additions where it can.
+	*/
+
+	static constexpr bool pairwise = false;
+
+	template <typename T>
+	struct Accumulator
+	{
+		T sum = T();
+
+		inline void add(const T& x) { this->sum += x; };
+		inline void addProduct(const T& a, const T& b) { this->sum += (a * b); };
+		inline void merge(const Accumulator& B) { this->sum += B.sum; };
+		inline T value() const { return this->sum; };
+	};
+};
+
+struct VectorsPairwiseReduction : VectorsReduction<VectorsPairwiseReduction>
+{
+	/*
+		# Vectors Pairwise Reduction (struct)
+		Sums blocks of 256 terms over independent accumulators, then adds the block
+		sums up in a balanced tree. The error bound grows with log n instead of n, at
+		little cost over VectorsFastReduction.
+	*/
+
+	static constexpr bool pairwise = true;
+
+	template <typename T>
+	struct Accumulator
+	{
+		T sum = T();
+
+		inline void add(const T& x) { this->sum += x; };
+		inline void addProduct(const T& a, const T& b) { this->sum += (a * b); };
+		inline void merge(const Accumulator& B) { this->sum += B.sum; };
+		inline T value() const { return this->sum; };
+	};
+};
+
+struct VectorsKahanReduction : VectorsReduction<VectorsKahanReduction>
+{
+	/*
+		# Vectors Kahan Reduction (struct)
+		Compensated (Kahan style) summation, which keeps the exact rounding error of
+		each addition in a second accumulator, and (for dot products) the rounding
+		error of each product too. The result is about as accurate as if the sum were done
+		in twice the precision and then rounded, for around four times the work.
+	*/
+
+	static constexpr bool pairwise = false;
+
+	template <typename T>
+	struct Accumulator
+	{
+		T sum = T();
+		T compensation = T();
+
+		inline void add(const T& x)
+		{
+			/*
+				Knuth's TwoSum: the rounding error of sum + x, whichever is larger, without
+				the branch of Neumaier's comparison so the lanes stay in SIMD.
+			*/
+
+			const T total = (this->sum + x);
+			const T part = (total - this->sum);
+			this->compensation += ((this->sum - (total - part)) + (x - part));
+			this->sum = total;
+		};
+		inline void addProduct(const T& a, const T& b)
+		{
+			T product;
+			T error;
+			vectorsTwoProduct(a, b, product, error);
+			this->add(product);
+			this->compensation += error;
+		};
+		inline void merge(const Accumulator& B)
+		{
+			this->add(B.sum);
+			this->compensation += B.compensation;
+		};
+		inline T value() const { return (this->sum + this->compensation); };
+	};
+};
+
+template <typename T>
+struct VectorsWideAccumulator
+{
+	/*
+		# Vectors Wide Accumulator (struct)
+		The accumulator of VectorsDoubleReduction: a double for float terms, whose
+		products are exact in double. Wider types have no wider hardware type to sum
+		in, and are summed as VectorsKahanReduction does instead.
+	*/
+
+	VectorsKahanReduction::Accumulator<T> sum;
+
+	inline void add(const T& x) { this->sum.add(x); };
+	inline void addProduct(const T& a, const T& b) { this->sum.addProduct(a, b); };
+	inline void merge(const VectorsWideAccumulator& B) { this->sum.merge(B.sum); };
+	inline T value() const { return this->sum.value(); };
+};
+template <>
+struct VectorsWideAccumulator<float>
+{
+	double sum = 0.0;
+
+	inline void add(const float& x) { this->sum += (double)x; };
+	inline void addProduct(const float& a, const float& b) { this->sum += ((double)a * (double)b); };
+	inline void merge(const VectorsWideAccumulator& B) { this->sum += B.sum; };
+	inline float value() const { return (float)this->sum; };
+};
+
+struct VectorsDoubleReduction : VectorsReduction<VectorsDoubleReduction>
+{
+	/*
+		# Vectors Double Reduction (struct)
+		Sums float in double, see VectorsWideAccumulator. Each product of two floats
+		is exact in double, so only the additions round, to double precision.
+	*/
+
+	static constexpr bool pairwise = false;
+
+	template <typename T>
+	using Accumulator = VectorsWideAccumulator<T>;
+};
+
+template <typename R>
+struct VectorsReductionTraits
+{
+	static constexpr bool isReduction = false;
+};
+template <> struct VectorsReductionTraits<VectorsFastReduction> { static constexpr bool isReduction = true; };
+template <> struct VectorsReductionTraits<VectorsPairwiseReduction> { static constexpr bool isReduction = true; };
+template <> struct VectorsReductionTraits<VectorsKahanReduction> { static constexpr bool isReduction = true; };
+template <> struct VectorsReductionTraits<VectorsDoubleReduction> { static constexpr bool isReduction = true; };
+
+/* Array Reductions */
+template <typename Reduction, typename T>
+inline T vectorsSum(const T* A, const size_t& n)
+{
+	/*
+		The sum of A[0] .. A[n - 1], accumulated as Reduction says.
+	*/
+
+	return Reduction::template sum<T>(n, [A](const size_t& i) { return A[i]; });
+};
+template <typename Reduction, typename T>
+inline T vectorsSumAbs(const T* A, const size_t& n)
+{
+	return Reduction::template sum<T>(n, [A](const size_t& i) { return vectorsAbs(A[i]); });
+};
+template <typename Reduction, typename T>
+inline T vectorsDot(const T* A, const T* B, const size_t& n)
+{
+	/*
+		The dot product of A[0] .. A[n - 1] and B[0] .. B[n - 1], accumulated as
+		Reduction says.
+	*/
+
+	return Reduction::template dot<T>(A, B, n);
+};
+template <typename Reduction, typename T>
+inline T vectorsSquaredNorm(const T* A, const size_t& n)
+{
+	return Reduction::template dot<T>(A, A, n);
+};
+
+/* Batch Reductions */
+template <typename Reduction, typename V>
+inline typename std::enable_if<VectorsReductionTraits<Reduction>::isReduction, V>::type batchSum(const V* A, const size_t& n)
+{
+	/*
+		The element-wise sum of A[0] .. A[n - 1], accumulated as Reduction says. The
+		elements are summed as one array, with lanes a whole number of vectors wide
+		so each lane only ever holds one component.
+	*/
+
+	typedef typename VectorTraits<V>::ElementType T;
+	typedef typename Reduction::template Accumulator<T> Accumulator;
+	constexpr size_t D = (size_t)VectorTraits<V>::dimensions;
+	constexpr size_t L = (D * ((VectorsReduction<Reduction>::lanes + D - 1) / D));
+	static_assert(sizeof(V) == (D * sizeof(T)), "The vectors must be packed to be summed as one array.");
+
+	const T* values = reinterpret_cast<const T*>(A);
+	Accumulator sums[L] = {};
+	VectorsReduction<Reduction>::template reduce<T>((n * D), [&](const size_t& first, const size_t& last, Accumulator (&out)[L]) {
+		size_t i = first;
+		for (; (i + L) <= last; i += L)
+		{
+			for (size_t l = 0; l < L; l++)
+			{
+				out[l].add(values[i + l]);
+			};
+		};
+		for (size_t l = 0; (l < L) && (i < last); i++, l++)
+		{
+			out[l].add(values[i]);
+		};
+	}, sums);
+
+	V result;
+	for (size_t c = 0; c < D; c++)
+	{
+		result.value[c] = VectorsReduction<Reduction>::template combine<T>(sums, c, D).value();
+	};
+	return result;
+};
+template <typename Reduction, typename V>
+inline typename std::enable_if<VectorsReductionTraits<Reduction>::isReduction>::type batchDot(const V* A, const V* B, typename VectorTraits<V>::ElementType* out, const size_t& n)
+{
+	/*
+		Writes the dot product of each A[i] and B[i] into out[i], accumulated as
+		Reduction says; for long vectors such as Vector<1024, float>.
+	*/
+
+	typedef typename VectorTraits<V>::ElementType T;
+	for (size_t i = 0; i < n; i++)
+	{
+		out[i] = vectorsDot<Reduction>(reinterpret_cast<const T*>(A + i), reinterpret_cast<const T*>(B + i), (size_t)VectorTraits<V>::dimensions);
+	};
+};
+template <typename Reduction, typename V>
+inline typename std::enable_if<VectorsReductionTraits<Reduction>::isReduction>::type batchNorm(const V* A, typename VectorTraits<V>::ElementType* out, const size_t& n)
+{
+	/*
+		Writes the euclidean norm of each A[i] into out[i], with the squared norm
+		accumulated as Reduction says.
+	*/
+
+	typedef typename VectorTraits<V>::ElementType T;
+	for (size_t i = 0; i < n; i++)
+	{
+		out[i] = (T)std::sqrt(vectorsSquaredNorm<Reduction>(reinterpret_cast<const T*>(A + i), (size_t)VectorTraits<V>::dimensions));
+	};
+};
+
+#endif
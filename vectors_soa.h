@@ -0,0 +1,605 @@
+#pragma once
+/*
+	# Vector Template Library - Structure of Arrays
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	A structure-of-arrays container for large collections of 2D, 3D and 4D vectors.
+	Each component is kept in its own contiguous, cache line aligned array so that
+	bulk operations vectorize, while element access goes through a proxy that
+	behaves like the matching VectorND type.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+#ifndef VECTOR_TEMPLATE_LIBRARY_SOA__H
+#define VECTOR_TEMPLATE_LIBRARY_SOA__H
+/* Deps */
+#include "vectors.h"
+#include <stddef.h>
+#include <string.h>
+#include <cmath>
+#include <new>
+#include <utility>
+
+/* Allocation */
+inline void* vectorsAlignedAlloc(const size_t& size, const size_t& alignment)
+{
+	/*
+		Allocates size bytes aligned to the given alignment, which must be a power of
+		two. Throws std::bad_alloc on failure.
+	*/
+
+	return ::operator new(size, std::align_val_t(alignment));
+};
+inline void vectorsAlignedFree(void* pointer, const size_t& alignment)
+{
+	::operator delete(pointer, std::align_val_t(alignment));
+};
+
+/* Types */
+template <uint64_t N, typename T>
+struct VectorSoATraits;
+
+template <typename T>
+struct VectorSoATraits<2, T>
+{
+	typedef Vector2D<T> VectorType;
+};
+template <typename T>
+struct VectorSoATraits<3, T>
+{
+	typedef Vector3D<T> VectorType;
+};
+template <typename T>
+struct VectorSoATraits<4, T>
+{
+	typedef Vector4D<T> VectorType;
+};
+
+/* Structures */
+template <uint64_t N, typename T>
+struct VectorSoAReference
+{
+	/*
+		# Vector SoA Reference (struct)
+		A proxy for one element of a VectorSoA. It reads and writes straight through
+		to the component arrays, and converts to the matching VectorND type so the
+		rest of the vector API can be used on it.
+	*/
+
+	typedef typename VectorSoATraits<N, T>::VectorType VectorType;
+
+	/* Elements */
+	T* const* lanes;
+	size_t index;
+
+	/* Methods */
+
+	// Constructors & Destructor
+	VectorSoAReference(T* const* lanes, const size_t& index) : lanes(lanes), index(index) {};
+	VectorSoAReference(const VectorSoAReference<N, T>& source) = default;
+
+	// Access Operators
+	inline T& x() const
+	{
+		return this->lanes[0][this->index];
+	};
+	inline T& y() const
+	{
+		return this->lanes[1][this->index];
+	};
+	inline T& z() const
+	{
+		static_assert(N >= 3, "z() requires at least 3 dimensions.");
+		return this->lanes[2][this->index];
+	};
+	inline T& t() const
+	{
+		static_assert(N >= 4, "t() requires 4 dimensions.");
+		return this->lanes[3][this->index];
+	};
+	inline T& operator[](const uint64_t& i) const
+	{
+		return this->lanes[i][this->index];
+	};
+	inline T& get(const uint64_t& i) const
+	{
+		return (*this)[i];
+	};
+
+	// Conversion
+	inline VectorType load() const
+	{
+		VectorType v;
+		for (uint64_t i = 0; i < N; i++)
+		{
+			v.value[i] = this->lanes[i][this->index];
+		};
+		return v;
+	};
+	inline operator VectorType() const
+	{
+		return this->load();
+	};
+	inline const VectorSoAReference<N, T>& operator=(const VectorType& B) const
+	{
+		for (uint64_t i = 0; i < N; i++)
+		{
+			this->lanes[i][this->index] = B.value[i];
+		};
+		return (*this);
+	};
+	inline const VectorSoAReference<N, T>& operator=(const VectorSoAReference<N, T>& B) const
+	{
+		return ((*this) = B.load());
+	};
+
+	// Serialization
+	inline std::string toString() const
+	{
+		return ::toString(this->load());
+	};
+
+	// Magnitude Operators
+	inline T length() const
+	{
+		return this->load().length();
+	};
+	inline T sum() const
+	{
+		return this->load().sum();
+	};
+
+	// Normalization Methods
+	inline T norm() const
+	{
+		return this->load().norm();
+	};
+	inline T pNorm(const uint64_t& p) const
+	{
+		return this->load().pNorm(p);
+	};
+	inline VectorType unitNormal() const
+	{
+		return this->load().unitNormal();
+	};
+	inline VectorType normal() const
+	{
+		return this->load().normal();
+	};
+
+	// Product Operators
+	inline T dot(const VectorType& B) const
+	{
+		return this->load().dot(B);
+	};
+	inline VectorType cross(const VectorType& B) const
+	{
+		return this->load().cross(B);
+	};
+
+	// Binary Operators
+	inline VectorType operator+(const VectorType& B) const { return this->load() + B; };
+	inline VectorType operator+(const T& B) const { return this->load() + B; };
+	inline VectorType operator-(const VectorType& B) const { return this->load() - B; };
+	inline VectorType operator-(const T& B) const { return this->load() - B; };
+	inline VectorType operator*(const VectorType& B) const { return this->load() * B; };
+	inline VectorType operator*(const T& B) const { return this->load() * B; };
+	inline VectorType operator/(const VectorType& B) const { return this->load() / B; };
+	inline VectorType operator/(const T& B) const { return this->load() / B; };
+
+	// Binary Assignment Operators
+	inline const VectorSoAReference<N, T>& operator+=(const VectorType& B) const { return ((*this) = (this->load() + B)); };
+	inline const VectorSoAReference<N, T>& operator+=(const T& B) const { return ((*this) = (this->load() + B)); };
+	inline const VectorSoAReference<N, T>& operator-=(const VectorType& B) const { return ((*this) = (this->load() - B)); };
+	inline const VectorSoAReference<N, T>& operator-=(const T& B) const { return ((*this) = (this->load() - B)); };
+	inline const VectorSoAReference<N, T>& operator*=(const VectorType& B) const { return ((*this) = (this->load() * B)); };
+	inline const VectorSoAReference<N, T>& operator*=(const T& B) const { return ((*this) = (this->load() * B)); };
+	inline const VectorSoAReference<N, T>& operator/=(const VectorType& B) const { return ((*this) = (this->load() / B)); };
+	inline const VectorSoAReference<N, T>& operator/=(const T& B) const { return ((*this) = (this->load() / B)); };
+};
+
+template <uint64_t N, typename T>
+struct VectorSoA
+{
+	/*
+		# Vector SoA (struct)
+		A growable array of N dimensional vectors stored as N separate component
+		arrays. Every component array is aligned to a cache line and padded (with
+		zeroes) to a whole number of blocks, where a block is one cache line of
+		elements - 16 floats or 8 doubles - so the bulk kernels below can run whole
+		blocks without a scalar tail.
+	*/
+
+	static_assert((N >= 2) && (N <= 4), "VectorSoA supports 2, 3 and 4 dimensions.");
+
+	typedef typename VectorSoATraits<N, T>::VectorType VectorType;
+	typedef VectorSoAReference<N, T> Reference;
+
+	static constexpr size_t alignment = 64;
+	static constexpr size_t block = ((alignment / sizeof(T)) > 0) ? (alignment / sizeof(T)) : 1;
+
+	/* Elements */
+	T* lanes[N];
+	size_t count;
+	size_t capacity;
+
+	/* Methods */
+
+	// Constructors & Destructor
+	VectorSoA() : count(0), capacity(0)
+	{
+		for (uint64_t i = 0; i < N; i++)
+		{
+			this->lanes[i] = nullptr;
+		};
+	};
+	explicit VectorSoA(const size_t& count) : VectorSoA()
+	{
+		this->resize(count);
+	};
+	VectorSoA(const VectorType* source, const size_t& count) : VectorSoA()
+	{
+		this->resize(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			(*this)[i] = source[i];
+		};
+	};
+	VectorSoA(const VectorSoA<N, T>& source) : VectorSoA()
+	{
+		(*this) = source;
+	};
+	VectorSoA(VectorSoA<N, T>&& source) noexcept : VectorSoA()
+	{
+		this->swap(source);
+	};
+	~VectorSoA()
+	{
+		this->release();
+	};
+
+	// Assignment Operators
+	inline VectorSoA<N, T>& operator=(const VectorSoA<N, T>& source)
+	{
+		if (this != &source)
+		{
+			this->resize(source.count);
+			for (uint64_t i = 0; i < N; i++)
+			{
+				memcpy(this->lanes[i], source.lanes[i], source.count * sizeof(T));
+			};
+		};
+		return (*this);
+	};
+	inline VectorSoA<N, T>& operator=(VectorSoA<N, T>&& source) noexcept
+	{
+		this->swap(source);
+		return (*this);
+	};
+
+	// Capacity Methods
+	inline size_t size() const
+	{
+		return this->count;
+	};
+	inline bool empty() const
+	{
+		return (this->count == 0);
+	};
+	inline size_t paddedSize() const
+	{
+		/*
+			The number of elements rounded up to a whole number of blocks, which is how
+			far the bulk kernels run. Elements past size() are always zero.
+		*/
+
+		return (((this->count + block - 1) / block) * block);
+	};
+	inline void reserve(const size_t& n)
+	{
+		if (n <= this->capacity)
+		{
+			return;
+		};
+
+		const size_t padded = (((n + block - 1) / block) * block);
+		for (uint64_t i = 0; i < N; i++)
+		{
+			T* lane = (T*)vectorsAlignedAlloc(padded * sizeof(T), alignment);
+			if (this->lanes[i] != nullptr)
+			{
+				memcpy(lane, this->lanes[i], this->count * sizeof(T));
+				vectorsAlignedFree(this->lanes[i], alignment);
+			};
+			memset(lane + this->count, 0, (padded - this->count) * sizeof(T));
+			this->lanes[i] = lane;
+		};
+		this->capacity = padded;
+	};
+	inline void resize(const size_t& n)
+	{
+		this->reserve(n);
+		if (n < this->count)
+		{
+			for (uint64_t i = 0; i < N; i++)
+			{
+				memset(this->lanes[i] + n, 0, (this->count - n) * sizeof(T));
+			};
+		};
+		this->count = n;
+	};
+	inline void clear()
+	{
+		this->resize(0);
+	};
+	inline void release()
+	{
+		for (uint64_t i = 0; i < N; i++)
+		{
+			if (this->lanes[i] != nullptr)
+			{
+				vectorsAlignedFree(this->lanes[i], alignment);
+				this->lanes[i] = nullptr;
+			};
+		};
+		this->count = 0;
+		this->capacity = 0;
+	};
+	inline void swap(VectorSoA<N, T>& B) noexcept
+	{
+		for (uint64_t i = 0; i < N; i++)
+		{
+			std::swap(this->lanes[i], B.lanes[i]);
+		};
+		std::swap(this->count, B.count);
+		std::swap(this->capacity, B.capacity);
+	};
+	inline void push_back(const VectorType& v)
+	{
+		if (this->count == this->capacity)
+		{
+			this->reserve((this->capacity > 0) ? (this->capacity * 2) : block);
+		};
+		this->count++;
+		(*this)[this->count - 1] = v;
+	};
+
+	// Access Operators
+	inline Reference operator[](const size_t& i)
+	{
+		return Reference(this->lanes, i);
+	};
+	inline VectorType operator[](const size_t& i) const
+	{
+		return Reference(this->lanes, i).load();
+	};
+	inline Reference get(const size_t& i)
+	{
+		return (*this)[i];
+	};
+	inline VectorType get(const size_t& i) const
+	{
+		return (*this)[i];
+	};
+	inline T* component(const uint64_t& i)
+	{
+		return this->lanes[i];
+	};
+	inline const T* component(const uint64_t& i) const
+	{
+		return this->lanes[i];
+	};
+	inline T* x() { return this->lanes[0]; };
+	inline const T* x() const { return this->lanes[0]; };
+	inline T* y() { return this->lanes[1]; };
+	inline const T* y() const { return this->lanes[1]; };
+	inline T* z() { static_assert(N >= 3, "z() requires at least 3 dimensions."); return this->lanes[2]; };
+	inline const T* z() const { static_assert(N >= 3, "z() requires at least 3 dimensions."); return this->lanes[2]; };
+	inline T* t() { static_assert(N >= 4, "t() requires 4 dimensions."); return this->lanes[3]; };
+	inline const T* t() const { static_assert(N >= 4, "t() requires 4 dimensions."); return this->lanes[3]; };
+
+	// Bulk Operators
+	inline bool add(const VectorSoA<N, T>& B)
+	{
+		/*
+			Adds B, which may be this, to this element-wise. Returns false, leaving this
+			unchanged, if B isn't the same size.
+		*/
+
+		if (B.count != this->count)
+		{
+			return false;
+		};
+
+		const size_t n = this->paddedSize();
+		for (uint64_t c = 0; c < N; c++)
+		{
+			T* a = vectorsAssumeAligned<alignment>(this->lanes[c]);
+			const T* b = vectorsAssumeAligned<alignment>(B.lanes[c]);
+			for (size_t i = 0; i < n; i += block)
+			{
+				for (size_t j = 0; j < block; j++)
+				{
+					a[i + j] += b[i + j];
+				};
+			};
+		};
+		return true;
+	};
+	inline VectorSoA<N, T>& scale(const T& s)
+	{
+		/*
+			Multiplies every element by s. The padding is cleared afterwards, as an
+			infinite or NaN s would otherwise turn its zeros into NaNs.
+		*/
+
+		const size_t n = this->paddedSize();
+		for (uint64_t c = 0; c < N; c++)
+		{
+			T* VECTORS_RESTRICT a = vectorsAssumeAligned<alignment>(this->lanes[c]);
+			for (size_t i = 0; i < n; i += block)
+			{
+				for (size_t j = 0; j < block; j++)
+				{
+					a[i + j] *= s;
+				};
+			};
+			memset(a + this->count, 0, (n - this->count) * sizeof(T));
+		};
+		return (*this);
+	};
+	inline bool dot(const VectorSoA<N, T>& B, T* out) const
+	{
+		/*
+			Writes the dot product of each pair of elements of this and B into out, which
+			must hold size() values. Returns false, writing nothing, if B isn't the same
+			size.
+		*/
+
+		if (B.count != this->count)
+		{
+			return false;
+		};
+
+		const size_t n = this->count;
+		const size_t blocked = ((n / block) * block);
+		size_t i = 0;
+		for (; i < blocked; i += block)
+		{
+			T values[block];
+			for (size_t j = 0; j < block; j++)
+			{
+				values[j] = this->lanes[0][i + j] * B.lanes[0][i + j];
+			};
+			for (uint64_t c = 1; c < N; c++)
+			{
+				const T* VECTORS_RESTRICT a = vectorsAssumeAligned<alignment>(this->lanes[c]);
+				const T* VECTORS_RESTRICT b = vectorsAssumeAligned<alignment>(B.lanes[c]);
+				for (size_t j = 0; j < block; j++)
+				{
+					values[j] += a[i + j] * b[i + j];
+				};
+			};
+			memcpy(out + i, values, sizeof(values));
+		};
+		for (; i < n; i++)
+		{
+			T value = T();
+			for (uint64_t c = 0; c < N; c++)
+			{
+				value += this->lanes[c][i] * B.lanes[c][i];
+			};
+			out[i] = value;
+		};
+		return true;
+	};
+	inline bool cross(const VectorSoA<N, T>& B, VectorSoA<N, T>& out) const
+	{
+		/*
+			Writes the cross product of each pair of elements of this and B into out,
+			which is resized to match and may be this or B. Returns false, leaving out
+			unchanged, if B isn't the same size.
+		*/
+
+		static_assert(N == 3, "The cross product is only defined for 3 dimensions.");
+		if (B.count != this->count)
+		{
+			return false;
+		};
+		if ((&out == this) || (&out == &B))
+		{
+			// The kernel takes out as a restrict pointer, so a result aliasing an
+			// operand is built separately and swapped in.
+			VectorSoA<N, T> C;
+			this->cross(B, C);
+			out.swap(C);
+			return true;
+		};
+		out.resize(this->count);
+
+		const size_t n = this->paddedSize();
+		const T* VECTORS_RESTRICT ax = vectorsAssumeAligned<alignment>(this->lanes[0]);
+		const T* VECTORS_RESTRICT ay = vectorsAssumeAligned<alignment>(this->lanes[1]);
+		const T* VECTORS_RESTRICT az = vectorsAssumeAligned<alignment>(this->lanes[2]);
+		const T* VECTORS_RESTRICT bx = vectorsAssumeAligned<alignment>(B.lanes[0]);
+		const T* VECTORS_RESTRICT by = vectorsAssumeAligned<alignment>(B.lanes[1]);
+		const T* VECTORS_RESTRICT bz = vectorsAssumeAligned<alignment>(B.lanes[2]);
+		T* VECTORS_RESTRICT cx = vectorsAssumeAligned<alignment>(out.lanes[0]);
+		T* VECTORS_RESTRICT cy = vectorsAssumeAligned<alignment>(out.lanes[1]);
+		T* VECTORS_RESTRICT cz = vectorsAssumeAligned<alignment>(out.lanes[2]);
+		for (size_t i = 0; i < n; i += block)
+		{
+			for (size_t j = 0; j < block; j++)
+			{
+				const size_t k = i + j;
+				cx[k] = (ay[k] * bz[k]) - (az[k] * by[k]);
+				cy[k] = (az[k] * bx[k]) - (ax[k] * bz[k]);
+				cz[k] = (ax[k] * by[k]) - (ay[k] * bx[k]);
+			};
+		};
+		return true;
+	};
+	inline void norm(T* out) const
+	{
+		/*
+			Writes the euclidean norm of each element into out, which must hold size()
+			values.
+		*/
+
+		this->dot(*this, out);
+		for (size_t i = 0; i < this->count; i++)
+		{
+			out[i] = (T)std::sqrt(out[i]);
+		};
+	};
+	inline VectorSoA<N, T>& normalize()
+	{
+		/*
+			Scales every element to unit length in place. Zero length elements are left
+			as they are.
+		*/
+
+		const size_t n = this->paddedSize();
+		for (size_t i = 0; i < n; i += block)
+		{
+			T scales[block];
+			for (size_t j = 0; j < block; j++)
+			{
+				scales[j] = this->lanes[0][i + j] * this->lanes[0][i + j];
+			};
+			for (uint64_t c = 1; c < N; c++)
+			{
+				const T* VECTORS_RESTRICT a = vectorsAssumeAligned<alignment>(this->lanes[c]);
+				for (size_t j = 0; j < block; j++)
+				{
+					scales[j] += a[i + j] * a[i + j];
+				};
+			};
+			for (size_t j = 0; j < block; j++)
+			{
+				scales[j] = (scales[j] > T()) ? ((T)1 / (T)std::sqrt(scales[j])) : (T)1;
+			};
+			for (uint64_t c = 0; c < N; c++)
+			{
+				T* VECTORS_RESTRICT a = vectorsAssumeAligned<alignment>(this->lanes[c]);
+				for (size_t j = 0; j < block; j++)
+				{
+					a[i + j] *= scales[j];
+				};
+			};
+		};
+		return (*this);
+	};
+};
+
+/* Pipe Operators */
+template <uint64_t N, typename T>
+std::ostream& operator<<(std::ostream& stream, const VectorSoAReference<N, T>& value)
+{
+	return stream << toString(value.load());
+};
+
+#endif
@@ -0,0 +1,893 @@
+#pragma once
+/*
+	# Vector Template Library - Sparse Vectors
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	SparseVector<T>, a vector of many dimensions of which only a few are non
+	zero, such as the bag of words features of a document, stored as the sorted
+	indices of its non zero elements and their values. It has the methods of
+	Vector<N,T> (dot(), norm(), pNorm(), normal(), the scalar operators) with
+	products to match:
+
+		* Sparse-dense dot products gather the dense elements at the sparse
+		  indices, with the gather instructions of AVX2 and AVX-512 when the
+		  running CPU has them (dispatched like the batch operations, see
+		  vectors_batch.h).
+		* Sparse-sparse dot products intersect the two index lists, with a
+		  blocked SIMD merge when their lengths are alike, and by galloping
+		  (exponential) search through the longer list otherwise.
+		* batchScore() multiplies sparse vectors by a dense matrix, e.g. to score
+		  feature vectors against the weights of every class or item at once, and
+		  batchDot() takes the dot products of many sparse vectors with one dense
+		  vector.
+
+		SparseVector<float> features(100000);
+		features.append(17, 0.5f);
+		features.append(4242, 1.0f);
+		...
+		batchScore(&features, 1, weights.data(), classes, scores.data());
+
+	Indices are 32 bit; the gather instructions treat them as signed, so sizes
+	past 2^31 fall back to scalar loads.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+#ifndef VECTOR_TEMPLATE_LIBRARY_SPARSE__H
+#define VECTOR_TEMPLATE_LIBRARY_SPARSE__H
+/* Deps */
+#include "vectors.h"
+#include "vectors_batch.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+/* Macros */
+#ifndef VECTORS_PREFETCH
+	#if defined(__GNUC__) || defined(__clang__)
+		#define VECTORS_PREFETCH(address) __builtin_prefetch((const void*)(address))
+	#else
+		#define VECTORS_PREFETCH(address) ((void)0)
+	#endif
+#endif
+
+/* Math Helpers */
+template <int ISA>
+struct VectorSparseMath
+{
+	/*
+		# Vector Sparse Math (struct)
+		The loops behind the sparse products, over the n non zero elements of a
+		sparse vector, given as their indices and values.
+
+		dot() is the dot product with a dense array B, gathering B at each index.
+		The generic form keeps four accumulators; the AVX2 and AVX-512 forms gather
+		a register of B at a time. score() adds values[k] times row indices[k] of
+		the row major matrix M to out, a row at a time, so its inner loop is a
+		contiguous multiply-add for the compiler to vectorize.
+	*/
+
+	template <typename T>
+	static VECTORS_ALWAYS_INLINE T dot(const uint32_t* indices, const T* values, const size_t& n, const T* B)
+	{
+		T sums[4] = {};
+		size_t k = 0;
+		for (; (k + 4) <= n; k += 4)
+		{
+			for (size_t l = 0; l < 4; l++)
+			{
+				sums[l] += (values[k + l] * B[indices[k + l]]);
+			};
+		};
+		T value = ((sums[0] + sums[1]) + (sums[2] + sums[3]));
+		for (; k < n; k++)
+		{
+			value += (values[k] * B[indices[k]]);
+		};
+		return value;
+	};
+	template <typename T>
+	static VECTORS_ALWAYS_INLINE void score(const uint32_t* indices, const T* values, const size_t& n, const T* M, const size_t& columns, T* VECTORS_RESTRICT out)
+	{
+		for (size_t c = 0; c < columns; c++)
+		{
+			out[c] = T();
+		};
+		for (size_t k = 0; k < n; k++)
+		{
+			if ((k + 4) < n)
+			{
+				VECTORS_PREFETCH(M + ((size_t)indices[k + 4] * columns));
+			};
+			const T v = values[k];
+			const T* VECTORS_RESTRICT row = (M + ((size_t)indices[k] * columns));
+			for (size_t c = 0; c < columns; c++)
+			{
+				out[c] += (v * row[c]);
+			};
+		};
+	};
+};
+
+#if VECTORS_DISPATCH
+template <>
+struct VectorSparseMath<VECTORS_ISA_AVX2> : VectorSparseMath<VECTORS_ISA_GENERIC>
+{
+	using VectorSparseMath<VECTORS_ISA_GENERIC>::dot;
+
+	VECTORS_TARGET_AVX2 static inline float dot(const uint32_t* indices, const float* values, const size_t& n, const float* B)
+	{
+		__m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps();
+		size_t k = 0;
+		for (; (k + 16) <= n; k += 16)
+		{
+			s0 = _mm256_fmadd_ps(_mm256_loadu_ps(values + k), _mm256_i32gather_ps(B, _mm256_loadu_si256((const __m256i*)(indices + k)), 4), s0);
+			s1 = _mm256_fmadd_ps(_mm256_loadu_ps(values + k + 8), _mm256_i32gather_ps(B, _mm256_loadu_si256((const __m256i*)(indices + k + 8)), 4), s1);
+		};
+		for (; (k + 8) <= n; k += 8)
+		{
+			s0 = _mm256_fmadd_ps(_mm256_loadu_ps(values + k), _mm256_i32gather_ps(B, _mm256_loadu_si256((const __m256i*)(indices + k)), 4), s0);
+		};
+		float value = vectorsReduceAdd(_mm256_add_ps(s0, s1));
+		for (; k < n; k++)
+		{
+			value += (values[k] * B[indices[k]]);
+		};
+		return value;
+	};
+	VECTORS_TARGET_AVX2 static inline double dot(const uint32_t* indices, const double* values, const size_t& n, const double* B)
+	{
+		/*
+			The unmasked double gathers trip a spurious uninitialized warning in GCC 12,
+			so these use the masked forms over a zeroed register.
+		*/
+
+		const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+		__m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+		size_t k = 0;
+		for (; (k + 8) <= n; k += 8)
+		{
+			s0 = _mm256_fmadd_pd(_mm256_loadu_pd(values + k), _mm256_mask_i32gather_pd(_mm256_setzero_pd(), B, _mm_loadu_si128((const __m128i*)(indices + k)), all, 8), s0);
+			s1 = _mm256_fmadd_pd(_mm256_loadu_pd(values + k + 4), _mm256_mask_i32gather_pd(_mm256_setzero_pd(), B, _mm_loadu_si128((const __m128i*)(indices + k + 4)), all, 8), s1);
+		};
+		const __m256d sums = _mm256_add_pd(s0, s1);
+		const __m128d halves = _mm_add_pd(_mm256_castpd256_pd128(sums), _mm256_extractf128_pd(sums, 1));
+		double value = _mm_cvtsd_f64(_mm_add_sd(halves, _mm_unpackhi_pd(halves, halves)));
+		for (; k < n; k++)
+		{
+			value += (values[k] * B[indices[k]]);
+		};
+		return value;
+	};
+};
+
+template <>
+struct VectorSparseMath<VECTORS_ISA_AVX512> : VectorSparseMath<VECTORS_ISA_GENERIC>
+{
+	/*
+		16 floats (or 8 doubles) a register; whatever is left over goes through the
+		AVX2 form. The gathers are masked for the same reason as the AVX2 double
+		ones.
+	*/
+
+	using VectorSparseMath<VECTORS_ISA_GENERIC>::dot;
+
+	VECTORS_TARGET_AVX512 static inline float dot(const uint32_t* indices, const float* values, const size_t& n, const float* B)
+	{
+		__m512 s0 = _mm512_setzero_ps(), s1 = _mm512_setzero_ps();
+		size_t k = 0;
+		for (; (k + 32) <= n; k += 32)
+		{
+			s0 = _mm512_fmadd_ps(_mm512_loadu_ps(values + k), _mm512_mask_i32gather_ps(_mm512_setzero_ps(), (__mmask16)0xFFFF, _mm512_loadu_si512((const void*)(indices + k)), B, 4), s0);
+			s1 = _mm512_fmadd_ps(_mm512_loadu_ps(values + k + 16), _mm512_mask_i32gather_ps(_mm512_setzero_ps(), (__mmask16)0xFFFF, _mm512_loadu_si512((const void*)(indices + k + 16)), B, 4), s1);
+		};
+		for (; (k + 16) <= n; k += 16)
+		{
+			s0 = _mm512_fmadd_ps(_mm512_loadu_ps(values + k), _mm512_mask_i32gather_ps(_mm512_setzero_ps(), (__mmask16)0xFFFF, _mm512_loadu_si512((const void*)(indices + k)), B, 4), s0);
+		};
+		return (vectorsReduceAdd(_mm512_add_ps(s0, s1)) + VectorSparseMath<VECTORS_ISA_AVX2>::dot(indices + k, values + k, n - k, B));
+	};
+	VECTORS_TARGET_AVX512 static inline double dot(const uint32_t* indices, const double* values, const size_t& n, const double* B)
+	{
+		__m512d s0 = _mm512_setzero_pd(), s1 = _mm512_setzero_pd();
+		size_t k = 0;
+		for (; (k + 16) <= n; k += 16)
+		{
+			s0 = _mm512_fmadd_pd(_mm512_loadu_pd(values + k), _mm512_mask_i32gather_pd(_mm512_setzero_pd(), (__mmask8)0xFF, _mm256_loadu_si256((const __m256i*)(indices + k)), B, 8), s0);
+			s1 = _mm512_fmadd_pd(_mm512_loadu_pd(values + k + 8), _mm512_mask_i32gather_pd(_mm512_setzero_pd(), (__mmask8)0xFF, _mm256_loadu_si256((const __m256i*)(indices + k + 8)), B, 8), s1);
+		};
+		return (vectorsReduceAdd(_mm512_add_pd(s0, s1)) + VectorSparseMath<VECTORS_ISA_AVX2>::dot(indices + k, values + k, n - k, B));
+	};
+};
+#endif
+
+/* Kernels */
+struct VectorSparseDot
+{
+	template <int ISA, typename T>
+	static VECTORS_ALWAYS_INLINE T run(const uint32_t* indices, const T* values, size_t n, const T* B)
+	{
+		return VectorSparseMath<ISA>::dot(indices, values, n, B);
+	};
+};
+struct VectorSparseBatchDot
+{
+	template <int ISA, typename S, typename T>
+	static VECTORS_ALWAYS_INLINE void run(const S* A, const T* B, T* out, size_t n)
+	{
+		for (size_t i = 0; i < n; i++)
+		{
+			if (A[i].size() > ((size_t)INT32_MAX + 1))
+			{
+				out[i] = VectorSparseMath<VECTORS_ISA_GENERIC>::dot(A[i].indices(), A[i].values(), A[i].nonZeros(), B);
+				continue;
+			};
+			out[i] = VectorSparseMath<ISA>::dot(A[i].indices(), A[i].values(), A[i].nonZeros(), B);
+		};
+	};
+};
+struct VectorSparseScore
+{
+	template <int ISA, typename S, typename T>
+	static VECTORS_ALWAYS_INLINE void run(const S* A, size_t n, const T* M, size_t columns, T* out)
+	{
+		for (size_t i = 0; i < n; i++)
+		{
+			VectorSparseMath<ISA>::score(A[i].indices(), A[i].values(), A[i].nonZeros(), M, columns, (out + (i * columns)));
+		};
+	};
+};
+
+/* Intersection */
+inline size_t vectorsGallop(const uint32_t* A, size_t first, const size_t& n, const uint32_t& target)
+{
+	/*
+		The first position at or after first in the sorted array A[0] .. A[n - 1]
+		whose value is at least target, or n. The step doubles until it passes the
+		target and a binary search finishes the job, so it costs O(log d) for a
+		distance d rather than the O(d) of walking.
+	*/
+
+	size_t step = 1;
+	while (((first + step) < n) && (A[first + step] < target))
+	{
+		first += step;
+		step *= 2;
+	};
+	return (size_t)(std::lower_bound((A + first), (A + std::min((first + step + 1), n)), target) - A);
+};
+
+template <typename T>
+inline T vectorsSparseDot(const uint32_t* iA, const T* vA, const size_t& nA, const uint32_t* iB, const T* vB, const size_t& nB)
+{
+	/*
+		The dot product of two sparse vectors, the sum over the indices they share.
+		Lists of similar length are merged, a block of 4 indices from each at a
+		time; when one is over 16 times the other, each index of the short list is
+		galloped to in the long one instead.
+	*/
+
+	if (nA > nB)
+	{
+		return vectorsSparseDot(iB, vB, nB, iA, vA, nA);
+	};
+
+	T value = T();
+	if ((nA * 16) < nB)
+	{
+		size_t j = 0;
+		for (size_t i = 0; (i < nA) && (j < nB); i++)
+		{
+			j = vectorsGallop(iB, j, nB, iA[i]);
+			if ((j < nB) && (iB[j] == iA[i]))
+			{
+				value += (vA[i] * vB[j]);
+			};
+		};
+		return value;
+	};
+
+	size_t i = 0;
+	size_t j = 0;
+	while (((i + 4) <= nA) && ((j + 4) <= nB))
+	{
+		/*
+			A block of 4 indices from each list is compared all against all (with 4
+			SSE compares against rotations of one block), and the block ending on the
+			smaller index is passed, so the loop waits on one load for every 4 elements
+			rather than every one. Shared indices are rare, and are only looked for in
+			blocks which have some.
+		*/
+
+#if VECTORS_SSE
+		const __m128i a4 = _mm_loadu_si128((const __m128i*)(iA + i));
+		const __m128i b4 = _mm_loadu_si128((const __m128i*)(iB + j));
+		const __m128i equal = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi32(a4, b4), _mm_cmpeq_epi32(a4, _mm_shuffle_epi32(b4, _MM_SHUFFLE(0, 3, 2, 1)))),
+			_mm_or_si128(_mm_cmpeq_epi32(a4, _mm_shuffle_epi32(b4, _MM_SHUFFLE(1, 0, 3, 2))), _mm_cmpeq_epi32(a4, _mm_shuffle_epi32(b4, _MM_SHUFFLE(2, 1, 0, 3))))
+		);
+		const bool shared = (_mm_movemask_epi8(equal) != 0);
+#else
+		bool shared = false;
+		for (size_t a = 0; a < 4; a++)
+		{
+			for (size_t b = 0; b < 4; b++)
+			{
+				shared |= (iA[i + a] == iB[j + b]);
+			};
+		};
+#endif
+		if (shared)
+		{
+			for (size_t a = 0; a < 4; a++)
+			{
+				for (size_t b = 0; b < 4; b++)
+				{
+					if (iA[i + a] == iB[j + b])
+					{
+						value += (vA[i + a] * vB[j + b]);
+					};
+				};
+			};
+		};
+		const uint32_t a = iA[i + 3];
+		const uint32_t b = iB[j + 3];
+		i += ((size_t)(a <= b) * 4);
+		j += ((size_t)(b <= a) * 4);
+	};
+	while ((i < nA) && (j < nB))
+	{
+		const uint32_t a = iA[i];
+		const uint32_t b = iB[j];
+		if (a == b)
+		{
+			value += (vA[i] * vB[j]);
+		};
+		i += (a <= b);
+		j += (b <= a);
+	};
+	return value;
+};
+
+/* Structures */
+template <typename T>
+struct SparseVector
+{
+	/*
+		# Sparse Vector (struct)
+		A vector of size() elements, of which nonZeros() are stored, as indices in
+		increasing order and their values; every other element is zero. Stored
+		elements may be zero too (e.g. after scaling by zero), which changes no
+		result; prune() drops them.
+	*/
+
+	typedef T value_type;
+	typedef uint32_t Index;
+
+	/* Methods */
+
+	// Constructors & Destructor
+	SparseVector() {};
+	explicit SparseVector(const size_t& dimensions) : dimensions(dimensions) {};
+	SparseVector(const size_t& dimensions, const Index* indices, const T* values, const size_t& n)
+	{
+		this->assign(dimensions, indices, values, n);
+	};
+	SparseVector(const T* A, const size_t& dimensions) : dimensions(dimensions)
+	{
+		/*
+			The non zero elements of the dense array A[0] .. A[dimensions - 1].
+		*/
+
+		for (size_t i = 0; i < dimensions; i++)
+		{
+			if (A[i] != T())
+			{
+				this->entries.push_back((Index)i);
+				this->elements.push_back(A[i]);
+			};
+		};
+	};
+	template <uint64_t N>
+	explicit SparseVector(const Vector<N, T>& source) : SparseVector(source.value, (size_t)N) {};
+
+	// Capacity Methods
+	inline size_t size() const
+	{
+		return this->dimensions;
+	};
+	inline size_t nonZeros() const
+	{
+		return this->entries.size();
+	};
+	inline bool empty() const
+	{
+		return this->entries.empty();
+	};
+	inline void reserve(const size_t& n)
+	{
+		this->entries.reserve(n);
+		this->elements.reserve(n);
+	};
+	inline void clear()
+	{
+		/*
+			Sets every element to zero, keeping the size.
+		*/
+
+		this->entries.clear();
+		this->elements.clear();
+	};
+	inline void prune()
+	{
+		/*
+			Drops the stored elements which are zero.
+		*/
+
+		size_t kept = 0;
+		for (size_t k = 0; k < this->entries.size(); k++)
+		{
+			if (this->elements[k] != T())
+			{
+				this->entries[kept] = this->entries[k];
+				this->elements[kept] = this->elements[k];
+				kept++;
+			};
+		};
+		this->entries.resize(kept);
+		this->elements.resize(kept);
+	};
+
+	// Assignment
+	inline bool assign(const size_t& dimensions, const Index* indices, const T* values, const size_t& n)
+	{
+		/*
+			Sets the vector to the given elements, in any order, adding up the values of
+			repeated indices. Returns false, leaving the vector empty, if any index is
+			not below dimensions.
+		*/
+
+		this->dimensions = dimensions;
+		this->clear();
+		std::vector<size_t> order(n);
+		std::iota(order.begin(), order.end(), 0);
+		if (!std::is_sorted(indices, (indices + n)))
+		{
+			std::stable_sort(order.begin(), order.end(), [&](const size_t& a, const size_t& b) { return (indices[a] < indices[b]); });
+		};
+
+		this->reserve(n);
+		for (const size_t& k : order)
+		{
+			if (indices[k] >= dimensions)
+			{
+				this->clear();
+				return false;
+			};
+			if (!this->entries.empty() && (this->entries.back() == indices[k]))
+			{
+				this->elements.back() += values[k];
+				continue;
+			};
+			this->entries.push_back(indices[k]);
+			this->elements.push_back(values[k]);
+		};
+		return true;
+	};
+	inline bool append(const Index& i, const T& value)
+	{
+		/*
+			Sets element i, which must come after every stored index, in O(1). Returns
+			false if it doesn't, or is past the end.
+		*/
+
+		if ((i >= this->dimensions) || (!this->entries.empty() && (i <= this->entries.back())))
+		{
+			return false;
+		};
+		this->entries.push_back(i);
+		this->elements.push_back(value);
+		return true;
+	};
+	inline bool set(const Index& i, const T& value)
+	{
+		/*
+			Sets element i, in O(nonZeros()) if it isn't stored yet. Returns false if i is
+			past the end.
+		*/
+
+		if (i >= this->dimensions)
+		{
+			return false;
+		};
+		const size_t k = this->find(i);
+		if ((k < this->entries.size()) && (this->entries[k] == i))
+		{
+			this->elements[k] = value;
+			return true;
+		};
+		this->entries.insert((this->entries.begin() + k), i);
+		this->elements.insert((this->elements.begin() + k), value);
+		return true;
+	};
+
+	// Conversion
+	inline void toDense(T* out) const
+	{
+		/*
+			Writes all size() elements to out.
+		*/
+
+		std::fill(out, (out + this->dimensions), T());
+		for (size_t k = 0; k < this->entries.size(); k++)
+		{
+			out[this->entries[k]] = this->elements[k];
+		};
+	};
+	template <uint64_t N>
+	inline bool toVector(Vector<N, T>& out) const
+	{
+		/*
+			Copies this into a Vector<N,T>. Returns false, leaving out as it was, if
+			the sizes differ.
+		*/
+
+		if (this->dimensions != N)
+		{
+			return false;
+		};
+		this->toDense(out.value);
+		return true;
+	};
+
+	// Access Operators
+	inline T operator[](const size_t& i) const
+	{
+		return this->get(i);
+	};
+	inline T get(const size_t& i) const
+	{
+		/*
+			Element i, found by binary search, or zero if it isn't stored.
+		*/
+
+		const size_t k = this->find(i);
+		return ((k < this->entries.size()) && (this->entries[k] == i)) ? this->elements[k] : T();
+	};
+	inline const Index* indices() const
+	{
+		return this->entries.data();
+	};
+	inline const T* values() const
+	{
+		return this->elements.data();
+	};
+	inline T* values()
+	{
+		return this->elements.data();
+	};
+
+	// Magnitude Operators
+	inline T length() const
+	{
+		return this->norm();
+	};
+	inline T sum() const
+	{
+		T sum = T();
+		for (const T& v : this->elements)
+		{
+			sum += vectorsAbs(v);
+		};
+		return sum;
+	};
+
+	// Normalization Methods
+	inline T squaredNorm() const
+	{
+		T sum = T();
+		for (const T& v : this->elements)
+		{
+			sum += (v * v);
+		};
+		return sum;
+	};
+	inline T norm() const
+	{
+		return (T)std::sqrt(this->squaredNorm());
+	};
+	inline T fastInvNorm() const
+	{
+		/*
+			An approximation of 1 / norm(), see vectorsFastInverseSqrt().
+		*/
+
+		return vectorsFastInverseSqrt(this->squaredNorm());
+	};
+	inline T pNorm(const uint64_t& p) const
+	{
+		if (p == 1)
+		{
+			return this->sum();
+		};
+		if (p == 2)
+		{
+			return this->norm();
+		};
+
+		T sum = T();
+		for (const T& v : this->elements)
+		{
+			sum += vectorsIntegerPower(vectorsAbs(v), p);
+		};
+		return vectorsRoot(sum, p);
+	};
+	inline T infNorm() const
+	{
+		/*
+			The infinity norm, the limit of pNorm() as p grows: the largest absolute
+			element.
+		*/
+
+		T largest = T();
+		for (const T& v : this->elements)
+		{
+			const T a = vectorsAbs(v);
+			largest = (a > largest) ? a : largest;
+		};
+		return largest;
+	};
+
+	inline SparseVector<T> unitNormal() const
+	{
+		return ((*this) / this->norm());
+	};
+	inline SparseVector<T> fastUnitNormal() const
+	{
+		return ((*this) * this->fastInvNorm());
+	};
+	inline SparseVector<T> normal() const
+	{
+		/*
+			Returns the normal vector, calculated from dividing each element by the sum
+			of all the elements.
+		*/
+
+		return ((*this) / this->sum());
+	};
+
+	// Product Operators
+	inline T dot(const T* B, const size_t& n) const
+	{
+		/*
+			The dot product with the dense array B[0] .. B[n - 1], as if it were padded
+			with zeros to size(). Stored elements at n or past it are skipped.
+		*/
+
+		size_t count = this->entries.size();
+		if ((count > 0) && (this->entries.back() >= n))
+		{
+			count = this->find(n);
+		};
+		if (n > ((size_t)INT32_MAX + 1))
+		{
+			return VectorSparseMath<VECTORS_ISA_GENERIC>::dot(this->entries.data(), this->elements.data(), count, B);
+		};
+		return vectorsDispatch<VectorSparseDot>(this->entries.data(), this->elements.data(), count, B);
+	};
+	template <uint64_t N>
+	inline T dot(const Vector<N, T>& B) const
+	{
+		return this->dot(B.value, (size_t)N);
+	};
+	inline T dot(const SparseVector<T>& B) const
+	{
+		return vectorsSparseDot(this->entries.data(), this->elements.data(), this->entries.size(), B.entries.data(), B.elements.data(), B.entries.size());
+	};
+
+	// Unary Operators
+	inline SparseVector<T> operator+() const
+	{
+		return (*this);
+	};
+	inline SparseVector<T> operator-() const
+	{
+		SparseVector<T> C = (*this);
+		for (T& v : C.elements)
+		{
+			v = -v;
+		};
+		return C;
+	};
+
+	// Comparison Operators
+	inline bool operator==(const SparseVector<T>& B) const
+	{
+		/*
+			Vectors are equal if they have the same size and every element is exactly
+			equal, whether or not it is stored, so a stored zero equals a missing one.
+		*/
+
+		if (this->dimensions != B.dimensions)
+		{
+			return false;
+		};
+		bool equal = true;
+		this->merge(B, [&](const Index&, const T& a, const T& b) { equal = (equal && (a == b)); });
+		return equal;
+	};
+	inline bool operator!=(const SparseVector<T>& B) const
+	{
+		return !((*this) == B);
+	};
+
+	// Binary Operators
+	inline SparseVector<T> operator+(const SparseVector<T>& B) const
+	{
+		/*
+			The sum, stored at the union of the two index lists. The result has the
+			larger of the two sizes.
+		*/
+
+		SparseVector<T> C(std::max(this->dimensions, B.dimensions));
+		C.reserve(std::max(this->entries.size(), B.entries.size()));
+		this->merge(B, [&](const Index& i, const T& a, const T& b) { C.append(i, (a + b)); });
+		return C;
+	};
+	inline SparseVector<T> operator-(const SparseVector<T>& B) const
+	{
+		SparseVector<T> C(std::max(this->dimensions, B.dimensions));
+		C.reserve(std::max(this->entries.size(), B.entries.size()));
+		this->merge(B, [&](const Index& i, const T& a, const T& b) { C.append(i, (a - b)); });
+		return C;
+	};
+
+	inline SparseVector<T> operator*(const T& B) const
+	{
+		SparseVector<T> C = (*this);
+		return (C *= B);
+	};
+	inline SparseVector<T> operator/(const T& B) const
+	{
+		SparseVector<T> C = (*this);
+		return (C /= B);
+	};
+
+	// Binary Assignment Operators
+	inline SparseVector<T>& operator+=(const SparseVector<T>& B)
+	{
+		(*this) = ((*this) + B);
+		return (*this);
+	};
+	inline SparseVector<T>& operator-=(const SparseVector<T>& B)
+	{
+		(*this) = ((*this) - B);
+		return (*this);
+	};
+	inline SparseVector<T>& operator*=(const T& B)
+	{
+		for (T& v : this->elements)
+		{
+			v *= B;
+		};
+		return (*this);
+	};
+	inline SparseVector<T>& operator/=(const T& B)
+	{
+		for (T& v : this->elements)
+		{
+			v /= B;
+		};
+		return (*this);
+	};
+
+private:
+	/* Elements */
+	std::vector<Index> entries;
+	std::vector<T> elements;
+	size_t dimensions = 0;
+
+	/* Methods */
+	inline size_t find(const size_t& i) const
+	{
+		/*
+			The position of the first stored index at or after i.
+		*/
+
+		return (size_t)(std::lower_bound(this->entries.begin(), this->entries.end(), i, [](const Index& a, const size_t& b) { return ((size_t)a < b); }) - this->entries.begin());
+	};
+	template <typename F>
+	inline void merge(const SparseVector<T>& B, const F& f) const
+	{
+		/*
+			Calls f(i, a, b) for each index i stored in either vector, in order, with
+			the elements of this and B there.
+		*/
+
+		size_t i = 0;
+		size_t j = 0;
+		const size_t nA = this->entries.size();
+		const size_t nB = B.entries.size();
+		while ((i < nA) || (j < nB))
+		{
+			// Each side is compared by position rather than padded with a sentinel
+			// index, as every 32 bit index, UINT32_MAX included, may be stored.
+			if ((j == nB) || ((i < nA) && (this->entries[i] < B.entries[j])))
+			{
+				f(this->entries[i], this->elements[i], T());
+				i++;
+			}
+			else if ((i == nA) || (B.entries[j] < this->entries[i]))
+			{
+				f(B.entries[j], T(), B.elements[j]);
+				j++;
+			}
+			else
+			{
+				f(this->entries[i], this->elements[i], B.elements[j]);
+				i++;
+				j++;
+			};
+		};
+	};
+};
+
+/* Scalar Operators */
+template <typename T>
+inline SparseVector<T> operator*(const typename std::common_type<T>::type& A, const SparseVector<T>& B) { return (B * A); };
+
+/* Batch Products */
+template <typename T>
+inline void batchDot(const SparseVector<T>* A, const T* B, T* out, const size_t& n)
+{
+	/*
+		out[i] = A[i].dot(B) for n sparse vectors and the dense array B, which must
+		have at least as many elements as each of them.
+	*/
+
+	vectorsDispatch<VectorSparseBatchDot>(A, B, out, n);
+};
+template <typename T>
+inline void batchScore(const SparseVector<T>* A, const size_t& n, const T* M, const size_t& columns, T* out)
+{
+	/*
+		Multiplies each of the n sparse vectors by the dense row major matrix M,
+		with a row for each of their dimensions and the given number of columns,
+		writing the columns scores of A[i] to out[i * columns] onwards. Each stored
+		element adds its row of M, so only nonZeros() rows are read.
+	*/
+
+	vectorsDispatch<VectorSparseScore>(A, n, M, columns, out);
+};
+
+#if defined(__cpp_lib_span)
+/* Span Overloads */
+// Both return false, doing nothing, unless out has room for exactly the results.
+template <typename SA, typename T, typename SO>
+inline typename std::enable_if<VectorsSpanOf<SA, SparseVector<T>>::value && VectorsSpanOf<SO, T, true>::value, bool>::type batchDot(SA A, const T* B, SO out)
+{
+	if (out.size() != A.size())
+	{
+		return false;
+	};
+	batchDot(A.data(), B, out.data(), A.size());
+	return true;
+};
+template <typename SA, typename T, typename SO>
+inline typename std::enable_if<VectorsSpanOf<SA, SparseVector<T>>::value && VectorsSpanOf<SO, T, true>::value, bool>::type batchScore(SA A, const T* M, const size_t& columns, SO out)
+{
+	if (out.size() != (A.size() * columns))
+	{
+		return false;
+	};
+	batchScore(A.data(), A.size(), M, columns, out.data());
+	return true;
+};
+#endif
+
+#endif
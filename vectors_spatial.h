@@ -0,0 +1,1371 @@
+#pragma once
+/*
+	# Vector Template Library - Spatial Indexes
+	## Version 1.1
+	## By Joseph Juma
+
+	## About
+	Spatial indexes over Vector3D, for nearest point, radius and box queries on
+	point clouds and sets of boxes without scanning all of them:
+
+		* KdTree3<T>, a k-d tree over points.
+		* Bvh3<T>, a bounding volume hierarchy over axis aligned boxes (Box3<T>),
+		  or over points as boxes of zero size.
+
+		KdTree3<float> tree(points.data(), points.size());
+		tree.nearest(query, 8, results);
+		tree.withinRadius(query, 0.5f, found);
+
+	Both are built in bulk by splitting at the median along the widest axis,
+	which is O(n log n) and gives balanced trees, with the upper levels split
+	across threads. Nodes are stored flattened in depth first order, with the
+	left child directly after its parent and the points (or boxes) of each leaf
+	contiguous, so a query walks forwards through memory where it can.
+
+	The batched queries sort the queries by the leaf they fall in first, so
+	consecutive queries visit the same nodes and points while they are still in
+	cache, then split them across threads.
+
+	Ids are the positions of the points or boxes in the array the index was
+	built from. Distances are squared euclidean distances, as in
+	vectors_index.h.
+
+	## Copyright
+	Copyright Joseph M. Juma, 2024. All rights reserved.
+*/
+#ifndef VECTOR_TEMPLATE_LIBRARY_SPATIAL__H
+#define VECTOR_TEMPLATE_LIBRARY_SPATIAL__H
+/* Deps */
+#include "vectors.h"
+#include "vectors_curve.h"
+#include "vectors_index.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/* Boxes */
+template <typename T>
+struct Box3
+{
+	/*
+		# Box 3 (struct)
+		An axis aligned box from lower to upper, inclusive. A default constructed box
+		is empty (lower above upper), so expanding it by a point gives that point.
+	*/
+
+	/* Elements */
+	Vector3D<T> lower;
+	Vector3D<T> upper;
+
+	/* Methods */
+
+	// Constructors & Destructor
+	Box3() :
+		lower(std::numeric_limits<T>::max(), std::numeric_limits<T>::max(), std::numeric_limits<T>::max()),
+		upper(std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest())
+	{};
+	Box3(const Vector3D<T>& lower, const Vector3D<T>& upper) : lower(lower), upper(upper) {};
+	explicit Box3(const Vector3D<T>& point) : lower(point), upper(point) {};
+
+	// Modifiers
+	inline void expand(const Vector3D<T>& point)
+	{
+		for (uint64_t i = 0; i < 3; i++)
+		{
+			this->lower.value[i] = (point.value[i] < this->lower.value[i]) ? point.value[i] : this->lower.value[i];
+			this->upper.value[i] = (point.value[i] > this->upper.value[i]) ? point.value[i] : this->upper.value[i];
+		};
+	};
+	inline void expand(const Box3<T>& B)
+	{
+		for (uint64_t i = 0; i < 3; i++)
+		{
+			this->lower.value[i] = (B.lower.value[i] < this->lower.value[i]) ? B.lower.value[i] : this->lower.value[i];
+			this->upper.value[i] = (B.upper.value[i] > this->upper.value[i]) ? B.upper.value[i] : this->upper.value[i];
+		};
+	};
+
+	// Queries
+	inline bool empty() const
+	{
+		return (
+			(this->lower.value[0] > this->upper.value[0]) ||
+			(this->lower.value[1] > this->upper.value[1]) ||
+			(this->lower.value[2] > this->upper.value[2])
+		);
+	};
+	inline bool contains(const Vector3D<T>& point) const
+	{
+		return (
+			(point.value[0] >= this->lower.value[0]) && (point.value[0] <= this->upper.value[0]) &&
+			(point.value[1] >= this->lower.value[1]) && (point.value[1] <= this->upper.value[1]) &&
+			(point.value[2] >= this->lower.value[2]) && (point.value[2] <= this->upper.value[2])
+		);
+	};
+	inline bool overlaps(const Box3<T>& B) const
+	{
+		return (
+			(B.lower.value[0] <= this->upper.value[0]) && (B.upper.value[0] >= this->lower.value[0]) &&
+			(B.lower.value[1] <= this->upper.value[1]) && (B.upper.value[1] >= this->lower.value[1]) &&
+			(B.lower.value[2] <= this->upper.value[2]) && (B.upper.value[2] >= this->lower.value[2])
+		);
+	};
+	inline T squaredDistance(const Vector3D<T>& point) const
+	{
+		/*
+			The squared distance from point to the nearest point of the box, 0 inside.
+		*/
+
+		T sum = T();
+		for (uint64_t i = 0; i < 3; i++)
+		{
+			const T below = (this->lower.value[i] - point.value[i]);
+			const T above = (point.value[i] - this->upper.value[i]);
+			const T d = (below > T()) ? below : ((above > T()) ? above : T());
+			sum += (d * d);
+		};
+		return sum;
+	};
+	inline Vector3D<T> center() const
+	{
+		return ((this->lower + this->upper) * (T)0.5);
+	};
+	inline uint32_t longestAxis() const
+	{
+		const Vector3D<T> extent = (this->upper - this->lower);
+		uint32_t axis = (extent.value[1] > extent.value[0]) ? 1 : 0;
+		return (extent.value[2] > extent.value[axis]) ? 2 : axis;
+	};
+};
+
+/* Helpers */
+template <typename T>
+inline T vectorsSquaredDistance(const Vector3D<T>& A, const Vector3D<T>& B)
+{
+	const T dx = (A.value[0] - B.value[0]);
+	const T dy = (A.value[1] - B.value[1]);
+	const T dz = (A.value[2] - B.value[2]);
+	return ((dx * dx) + (dy * dy) + (dz * dz));
+};
+
+inline size_t vectorsSpatialNodeCount(const size_t& n, const size_t& leafSize)
+{
+	/*
+		The number of nodes in a tree over n items split at the median down to
+		leaves of at most leafSize. The shape only depends on n, so a subtree's nodes
+		can be placed before it is built, and subtrees built in parallel.
+	*/
+
+	if (n <= leafSize)
+	{
+		return 1;
+	};
+	return (1 + vectorsSpatialNodeCount(n / 2, leafSize) + vectorsSpatialNodeCount(n - (n / 2), leafSize));
+};
+
+inline size_t vectorsSpatialThreads(const size_t& threads, const size_t& count)
+{
+	/*
+		The number of threads to split count queries (or a build) across: threads, or
+		one per hardware thread if that is 0, but no more than count.
+	*/
+
+	size_t n = threads;
+	if (n == 0)
+	{
+		n = (size_t)std::thread::hardware_concurrency();
+	};
+	return std::max((size_t)1, std::min(n, count));
+};
+
+template <typename Locate, typename Run>
+inline void vectorsSpatialBatch(const size_t& count, const size_t& threads, const Locate& locate, const Run& run)
+{
+	/*
+		Orders count queries by the leaf locate(i) finds each in, then calls
+		run(order, first, last, worker) for contiguous ranges of that order, one per
+		worker thread (see vectorsSpatialThreads()).
+	*/
+
+	std::vector<std::pair<uint32_t, uint32_t>> keys(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		keys[i] = std::make_pair(locate(i), (uint32_t)i);
+	};
+	std::sort(keys.begin(), keys.end());
+	std::vector<uint32_t> order(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		order[i] = keys[i].second;
+	};
+
+	const size_t workers = vectorsSpatialThreads(threads, count);
+	const size_t share = ((count + workers - 1) / workers);
+	auto work = [&](const size_t& worker) {
+		const size_t first = (worker * share);
+		run(order.data(), first, std::min(count, (first + share)), worker);
+	};
+
+	std::vector<std::thread> pool;
+	for (size_t worker = 1; (worker * share) < count; worker++)
+	{
+		pool.emplace_back(work, worker);
+	};
+	work(0);
+	for (std::thread& thread : pool)
+	{
+		thread.join();
+	};
+};
+
+template <typename T>
+struct VectorSpatialResults
+{
+	/*
+		# Vector Spatial Results (struct)
+		The results of a batch of radius queries: those of query i are
+		results[offsets[i]] up to results[offsets[i + 1]], in no particular order.
+	*/
+
+	/* Elements */
+	std::vector<size_t> offsets;
+	std::vector<VectorNeighbour<T>> results;
+
+	/* Methods */
+
+	// Access Methods
+	inline size_t count(const size_t& i) const
+	{
+		return (this->offsets[i + 1] - this->offsets[i]);
+	};
+	inline const VectorNeighbour<T>* begin(const size_t& i) const
+	{
+		return (this->results.data() + this->offsets[i]);
+	};
+	inline const VectorNeighbour<T>* end(const size_t& i) const
+	{
+		return (this->results.data() + this->offsets[i + 1]);
+	};
+
+	// Gathering
+	template <typename Locate, typename Search>
+	inline void gather(const size_t& count, const size_t& threads, const Locate& locate, const Search& search)
+	{
+		/*
+			Runs search(i, buffer) for each query through vectorsSpatialBatch(), each
+			worker appending to its own buffer, then packs the buffers in query order.
+		*/
+
+		const size_t workers = vectorsSpatialThreads(threads, count);
+		std::vector<std::vector<VectorNeighbour<T>>> buffers(workers);
+		std::vector<std::pair<size_t, size_t>> spans(count); // (worker, start) of each query
+		std::vector<size_t> counts(count);
+
+		vectorsSpatialBatch(count, workers, locate, [&](const uint32_t* order, const size_t& first, const size_t& last, const size_t& worker) {
+			std::vector<VectorNeighbour<T>>& buffer = buffers[worker];
+			for (size_t j = first; j < last; j++)
+			{
+				const uint32_t i = order[j];
+				const size_t start = buffer.size();
+				search(i, buffer);
+				spans[i] = std::make_pair(worker, start);
+				counts[i] = (buffer.size() - start);
+			};
+		});
+
+		this->offsets.assign(count + 1, 0);
+		for (size_t i = 0; i < count; i++)
+		{
+			this->offsets[i + 1] = (this->offsets[i] + counts[i]);
+		};
+		this->results.resize(this->offsets[count]);
+		for (size_t i = 0; i < count; i++)
+		{
+			const VectorNeighbour<T>* source = (buffers[spans[i].first].data() + spans[i].second);
+			std::copy(source, source + counts[i], this->results.data() + this->offsets[i]);
+		};
+	};
+};
+
+/* K-D Tree */
+template <typename T>
+struct KdTree3
+{
+	/*
+		# K-D Tree 3 (struct)
+		A k-d tree over a set of 3D points. Each inner node splits its points at the
+		median along the axis they are most spread out on, down to leaves of at most
+		leafSize points.
+	*/
+
+	typedef Vector3D<T> V;
+
+	static constexpr size_t leafSize = 8;
+	static constexpr uint32_t leaf = 3;
+
+	struct Entry
+	{
+		V point;
+		uint32_t id;
+	};
+	struct Node
+	{
+		/*
+			An inner node's left child is the next node and index is its right child;
+			a leaf's points are entries[index] up to entries[index + count]. Points on
+			the split plane may be on either side.
+		*/
+
+		T split;
+		uint32_t index;
+		uint32_t count;
+		uint32_t axis;
+	};
+
+	/* Elements */
+	std::vector<Entry> entries;
+	std::vector<Node> nodes;
+
+	/* Methods */
+
+	// Constructors & Destructor
+	KdTree3() {};
+	KdTree3(const V* points, const size_t& n, const size_t& threads = 0)
+	{
+		this->build(points, n, threads);
+	};
+
+	// Capacity Methods
+	inline size_t size() const
+	{
+		return this->entries.size();
+	};
+	inline bool empty() const
+	{
+		return this->entries.empty();
+	};
+	inline void clear()
+	{
+		this->entries.clear();
+		this->nodes.clear();
+	};
+
+	// Construction
+	inline bool build(const V* points, const size_t& n, const size_t& threads = 0)
+	{
+		/*
+			Rebuilds the tree over points[0] to points[n - 1], with the upper levels
+			split across threads (by default one per hardware thread). Returns false,
+			leaving the tree empty, if there are too many points for 32 bit ids.
+		*/
+
+		this->clear();
+		if ((n == 0) || (n > (size_t)std::numeric_limits<uint32_t>::max()))
+		{
+			return (n == 0);
+		};
+
+		this->entries.resize(n);
+		for (size_t i = 0; i < n; i++)
+		{
+			this->entries[i].point = points[i];
+			this->entries[i].id = (uint32_t)i;
+		};
+		this->nodes.resize(vectorsSpatialNodeCount(n, leafSize));
+
+		// Every level down halves the work, so spawning log2(threads) levels deep uses them all
+		size_t depth = 0;
+		while (((size_t)1 << depth) < vectorsSpatialThreads(threads, n))
+		{
+			depth++;
+		};
+		this->buildNode(0, 0, n, depth);
+		return true;
+	};
+
+	// Query Methods
+	inline size_t nearest(const V& query, const size_t& k, VectorNeighbour<T>* out) const
+	{
+		/*
+			Finds the k nearest points to query, writing them to out nearest first, and
+			returns how many were found. The remaining slots are padded as in
+			FlatIndex::search().
+		*/
+
+		VectorTopK<T> top;
+		return this->nearest(query, k, out, top);
+	};
+	inline size_t withinRadius(const V& center, const T& radius, std::vector<VectorNeighbour<T>>& out) const
+	{
+		/*
+			Appends every point within radius of center (inclusive) to out, in no
+			particular order. Returns how many were appended.
+		*/
+
+		const size_t before = out.size();
+		if (this->empty())
+		{
+			return 0;
+		};
+
+		const T limit = (radius * radius);
+		uint32_t stack[64];
+		size_t top = 0;
+		stack[top++] = 0;
+		while (top > 0)
+		{
+			const Node* node = &this->nodes[stack[--top]];
+			while (node->axis != leaf)
+			{
+				const T d = (center.value[node->axis] - node->split);
+				const uint32_t left = (uint32_t)((node - this->nodes.data()) + 1);
+				if ((d * d) <= limit)
+				{
+					stack[top++] = (d < T()) ? node->index : left;
+				};
+				node = &this->nodes[(d < T()) ? left : node->index];
+			};
+			for (uint32_t i = node->index; i < (node->index + node->count); i++)
+			{
+				const T distance = vectorsSquaredDistance(center, this->entries[i].point);
+				if (distance <= limit)
+				{
+					out.push_back(VectorNeighbour<T>{ this->entries[i].id, distance });
+				};
+			};
+		};
+		return (out.size() - before);
+	};
+	inline size_t withinBox(const Box3<T>& box, std::vector<uint64_t>& out) const
+	{
+		/*
+			Appends the id of every point inside box (inclusive) to out, in no
+			particular order. Returns how many were appended.
+		*/
+
+		const size_t before = out.size();
+		if (this->empty() || box.empty())
+		{
+			return 0;
+		};
+
+		uint32_t stack[64];
+		size_t top = 0;
+		stack[top++] = 0;
+		while (top > 0)
+		{
+			const uint32_t index = stack[--top];
+			const Node& node = this->nodes[index];
+			if (node.axis == leaf)
+			{
+				for (uint32_t i = node.index; i < (node.index + node.count); i++)
+				{
+					if (box.contains(this->entries[i].point))
+					{
+						out.push_back(this->entries[i].id);
+					};
+				};
+				continue;
+			};
+			if (box.upper.value[node.axis] >= node.split)
+			{
+				stack[top++] = node.index;
+			};
+			if (box.lower.value[node.axis] <= node.split)
+			{
+				stack[top++] = (index + 1);
+			};
+		};
+		return (out.size() - before);
+	};
+
+	// Batched Query Methods
+	inline void nearest(const V* queries, const size_t& count, const size_t& k, VectorNeighbour<T>* out, const size_t& threads = 0) const
+	{
+		/*
+			Answers count nearest point queries at once, writing k results for
+			queries[i] to out[i * k] onwards.
+		*/
+
+		if ((count == 0) || (k == 0))
+		{
+			return;
+		};
+		vectorsSpatialBatch(count, threads, [&](const size_t& i) { return this->locate(queries[i]); }, [&](const uint32_t* order, const size_t& first, const size_t& last, const size_t&) {
+			VectorTopK<T> top;
+			for (size_t j = first; j < last; j++)
+			{
+				this->nearest(queries[order[j]], k, out + (order[j] * k), top);
+			};
+		});
+	};
+	inline void withinRadius(const V* centers, const size_t& count, const T& radius, VectorSpatialResults<T>& out, const size_t& threads = 0) const
+	{
+		/*
+			Answers count radius queries at once, see VectorSpatialResults.
+		*/
+
+		out.gather(count, threads, [&](const size_t& i) { return this->locate(centers[i]); }, [&](const uint32_t& i, std::vector<VectorNeighbour<T>>& buffer) {
+			this->withinRadius(centers[i], radius, buffer);
+		});
+	};
+
+private:
+	inline void buildNode(const size_t& index, const size_t& first, const size_t& last, const size_t& depth)
+	{
+		Node& node = this->nodes[index];
+		const size_t n = (last - first);
+		if (n <= leafSize)
+		{
+			node.split = T();
+			node.index = (uint32_t)first;
+			node.count = (uint32_t)n;
+			node.axis = leaf;
+			return;
+		};
+
+		Box3<T> bounds;
+		for (size_t i = first; i < last; i++)
+		{
+			bounds.expand(this->entries[i].point);
+		};
+		const uint32_t axis = bounds.longestAxis();
+		const size_t middle = (first + (n / 2));
+		std::nth_element(this->entries.begin() + first, this->entries.begin() + middle, this->entries.begin() + last, [&](const Entry& A, const Entry& B) {
+			return (A.point.value[axis] < B.point.value[axis]);
+		});
+
+		const size_t right = (index + 1 + vectorsSpatialNodeCount(n / 2, leafSize));
+		node.split = this->entries[middle].point.value[axis];
+		node.index = (uint32_t)right;
+		node.count = 0;
+		node.axis = axis;
+
+		if ((depth > 0) && (n > 65536))
+		{
+			std::thread worker([&]() { this->buildNode(index + 1, first, middle, depth - 1); });
+			this->buildNode(right, middle, last, depth - 1);
+			worker.join();
+		}
+		else
+		{
+			this->buildNode(index + 1, first, middle, 0);
+			this->buildNode(right, middle, last, 0);
+		};
+	};
+
+	inline uint32_t locate(const V& point) const
+	{
+		/*
+			The leaf point falls in.
+		*/
+
+		uint32_t index = 0;
+		if (this->nodes.empty())
+		{
+			return index;
+		};
+		while (this->nodes[index].axis != leaf)
+		{
+			const Node& node = this->nodes[index];
+			index = (point.value[node.axis] < node.split) ? (index + 1) : node.index;
+		};
+		return index;
+	};
+
+	inline size_t nearest(const V& query, const size_t& k, VectorNeighbour<T>* out, VectorTopK<T>& top) const
+	{
+		/*
+			Descends to the query's leaf first, leaving the far side of each split on a
+			stack with the distance to its plane. A far side is only visited if that is
+			still closer than the k-th nearest point found so far.
+		*/
+
+		top.reset(k);
+		if (k == 0)
+		{
+			return 0;
+		};
+		if (!this->empty())
+		{
+			struct Pending
+			{
+				uint32_t index;
+				T distance;
+			};
+			Pending stack[64];
+			size_t depth = 0;
+			stack[depth++] = Pending{ 0, T() };
+			while (depth > 0)
+			{
+				const Pending pending = stack[--depth];
+				if (pending.distance > top.threshold())
+				{
+					continue;
+				};
+				const Node* node = &this->nodes[pending.index];
+				while (node->axis != leaf)
+				{
+					const T d = (query.value[node->axis] - node->split);
+					const uint32_t left = (uint32_t)((node - this->nodes.data()) + 1);
+					const T plane = (d * d);
+					if (plane <= top.threshold())
+					{
+						stack[depth++] = Pending{ (d < T()) ? node->index : left, (plane > pending.distance) ? plane : pending.distance };
+					};
+					node = &this->nodes[(d < T()) ? left : node->index];
+				};
+				for (uint32_t i = node->index; i < (node->index + node->count); i++)
+				{
+					const T distance = vectorsSquaredDistance(query, this->entries[i].point);
+					if (distance <= top.threshold())
+					{
+						top.push(this->entries[i].id, distance);
+					};
+				};
+			};
+		};
+		return top.take(out, (T)1);
+	};
+};
+
+/* Bounding Volume Hierarchy */
+template <typename T>
+struct Bvh3
+{
+	/*
+		# BVH 3 (struct)
+		A bounding volume hierarchy over a set of axis aligned boxes. Each inner node
+		splits its boxes at the median of their centers along the axis the centers
+		are most spread out on, down to leaves of at most leafSize boxes, and stores
+		the bounds of everything below it.
+	*/
+
+	typedef Vector3D<T> V;
+
+	static constexpr size_t leafSize = 4;
+
+	struct Entry
+	{
+		Box3<T> box;
+		uint32_t id;
+	};
+	struct Node
+	{
+		/*
+			An inner node (count 0) has its left child next and index is its right
+			child; a leaf's boxes are entries[index] up to entries[index + count].
+		*/
+
+		Box3<T> bounds;
+		uint32_t index;
+		uint32_t count;
+	};
+
+	/* Elements */
+	std::vector<Entry> entries;
+	std::vector<Node> nodes;
+
+	/* Methods */
+
+	// Constructors & Destructor
+	Bvh3() {};
+	Bvh3(const Box3<T>* boxes, const size_t& n, const size_t& threads = 0)
+	{
+		this->build(boxes, n, threads);
+	};
+	Bvh3(const V* points, const size_t& n, const size_t& threads = 0)
+	{
+		this->build(points, n, threads);
+	};
+
+	// Capacity Methods
+	inline size_t size() const
+	{
+		return this->entries.size();
+	};
+	inline bool empty() const
+	{
+		return this->entries.empty();
+	};
+	inline void clear()
+	{
+		this->entries.clear();
+		this->nodes.clear();
+	};
+	inline Box3<T> bounds() const
+	{
+		return this->empty() ? Box3<T>() : this->nodes[0].bounds;
+	};
+
+	// Construction
+	inline bool build(const Box3<T>* boxes, const size_t& n, const size_t& threads = 0)
+	{
+		/*
+			Rebuilds the hierarchy over boxes[0] to boxes[n - 1], with the upper levels
+			split across threads (by default one per hardware thread). Returns false,
+			leaving it empty, if there are too many boxes for 32 bit ids.
+		*/
+
+		this->clear();
+		if ((n == 0) || (n > (size_t)std::numeric_limits<uint32_t>::max()))
+		{
+			return (n == 0);
+		};
+
+		this->entries.resize(n);
+		for (size_t i = 0; i < n; i++)
+		{
+			this->entries[i].box = boxes[i];
+			this->entries[i].id = (uint32_t)i;
+		};
+		this->buildAll(threads);
+		return true;
+	};
+	inline bool build(const V* points, const size_t& n, const size_t& threads = 0)
+	{
+		this->clear();
+		if ((n == 0) || (n > (size_t)std::numeric_limits<uint32_t>::max()))
+		{
+			return (n == 0);
+		};
+
+		this->entries.resize(n);
+		for (size_t i = 0; i < n; i++)
+		{
+			this->entries[i].box = Box3<T>(points[i]);
+			this->entries[i].id = (uint32_t)i;
+		};
+		this->buildAll(threads);
+		return true;
+	};
+
+	// Query Methods
+	inline size_t nearest(const V& query, const size_t& k, VectorNeighbour<T>* out) const
+	{
+		/*
+			Finds the k boxes nearest to query (0 for boxes containing it), writing
+			them to out nearest first, and returns how many were found. The remaining
+			slots are padded as in FlatIndex::search().
+		*/
+
+		VectorTopK<T> top;
+		return this->nearest(query, k, out, top);
+	};
+	inline size_t withinRadius(const V& center, const T& radius, std::vector<VectorNeighbour<T>>& out) const
+	{
+		/*
+			Appends every box within radius of center (inclusive) to out, with its
+			squared distance, in no particular order. Returns how many were appended.
+		*/
+
+		const size_t before = out.size();
+		if (this->empty())
+		{
+			return 0;
+		};
+
+		const T limit = (radius * radius);
+		uint32_t stack[64];
+		size_t top = 0;
+		stack[top++] = 0;
+		while (top > 0)
+		{
+			const uint32_t index = stack[--top];
+			const Node& node = this->nodes[index];
+			if (node.bounds.squaredDistance(center) > limit)
+			{
+				continue;
+			};
+			if (node.count == 0)
+			{
+				stack[top++] = node.index;
+				stack[top++] = (index + 1);
+				continue;
+			};
+			for (uint32_t i = node.index; i < (node.index + node.count); i++)
+			{
+				const T distance = this->entries[i].box.squaredDistance(center);
+				if (distance <= limit)
+				{
+					out.push_back(VectorNeighbour<T>{ this->entries[i].id, distance });
+				};
+			};
+		};
+		return (out.size() - before);
+	};
+	inline size_t overlapping(const Box3<T>& box, std::vector<uint64_t>& out) const
+	{
+		/*
+			Appends the id of every box overlapping box (touching counts) to out, in no
+			particular order. Returns how many were appended.
+		*/
+
+		const size_t before = out.size();
+		if (this->empty() || box.empty())
+		{
+			return 0;
+		};
+
+		uint32_t stack[64];
+		size_t top = 0;
+		stack[top++] = 0;
+		while (top > 0)
+		{
+			const uint32_t index = stack[--top];
+			const Node& node = this->nodes[index];
+			if (!node.bounds.overlaps(box))
+			{
+				continue;
+			};
+			if (node.count == 0)
+			{
+				stack[top++] = node.index;
+				stack[top++] = (index + 1);
+				continue;
+			};
+			for (uint32_t i = node.index; i < (node.index + node.count); i++)
+			{
+				if (this->entries[i].box.overlaps(box))
+				{
+					out.push_back(this->entries[i].id);
+				};
+			};
+		};
+		return (out.size() - before);
+	};
+
+	// Batched Query Methods
+	inline void nearest(const V* queries, const size_t& count, const size_t& k, VectorNeighbour<T>* out, const size_t& threads = 0) const
+	{
+		/*
+			Answers count nearest box queries at once, writing k results for
+			queries[i] to out[i * k] onwards.
+		*/
+
+		if ((count == 0) || (k == 0))
+		{
+			return;
+		};
+		vectorsSpatialBatch(count, threads, [&](const size_t& i) { return this->locate(queries[i]); }, [&](const uint32_t* order, const size_t& first, const size_t& last, const size_t&) {
+			VectorTopK<T> top;
+			for (size_t j = first; j < last; j++)
+			{
+				this->nearest(queries[order[j]], k, out + (order[j] * k), top);
+			};
+		});
+	};
+	inline void withinRadius(const V* centers, const size_t& count, const T& radius, VectorSpatialResults<T>& out, const size_t& threads = 0) const
+	{
+		/*
+			Answers count radius queries at once, see VectorSpatialResults.
+		*/
+
+		out.gather(count, threads, [&](const size_t& i) { return this->locate(centers[i]); }, [&](const uint32_t& i, std::vector<VectorNeighbour<T>>& buffer) {
+			this->withinRadius(centers[i], radius, buffer);
+		});
+	};
+
+private:
+	inline void buildAll(const size_t& threads)
+	{
+		this->nodes.resize(vectorsSpatialNodeCount(this->entries.size(), leafSize));
+		size_t depth = 0;
+		while (((size_t)1 << depth) < vectorsSpatialThreads(threads, this->entries.size()))
+		{
+			depth++;
+		};
+		this->buildNode(0, 0, this->entries.size(), depth);
+	};
+	inline void buildNode(const size_t& index, const size_t& first, const size_t& last, const size_t& depth)
+	{
+		Node& node = this->nodes[index];
+		const size_t n = (last - first);
+
+		Box3<T> centers;
+		node.bounds = Box3<T>();
+		for (size_t i = first; i < last; i++)
+		{
+			node.bounds.expand(this->entries[i].box);
+			centers.expand(this->entries[i].box.lower + this->entries[i].box.upper);
+		};
+		if (n <= leafSize)
+		{
+			node.index = (uint32_t)first;
+			node.count = (uint32_t)n;
+			return;
+		};
+
+		// Centers are compared doubled (lower + upper), which orders them the same
+		const uint32_t axis = centers.longestAxis();
+		const size_t middle = (first + (n / 2));
+		std::nth_element(this->entries.begin() + first, this->entries.begin() + middle, this->entries.begin() + last, [&](const Entry& A, const Entry& B) {
+			return ((A.box.lower.value[axis] + A.box.upper.value[axis]) < (B.box.lower.value[axis] + B.box.upper.value[axis]));
+		});
+
+		const size_t right = (index + 1 + vectorsSpatialNodeCount(n / 2, leafSize));
+		node.index = (uint32_t)right;
+		node.count = 0;
+
+		if ((depth > 0) && (n > 65536))
+		{
+			std::thread worker([&]() { this->buildNode(index + 1, first, middle, depth - 1); });
+			this->buildNode(right, middle, last, depth - 1);
+			worker.join();
+		}
+		else
+		{
+			this->buildNode(index + 1, first, middle, 0);
+			this->buildNode(right, middle, last, 0);
+		};
+	};
+
+	inline uint32_t locate(const V& point) const
+	{
+		/*
+			The leaf reached by always stepping into the nearer child.
+		*/
+
+		uint32_t index = 0;
+		if (this->nodes.empty())
+		{
+			return index;
+		};
+		while (this->nodes[index].count == 0)
+		{
+			const Node& node = this->nodes[index];
+			const T left = this->nodes[index + 1].bounds.squaredDistance(point);
+			const T right = this->nodes[node.index].bounds.squaredDistance(point);
+			index = (left <= right) ? (index + 1) : node.index;
+		};
+		return index;
+	};
+
+	inline size_t nearest(const V& query, const size_t& k, VectorNeighbour<T>* out, VectorTopK<T>& top) const
+	{
+		/*
+			Visits the nearer child of each node first and leaves the other on a stack
+			with the distance to its bounds, which is skipped once k boxes at least
+			that close have been found.
+		*/
+
+		top.reset(k);
+		if (k == 0)
+		{
+			return 0;
+		};
+		if (!this->empty())
+		{
+			struct Pending
+			{
+				uint32_t index;
+				T distance;
+			};
+			Pending stack[64];
+			size_t depth = 0;
+			stack[depth++] = Pending{ 0, this->nodes[0].bounds.squaredDistance(query) };
+			while (depth > 0)
+			{
+				const Pending pending = stack[--depth];
+				if (pending.distance > top.threshold())
+				{
+					continue;
+				};
+				const Node& node = this->nodes[pending.index];
+				if (node.count == 0)
+				{
+					const uint32_t left = (pending.index + 1);
+					const T l = this->nodes[left].bounds.squaredDistance(query);
+					const T r = this->nodes[node.index].bounds.squaredDistance(query);
+					if (l <= r)
+					{
+						stack[depth++] = Pending{ node.index, r };
+						stack[depth++] = Pending{ left, l };
+					}
+					else
+					{
+						stack[depth++] = Pending{ left, l };
+						stack[depth++] = Pending{ node.index, r };
+					};
+					continue;
+				};
+				for (uint32_t i = node.index; i < (node.index + node.count); i++)
+				{
+					const T distance = this->entries[i].box.squaredDistance(query);
+					if (distance <= top.threshold())
+					{
+						top.push(this->entries[i].id, distance);
+					};
+				};
+			};
+		};
+		return top.take(out, (T)1);
+	};
+};
+
+/* Spatial Hash Grid */
+template <typename T>
+struct SpatialHashGrid3
+{
+	/*
+		# Spatial Hash Grid 3 (struct)
+		A uniform grid of cubic cells over a set of 3D points, for finding the points
+		near a point, or every pair of points within a distance of each other,
+		without a tree. Cells are hashed into a table with about one bucket per
+		point, so the grid is unbounded and only occupied cells cost memory.
+
+		Building is a counting sort of the points by bucket into one array, which
+		is O(n) and reuses the arrays of the last build, so rebuilding every frame
+		of a simulation doesn't allocate once the point count settles. Cells next
+		to each other along z land in consecutive buckets, so a query reads each
+		row of cells as one run of entries instead of looking up every cell. A cell
+		around the query radius is best; smaller cells mean more rows to visit and
+		larger ones more points per cell.
+	*/
+
+	typedef Vector3D<T> V;
+
+	struct Entry
+	{
+		/*
+			A point with its id and packed cell coordinates. Each bucket may hold points
+			from several cells, which are told apart by cell.
+		*/
+
+		V point;
+		uint32_t id;
+		uint64_t cell;
+	};
+
+	/* Elements */
+	T cellSize;
+	std::vector<Entry> entries; // Grouped by bucket
+	std::vector<uint32_t> starts; // Bucket b is entries[starts[b]] up to entries[starts[b + 1]]
+	uint64_t mask; // The bucket count - 1
+	uint32_t shift; // Cell (x, y, z) is in bucket (x << 2 * shift) + (y << shift) + z, wrapped by mask
+
+	/* Methods */
+
+	// Constructors & Destructor
+	explicit SpatialHashGrid3(const T& cellSize = (T)1) : cellSize(cellSize), mask(0), shift(0) {};
+	SpatialHashGrid3(const T& cellSize, const V* points, const size_t& n, const size_t& threads = 0) : cellSize(cellSize), mask(0), shift(0)
+	{
+		this->build(points, n, threads);
+	};
+
+	// Capacity Methods
+	inline size_t size() const
+	{
+		return this->entries.size();
+	};
+	inline bool empty() const
+	{
+		return this->entries.empty();
+	};
+	inline void clear()
+	{
+		this->entries.clear();
+		this->starts.clear();
+		this->mask = 0;
+		this->shift = 0;
+	};
+
+	// Cells
+	inline Vector3D<int32_t> cell(const V& point) const
+	{
+		/*
+			The coordinates of the cell containing point, clamped to +/-2^30.
+		*/
+
+		const T scale = ((T)1 / this->cellSize);
+		const T limit = (T)(1 << 30);
+		Vector3D<int32_t> result;
+		for (uint64_t i = 0; i < 3; i++)
+		{
+			// Written so NaN lands in the lowest cell
+			T c = std::floor(point.value[i] * scale);
+			c = (c > -limit) ? c : -limit;
+			c = (c < limit) ? c : limit;
+			result.value[i] = (int32_t)c;
+		};
+		return result;
+	};
+
+	// Construction
+	inline bool build(const V* points, const size_t& n, const size_t& threads = 0)
+	{
+		/*
+			Rebuilds the grid over points[0] to points[n - 1]. The cells are worked out
+			across threads (by default one per hardware thread) and the points are
+			then counting sorted into their buckets. Returns false, leaving the grid
+			empty, if the cell size isn't positive or there are too many points for
+			32 bit ids.
+		*/
+
+		if (!(this->cellSize > T()) || (n > (size_t)std::numeric_limits<uint32_t>::max()))
+		{
+			this->clear();
+			return false;
+		};
+
+		// At most 2^21 buckets, so stepping z across the wrap of its 21 bits is still the next bucket
+		uint32_t bits = 0;
+		while ((bits < 21) && (((size_t)1 << bits) < n))
+		{
+			bits++;
+		};
+		const size_t buckets = ((size_t)1 << bits);
+		this->mask = (uint64_t)(buckets - 1);
+		this->shift = ((bits + 2) / 3);
+		this->entries.resize(n);
+		this->starts.assign(buckets + 1, 0);
+
+		// The cells and buckets of the points
+		std::vector<uint32_t> slots(n);
+		std::vector<uint64_t> cells(n);
+		const size_t workers = vectorsSpatialThreads(threads, (n >> 16));
+		const size_t share = ((n + workers - 1) / workers);
+		auto locate = [&](const size_t& first) {
+			const size_t last = std::min(n, (first + share));
+			for (size_t i = first; i < last; i++)
+			{
+				cells[i] = packCell(this->cell(points[i]));
+				slots[i] = this->bucket(cells[i]);
+			};
+		};
+		std::vector<std::thread> pool;
+		for (size_t first = share; first < n; first += share)
+		{
+			pool.emplace_back(locate, first);
+		};
+		locate(0);
+		for (std::thread& thread : pool)
+		{
+			thread.join();
+		};
+
+		// Counting sort, stable so each bucket keeps its points in id order
+		for (size_t i = 0; i < n; i++)
+		{
+			this->starts[slots[i] + 1]++;
+		};
+		for (size_t b = 0; b < buckets; b++)
+		{
+			this->starts[b + 1] += this->starts[b];
+		};
+		for (size_t i = 0; i < n; i++)
+		{
+			const uint32_t slot = this->starts[slots[i]]++;
+			this->entries[slot].point = points[i];
+			this->entries[slot].id = (uint32_t)i;
+			this->entries[slot].cell = cells[i];
+		};
+
+		// Filling the buckets moved each start along to the next bucket's
+		for (size_t b = buckets; b > 0; b--)
+		{
+			this->starts[b] = this->starts[b - 1];
+		};
+		this->starts[0] = 0;
+		return true;
+	};
+
+	// Query Methods
+	template <typename F>
+	inline void forEachInCell(const Vector3D<int32_t>& cell, const F& f) const
+	{
+		/*
+			Calls f(entry) for each entry of the points in cell.
+		*/
+
+		this->visitRow(packCell(cell), 0, f);
+	};
+	template <typename F>
+	inline void forEachNear(const V& center, const T& radius, const F& f) const
+	{
+		/*
+			Calls f(id, distance) for each point within radius of center (inclusive),
+			visiting the rows of cells the radius reaches.
+		*/
+
+		const T limit = (radius * radius);
+		const int32_t reach = this->reach(radius);
+		const Vector3D<int32_t> home = this->cell(center);
+		auto visit = [&](const Entry& entry) {
+			const T distance = vectorsSquaredDistance(center, entry.point);
+			if (distance <= limit)
+			{
+				f(entry.id, distance);
+			};
+		};
+		for (int32_t dx = -reach; dx <= reach; dx++)
+		{
+			for (int32_t dy = -reach; dy <= reach; dy++)
+			{
+				this->visitRow(packCell(Vector3D<int32_t>(home.value[0] + dx, home.value[1] + dy, home.value[2] - reach)), (uint32_t)(2 * reach), visit);
+			};
+		};
+	};
+	inline size_t withinRadius(const V& center, const T& radius, std::vector<VectorNeighbour<T>>& out) const
+	{
+		/*
+			Appends every point within radius of center (inclusive) to out, in no
+			particular order. Returns how many were appended.
+		*/
+
+		const size_t before = out.size();
+		this->forEachNear(center, radius, [&](const uint32_t& id, const T& distance) {
+			out.push_back(VectorNeighbour<T>{ id, distance });
+		});
+		return (out.size() - before);
+	};
+
+	// Pairs
+	inline size_t pairs(const T& radius, std::vector<std::pair<uint32_t, uint32_t>>& out, const size_t& threads = 0) const
+	{
+		/*
+			Appends every pair of points within radius of each other (inclusive) to
+			out, once each as (smaller id, larger id), and returns how many were
+			appended. The entries are split into contiguous ranges across threads (by
+			default one per hardware thread), each looking only at the half of the
+			neighbouring cells which come after its own, so no pair is found twice.
+			The order of the pairs is the same whatever the thread count.
+		*/
+
+		const size_t before = out.size();
+		const size_t n = this->size();
+		if (n < 2)
+		{
+			return 0;
+		};
+		const T limit = (radius * radius);
+		const int32_t reach = this->reach(radius);
+
+		const size_t workers = vectorsSpatialThreads(threads, (n >> 12));
+		const size_t share = ((n + workers - 1) / workers);
+		std::vector<std::vector<std::pair<uint32_t, uint32_t>>> found(workers);
+		auto search = [&](const size_t& worker) {
+			std::vector<std::pair<uint32_t, uint32_t>>& buffer = (worker == 0) ? out : found[worker];
+			const size_t last = std::min(n, ((worker + 1) * share));
+			for (size_t e = (worker * share); e < last; e++)
+			{
+				const Entry& entry = this->entries[e];
+				auto emit = [&](const Entry& other) {
+					if (vectorsSquaredDistance(entry.point, other.point) <= limit)
+					{
+						buffer.push_back((entry.id < other.id) ? std::make_pair(entry.id, other.id) : std::make_pair(other.id, entry.id));
+					};
+				};
+
+				// Its own cell from the entries after it and the rest of its row, then the
+				// rows after its own in the order x, y. The whole row is scanned, as when it
+				// wraps around the table other cells may share its bucket and come before it.
+				const Vector3D<int32_t> home = unpackCell(entry.cell);
+				this->visitRow(entry.cell, (uint32_t)reach, [&](const Entry& other) {
+					if ((other.cell != entry.cell) || (&other > &entry))
+					{
+						emit(other);
+					};
+				});
+				for (int32_t dx = 0; dx <= reach; dx++)
+				{
+					for (int32_t dy = ((dx == 0) ? 1 : -reach); dy <= reach; dy++)
+					{
+						this->visitRow(packCell(Vector3D<int32_t>(home.value[0] + dx, home.value[1] + dy, home.value[2] - reach)), (uint32_t)(2 * reach), emit);
+					};
+				};
+			};
+		};
+
+		std::vector<std::thread> pool;
+		for (size_t worker = 1; (worker * share) < n; worker++)
+		{
+			pool.emplace_back(search, worker);
+		};
+		search(0);
+		for (std::thread& thread : pool)
+		{
+			thread.join();
+		};
+		for (size_t worker = 1; worker < workers; worker++)
+		{
+			out.insert(out.end(), found[worker].begin(), found[worker].end());
+		};
+		return (out.size() - before);
+	};
+
+private:
+	static inline uint64_t packCell(const Vector3D<int32_t>& cell)
+	{
+		/*
+			The low 21 bits of each coordinate, z lowest. Cells 2^21 apart share a
+			key, which only costs some extra distance checks.
+		*/
+
+		return (((uint64_t)(cell.value[0] & 0x1FFFFF) << 42) | ((uint64_t)(cell.value[1] & 0x1FFFFF) << 21) | (uint64_t)(cell.value[2] & 0x1FFFFF));
+	};
+	static inline Vector3D<int32_t> unpackCell(const uint64_t& key)
+	{
+		return Vector3D<int32_t>((int32_t)((key >> 42) & 0x1FFFFF), (int32_t)((key >> 21) & 0x1FFFFF), (int32_t)(key & 0x1FFFFF));
+	};
+	inline uint32_t bucket(const uint64_t& key) const
+	{
+		return (uint32_t)((((key >> 42) << (2 * this->shift)) + (((key >> 21) & 0x1FFFFF) << this->shift) + (key & 0x1FFFFF)) & this->mask);
+	};
+	inline int32_t reach(const T& radius) const
+	{
+		/*
+			How many cells out from its own a point within radius can be.
+		*/
+
+		const T cells = std::ceil(radius / this->cellSize);
+		return (cells > T()) ? (int32_t)std::min(cells, (T)((1 << 20) - 1)) : 0;
+	};
+	template <typename F>
+	inline void visitRow(const uint64_t& key, const uint32_t& span, const F& f) const
+	{
+		/*
+			Calls f(entry) for the entries in the cells from key to span further along
+			z. Those cells are in consecutive buckets, wrapping around the end of the
+			table, so they are one or two runs of entries.
+		*/
+
+		if (this->empty())
+		{
+			return;
+		};
+		const uint64_t row = (key >> 21);
+		const uint32_t z = (uint32_t)(key & 0x1FFFFF);
+		const Entry* entries = this->entries.data();
+		const uint32_t* starts = this->starts.data();
+		const uint64_t buckets = (this->mask + 1);
+		const uint64_t b = this->bucket(key);
+		const uint64_t count = std::min(((uint64_t)span + 1), buckets);
+		auto scan = [&](uint32_t e, const uint32_t& end) {
+			for (; e < end; e++)
+			{
+				const uint64_t cell = entries[e].cell;
+				if (((cell >> 21) == row) && ((((uint32_t)cell - z) & 0x1FFFFF) <= span))
+				{
+					f(entries[e]);
+				};
+			};
+		};
+		if ((b + count) <= buckets)
+		{
+			scan(starts[b], starts[b + count]);
+		}
+		else
+		{
+			scan(starts[b], starts[buckets]);
+			scan(0, starts[(b + count) - buckets]);
+		};
+	};
+};
+
+#endif